@@ -0,0 +1,366 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2022
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 6.3.2026.10.17
+
+#include <Applications/GTApplicationsPCH.h>
+#include <Applications/BinaryContainer.h>
+#include <Graphics/DataFormat.h>
+#include <fstream>
+using namespace gte;
+
+static_assert(sizeof(BinaryContainer::Header) == 64, "Unexpected header size.");
+static_assert(sizeof(BinaryContainer::Section) == 288, "Unexpected section size.");
+
+char const* const BinaryContainer::msMagic = "GTEBINC";
+
+BinaryContainer::BinaryContainer()
+{
+}
+
+bool BinaryContainer::Open(std::string const& filename)
+{
+    Close();
+    if (!mFile.Open(filename))
+    {
+        return false;
+    }
+
+    size_t const numFileBytes = mFile.GetNumBytes();
+    Header header;
+    if (numFileBytes < sizeof(Header))
+    {
+        Close();
+        return false;
+    }
+    std::memcpy(&header, mFile.GetData(), sizeof(Header));
+    if (std::memcmp(header.magic, msMagic, sizeof(header.magic)) != 0
+        || header.version == 0 || header.version > VERSION
+        || header.tableOffset > numFileBytes
+        || header.numSections > (numFileBytes - header.tableOffset) / sizeof(Section))
+    {
+        Close();
+        return false;
+    }
+
+    mSections.resize(header.numSections);
+    if (header.numSections > 0)
+    {
+        std::memcpy(mSections.data(), mFile.GetData() + header.tableOffset,
+            header.numSections * sizeof(Section));
+    }
+
+    for (auto& section : mSections)
+    {
+        section.name[MAX_NAME_LENGTH] = 0;
+        if (section.offset % ALIGNMENT != 0
+            || section.offset > numFileBytes
+            || section.numBytes > numFileBytes - section.offset
+            || section.numAttributes > VAConstant::MAX_ATTRIBUTES)
+        {
+            Close();
+            return false;
+        }
+    }
+    return true;
+}
+
+void BinaryContainer::Close()
+{
+    mFile.Close();
+    mSections.clear();
+}
+
+int32_t BinaryContainer::Find(std::string const& name) const
+{
+    for (size_t i = 0; i < mSections.size(); ++i)
+    {
+        if (name == mSections[i].name)
+        {
+            return static_cast<int32_t>(i);
+        }
+    }
+    return -1;
+}
+
+BinaryContainer::Section const& BinaryContainer::GetSection(int32_t i) const
+{
+    LogAssert(0 <= i && i < GetNumSections(), "Invalid section index.");
+    return mSections[i];
+}
+
+char* BinaryContainer::GetData(int32_t i) const
+{
+    return mFile.GetData() + GetSection(i).offset;
+}
+
+std::shared_ptr<VertexBuffer> BinaryContainer::CreateVertexBuffer(int32_t i) const
+{
+    Section const& section = GetSection(i);
+    LogAssert(section.type == SectionType::VERTICES, "The section is not a vertex buffer.");
+
+    VertexFormat vformat;
+    for (uint32_t j = 0; j < section.numAttributes; ++j)
+    {
+        auto const& attribute = section.attributes[j];
+        vformat.Bind(static_cast<VASemantic>(attribute[0]),
+            static_cast<DFType>(attribute[1]), attribute[2]);
+    }
+    LogAssert(vformat.GetVertexSize() == section.elementSize, "Mismatched vertex size.");
+
+    auto vbuffer = std::make_shared<VertexBuffer>(vformat, section.numElements, false);
+    LogAssert(vbuffer->GetNumBytes() == section.numBytes, "Mismatched number of bytes.");
+    vbuffer->SetData(GetData(i));
+    return vbuffer;
+}
+
+std::shared_ptr<IndexBuffer> BinaryContainer::CreateIndexBuffer(int32_t i) const
+{
+    Section const& section = GetSection(i);
+    LogAssert(section.type == SectionType::INDICES, "The section is not an index buffer.");
+
+    auto ibuffer = std::make_shared<IndexBuffer>(static_cast<IPType>(section.format),
+        section.numElements, section.elementSize, false);
+    LogAssert(ibuffer->GetNumBytes() == section.numBytes, "Mismatched number of bytes.");
+    ibuffer->SetData(GetData(i));
+    return ibuffer;
+}
+
+std::shared_ptr<Texture2> BinaryContainer::CreateTexture2(int32_t i) const
+{
+    Section const& section = GetImageSection(i, 0);
+    LogAssert(section.dimensions[2] == 1, "The section is not a 2D image.");
+
+    auto texture = std::make_shared<Texture2>(section.format,
+        section.dimensions[0], section.dimensions[1], false, false);
+    LogAssert(texture->GetNumBytes() == section.numBytes, "Mismatched number of bytes.");
+    texture->SetData(GetData(i));
+    return texture;
+}
+
+std::shared_ptr<Texture3> BinaryContainer::CreateTexture3(int32_t i) const
+{
+    Section const& section = GetImageSection(i, 0);
+
+    auto texture = std::make_shared<Texture3>(section.format, section.dimensions[0],
+        section.dimensions[1], section.dimensions[2], false, false);
+    LogAssert(texture->GetNumBytes() == section.numBytes, "Mismatched number of bytes.");
+    texture->SetData(GetData(i));
+    return texture;
+}
+
+BinaryContainer::Section const& BinaryContainer::GetImageSection(int32_t i,
+    size_t elementSize) const
+{
+    // An elementSize of 0 requests a section that can be used for a
+    // texture.
+    Section const& section = GetSection(i);
+    LogAssert(section.type == SectionType::IMAGE, "The section is not an image.");
+    if (elementSize > 0)
+    {
+        LogAssert(section.elementSize == elementSize, "Mismatched pixel size.");
+    }
+    else
+    {
+        LogAssert(section.format != DF_UNKNOWN
+            && DataFormat::GetNumBytesPerStruct(section.format) == section.elementSize,
+            "The section does not have a texture format.");
+    }
+    return section;
+}
+
+int32_t BinaryContainerWriter::AddRaw(std::string const& name, size_t numBytes,
+    void const* data, uint32_t elementSize)
+{
+    LogAssert(elementSize > 0 && numBytes % elementSize == 0, "Invalid element size.");
+
+    BinaryContainer::Section section{};
+    section.type = BinaryContainer::SectionType::RAW;
+    section.elementSize = elementSize;
+    section.numBytes = numBytes;
+    section.numElements = static_cast<uint32_t>(numBytes / elementSize);
+    std::strncpy(section.name, name.c_str(), BinaryContainer::MAX_NAME_LENGTH);
+    return Add(section, data);
+}
+
+int32_t BinaryContainerWriter::AddVertices(std::string const& name,
+    VertexFormat const& vformat, uint32_t numVertices, void const* data)
+{
+    BinaryContainer::Section section{};
+    section.type = BinaryContainer::SectionType::VERTICES;
+    section.elementSize = vformat.GetVertexSize();
+    section.numBytes = static_cast<uint64_t>(numVertices) * vformat.GetVertexSize();
+    section.numElements = numVertices;
+    section.numAttributes = static_cast<uint32_t>(vformat.GetNumAttributes());
+    for (int32_t j = 0; j < vformat.GetNumAttributes(); ++j)
+    {
+        VASemantic semantic{};
+        DFType type{};
+        uint32_t unit{}, offset{};
+        vformat.GetAttribute(j, semantic, type, unit, offset);
+        section.attributes[j] = { static_cast<uint32_t>(semantic),
+            static_cast<uint32_t>(type), unit };
+    }
+    std::strncpy(section.name, name.c_str(), BinaryContainer::MAX_NAME_LENGTH);
+    return Add(section, data);
+}
+
+int32_t BinaryContainerWriter::AddVertices(std::string const& name,
+    VertexBuffer const& vbuffer)
+{
+    LogAssert(vbuffer.GetData() != nullptr, "The vertex buffer has no data.");
+    return AddVertices(name, vbuffer.GetFormat(), vbuffer.GetNumElements(), vbuffer.GetData());
+}
+
+int32_t BinaryContainerWriter::AddIndices(std::string const& name, IPType type,
+    uint32_t numPrimitives, size_t indexSize, void const* data)
+{
+    // The index buffer computes the number of indices for the primitive
+    // type.
+    IndexBuffer ibuffer(type, numPrimitives, indexSize, false);
+
+    BinaryContainer::Section section{};
+    section.type = BinaryContainer::SectionType::INDICES;
+    section.elementSize = static_cast<uint32_t>(indexSize);
+    section.numBytes = ibuffer.GetNumBytes();
+    section.format = static_cast<uint32_t>(type);
+    section.numElements = numPrimitives;
+    std::strncpy(section.name, name.c_str(), BinaryContainer::MAX_NAME_LENGTH);
+    return Add(section, data);
+}
+
+int32_t BinaryContainerWriter::AddIndices(std::string const& name,
+    IndexBuffer const& ibuffer)
+{
+    LogAssert(ibuffer.GetData() != nullptr, "The index buffer has no data.");
+    return AddIndices(name, ibuffer.GetPrimitiveType(), ibuffer.GetNumPrimitives(),
+        ibuffer.GetElementSize(), ibuffer.GetData());
+}
+
+int32_t BinaryContainerWriter::AddImage(std::string const& name, uint32_t format,
+    uint32_t elementSize, uint32_t dimension0, uint32_t dimension1,
+    uint32_t dimension2, void const* data)
+{
+    LogAssert(elementSize > 0, "Invalid element size.");
+    LogAssert(format == DF_UNKNOWN || DataFormat::GetNumBytesPerStruct(format) == elementSize,
+        "Mismatched format and element size.");
+
+    BinaryContainer::Section section{};
+    section.type = BinaryContainer::SectionType::IMAGE;
+    section.elementSize = elementSize;
+    section.format = format;
+    section.dimensions = { dimension0, dimension1, dimension2 };
+    uint64_t numElements = static_cast<uint64_t>(dimension0) * dimension1 * dimension2;
+    section.numElements = static_cast<uint32_t>(numElements);
+    section.numBytes = numElements * elementSize;
+    std::strncpy(section.name, name.c_str(), BinaryContainer::MAX_NAME_LENGTH);
+    return Add(section, data);
+}
+
+int32_t BinaryContainerWriter::Add(BinaryContainer::Section const& section, void const* data)
+{
+    LogAssert(section.numBytes == 0 || data != nullptr, "Invalid data.");
+    for (auto const& other : mSections)
+    {
+        LogAssert(std::strcmp(other.name, section.name) != 0, "Duplicate section name.");
+    }
+
+    mSections.push_back(section);
+    mData.push_back(data);
+    return static_cast<int32_t>(mSections.size()) - 1;
+}
+
+bool BinaryContainerWriter::Save(std::string const& filename) const
+{
+    uint64_t const alignment = BinaryContainer::ALIGNMENT;
+    auto align = [alignment](uint64_t offset)
+    {
+        return (offset + alignment - 1) / alignment * alignment;
+    };
+
+    BinaryContainer::Header header{};
+    std::memcpy(header.magic, BinaryContainer::msMagic, sizeof(header.magic));
+    header.version = BinaryContainer::VERSION;
+    header.numSections = static_cast<uint32_t>(mSections.size());
+    header.tableOffset = sizeof(BinaryContainer::Header);
+
+    std::vector<BinaryContainer::Section> sections = mSections;
+    uint64_t offset = align(header.tableOffset + sections.size() * sizeof(BinaryContainer::Section));
+    for (auto& section : sections)
+    {
+        section.offset = offset;
+        offset = align(offset + section.numBytes);
+    }
+
+    std::ofstream output(filename, std::ios::binary);
+    if (!output)
+    {
+        return false;
+    }
+
+    output.write(reinterpret_cast<char const*>(&header), sizeof(header));
+    if (sections.size() > 0)
+    {
+        output.write(reinterpret_cast<char const*>(sections.data()),
+            sections.size() * sizeof(BinaryContainer::Section));
+    }
+
+    std::array<char, BinaryContainer::ALIGNMENT> const padding{};
+    uint64_t position = header.tableOffset + sections.size() * sizeof(BinaryContainer::Section);
+    for (size_t i = 0; i < sections.size(); ++i)
+    {
+        output.write(padding.data(), static_cast<std::streamsize>(sections[i].offset - position));
+        output.write(static_cast<char const*>(mData[i]),
+            static_cast<std::streamsize>(sections[i].numBytes));
+        position = sections[i].offset + sections[i].numBytes;
+    }
+    output.write(padding.data(), static_cast<std::streamsize>(align(position) - position));
+    return static_cast<bool>(output);
+}
+
+bool BinaryContainerWriter::ConvertMesh(std::string const& inputFilename,
+    VertexFormat const& vformat, uint32_t numVertices, IPType type,
+    uint32_t numPrimitives, size_t indexSize, std::string const& outputFilename)
+{
+    MappedFile input;
+    if (!input.Open(inputFilename))
+    {
+        return false;
+    }
+
+    BinaryContainerWriter writer;
+    writer.AddVertices("vertices", vformat, numVertices, input.GetData());
+    uint64_t vertexBytes = writer.mSections[0].numBytes;
+    if (vertexBytes > input.GetNumBytes())
+    {
+        return false;
+    }
+    writer.AddIndices("indices", type, numPrimitives, indexSize, input.GetData() + vertexBytes);
+    if (writer.mSections[1].numBytes != input.GetNumBytes() - vertexBytes)
+    {
+        return false;
+    }
+    return writer.Save(outputFilename);
+}
+
+bool BinaryContainerWriter::ConvertImage(std::string const& inputFilename,
+    uint32_t format, uint32_t elementSize, uint32_t dimension0,
+    uint32_t dimension1, uint32_t dimension2, std::string const& outputFilename)
+{
+    MappedFile input;
+    if (!input.Open(inputFilename))
+    {
+        return false;
+    }
+
+    BinaryContainerWriter writer;
+    writer.AddImage("image", format, elementSize, dimension0, dimension1,
+        dimension2, input.GetData());
+    if (writer.mSections[0].numBytes != input.GetNumBytes())
+    {
+        return false;
+    }
+    return writer.Save(outputFilename);
+}
@@ -0,0 +1,266 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2022
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 6.3.2026.10.17
+
+#pragma once
+
+#include <Applications/MappedFile.h>
+#include <Graphics/IndexBuffer.h>
+#include <Graphics/Texture2.h>
+#include <Graphics/Texture3.h>
+#include <Graphics/VertexBuffer.h>
+#include <Mathematics/Image2.h>
+#include <Mathematics/Image3.h>
+#include <Mathematics/Logger.h>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+// A versioned binary container for meshes and volumes that is loaded by
+// memory-mapping the file. The file is a 64-byte header, a table of
+// sections and the section data, each section starting at a multiple of 64
+// bytes from the beginning of the file. A section is one of
+//   RAW:       an array of bytes with an application-defined meaning
+//   VERTICES:  the vertices of a VertexBuffer and its VertexFormat
+//   INDICES:   the indices of an IndexBuffer, its primitive type, number
+//              of primitives and index size
+//   IMAGE:     a 2D or 3D grid of pixels (voxels) with a pixel size and
+//              optionally a DFType, for use with Image2, Image3, Texture2
+//              or Texture3
+// All values are stored in little-endian order.
+//
+// The Create* functions return resources without storage whose data
+// pointers are set to the mapped memory, so no data is copied and the
+// operating system reads the pages of the file only when they are
+// accessed. The container must not be closed or destroyed while such
+// resources are in use. The mapping is copy-on-write, so the resources may
+// be modified; the modifications are not written to the file. Image2 and
+// Image3 store their pixels in a std::vector, so GetImage copies the
+// section data once; use GetData to access the voxels without a copy.
+//
+// The legacy sample files, for example, Brain_V4098_T8192.binary (the
+// vertex array followed by the index array) and
+// Head_U16_X128_Y128_Z64.binary (the voxel array), are converted by the
+// BinaryContainerWriter::Convert* functions.
+
+namespace gte
+{
+    class BinaryContainer
+    {
+    public:
+        enum
+        {
+            VERSION = 1,
+            ALIGNMENT = 64,
+            MAX_NAME_LENGTH = 47
+        };
+
+        enum class SectionType : uint32_t
+        {
+            RAW,
+            VERTICES,
+            INDICES,
+            IMAGE
+        };
+
+        // The file layout of the header and of the entries of the section
+        // table.
+        struct Header
+        {
+            char magic[8];
+            uint32_t version;
+            uint32_t numSections;
+            uint64_t tableOffset;
+            uint8_t reserved[40];
+        };
+
+        struct Section
+        {
+            char name[MAX_NAME_LENGTH + 1];
+            SectionType type;
+            uint32_t elementSize;
+            uint64_t offset;
+            uint64_t numBytes;
+
+            // VERTICES: unused, INDICES: IPType, IMAGE: DFType or
+            // DF_UNKNOWN for pixel types without a DFType.
+            uint32_t format;
+
+            // VERTICES: the number of vertices, INDICES: the number of
+            // primitives, IMAGE and RAW: the number of elements.
+            uint32_t numElements;
+
+            // IMAGE: the dimensions, where dimensions[2] is 1 for a 2D
+            // image.
+            std::array<uint32_t, 3> dimensions;
+
+            // VERTICES: the VASemantic, DFType and unit of each attribute.
+            uint32_t numAttributes;
+            std::array<std::array<uint32_t, 3>, VAConstant::MAX_ATTRIBUTES> attributes;
+        };
+
+        static char const* const msMagic;
+
+        // Construction and destruction.
+        BinaryContainer();
+        ~BinaryContainer() = default;
+
+        // Map the file and validate its header and section table. The
+        // function returns 'false' when the file cannot be mapped or is not
+        // a valid container of a version no larger than VERSION.
+        bool Open(std::string const& filename);
+        void Close();
+
+        inline bool IsOpen() const
+        {
+            return mFile.IsOpen();
+        }
+
+        // Section access. Find returns -1 when the container has no section
+        // with the specified name.
+        inline int32_t GetNumSections() const
+        {
+            return static_cast<int32_t>(mSections.size());
+        }
+
+        int32_t Find(std::string const& name) const;
+        Section const& GetSection(int32_t i) const;
+
+        // The mapped memory of a section.
+        char* GetData(int32_t i) const;
+
+        // The mapped memory of a section as an array of T. The size of T
+        // must be the element size of the section.
+        template <typename T>
+        T* Get(int32_t i) const
+        {
+            LogAssert(GetSection(i).elementSize == sizeof(T), "Mismatched element size.");
+            return reinterpret_cast<T*>(GetData(i));
+        }
+
+        // Create resources whose data pointers are set to the mapped memory
+        // of VERTICES, INDICES or IMAGE sections. The IMAGE section for a
+        // texture must have a DFType whose size is the element size.
+        std::shared_ptr<VertexBuffer> CreateVertexBuffer(int32_t i) const;
+        std::shared_ptr<IndexBuffer> CreateIndexBuffer(int32_t i) const;
+        std::shared_ptr<Texture2> CreateTexture2(int32_t i) const;
+        std::shared_ptr<Texture3> CreateTexture3(int32_t i) const;
+
+        // Copy the pixels of an IMAGE section to an image. The size of
+        // PixelType must be the element size of the section.
+        template <typename PixelType>
+        void GetImage(int32_t i, Image2<PixelType>& image) const
+        {
+            Section const& section = GetImageSection(i, sizeof(PixelType));
+            LogAssert(section.dimensions[2] == 1, "The section is not a 2D image.");
+            image.Reconstruct(static_cast<int32_t>(section.dimensions[0]),
+                static_cast<int32_t>(section.dimensions[1]));
+            std::memcpy(image.GetPixels().data(), GetData(i), static_cast<size_t>(section.numBytes));
+        }
+
+        template <typename PixelType>
+        void GetImage(int32_t i, Image3<PixelType>& image) const
+        {
+            Section const& section = GetImageSection(i, sizeof(PixelType));
+            image.Reconstruct(static_cast<int32_t>(section.dimensions[0]),
+                static_cast<int32_t>(section.dimensions[1]),
+                static_cast<int32_t>(section.dimensions[2]));
+            std::memcpy(image.GetPixels().data(), GetData(i), static_cast<size_t>(section.numBytes));
+        }
+
+    private:
+        Section const& GetImageSection(int32_t i, size_t elementSize) const;
+
+        MappedFile mFile;
+        std::vector<Section> mSections;
+    };
+
+    // Create a container file from data in memory. The Add* functions store
+    // pointers to the data, not copies, so the data must exist until Save
+    // is called. This allows converting files larger than the available
+    // memory by passing pointers to memory-mapped files.
+    class BinaryContainerWriter
+    {
+    public:
+        BinaryContainerWriter() = default;
+
+        // The Add* functions return the index of the section. The names of
+        // the sections must be distinct and have at most MAX_NAME_LENGTH
+        // characters.
+        int32_t AddRaw(std::string const& name, size_t numBytes,
+            void const* data, uint32_t elementSize = 1);
+
+        int32_t AddVertices(std::string const& name, VertexFormat const& vformat,
+            uint32_t numVertices, void const* data);
+
+        int32_t AddVertices(std::string const& name, VertexBuffer const& vbuffer);
+
+        int32_t AddIndices(std::string const& name, IPType type,
+            uint32_t numPrimitives, size_t indexSize, void const* data);
+
+        int32_t AddIndices(std::string const& name, IndexBuffer const& ibuffer);
+
+        // Add a 2D image (dimension2 = 1) or 3D image. The format is the
+        // DFType of a pixel or DF_UNKNOWN when the pixel type has no
+        // DFType, in which case the section cannot be used to create a
+        // texture.
+        int32_t AddImage(std::string const& name, uint32_t format,
+            uint32_t elementSize, uint32_t dimension0, uint32_t dimension1,
+            uint32_t dimension2, void const* data);
+
+        template <typename PixelType>
+        int32_t AddImage(std::string const& name, Image2<PixelType> const& image,
+            uint32_t format = DF_UNKNOWN)
+        {
+            return AddImage(name, format, sizeof(PixelType),
+                static_cast<uint32_t>(image.GetDimension(0)),
+                static_cast<uint32_t>(image.GetDimension(1)), 1,
+                image.GetPixels().data());
+        }
+
+        template <typename PixelType>
+        int32_t AddImage(std::string const& name, Image3<PixelType> const& image,
+            uint32_t format = DF_UNKNOWN)
+        {
+            return AddImage(name, format, sizeof(PixelType),
+                static_cast<uint32_t>(image.GetDimension(0)),
+                static_cast<uint32_t>(image.GetDimension(1)),
+                static_cast<uint32_t>(image.GetDimension(2)),
+                image.GetPixels().data());
+        }
+
+        // Write the container. The function returns 'false' when the file
+        // cannot be written.
+        bool Save(std::string const& filename) const;
+
+        // Convert a legacy mesh file that stores the vertex array followed
+        // by the index array, for example, Brain_V4098_T8192.binary with
+        // vertices of 3 floats and triangles of 3 uint32_t indices. The
+        // sections are named "vertices" and "indices".
+        static bool ConvertMesh(std::string const& inputFilename,
+            VertexFormat const& vformat, uint32_t numVertices, IPType type,
+            uint32_t numPrimitives, size_t indexSize,
+            std::string const& outputFilename);
+
+        // Convert a legacy volume file that stores the voxel array, for
+        // example, Head_U16_X128_Y128_Z64.binary with format DF_R16_UINT,
+        // element size 2 and dimensions 128, 128 and 64. The section is
+        // named "image".
+        static bool ConvertImage(std::string const& inputFilename,
+            uint32_t format, uint32_t elementSize, uint32_t dimension0,
+            uint32_t dimension1, uint32_t dimension2,
+            std::string const& outputFilename);
+
+    private:
+        int32_t Add(BinaryContainer::Section const& section, void const* data);
+
+        std::vector<BinaryContainer::Section> mSections;
+        std::vector<void const*> mData;
+    };
+}
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 6.0.2022.01.06
+// Version: 6.3.2026.10.17
 
 // The functions were written based on the example source code
 // https://dev.w3.org/Amaya/libpng/example.c
@@ -54,6 +54,12 @@ struct WICFileIOPrivateHelper
     bool isRead;
 };
 
+static bool IsLittleEndian()
+{
+    uint16_t const value = 1;
+    return *reinterpret_cast<uint8_t const*>(&value) == 1;
+}
+
 std::shared_ptr<Texture2> WICFileIO::Load(std::string const& filename, bool wantMipmaps)
 {
     // The destructor for the helper will be called on any return from
@@ -76,6 +82,10 @@ std::shared_ptr<Texture2> WICFileIO::Load(std::string const& filename, bool want
         return nullptr;
     }
 
+    // The texture and row pointers are declared before the setjmp call
+    // so that they are destroyed when libpng reports an error.
+    std::shared_ptr<Texture2> texture;
+    std::vector<png_bytep> rows;
     if (setjmp(png_jmpbuf(helper.png_ptr)))
     {
         return nullptr;
@@ -83,8 +93,7 @@ std::shared_ptr<Texture2> WICFileIO::Load(std::string const& filename, bool want
 
     png_init_io(helper.png_ptr, helper.fp);
     png_set_sig_bytes(helper.png_ptr, 0);
-
-    png_read_png(helper.png_ptr, helper.info_ptr, 0, nullptr);
+    png_read_info(helper.png_ptr, helper.info_ptr);
 
     png_uint_32 width, height;
     int32_t bit_depth, color_type, interlace_method, compression_method, filter_method;
@@ -109,144 +118,53 @@ std::shared_ptr<Texture2> WICFileIO::Load(std::string const& filename, bool want
         return nullptr;
     }
 
-    png_bytepp rows = png_get_rows(helper.png_ptr, helper.info_ptr);
+    uint32_t format = DF_UNKNOWN;
+    switch (color_type)
+    {
+    case PNG_COLOR_TYPE_RGBA:
+    case PNG_COLOR_TYPE_RGB:
+        format = (bit_depth == 8 ? DF_R8G8B8A8_UNORM : DF_R16G16B16A16_UNORM);
+        break;
+    case PNG_COLOR_TYPE_GA:
+        format = (bit_depth == 8 ? DF_R8G8_UNORM : DF_R16G16_UNORM);
+        break;
+    case PNG_COLOR_TYPE_GRAY:
+        format = (bit_depth == 8 ? DF_R8_UNORM : DF_R16_UNORM);
+        break;
+    default:
+        return nullptr;
+    }
 
-    std::shared_ptr<Texture2> texture;
-    if (bit_depth == 8)
+    // The libpng transformations convert the pixels to the texture format
+    // while decoding, so the rows are decoded directly into the texture
+    // storage. RGB is expanded to RGBA with an opaque alpha channel and the
+    // 16-bit channels, which are big-endian in the file, are converted to
+    // the byte order of the machine.
+    if (color_type == PNG_COLOR_TYPE_RGB)
     {
-        uint8_t const* src = nullptr;
-        uint8_t* trg = nullptr;
-        if (color_type == PNG_COLOR_TYPE_RGBA)
-        {
-            texture = std::make_shared<Texture2>(DF_R8G8B8A8_UNORM, width, height, wantMipmaps);
-            trg = texture->Get<uint8_t>();
-            for (png_uint_32 y = 0; y < height; ++y)
-            {
-                src = reinterpret_cast<uint8_t const*>(rows[y]);
-                for (png_uint_32 x = 0; x < width; ++x)
-                {
-                    for (int32_t i = 0; i < 4; ++i)
-                    {
-                        *trg++ = src[4 * x + i];
-                    }
-                }
-            }
-        }
-        else if (color_type == PNG_COLOR_TYPE_RGB)
-        {
-            texture = std::make_shared<Texture2>(DF_R8G8B8A8_UNORM, width, height, wantMipmaps);
-            trg = texture->Get<uint8_t>();
-            for (png_uint_32 y = 0; y < height; ++y)
-            {
-                src = reinterpret_cast<uint8_t const*>(rows[y]);
-                for (png_uint_32 x = 0; x < width; ++x)
-                {
-                    for (int32_t i = 0; i < 3; ++i)
-                    {
-                        *trg++ = src[3 * x + i];
-                    }
-                    *trg++ = 0xFFu;
-                }
-            }
-        }
-        else if (color_type == PNG_COLOR_TYPE_GRAY)
-        {
-            texture = std::make_shared<Texture2>(DF_R8_UNORM, width, height, wantMipmaps);
-            trg = texture->Get<uint8_t>();
-            for (png_uint_32 y = 0; y < height; ++y)
-            {
-                src = reinterpret_cast<uint8_t const*>(rows[y]);
-                for (png_uint_32 x = 0; x < width; ++x)
-                {
-                    *trg++ = src[x];
-                }
-            }
-        }
-        else if (color_type == PNG_COLOR_TYPE_GA)
-        {
-            texture = std::make_shared<Texture2>(DF_R8G8_UNORM, width, height, wantMipmaps);
-            trg = texture->Get<uint8_t>();
-            for (png_uint_32 y = 0; y < height; ++y)
-            {
-                src = reinterpret_cast<uint8_t const*>(rows[y]);
-                for (png_uint_32 x = 0; x < width; ++x)
-                {
-                    for (int32_t i = 0; i < 2; ++i)
-                    {
-                        *trg++ = src[2 * x + i];
-                    }
-                }
-            }
-        }
+        png_set_filler(helper.png_ptr, (bit_depth == 8 ? 0xFFu : 0xFFFFu), PNG_FILLER_AFTER);
     }
-    else // bit_depth is 16
+    if (bit_depth == 16 && IsLittleEndian())
     {
-        uint16_t const* src = nullptr;
-        uint16_t* trg = nullptr;
-        if (color_type == PNG_COLOR_TYPE_RGBA)
-        {
-            texture = std::make_shared<Texture2>(DF_R16G16B16A16_UNORM, width, height, wantMipmaps);
-            trg = texture->Get<uint16_t>();
-            for (png_uint_32 y = 0; y < height; ++y)
-            {
-                src = reinterpret_cast<uint16_t const*>(rows[y]);
-                for (png_uint_32 x = 0; x < width; ++x)
-                {
-                    for (int32_t i = 0; i < 4; ++i)
-                    {
-                        *trg++ = src[4 * x + i];
-                    }
-                }
-            }
-        }
-        else if (color_type == PNG_COLOR_TYPE_RGB)
-        {
-            texture = std::make_shared<Texture2>(DF_R8G8B8A8_UNORM, width, height, wantMipmaps);
-            trg = texture->Get<uint16_t>();
-            for (png_uint_32 y = 0; y < height; ++y)
-            {
-                src = reinterpret_cast<uint16_t const*>(rows[y]);
-                for (png_uint_32 x = 0; x < width; ++x)
-                {
-                    for (int32_t i = 0; i < 3; ++i)
-                    {
-                        *trg++ = src[3 * x + i];
-                    }
-                    *trg++ = 0xFFFFu;
-                }
-            }
-        }
-        else if (color_type == PNG_COLOR_TYPE_GRAY)
-        {
-            texture = std::make_shared<Texture2>(DF_R16_UNORM, width, height, wantMipmaps);
-            trg = texture->Get<uint16_t>();
-            for (png_uint_32 y = 0; y < height; ++y)
-            {
-                src = reinterpret_cast<uint16_t const*>(rows[y]);
-                for (png_uint_32 x = 0; x < width; ++x)
-                {
-                    *trg++ = src[x];
-                }
-            }
-        }
-        else if (color_type == PNG_COLOR_TYPE_GA)
-        {
-            texture = std::make_shared<Texture2>(DF_R16G16_UNORM, width, height, wantMipmaps);
-            trg = texture->Get<uint16_t>();
-            for (png_uint_32 y = 0; y < height; ++y)
-            {
-                src = reinterpret_cast<uint16_t const*>(rows[y]);
-                for (png_uint_32 x = 0; x < width; ++x)
-                {
-                    for (int32_t i = 0; i < 2; ++i)
-                    {
-                        *trg++ = src[2 * x + i];
-                    }
-                }
-            }
-        }
+        png_set_swap(helper.png_ptr);
+    }
+    png_read_update_info(helper.png_ptr, helper.info_ptr);
+
+    texture = std::make_shared<Texture2>(format, width, height, wantMipmaps);
+    size_t const rowBytes = static_cast<size_t>(width) * texture->GetElementSize();
+    if (png_get_rowbytes(helper.png_ptr, helper.info_ptr) != rowBytes)
+    {
+        return nullptr;
     }
 
+    rows.resize(height);
+    uint8_t* texels = texture->Get<uint8_t>();
+    for (png_uint_32 y = 0; y < height; ++y)
+    {
+        rows[y] = texels + y * rowBytes;
+    }
+    png_read_image(helper.png_ptr, rows.data());
+    png_read_end(helper.png_ptr, nullptr);
     return texture;
 }
 
@@ -342,6 +260,10 @@ bool WICFileIO::SaveToPNG(std::string const& filename, std::shared_ptr<Texture2>
     }
 
     png_write_info(helper.png_ptr, helper.info_ptr);
+    if (bit_depth == 16 && IsLittleEndian())
+    {
+        png_set_swap(helper.png_ptr);
+    }
     png_write_image(helper.png_ptr, row_pointers.data());
     png_write_end(helper.png_ptr, helper.info_ptr);
     return true;
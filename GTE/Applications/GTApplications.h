@@ -3,18 +3,21 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 6.0.2022.01.06
+// Version: 6.3.2026.10.17
 
 #pragma once
 
 // Applications/Common
 #include <Applications/Application.h>
+#include <Applications/BinaryContainer.h>
 #include <Applications/CameraRig.h>
 #include <Applications/Command.h>
 #include <Applications/Console.h>
 #include <Applications/ConsoleApplication.h>
 #include <Applications/Environment.h>
+#include <Applications/MappedFile.h>
 #include <Applications/OnIdleTimer.h>
+#include <Applications/TextureLoader.h>
 #include <Applications/Timer.h>
 #include <Applications/TrackBall.h>
 #include <Applications/TrackCylinder.h>
@@ -0,0 +1,130 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2022
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 6.3.2026.10.17
+
+#include <Applications/GTApplicationsPCH.h>
+#include <Applications/MappedFile.h>
+#if defined(GTE_USE_MSWINDOWS)
+#include <Windows.h>
+#elif defined(GTE_USE_LINUX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+using namespace gte;
+
+MappedFile::MappedFile()
+    :
+    mData(nullptr),
+    mNumBytes(0)
+#if defined(GTE_USE_MSWINDOWS)
+    ,
+    mFile(INVALID_HANDLE_VALUE),
+    mMapping(nullptr)
+#endif
+{
+}
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+bool MappedFile::Open(std::string const& filename)
+{
+    Close();
+
+#if defined(GTE_USE_MSWINDOWS)
+    mFile = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ,
+        nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (mFile == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(mFile, &size) || size.QuadPart == 0)
+    {
+        Close();
+        return false;
+    }
+
+    // PAGE_WRITECOPY and FILE_MAP_COPY provide the copy-on-write pages.
+    mMapping = CreateFileMappingA(mFile, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    if (!mMapping)
+    {
+        Close();
+        return false;
+    }
+
+    mData = static_cast<char*>(MapViewOfFile(mMapping, FILE_MAP_COPY, 0, 0, 0));
+    if (!mData)
+    {
+        Close();
+        return false;
+    }
+    mNumBytes = static_cast<size_t>(size.QuadPart);
+    return true;
+#elif defined(GTE_USE_LINUX)
+    int file = open(filename.c_str(), O_RDONLY);
+    if (file < 0)
+    {
+        return false;
+    }
+
+    struct stat status;
+    if (fstat(file, &status) != 0 || status.st_size == 0)
+    {
+        close(file);
+        return false;
+    }
+
+    // MAP_PRIVATE with PROT_WRITE provides the copy-on-write pages. The
+    // mapping remains valid after the file descriptor is closed.
+    size_t numBytes = static_cast<size_t>(status.st_size);
+    void* data = mmap(nullptr, numBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+    close(file);
+    if (data == MAP_FAILED)
+    {
+        return false;
+    }
+
+    mData = static_cast<char*>(data);
+    mNumBytes = numBytes;
+    return true;
+#else
+    (void)filename;
+    return false;
+#endif
+}
+
+void MappedFile::Close()
+{
+#if defined(GTE_USE_MSWINDOWS)
+    if (mData)
+    {
+        UnmapViewOfFile(mData);
+    }
+    if (mMapping)
+    {
+        CloseHandle(mMapping);
+        mMapping = nullptr;
+    }
+    if (mFile != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(mFile);
+        mFile = INVALID_HANDLE_VALUE;
+    }
+#elif defined(GTE_USE_LINUX)
+    if (mData)
+    {
+        munmap(mData, mNumBytes);
+    }
+#endif
+    mData = nullptr;
+    mNumBytes = 0;
+}
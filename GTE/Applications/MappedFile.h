@@ -0,0 +1,69 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2022
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 6.3.2026.10.17
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// A read-only file mapped into the address space of the process. The pages
+// are loaded by the operating system on first access, so opening a large
+// file is fast and only the accessed parts of the file are read. The
+// mapping is copy-on-write: the memory may be modified, for example, by a
+// Resource whose data pointer is set to the mapped memory, but the
+// modifications are private to the process and are not written to the
+// file.
+
+namespace gte
+{
+    class MappedFile
+    {
+    public:
+        // Construction and destruction. The destructor unmaps the file.
+        MappedFile();
+        ~MappedFile();
+
+        // The object owns the mapping, so it cannot be copied.
+        MappedFile(MappedFile const&) = delete;
+        MappedFile& operator=(MappedFile const&) = delete;
+
+        // Map the entire file. The function returns 'false' when the file
+        // cannot be opened or mapped or when the file is empty. A currently
+        // mapped file is unmapped first.
+        bool Open(std::string const& filename);
+
+        // Unmap the file. Pointers to the mapped memory are invalid after
+        // this call.
+        void Close();
+
+        // Member access.
+        inline bool IsOpen() const
+        {
+            return mData != nullptr;
+        }
+
+        inline char* GetData() const
+        {
+            return mData;
+        }
+
+        inline size_t GetNumBytes() const
+        {
+            return mNumBytes;
+        }
+
+    private:
+        char* mData;
+        size_t mNumBytes;
+
+#if defined(GTE_USE_MSWINDOWS)
+        void* mFile;
+        void* mMapping;
+#endif
+    };
+}
@@ -0,0 +1,233 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2022
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 6.3.2026.10.17
+
+#include <Applications/GTApplicationsPCH.h>
+#include <Applications/TextureLoader.h>
+#include <Applications/WICFileIO.h>
+#include <Mathematics/Logger.h>
+#include <stdexcept>
+using namespace gte;
+
+TextureLoader::TextureLoader(size_t numThreads, Mipmaps mipmaps,
+    MipmapGenerator::Filter filter)
+    :
+    mMipmaps(mipmaps),
+    mGenerator(filter),
+    mTimer{},
+    mElapsedSeconds(0.0),
+    mStop(false)
+{
+    mWorkers.resize(numThreads);
+    for (auto& worker : mWorkers)
+    {
+        worker = std::thread([this]() { Work(); });
+    }
+}
+
+TextureLoader::~TextureLoader()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = true;
+    }
+    mWorkAvailable.notify_all();
+    for (auto& worker : mWorkers)
+    {
+        worker.join();
+    }
+}
+
+int32_t TextureLoader::Load(std::string const& filename)
+{
+    return Enqueue(filename, nullptr, true);
+}
+
+int32_t TextureLoader::Save(std::string const& filename,
+    std::shared_ptr<Texture2> const& texture)
+{
+    LogAssert(texture != nullptr, "Invalid texture.");
+    return Enqueue(filename, texture, false);
+}
+
+int32_t TextureLoader::Load(std::vector<std::string> const& filenames)
+{
+    int32_t first = GetNumRequests();
+    for (auto const& filename : filenames)
+    {
+        Load(filename);
+    }
+    return first;
+}
+
+int32_t TextureLoader::Save(std::vector<std::string> const& filenames,
+    std::vector<std::shared_ptr<Texture2>> const& textures)
+{
+    LogAssert(filenames.size() == textures.size(), "Mismatched sizes.");
+    int32_t first = GetNumRequests();
+    for (size_t i = 0; i < filenames.size(); ++i)
+    {
+        Save(filenames[i], textures[i]);
+    }
+    return first;
+}
+
+bool TextureLoader::IsFinished(int32_t ticket) const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    LogAssert(0 <= ticket && ticket < static_cast<int32_t>(mRequests.size()), "Invalid ticket.");
+    return mRequests[ticket].isFinished;
+}
+
+std::shared_ptr<Texture2> TextureLoader::Get(int32_t ticket)
+{
+    return Wait(ticket).texture;
+}
+
+TextureLoader::Request const& TextureLoader::Wait(int32_t ticket)
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    LogAssert(0 <= ticket && ticket < static_cast<int32_t>(mRequests.size()), "Invalid ticket.");
+    Request const& request = mRequests[ticket];
+    mWorkFinished.wait(lock, [&request]() { return request.isFinished; });
+    return request;
+}
+
+bool TextureLoader::WaitAll()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    size_t const numRequests = mRequests.size();
+    bool succeeded = true;
+    for (size_t i = 0; i < numRequests; ++i)
+    {
+        Request const& request = mRequests[i];
+        mWorkFinished.wait(lock, [&request]() { return request.isFinished; });
+        succeeded = succeeded && request.succeeded;
+    }
+    return succeeded;
+}
+
+double TextureLoader::GetElapsedSeconds() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mElapsedSeconds;
+}
+
+int32_t TextureLoader::Enqueue(std::string const& filename,
+    std::shared_ptr<Texture2> const& texture, bool isLoad)
+{
+    int32_t ticket;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        ticket = static_cast<int32_t>(mRequests.size());
+        mRequests.push_back(Request{ filename, texture, isLoad, false, false, 0.0, 0.0 });
+        if (mWorkers.size() > 0)
+        {
+            mPending.push_back(ticket);
+        }
+    }
+
+    if (mWorkers.size() > 0)
+    {
+        mWorkAvailable.notify_one();
+    }
+    else
+    {
+        Process(ticket);
+    }
+    return ticket;
+}
+
+void TextureLoader::Process(int32_t ticket)
+{
+    // The request is not modified by other threads until it is finished,
+    // so its members are accessed without the lock.
+    Request* request;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        request = &mRequests[ticket];
+    }
+
+    Timer timer;
+    std::shared_ptr<Texture2> texture = request->texture;
+    bool succeeded = false;
+    double fileSeconds = 0.0, mipmapSeconds = 0.0;
+    try
+    {
+        if (request->isLoad)
+        {
+            // The Windows implementation throws an exception when the load
+            // is not successful and the Linux implementation returns null.
+            texture = WICFileIO::Load(request->filename, mMipmaps != Mipmaps::NONE);
+            fileSeconds = timer.GetSeconds();
+            if (texture)
+            {
+                // The formats not supported by MipmapGenerator fall back
+                // to the graphics engine.
+                if (mMipmaps == Mipmaps::CPU && MipmapGenerator::IsSupported(texture->GetFormat()))
+                {
+                    mGenerator(*texture);
+                }
+                else if (mMipmaps != Mipmaps::NONE)
+                {
+                    texture->AutogenerateMipmaps();
+                }
+                mipmapSeconds = timer.GetSeconds() - fileSeconds;
+                succeeded = true;
+            }
+        }
+        else
+        {
+#if defined(GTE_USE_MSWINDOWS)
+            WICFileIO::SaveToPNG(request->filename, texture);
+            succeeded = true;
+#else
+            succeeded = WICFileIO::SaveToPNG(request->filename, texture);
+#endif
+            fileSeconds = timer.GetSeconds();
+        }
+    }
+    catch (std::exception const&)
+    {
+        texture = nullptr;
+        succeeded = false;
+        fileSeconds = timer.GetSeconds();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (request->isLoad)
+        {
+            request->texture = texture;
+        }
+        request->succeeded = succeeded;
+        request->fileSeconds = fileSeconds;
+        request->mipmapSeconds = mipmapSeconds;
+        request->isFinished = true;
+        mElapsedSeconds = mTimer.GetSeconds();
+    }
+    mWorkFinished.notify_all();
+}
+
+void TextureLoader::Work()
+{
+    for (;;)
+    {
+        int32_t ticket;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mWorkAvailable.wait(lock, [this]() { return mStop || mPending.size() > 0; });
+            if (mPending.size() == 0)
+            {
+                // mStop is true and all requests are processed.
+                return;
+            }
+            ticket = mPending.front();
+            mPending.pop_front();
+        }
+        Process(ticket);
+    }
+}
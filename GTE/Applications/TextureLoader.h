@@ -0,0 +1,141 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2022
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 6.3.2026.10.17
+
+#pragma once
+
+#include <Applications/Timer.h>
+#include <Graphics/MipmapGenerator.h>
+#include <Graphics/Texture2.h>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Asynchronous loading and saving of textures with WICFileIO. The requests
+// are processed by a pool of worker threads, so many files are decoded or
+// encoded concurrently while the main thread continues, for example, to
+// load the textures of a scene at startup or to dump frames to PNG files.
+// Each request has a ticket that is used to wait for the request and to
+// obtain its texture and timing. The mipmaps of loaded textures are
+// optionally computed on the worker threads by a MipmapGenerator.
+//
+// The textures are not bound to a graphics engine by the loader. The
+// engine functions must be called from the thread that owns the graphics
+// context after the requests are finished.
+
+namespace gte
+{
+    class TextureLoader
+    {
+    public:
+        enum class Mipmaps
+        {
+            // The textures do not have mipmaps.
+            NONE,
+
+            // The textures have mipmaps and AutogenerateMipmaps is called
+            // for them, so the graphics engine computes the mipmaps.
+            GPU,
+
+            // The textures have mipmaps that are computed on the worker
+            // threads.
+            CPU
+        };
+
+        struct Request
+        {
+            std::string filename;
+
+            // For a load request, the loaded texture or null when the load
+            // is not successful. For a save request, the texture to save.
+            std::shared_ptr<Texture2> texture;
+
+            bool isLoad, isFinished, succeeded;
+
+            // The times spent decoding or encoding and computing mipmaps.
+            double fileSeconds, mipmapSeconds;
+        };
+
+        // To process the requests in the main thread only, choose
+        // numThreads to be 0, in which case each request is processed when
+        // it is made. For asynchronous processing, choose numThreads > 0.
+        TextureLoader(size_t numThreads, Mipmaps mipmaps = Mipmaps::NONE,
+            MipmapGenerator::Filter filter = MipmapGenerator::Filter::BOX);
+
+        // The destructor waits for the pending requests to finish.
+        ~TextureLoader();
+
+        TextureLoader(TextureLoader const&) = delete;
+        TextureLoader& operator=(TextureLoader const&) = delete;
+
+        // Request that a texture be loaded or saved and return the ticket
+        // of the request. The texture to save must not be modified until
+        // the request is finished.
+        int32_t Load(std::string const& filename);
+        int32_t Save(std::string const& filename, std::shared_ptr<Texture2> const& texture);
+
+        // Request that several textures be loaded or saved and return the
+        // ticket of the first request. The tickets of the requests are
+        // consecutive.
+        int32_t Load(std::vector<std::string> const& filenames);
+        int32_t Save(std::vector<std::string> const& filenames,
+            std::vector<std::shared_ptr<Texture2>> const& textures);
+
+        // Query whether a request is finished without blocking.
+        bool IsFinished(int32_t ticket) const;
+
+        // Block until a request is finished and return its texture, which
+        // is null when a load is not successful.
+        std::shared_ptr<Texture2> Get(int32_t ticket);
+
+        // Block until a request is finished and return its description.
+        Request const& Wait(int32_t ticket);
+
+        // Block until all requests made so far are finished. The function
+        // returns 'true' when all requests have succeeded.
+        bool WaitAll();
+
+        // Member access.
+        inline int32_t GetNumRequests() const
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            return static_cast<int32_t>(mRequests.size());
+        }
+
+        // The elapsed time from the construction of the loader to the
+        // completion of the most recently finished request, which is the
+        // wall-clock time of the processing when the requests are made at
+        // startup.
+        double GetElapsedSeconds() const;
+
+    private:
+        int32_t Enqueue(std::string const& filename,
+            std::shared_ptr<Texture2> const& texture, bool isLoad);
+
+        void Process(int32_t ticket);
+
+        void Work();
+
+        Mipmaps mMipmaps;
+        MipmapGenerator mGenerator;
+        Timer mTimer;
+        double mElapsedSeconds;
+
+        // The requests are stored in a deque so that references to them
+        // remain valid when requests are added.
+        mutable std::mutex mMutex;
+        std::condition_variable mWorkAvailable, mWorkFinished;
+        std::deque<Request> mRequests;
+        std::deque<int32_t> mPending;
+        bool mStop;
+        std::vector<std::thread> mWorkers;
+    };
+}
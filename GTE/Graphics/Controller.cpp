@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 6.0.2022.01.06
+// Version: 6.3.2026.10.17
 
 #include <Graphics/GTGraphicsPCH.h>
 #include <Graphics/Controller.h>
@@ -44,6 +44,14 @@ void Controller::SetObject(ControlledObject* object)
 }
 
 double Controller::GetControlTime(double applicationTime)
+{
+    return ComputeControlTime(applicationTime, repeat, minTime, maxTime,
+        phase, frequency);
+}
+
+double Controller::ComputeControlTime(double applicationTime,
+    RepeatType repeat, double minTime, double maxTime, double phase,
+    double frequency)
 {
     double controlTime = frequency * applicationTime + phase;
 
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 6.0.2022.01.06
+// Version: 6.3.2026.10.17
 
 #pragma once
 
@@ -60,6 +60,15 @@ namespace gte
         // Allow user-readable names for nodes in a scene graph.
         std::string name;
 
+        // Conversion from application time units to controller time units
+        // for the specified time parameters. GetControlTime uses this with
+        // the members of the controller. Classes that animate many objects
+        // without Controller objects, such as KeyframeAnimationBatch, use
+        // it with their own time parameters.
+        static double ComputeControlTime(double applicationTime,
+            RepeatType repeat, double minTime, double maxTime, double phase,
+            double frequency);
+
     public:  // INTERNAL USE ONLY
         // The class ControlledObject needs to set the object during a call to
         // AttachController.  Derived classes that manage a set of controllers
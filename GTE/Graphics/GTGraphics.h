@@ -73,6 +73,7 @@
 
 // Resources/Textures
 #include <Graphics/DrawTarget.h>
+#include <Graphics/MipmapGenerator.h>
 #include <Graphics/Texture.h>
 #include <Graphics/Texture1.h>
 #include <Graphics/Texture1Array.h>
@@ -99,6 +100,7 @@
 #include <Graphics/Controller.h>
 #include <Graphics/ControlledObject.h>
 #include <Graphics/IKController.h>
+#include <Graphics/KeyframeAnimationBatch.h>
 #include <Graphics/KeyframeController.h>
 #include <Graphics/MorphController.h>
 #include <Graphics/ParticleController.h>
@@ -121,6 +123,7 @@
 #include <Graphics/Node.h>
 #include <Graphics/Particles.h>
 #include <Graphics/PVWUpdater.h>
+#include <Graphics/ScenePool.h>
 #include <Graphics/Spatial.h>
 #include <Graphics/ViewVolume.h>
 #include <Graphics/ViewVolumeNode.h>
@@ -3,11 +3,15 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 6.0.2022.01.06
+// Version: 6.3.2026.10.17
 
 #include <Graphics/GTGraphicsPCH.h>
 #include <Graphics/IKController.h>
 #include <Mathematics/Logger.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <unordered_map>
 using namespace gte;
 
 IKController::IKController(size_t numJoints, size_t numGoals, size_t numIterations, bool orderEndToRoot)
@@ -15,7 +19,10 @@ IKController::IKController(size_t numJoints, size_t numGoals, size_t numIteratio
     mJoints(numJoints),
     mGoals(numGoals),
     mNumIterations(numIterations),
-    mOrderEndToRoot(orderEndToRoot)
+    mOrderEndToRoot(orderEndToRoot),
+    mSolver(Solver::CCD),
+    mTolerance(0.0f),
+    mNumIterationsPerformed(0)
 {
 }
 
@@ -123,91 +130,356 @@ bool IKController::Update(double applicationTime)
         joint.UpdateWorldSRT();
     }
 
-    // Update joints one-at-a-time to meet goals.  As each joint is updated,
-    // the nodes occurring in the chain after that joint must be made current
-    // in world space.
-    int32_t numJoints = static_cast<int32_t>(mJoints.size());
-    if (mOrderEndToRoot)
+    // The solvers compute the effector positions from the offsets of the
+    // effectors relative to the joints rather than updating the world
+    // transforms of all the joints after each change, so the cost of an
+    // iteration is linear in the number of joints.
+    ComputeDownstreamGoals();
+    mEffectors.resize(mGoals.size());
+    for (size_t g = 0; g < mGoals.size(); ++g)
     {
-        for (size_t iter = 0; iter < mNumIterations; ++iter)
+        mEffectors[g] = mGoals[g].effector->worldTransform.GetTranslation();
+    }
+    UpdateEffectors();
+
+    mNumIterationsPerformed = 0;
+    while (mNumIterationsPerformed < mNumIterations && !MeetsTolerance())
+    {
+        ++mNumIterationsPerformed;
+        bool changed = (mSolver == Solver::CCD ? IterateCCD() : IterateJacobianTranspose());
+        if (!changed)
+        {
+            // The joints are at a fixed point of the solver.
+            break;
+        }
+    }
+
+    return true;
+}
+
+void IKController::UpdateAll(std::vector<std::shared_ptr<IKController>> const& controllers,
+    double applicationTime, size_t numThreads)
+{
+    numThreads = std::min(numThreads, controllers.size());
+    if (numThreads > 0)
+    {
+        // The controllers can have very different costs, so they are
+        // assigned to the threads dynamically.
+        std::atomic<size_t> next(0);
+        std::vector<std::thread> process(numThreads);
+        for (size_t t = 0; t < numThreads; ++t)
         {
-            for (int32_t k = 0; k < numJoints; ++k)
+            process[t] = std::thread([&controllers, &next, applicationTime]()
             {
-                int32_t r = numJoints - 1 - k;
-                auto& joint = mJoints[r];
+                for (size_t i = next++; i < controllers.size(); i = next++)
+                {
+                    controllers[i]->Update(applicationTime);
+                }
+            });
+        }
+        for (size_t t = 0; t < numThreads; ++t)
+        {
+            process[t].join();
+        }
+    }
+    else
+    {
+        for (auto const& controller : controllers)
+        {
+            controller->Update(applicationTime);
+        }
+    }
+}
+
+bool IKController::IterateCCD()
+{
+    // Update joints one-at-a-time to meet goals.  The world transform of a
+    // joint is made current when the joint is visited, which requires only
+    // its parent to be current.  The effector positions are computed from
+    // the world transform of the joint and the effector offsets, which
+    // depend only on the joints after it.  When the order is end to root,
+    // those joints have been updated, so the offsets are computed when the
+    // joint is visited.  When the order is root to end, those joints have
+    // not yet been updated, so the offsets are computed before the loop.
+    bool changed = false;
+    size_t const numJoints = mJoints.size();
+    if (!mOrderEndToRoot)
+    {
+        for (size_t k = numJoints; k > 0; --k)
+        {
+            UpdateEffectorOffsets(k - 1);
+        }
+    }
 
-                for (int32_t axis = 0; axis < 3; ++axis)
+    for (size_t k = 0; k < numJoints; ++k)
+    {
+        size_t const j = (mOrderEndToRoot ? numJoints - 1 - k : k);
+        auto& joint = mJoints[j];
+        joint.UpdateWorldRT();
+        if (mOrderEndToRoot)
+        {
+            UpdateEffectorOffsets(j);
+        }
+        UpdateEffectors(j);
+
+        for (int32_t axis = 0; axis < 3; ++axis)
+        {
+            if (joint.allowTranslation[axis])
+            {
+                if (joint.UpdateLocalT(axis, mGoals, mEffectors))
                 {
-                    if (joint.allowTranslation[axis])
-                    {
-                        if (joint.UpdateLocalT(axis, mGoals))
-                        {
-                            for (int32_t j = r; j < numJoints; ++j)
-                            {
-                                mJoints[j].UpdateWorldRT();
-                            }
-                        }
-                    }
+                    joint.UpdateWorldRT();
+                    UpdateEffectors(j);
+                    changed = true;
                 }
+            }
+        }
 
-                for (int32_t axis = 0; axis < 3; ++axis)
+        for (int32_t axis = 0; axis < 3; ++axis)
+        {
+            if (joint.allowRotation[axis])
+            {
+                if (joint.UpdateLocalR(axis, mGoals, mEffectors))
                 {
-                    if (joint.allowRotation[axis])
-                    {
-                        if (joint.UpdateLocalR(axis, mGoals))
-                        {
-                            for (int32_t j = r; j < numJoints; ++j)
-                            {
-                                mJoints[j].UpdateWorldRT();
-                            }
-                        }
-                    }
+                    joint.UpdateWorldRT();
+                    UpdateEffectors(j);
+                    changed = true;
                 }
             }
         }
     }
-    else  // order root to end
+
+    // When the order is end to root, the joints after a changed joint are
+    // not current in world space.
+    UpdateWorldRT();
+    UpdateEffectors();
+    return changed;
+}
+
+bool IKController::IterateJacobianTranspose()
+{
+    // The columns of the Jacobian for a joint axis are the velocities of
+    // the effectors below the joint. A translation along the world axis U
+    // moves an effector E with velocity U and a rotation about U through
+    // the joint position P moves it with velocity Cross(U,E-P). The step
+    // for an axis is alpha*Dot(column,W*error), where W is the diagonal
+    // matrix of goal weights, and alpha minimizes the weighted squared
+    // length of error - alpha*J*Transpose(J)*W*error.
+    struct Step
+    {
+        size_t joint;
+        int32_t axis;
+        bool rotation;
+        float coefficient;
+    };
+
+    size_t const numGoals = mGoals.size();
+    std::vector<Step> steps;
+    std::vector<Vector3<float>> JJTWe(numGoals, Vector3<float>::Zero());
+    for (size_t j = 0; j < mJoints.size(); ++j)
     {
-        for (size_t iter = 0; iter < mNumIterations; ++iter)
+        auto& joint = mJoints[j];
+        Vector3<float> P = joint.object->worldTransform.GetTranslation();
+        for (int32_t k = 0; k < 6; ++k)
         {
-            for (int32_t k = 0; k < numJoints; ++k)
+            int32_t axis = k % 3;
+            bool rotation = (k >= 3);
+            if (!(rotation ? joint.allowRotation[axis] : joint.allowTranslation[axis]))
             {
-                auto& joint = mJoints[k];
+                continue;
+            }
 
-                for (int32_t axis = 0; axis < 3; ++axis)
-                {
-                    if (joint.allowTranslation[axis])
-                    {
-                        if (joint.UpdateLocalT(axis, mGoals))
-                        {
-                            for (int32_t j = k; j < numJoints; ++j)
-                            {
-                                mJoints[j].UpdateWorldRT();
-                            }
-                        }
-                    }
-                }
+            Vector3<float> U = joint.GetAxis(axis);
+            float coefficient = 0.0f;
+            for (auto g : joint.goalIndices)
+            {
+                auto const& goal = mGoals[g];
+                Vector3<float> column = (rotation ? Cross(U, mEffectors[g] - P) : U);
+                coefficient += goal.weight * Dot(column, goal.GetTargetPosition() - mEffectors[g]);
+            }
+            for (auto g : joint.goalIndices)
+            {
+                Vector3<float> column = (rotation ? Cross(U, mEffectors[g] - P) : U);
+                JJTWe[g] += coefficient * column;
+            }
+            steps.push_back({ j, axis, rotation, coefficient });
+        }
+    }
 
-                for (int32_t axis = 0; axis < 3; ++axis)
+    float numer = 0.0f, denom = 0.0f;
+    for (size_t g = 0; g < numGoals; ++g)
+    {
+        auto const& goal = mGoals[g];
+        numer += goal.weight * Dot(goal.GetTargetPosition() - mEffectors[g], JJTWe[g]);
+        denom += goal.weight * Dot(JJTWe[g], JJTWe[g]);
+    }
+    if (numer <= 0.0f || denom <= 0.0f)
+    {
+        return false;
+    }
+
+    // Limit the angle changes so that the linearization is reasonable.
+    float const maxAngle = 0.5f;
+    float alpha = numer / denom;
+    for (auto const& step : steps)
+    {
+        if (step.rotation && alpha * std::fabs(step.coefficient) > maxAngle)
+        {
+            alpha = maxAngle / std::fabs(step.coefficient);
+        }
+    }
+
+    // Take the step, halving it when it does not reduce the error.
+    std::vector<Transform<float>> localTransforms(mJoints.size());
+    for (size_t j = 0; j < mJoints.size(); ++j)
+    {
+        localTransforms[j] = mJoints[j].object->localTransform;
+    }
+    float const oldError = GetError();
+
+    size_t const maxHalvings = 8;
+    for (size_t halving = 0; halving <= maxHalvings; ++halving, alpha *= 0.5f)
+    {
+        for (auto const& step : steps)
+        {
+            if (step.rotation)
+            {
+                mJoints[step.joint].AddLocalR(step.axis, alpha * step.coefficient);
+            }
+            else
+            {
+                mJoints[step.joint].AddLocalT(step.axis, alpha * step.coefficient);
+            }
+        }
+        UpdateWorldRT();
+        UpdateEffectors();
+
+        if (GetError() < oldError)
+        {
+            return true;
+        }
+
+        for (size_t j = 0; j < mJoints.size(); ++j)
+        {
+            mJoints[j].object->localTransform = localTransforms[j];
+        }
+        UpdateWorldRT();
+        UpdateEffectors();
+    }
+    return false;
+}
+
+void IKController::ComputeDownstreamGoals()
+{
+    std::unordered_map<Spatial const*, size_t> jointIndex;
+    for (size_t j = 0; j < mJoints.size(); ++j)
+    {
+        jointIndex.insert(std::make_pair(mJoints[j].object, j));
+    }
+
+    mDownstreamGoals.resize(mJoints.size());
+    for (auto& goals : mDownstreamGoals)
+    {
+        goals.clear();
+    }
+
+    // The offset of an effector in the coordinate system of its nearest
+    // joint ancestor is constant during the updates.
+    mEffectorJoints.resize(mGoals.size());
+    mEffectorOffsets.resize(mGoals.size());
+    for (size_t g = 0; g < mGoals.size(); ++g)
+    {
+        mEffectorJoints[g] = mJoints.size();
+        Vector4<float> offset{ 0.0f, 0.0f, 0.0f, 1.0f };
+        for (Spatial* object = mGoals[g].effector; object; object = object->GetParent())
+        {
+            auto iter = jointIndex.find(object);
+            if (iter != jointIndex.end())
+            {
+                if (mEffectorJoints[g] == mJoints.size())
                 {
-                    if (joint.allowRotation[axis])
-                    {
-                        if (joint.UpdateLocalR(axis, mGoals))
-                        {
-                            for (int32_t j = k; j < numJoints; ++j)
-                            {
-                                mJoints[j].UpdateWorldRT();
-                            }
-                        }
-                    }
+                    mEffectorJoints[g] = iter->second;
+                    mEffectorOffsets[g].resize(iter->second + 1);
+                    mEffectorOffsets[g][iter->second] = offset;
                 }
+                mDownstreamGoals[iter->second].push_back(g);
             }
+            else if (mEffectorJoints[g] == mJoints.size())
+            {
+                offset = object->localTransform * offset;
+            }
+        }
+    }
+}
+
+void IKController::UpdateEffectorOffsets(size_t j)
+{
+    // The joints form a chain, so the offset for joint j is obtained from
+    // that for joint j+1 by the local transform of joint j+1.
+    for (auto g : mDownstreamGoals[j])
+    {
+        if (j < mEffectorJoints[g])
+        {
+            mEffectorOffsets[g][j] = mJoints[j + 1].object->localTransform *
+                mEffectorOffsets[g][j + 1];
         }
     }
+}
 
+void IKController::UpdateEffectors(size_t j)
+{
+    auto const& owxfrm = mJoints[j].object->worldTransform;
+    for (auto g : mDownstreamGoals[j])
+    {
+        mEffectors[g] = HProject(owxfrm * mEffectorOffsets[g][j]);
+    }
+}
+
+void IKController::UpdateEffectors()
+{
+    for (size_t g = 0; g < mGoals.size(); ++g)
+    {
+        size_t j = mEffectorJoints[g];
+        if (j < mJoints.size())
+        {
+            mEffectors[g] = HProject(mJoints[j].object->worldTransform * mEffectorOffsets[g][j]);
+        }
+    }
+}
+
+bool IKController::MeetsTolerance() const
+{
+    float const sqrTolerance = mTolerance * mTolerance;
+    for (size_t g = 0; g < mGoals.size(); ++g)
+    {
+        Vector3<float> GmE = mGoals[g].GetTargetPosition() - mEffectors[g];
+        if (Dot(GmE, GmE) > sqrTolerance)
+        {
+            return false;
+        }
+    }
     return true;
 }
 
+float IKController::GetError() const
+{
+    float error = 0.0f;
+    for (size_t g = 0; g < mGoals.size(); ++g)
+    {
+        Vector3<float> GmE = mGoals[g].GetTargetPosition() - mEffectors[g];
+        error += mGoals[g].weight * Dot(GmE, GmE);
+    }
+    return error;
+}
+
+void IKController::UpdateWorldRT()
+{
+    for (auto& joint : mJoints)
+    {
+        joint.UpdateWorldRT();
+    }
+}
+
 IKController::Goal::Goal()
     :
     target(nullptr),
@@ -277,7 +549,8 @@ Vector3<float> IKController::Joint::GetAxis(int32_t axis)
     }
 }
 
-bool IKController::Joint::UpdateLocalT(int32_t axis, std::vector<Goal> const& goals)
+bool IKController::Joint::UpdateLocalT(int32_t axis, std::vector<Goal> const& goals,
+    std::vector<Vector3<float>> const& effectors)
 {
     Vector3<float> U = GetAxis(axis);
     float numer = 0.0f;
@@ -286,7 +559,7 @@ bool IKController::Joint::UpdateLocalT(int32_t axis, std::vector<Goal> const& go
     for (auto g : goalIndices)
     {
         auto const& goal = goals[g];
-        Vector3<float> GmE = goal.GetTargetPosition() - goal.GetEffectorPosition();
+        Vector3<float> GmE = goal.GetTargetPosition() - effectors[g];
         oldNorm += Dot(GmE, GmE);
         numer += goal.weight * Dot(U, GmE);
         denom += goal.weight;
@@ -327,7 +600,7 @@ bool IKController::Joint::UpdateLocalT(int32_t axis, std::vector<Goal> const& go
     for (auto g : goalIndices)
     {
         auto const& goal = goals[g];
-        Vector3<float> newE = goal.GetEffectorPosition() + step;
+        Vector3<float> newE = effectors[g] + step;
         Vector3<float> diff = goal.GetTargetPosition() - newE;
         newNorm += Dot(diff, diff);
     }
@@ -342,7 +615,8 @@ bool IKController::Joint::UpdateLocalT(int32_t axis, std::vector<Goal> const& go
     return true;
 }
 
-bool IKController::Joint::UpdateLocalR(int32_t axis, std::vector<Goal> const& goals)
+bool IKController::Joint::UpdateLocalR(int32_t axis, std::vector<Goal> const& goals,
+    std::vector<Vector3<float>> const& effectors)
 {
     Vector3<float> U = GetAxis(axis);
     float numer = 0.0f;
@@ -352,9 +626,9 @@ bool IKController::Joint::UpdateLocalR(int32_t axis, std::vector<Goal> const& go
     for (auto g : goalIndices)
     {
         auto const& goal = goals[g];
-        Vector3<float> EmP = goal.GetEffectorPosition() - object->worldTransform.GetTranslation();
+        Vector3<float> EmP = effectors[g] - object->worldTransform.GetTranslation();
         Vector3<float> GmP = goal.GetTargetPosition() - object->worldTransform.GetTranslation();
-        Vector3<float> GmE = goal.GetTargetPosition() - goal.GetEffectorPosition();
+        Vector3<float> GmE = goal.GetTargetPosition() - effectors[g];
         oldNorm += Dot(GmE, GmE);
         Vector3<float> UxEmP = Cross(U, EmP);
         Vector3<float> UxUxEmP = Cross(U, UxEmP);
@@ -400,7 +674,7 @@ bool IKController::Joint::UpdateLocalR(int32_t axis, std::vector<Goal> const& go
     for (auto g : goalIndices)
     {
         auto const& goal = goals[g];
-        Vector3<float> EmP = goal.GetEffectorPosition() - object->worldTransform.GetTranslation();
+        Vector3<float> EmP = effectors[g] - object->worldTransform.GetTranslation();
         Vector3<float> newE = object->worldTransform.GetTranslation() + rotate * EmP;
         Vector3<float> GmE = goal.GetTargetPosition() - newE;
         newNorm += Dot(GmE, GmE);
@@ -417,3 +691,19 @@ bool IKController::Joint::UpdateLocalR(int32_t axis, std::vector<Goal> const& go
     object->localTransform.SetRotation(rotate);
     return true;
 }
+
+void IKController::Joint::AddLocalT(int32_t axis, float delta)
+{
+    Vector3<float> trn = object->localTransform.GetTranslation();
+    trn[axis] = std::min(std::max(trn[axis] + delta, minTranslation[axis]), maxTranslation[axis]);
+    object->localTransform.SetTranslation(trn);
+}
+
+void IKController::Joint::AddLocalR(int32_t axis, float delta)
+{
+    EulerAngles<float> euler =
+        Rotation<4, float>(object->localTransform.GetRotation())(0, 1, 2);
+    euler.angle[axis] = std::min(std::max(euler.angle[axis] + delta, minRotation[axis]), maxRotation[axis]);
+    Matrix3x3<float> rotate = Rotation<3, float>(euler);
+    object->localTransform.SetRotation(rotate);
+}
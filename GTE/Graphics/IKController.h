@@ -3,11 +3,13 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 6.0.2022.01.06
+// Version: 6.3.2026.10.17
 
 #pragma once
 
 #include <Graphics/Spatial.h>
+#include <memory>
+#include <vector>
 
 namespace gte
 {
@@ -20,6 +22,50 @@ namespace gte
         virtual ~IKController() = default;
         IKController(size_t numJoints, size_t numGoals, size_t numIterations, bool orderEndToRoot);
 
+        // The solver used by Update. CCD is cyclic coordinate descent, which
+        // updates one joint axis at a time in the order specified by the
+        // constructor input orderEndToRoot. JACOBIAN_TRANSPOSE updates all
+        // joint axes simultaneously using a step along the transpose of the
+        // Jacobian of the effector positions, which has the step length
+        // that minimizes the linearized error. The step is halved when it
+        // does not reduce the error. Both solvers have a cost per iteration
+        // that is linear in the number of joints (for a bounded number of
+        // goals). The default is CCD.
+        enum class Solver
+        {
+            CCD,
+            JACOBIAN_TRANSPOSE
+        };
+
+        inline void SetSolver(Solver solver)
+        {
+            mSolver = solver;
+        }
+
+        inline Solver GetSolver() const
+        {
+            return mSolver;
+        }
+
+        // The iterations terminate early when all the effectors are within
+        // the tolerance distance of their targets or when an iteration does
+        // not change the joints. The default tolerance is 0.
+        inline void SetTolerance(float tolerance)
+        {
+            mTolerance = tolerance;
+        }
+
+        inline float GetTolerance() const
+        {
+            return mTolerance;
+        }
+
+        // The number of iterations performed by the last call to Update.
+        inline size_t GetNumIterationsPerformed() const
+        {
+            return mNumIterationsPerformed;
+        }
+
         // Deferred construction.
         void InitializeGoal(size_t g, std::shared_ptr<Spatial> const& target,
             std::shared_ptr<Spatial> const& effector, float weight);
@@ -44,6 +90,13 @@ namespace gte
         // The animation update.  The application time is in milliseconds.
         virtual bool Update(double applicationTime) override;
 
+        // Update many IK controllers. To run in the main thread only, choose
+        // numThreads to be 0. For multithreading, choose numThreads > 0.
+        // The joints of the controllers must be distinct and the joint
+        // chains must not be descendants of the joints of other controllers.
+        static void UpdateAll(std::vector<std::shared_ptr<IKController>> const& controllers,
+            double applicationTime, size_t numThreads = 0);
+
     protected:
         struct Goal
         {
@@ -54,11 +107,6 @@ namespace gte
                 return target->worldTransform.GetTranslation();
             }
 
-            inline Vector3<float> GetEffectorPosition() const
-            {
-                return effector->worldTransform.GetTranslation();
-            }
-
             Spatial* target;
             Spatial* effector;
             float weight;
@@ -74,8 +122,20 @@ namespace gte
             void UpdateWorldSRT();
             void UpdateWorldRT();
             Vector3<float> GetAxis(int32_t axis);
-            bool UpdateLocalT(int32_t axis, std::vector<Goal> const& goals);
-            bool UpdateLocalR(int32_t axis, std::vector<Goal> const& goals);
+
+            // The effector positions are those of the goals. They are
+            // passed separately because the solvers compute them without
+            // updating the world transforms of all the joints.
+            bool UpdateLocalT(int32_t axis, std::vector<Goal> const& goals,
+                std::vector<Vector3<float>> const& effectors);
+            bool UpdateLocalR(int32_t axis, std::vector<Goal> const& goals,
+                std::vector<Vector3<float>> const& effectors);
+
+            // Add delta to the local translation or to the Euler angle of
+            // the local rotation for the axis. The result is clamped to the
+            // range of the axis.
+            void AddLocalT(int32_t axis, float delta);
+            void AddLocalR(int32_t axis, float delta);
 
             Spatial* object;
             std::vector<size_t> goalIndices;
@@ -89,9 +149,36 @@ namespace gte
             std::array<float, 3> maxRotation;      // default = +infinity
         };
 
+        // Support for Update. The world transforms of the joints are
+        // current when the iterations are called.
+        bool IterateCCD();
+        bool IterateJacobianTranspose();
+        void ComputeDownstreamGoals();
+        void UpdateEffectorOffsets(size_t j);
+        void UpdateEffectors(size_t j);
+        void UpdateEffectors();
+        bool MeetsTolerance() const;
+        float GetError() const;
+        void UpdateWorldRT();
+
         std::vector<Joint> mJoints;
         std::vector<Goal> mGoals;
         size_t mNumIterations;
         bool mOrderEndToRoot;
+        Solver mSolver;
+        float mTolerance;
+        size_t mNumIterationsPerformed;
+
+        // The current effector positions, one per goal. The effector of
+        // goal g is at or below joint mEffectorJoints[g], which is the
+        // number of joints when the effector is not below a joint. The
+        // offset mEffectorOffsets[g][j] is the effector position in the
+        // coordinate system of joint j <= mEffectorJoints[g].
+        // mDownstreamGoals[j] contains the indices of the goals whose
+        // effectors are at or below joint j.
+        std::vector<Vector3<float>> mEffectors;
+        std::vector<size_t> mEffectorJoints;
+        std::vector<std::vector<Vector4<float>>> mEffectorOffsets;
+        std::vector<std::vector<size_t>> mDownstreamGoals;
     };
 }
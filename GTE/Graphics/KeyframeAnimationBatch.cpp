@@ -0,0 +1,475 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2022
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 6.3.2026.10.17
+
+#include <Graphics/GTGraphicsPCH.h>
+#include <Graphics/KeyframeAnimationBatch.h>
+#include <Graphics/KeyframeController.h>
+#include <Graphics/Spatial.h>
+#include <Mathematics/Logger.h>
+#include <algorithm>
+#include <cmath>
+#include <thread>
+using namespace gte;
+
+namespace
+{
+    // Evaluate a piecewise linear channel of a KeyframeController at the
+    // specified time. The keys are clamped at the ends of the time range.
+    template <typename Key, typename Interpolate>
+    Key SampleChannel(float time, int32_t numTimes, float const* times,
+        Key const* keys, Interpolate const& interpolate)
+    {
+        if (time <= times[0])
+        {
+            return keys[0];
+        }
+        if (time >= times[numTimes - 1])
+        {
+            return keys[numTimes - 1];
+        }
+        int32_t i1 = static_cast<int32_t>(std::upper_bound(times, times + numTimes, time) - times);
+        int32_t i0 = i1 - 1;
+        float t = (time - times[i0]) / (times[i1] - times[i0]);
+        return interpolate(t, keys[i0], keys[i1]);
+    }
+}
+
+KeyframeAnimationBatch::KeyframeAnimationBatch(size_t numThreads)
+    :
+    mNumThreads(numThreads)
+{
+}
+
+int32_t KeyframeAnimationBatch::AddClip(int32_t numKeys, float const* times,
+    Vector4<float> const* translations, Quaternion<float> const* rotations,
+    float const* scales, Compression compression)
+{
+    LogAssert(numKeys > 0 && times != nullptr, "Invalid input.");
+    for (int32_t k = 1; k < numKeys; ++k)
+    {
+        LogAssert(times[k - 1] < times[k], "The times must be increasing.");
+    }
+
+    Clip clip{};
+    clip.numKeys = numKeys;
+    clip.timeStart = static_cast<int32_t>(mTimes.size());
+    clip.channels = 0;
+    clip.compression = compression;
+    mTimes.insert(mTimes.end(), times, times + numKeys);
+
+    std::vector<std::array<float, 4>> values(numKeys);
+    if (translations)
+    {
+        for (int32_t k = 0; k < numKeys; ++k)
+        {
+            values[k] = { translations[k][0], translations[k][1], translations[k][2], 0.0f };
+        }
+        clip.channels |= TRANSLATION;
+        clip.channelStart[0] = StoreChannel(clip, 0, 3, values);
+    }
+
+    if (rotations)
+    {
+        for (int32_t k = 0; k < numKeys; ++k)
+        {
+            values[k] = { rotations[k][0], rotations[k][1], rotations[k][2], rotations[k][3] };
+        }
+        clip.channels |= ROTATION;
+        clip.channelStart[1] = StoreChannel(clip, 1, 4, values);
+    }
+
+    if (scales)
+    {
+        for (int32_t k = 0; k < numKeys; ++k)
+        {
+            values[k] = { scales[k], 0.0f, 0.0f, 0.0f };
+        }
+        clip.channels |= SCALE;
+        clip.channelStart[2] = StoreChannel(clip, 2, 1, values);
+    }
+
+    mClips.push_back(clip);
+    return static_cast<int32_t>(mClips.size()) - 1;
+}
+
+int32_t KeyframeAnimationBatch::AddClip(KeyframeController& controller,
+    Compression compression)
+{
+    int32_t const numCommonTimes = controller.GetNumCommonTimes();
+    int32_t const numTranslations = controller.GetNumTranslations();
+    int32_t const numRotations = controller.GetNumRotations();
+    int32_t const numScales = controller.GetNumScales();
+    Vector4<float> const* translations = (numTranslations > 0 ? controller.GetTranslations() : nullptr);
+    Quaternion<float> const* rotations = (numRotations > 0 ? controller.GetRotations() : nullptr);
+    float const* scales = (numScales > 0 ? controller.GetScales() : nullptr);
+
+    if (numCommonTimes > 0)
+    {
+        return AddClip(numCommonTimes, controller.GetCommonTimes(), translations,
+            rotations, scales, compression);
+    }
+
+    // The channels have their own times. Resample the channels at the union
+    // of the times.
+    std::vector<float> times;
+    times.insert(times.end(), controller.GetTranslationTimes(),
+        controller.GetTranslationTimes() + numTranslations);
+    times.insert(times.end(), controller.GetRotationTimes(),
+        controller.GetRotationTimes() + numRotations);
+    times.insert(times.end(), controller.GetScaleTimes(),
+        controller.GetScaleTimes() + numScales);
+    LogAssert(times.size() > 0, "The controller has no keys.");
+    std::sort(times.begin(), times.end());
+    times.erase(std::unique(times.begin(), times.end()), times.end());
+    int32_t const numKeys = static_cast<int32_t>(times.size());
+
+    std::vector<Vector4<float>> resampledTranslations;
+    if (translations)
+    {
+        resampledTranslations.resize(numKeys);
+        for (int32_t k = 0; k < numKeys; ++k)
+        {
+            resampledTranslations[k] = SampleChannel(times[k], numTranslations,
+                controller.GetTranslationTimes(), translations,
+                [](float t, Vector4<float> const& key0, Vector4<float> const& key1)
+                {
+                    return key0 + t * (key1 - key0);
+                });
+        }
+    }
+
+    std::vector<Quaternion<float>> resampledRotations;
+    if (rotations)
+    {
+        resampledRotations.resize(numKeys);
+        for (int32_t k = 0; k < numKeys; ++k)
+        {
+            resampledRotations[k] = SampleChannel(times[k], numRotations,
+                controller.GetRotationTimes(), rotations,
+                [](float t, Quaternion<float> const& key0, Quaternion<float> const& key1)
+                {
+                    return Slerp(t, key0, key1);
+                });
+        }
+    }
+
+    std::vector<float> resampledScales;
+    if (scales)
+    {
+        resampledScales.resize(numKeys);
+        for (int32_t k = 0; k < numKeys; ++k)
+        {
+            resampledScales[k] = SampleChannel(times[k], numScales,
+                controller.GetScaleTimes(), scales,
+                [](float t, float key0, float key1)
+                {
+                    return key0 + t * (key1 - key0);
+                });
+        }
+    }
+
+    return AddClip(numKeys, times.data(),
+        (translations ? resampledTranslations.data() : nullptr),
+        (rotations ? resampledRotations.data() : nullptr),
+        (scales ? resampledScales.data() : nullptr), compression);
+}
+
+int32_t KeyframeAnimationBatch::AddInstance(int32_t clip, Spatial* target,
+    Transform<float> const& localTransform, Controller::RepeatType repeat,
+    double minTime, double maxTime, double phase, double frequency)
+{
+    LogAssert(0 <= clip && clip < GetNumClips(), "Invalid clip.");
+    LogAssert(target != nullptr, "Invalid target.");
+
+    mInstanceClip.push_back(clip);
+    mTarget.push_back(target);
+    mLocalTransform.push_back(localTransform);
+    mRepeat.push_back(repeat);
+    mMinTime.push_back(minTime);
+    mMaxTime.push_back(maxTime);
+    mPhase.push_back(phase);
+    mFrequency.push_back(frequency);
+    mLastKey.push_back(0);
+
+    size_t const numInstances = mInstanceClip.size();
+    for (auto& component : mTranslation)
+    {
+        component.resize(numInstances);
+    }
+    for (auto& component : mRotation)
+    {
+        component.resize(numInstances);
+    }
+    mScale.resize(numInstances);
+    return static_cast<int32_t>(numInstances) - 1;
+}
+
+int32_t KeyframeAnimationBatch::AddInstance(int32_t clip, KeyframeController const& controller)
+{
+    Spatial* target = static_cast<Spatial*>(controller.GetObject());
+    return AddInstance(clip, target, controller.GetTransform(), controller.repeat,
+        controller.minTime, controller.maxTime, controller.phase, controller.frequency);
+}
+
+void KeyframeAnimationBatch::SetTime(int32_t instance, double phase, double frequency)
+{
+    LogAssert(0 <= instance && instance < GetNumInstances(), "Invalid instance.");
+    mPhase[instance] = phase;
+    mFrequency[instance] = frequency;
+}
+
+void KeyframeAnimationBatch::Update(double applicationTime)
+{
+    Execute([this, applicationTime](int32_t imin, int32_t imax)
+    {
+        Evaluate(applicationTime, imin, imax);
+        Apply(imin, imax);
+    });
+}
+
+void KeyframeAnimationBatch::Evaluate(double applicationTime)
+{
+    Execute([this, applicationTime](int32_t imin, int32_t imax)
+    {
+        Evaluate(applicationTime, imin, imax);
+    });
+}
+
+void KeyframeAnimationBatch::Apply()
+{
+    Execute([this](int32_t imin, int32_t imax)
+    {
+        Apply(imin, imax);
+    });
+}
+
+size_t KeyframeAnimationBatch::StoreChannel(Clip& clip, int32_t channel,
+    int32_t numComponents, std::vector<std::array<float, 4>> const& values)
+{
+    size_t const numKeys = static_cast<size_t>(clip.numKeys);
+    if (clip.compression == Compression::NONE)
+    {
+        size_t start = mFloatKeys.size();
+        mFloatKeys.resize(start + numComponents * numKeys);
+        for (int32_t j = 0; j < numComponents; ++j)
+        {
+            float* component = &mFloatKeys[start + j * numKeys];
+            for (size_t k = 0; k < numKeys; ++k)
+            {
+                component[k] = values[k][j];
+            }
+        }
+        return start;
+    }
+
+    float const qmax = 65535.0f;
+    size_t start = mQuantizedKeys.size();
+    mQuantizedKeys.resize(start + numComponents * numKeys);
+    for (int32_t j = 0; j < numComponents; ++j)
+    {
+        float vmin, vmax;
+        if (channel == 1)
+        {
+            // The components of unit quaternions are in [-1,1].
+            vmin = -1.0f;
+            vmax = 1.0f;
+        }
+        else
+        {
+            vmin = values[0][j];
+            vmax = values[0][j];
+            for (size_t k = 1; k < numKeys; ++k)
+            {
+                vmin = std::min(vmin, values[k][j]);
+                vmax = std::max(vmax, values[k][j]);
+            }
+        }
+        clip.minimum[channel][j] = vmin;
+        clip.delta[channel][j] = (vmax - vmin) / qmax;
+
+        uint16_t* component = &mQuantizedKeys[start + j * numKeys];
+        float const invDelta = (vmax > vmin ? qmax / (vmax - vmin) : 0.0f);
+        for (size_t k = 0; k < numKeys; ++k)
+        {
+            float q = std::round((values[k][j] - vmin) * invDelta);
+            component[k] = static_cast<uint16_t>(std::min(std::max(q, 0.0f), qmax));
+        }
+    }
+    return start;
+}
+
+inline float KeyframeAnimationBatch::GetComponent(Clip const& clip, int32_t channel,
+    int32_t component, int32_t key) const
+{
+    size_t index = clip.channelStart[channel] +
+        static_cast<size_t>(component) * clip.numKeys + key;
+    if (clip.compression == Compression::NONE)
+    {
+        return mFloatKeys[index];
+    }
+    return clip.minimum[channel][component] +
+        clip.delta[channel][component] * static_cast<float>(mQuantizedKeys[index]);
+}
+
+void KeyframeAnimationBatch::Evaluate(double applicationTime, int32_t imin, int32_t imax)
+{
+    for (int32_t i = imin; i < imax; ++i)
+    {
+        Clip const& clip = mClips[mInstanceClip[i]];
+        float const* times = &mTimes[clip.timeStart];
+        int32_t const numKeys = clip.numKeys;
+        float ctrlTime = static_cast<float>(Controller::ComputeControlTime(applicationTime,
+            mRepeat[i], mMinTime[i], mMaxTime[i], mPhase[i], mFrequency[i]));
+
+        // Look up the keys bounding the control time. The cached key is
+        // the correct one or a neighbor of it for a sequence of times that
+        // changes slowly compared to the key spacing, in which case the
+        // lookup is O(1). Otherwise a binary search is used, for example,
+        // when a wrapped or cycled animation restarts.
+        int32_t i0, i1;
+        float t;
+        if (ctrlTime <= times[0])
+        {
+            i0 = 0;
+            i1 = 0;
+            t = 0.0f;
+        }
+        else if (ctrlTime >= times[numKeys - 1])
+        {
+            i0 = numKeys - 1;
+            i1 = i0;
+            t = 0.0f;
+        }
+        else
+        {
+            // The control time is in [times[0],times[numKeys-1]), so
+            // i0 < numKeys - 1 and the interval [times[i0],times[i0+1])
+            // containing the control time exists.
+            i0 = std::min(mLastKey[i], numKeys - 2);
+            if (ctrlTime < times[i0])
+            {
+                if (i0 > 0 && ctrlTime >= times[i0 - 1])
+                {
+                    --i0;
+                }
+                else
+                {
+                    i0 = static_cast<int32_t>(std::upper_bound(times, times + i0, ctrlTime) - times) - 1;
+                }
+            }
+            else if (ctrlTime >= times[i0 + 1])
+            {
+                if (i0 + 2 < numKeys && ctrlTime < times[i0 + 2])
+                {
+                    ++i0;
+                }
+                else
+                {
+                    i0 = static_cast<int32_t>(std::upper_bound(times + i0 + 1,
+                        times + numKeys, ctrlTime) - times) - 1;
+                }
+            }
+            i1 = i0 + 1;
+            t = (ctrlTime - times[i0]) / (times[i1] - times[i0]);
+        }
+        mLastKey[i] = i0;
+
+        if (clip.channels & TRANSLATION)
+        {
+            for (int32_t j = 0; j < 3; ++j)
+            {
+                float v0 = GetComponent(clip, 0, j, i0);
+                float v1 = GetComponent(clip, 0, j, i1);
+                mTranslation[j][i] = v0 + t * (v1 - v0);
+            }
+        }
+
+        if (clip.channels & ROTATION)
+        {
+            Quaternion<float> q0, q1;
+            for (int32_t j = 0; j < 4; ++j)
+            {
+                q0[j] = GetComponent(clip, 1, j, i0);
+                q1[j] = GetComponent(clip, 1, j, i1);
+            }
+            if (clip.compression != Compression::NONE)
+            {
+                Normalize(q0);
+                Normalize(q1);
+            }
+            Quaternion<float> q = Slerp(t, q0, q1);
+            for (int32_t j = 0; j < 4; ++j)
+            {
+                mRotation[j][i] = q[j];
+            }
+        }
+
+        if (clip.channels & SCALE)
+        {
+            float v0 = GetComponent(clip, 2, 0, i0);
+            float v1 = GetComponent(clip, 2, 0, i1);
+            mScale[i] = v0 + t * (v1 - v0);
+        }
+    }
+}
+
+void KeyframeAnimationBatch::Apply(int32_t imin, int32_t imax)
+{
+    for (int32_t i = imin; i < imax; ++i)
+    {
+        int32_t const channels = mClips[mInstanceClip[i]].channels;
+        Transform<float>& localTransform = mLocalTransform[i];
+
+        if (channels & TRANSLATION)
+        {
+            localTransform.SetTranslation(mTranslation[0][i], mTranslation[1][i],
+                mTranslation[2][i]);
+        }
+
+        if (channels & ROTATION)
+        {
+            localTransform.SetRotation(Quaternion<float>(mRotation[0][i],
+                mRotation[1][i], mRotation[2][i], mRotation[3][i]));
+        }
+
+        if (channels & SCALE)
+        {
+            localTransform.SetUniformScale(mScale[i]);
+        }
+
+        mTarget[i]->localTransform = localTransform;
+    }
+}
+
+template <typename Function>
+void KeyframeAnimationBatch::Execute(Function const& function)
+{
+    int32_t const numInstances = GetNumInstances();
+    int32_t const numThreads = static_cast<int32_t>(
+        std::min(mNumThreads, static_cast<size_t>(numInstances)));
+    if (numThreads > 0)
+    {
+        std::vector<std::thread> process(numThreads);
+        for (int32_t t = 0; t < numThreads; ++t)
+        {
+            int32_t imin = static_cast<int32_t>(static_cast<int64_t>(t) * numInstances / numThreads);
+            int32_t imax = static_cast<int32_t>(static_cast<int64_t>(t + 1) * numInstances / numThreads);
+            process[t] = std::thread([&function, imin, imax]()
+            {
+                function(imin, imax);
+            });
+        }
+        for (int32_t t = 0; t < numThreads; ++t)
+        {
+            process[t].join();
+        }
+    }
+    else
+    {
+        function(0, numInstances);
+    }
+}
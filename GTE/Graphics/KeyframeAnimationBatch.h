@@ -0,0 +1,195 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2022
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 6.3.2026.10.17
+
+#pragma once
+
+#include <Graphics/Controller.h>
+#include <Mathematics/Quaternion.h>
+#include <Mathematics/Transform.h>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Keyframe animation of many Spatial objects in a single pass. Each
+// KeyframeController evaluates its own channels and writes the local
+// transform of its own Spatial, which for large crowds of animated objects
+// means many virtual calls and scattered memory accesses. The batch stores
+// the keys of all clips in structure-of-arrays form, one array per
+// component of each channel, and it stores the per-instance state in
+// arrays. A call to Update evaluates all the instances and writes the local
+// transforms of their Spatial objects. The instances are partitioned among
+// threads when the batch is constructed with numThreads > 0.
+//
+// A clip is a set of keyframes with common times for the translations,
+// rotations and uniform scales, any of which may be absent. A clip can be
+// played by any number of instances, each with its own Spatial, initial
+// local transform and time parameters. The time parameters have the same
+// meaning as those of Controller, and the interpolation is the same as
+// that of KeyframeController: linear interpolation of translations and
+// scales and spherical linear interpolation of rotations. The local
+// transform channels that are not animated by a clip are those of the
+// instance's initial local transform.
+//
+// The keys may be quantized to 16 bits per component. The translations
+// and scales are quantized relative to the range of their values in the
+// clip and the rotation components are quantized relative to [-1,1]. The
+// decoded rotations are normalized before interpolation.
+//
+// The Spatial objects of the instances must be distinct and must not have
+// controllers that also set their local transforms.
+
+namespace gte
+{
+    class KeyframeController;
+    class Spatial;
+
+    class KeyframeAnimationBatch
+    {
+    public:
+        enum class Compression
+        {
+            NONE,
+            QUANTIZED16
+        };
+
+        // To evaluate in the main thread only, choose numThreads to be 0.
+        // For multithreading, choose numThreads > 0.
+        KeyframeAnimationBatch(size_t numThreads = 0);
+
+        // Add a clip and return its index. The times must be increasing.
+        // Pass nullptr for a channel that is not animated. The
+        // translations have w-components that are ignored, which is the
+        // layout used by KeyframeController.
+        int32_t AddClip(int32_t numKeys, float const* times,
+            Vector4<float> const* translations, Quaternion<float> const* rotations,
+            float const* scales, Compression compression = Compression::NONE);
+
+        // Add the keys of a KeyframeController as a clip and return its
+        // index. When the channels of the controller have different times,
+        // they are resampled at the union of the times, which reproduces
+        // the piecewise linear and piecewise spherical linear curves of the
+        // channels.
+        int32_t AddClip(KeyframeController& controller,
+            Compression compression = Compression::NONE);
+
+        // Add an instance that plays a clip on a Spatial object and return
+        // its index.
+        int32_t AddInstance(int32_t clip, Spatial* target,
+            Transform<float> const& localTransform,
+            Controller::RepeatType repeat, double minTime, double maxTime,
+            double phase = 0.0, double frequency = 1.0);
+
+        // Add an instance that uses the clip, the Spatial object, the local
+        // transform and the time parameters of a KeyframeController, for
+        // example, one for which AddClip(controller) was called.
+        int32_t AddInstance(int32_t clip, KeyframeController const& controller);
+
+        // Member access.
+        inline int32_t GetNumClips() const
+        {
+            return static_cast<int32_t>(mClips.size());
+        }
+
+        inline int32_t GetNumInstances() const
+        {
+            return static_cast<int32_t>(mInstanceClip.size());
+        }
+
+        // The time parameters of an instance may be modified between
+        // updates, for example, to change the playback speed.
+        void SetTime(int32_t instance, double phase, double frequency);
+
+        // Evaluate all instances at the specified application time and
+        // write their local transforms. This is equivalent to calling
+        // Evaluate and then Apply. The application time is in milliseconds.
+        void Update(double applicationTime);
+
+        // Evaluate all instances without modifying the Spatial objects. The
+        // results are available from the Get* functions below.
+        void Evaluate(double applicationTime);
+
+        // Write the evaluated local transforms to the Spatial objects.
+        void Apply();
+
+        // The results of the most recent Evaluate call in SoA form. Only
+        // the channels animated by the instance's clip are valid.
+        inline std::array<std::vector<float>, 3> const& GetTranslations() const
+        {
+            return mTranslation;
+        }
+
+        inline std::array<std::vector<float>, 4> const& GetRotations() const
+        {
+            return mRotation;
+        }
+
+        inline std::vector<float> const& GetScales() const
+        {
+            return mScale;
+        }
+
+    private:
+        enum
+        {
+            TRANSLATION = 1,
+            ROTATION = 2,
+            SCALE = 4
+        };
+
+        // The keys of a clip. The component j of the key k of a channel is
+        // stored at channelStart[c] + j * numKeys + k in mFloatKeys or in
+        // mQuantizedKeys. A quantized component q represents the value
+        // minimum[c][j] + delta[c][j] * q.
+        struct Clip
+        {
+            int32_t numKeys, timeStart, channels;
+            Compression compression;
+            std::array<size_t, 3> channelStart;
+            std::array<std::array<float, 4>, 3> minimum, delta;
+        };
+
+        // Store the numComponents SoA component arrays of a channel and
+        // return the start index of the first array.
+        size_t StoreChannel(Clip& clip, int32_t channel, int32_t numComponents,
+            std::vector<std::array<float, 4>> const& values);
+
+        inline float GetComponent(Clip const& clip, int32_t channel,
+            int32_t component, int32_t key) const;
+
+        // Evaluate the instances in [imin,imax).
+        void Evaluate(double applicationTime, int32_t imin, int32_t imax);
+
+        // Apply the instances in [imin,imax).
+        void Apply(int32_t imin, int32_t imax);
+
+        // Partition the instances among the threads and call
+        // (this->*function)(imin,imax) for each subset.
+        template <typename Function>
+        void Execute(Function const& function);
+
+        size_t mNumThreads;
+
+        // The clips and their keys.
+        std::vector<Clip> mClips;
+        std::vector<float> mTimes;
+        std::vector<float> mFloatKeys;
+        std::vector<uint16_t> mQuantizedKeys;
+
+        // The instance state.
+        std::vector<int32_t> mInstanceClip;
+        std::vector<Spatial*> mTarget;
+        std::vector<Transform<float>> mLocalTransform;
+        std::vector<Controller::RepeatType> mRepeat;
+        std::vector<double> mMinTime, mMaxTime, mPhase, mFrequency;
+        std::vector<int32_t> mLastKey;
+
+        // The evaluated channels.
+        std::array<std::vector<float>, 3> mTranslation;
+        std::array<std::vector<float>, 4> mRotation;
+        std::vector<float> mScale;
+    };
+}
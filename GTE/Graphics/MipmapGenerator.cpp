@@ -0,0 +1,552 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2022
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 6.3.2026.10.17
+
+#include <Graphics/GTGraphicsPCH.h>
+#include <Graphics/MipmapGenerator.h>
+#include <Mathematics/IEEEBinary16.h>
+#include <Mathematics/Logger.h>
+#include <Mathematics/Math.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <thread>
+using namespace gte;
+
+namespace
+{
+    float SRGBToLinear(float value)
+    {
+        if (value <= 0.04045f)
+        {
+            return value / 12.92f;
+        }
+        return std::pow((value + 0.055f) / 1.055f, 2.4f);
+    }
+
+    float LinearToSRGB(float value)
+    {
+        if (value <= 0.0031308f)
+        {
+            return 12.92f * value;
+        }
+        return 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+    }
+
+    // Conversion of the channels of an integer type. The normalized
+    // unsigned (signed) integers represent numbers in [0,1] ([-1,1]).
+    template <typename T>
+    void DecodeInteger(T const* texels, size_t imin, size_t imax,
+        uint32_t numChannels, bool normalized, float* rgba)
+    {
+        // The minimum normalized signed integer maps to -1, as does the
+        // next larger one.
+        float const scale = (normalized ? 1.0f / static_cast<float>(std::numeric_limits<T>::max()) : 1.0f);
+        float const minValue = (normalized ? -1.0f : -std::numeric_limits<float>::max());
+        for (size_t i = imin; i < imax; ++i)
+        {
+            T const* texel = texels + i * numChannels;
+            float* target = rgba + 4 * i;
+            for (uint32_t c = 0; c < numChannels; ++c)
+            {
+                target[c] = std::max(scale * static_cast<float>(texel[c]), minValue);
+            }
+        }
+    }
+
+    template <typename T>
+    void EncodeInteger(float const* rgba, size_t imin, size_t imax,
+        uint32_t numChannels, bool normalized, T* texels)
+    {
+        // The clamping is in double precision because the maximum of a
+        // 32-bit integer type is not exactly representable as a float.
+        double const scale = (normalized ? static_cast<double>(std::numeric_limits<T>::max()) : 1.0);
+        double const minValue = static_cast<double>(std::numeric_limits<T>::lowest());
+        double const maxValue = static_cast<double>(std::numeric_limits<T>::max());
+        for (size_t i = imin; i < imax; ++i)
+        {
+            float const* source = rgba + 4 * i;
+            T* texel = texels + i * numChannels;
+            for (uint32_t c = 0; c < numChannels; ++c)
+            {
+                double value = std::round(scale * static_cast<double>(source[c]));
+                texel[c] = static_cast<T>(std::min(std::max(value, minValue), maxValue));
+            }
+        }
+    }
+}
+
+MipmapGenerator::MipmapGenerator(Filter filter, size_t numThreads)
+    :
+    mFilter(filter),
+    mNumThreads(numThreads)
+{
+}
+
+void MipmapGenerator::operator()(Texture& texture) const
+{
+    uint32_t const format = texture.GetFormat();
+    LogAssert(texture.HasMipmaps(), "The texture must have mipmaps.");
+    LogAssert(texture.GetData() != nullptr, "The texture must have CPU storage.");
+    LogAssert(IsSupported(format), "Unsupported format " + DataFormat::GetName(format) + ".");
+
+    size_t const numItems = texture.GetNumItems();
+    uint32_t const numLevels = texture.GetNumLevels();
+    std::array<uint32_t, 3> dimensions =
+    {
+        texture.GetDimensionFor(0, 0),
+        texture.GetDimensionFor(0, 1),
+        texture.GetDimensionFor(0, 2)
+    };
+    size_t numTexels = static_cast<size_t>(dimensions[0]) * dimensions[1] * dimensions[2];
+
+    // Convert the level-0 texels of the items to RGBA floats. The items
+    // are stored contiguously in 'current'.
+    std::vector<float> current(4 * numItems * numTexels), next;
+    Execute(numItems * numTexels, [&](size_t tmin, size_t tmax)
+    {
+        for (size_t t = tmin; t < tmax; )
+        {
+            size_t item = t / numTexels;
+            size_t imin = t - item * numTexels;
+            size_t imax = std::min(numTexels, tmax - item * numTexels);
+            Decode(format, texture.GetDataFor(static_cast<uint32_t>(item), 0),
+                imin, imax, current.data() + 4 * item * numTexels);
+            t = item * numTexels + imax;
+        }
+    });
+
+    for (uint32_t level = 1; level < numLevels; ++level)
+    {
+        // Filter the previous level along each axis whose dimension
+        // changes.
+        for (int32_t axis = 0; axis < 3; ++axis)
+        {
+            uint32_t const srcDimension = dimensions[axis];
+            uint32_t const dstDimension = texture.GetDimensionFor(level, axis);
+            if (srcDimension == dstDimension)
+            {
+                continue;
+            }
+
+            size_t numInner = 1, numOuter = numItems;
+            for (int32_t i = 0; i < axis; ++i)
+            {
+                numInner *= dimensions[i];
+            }
+            for (int32_t i = axis + 1; i < 3; ++i)
+            {
+                numOuter *= dimensions[i];
+            }
+
+            Resample(numOuter, srcDimension, dstDimension, numInner, current, next);
+            std::swap(current, next);
+            dimensions[axis] = dstDimension;
+        }
+
+        // Convert the level texels to the texture format.
+        numTexels = static_cast<size_t>(dimensions[0]) * dimensions[1] * dimensions[2];
+        Execute(numItems * numTexels, [&](size_t tmin, size_t tmax)
+        {
+            for (size_t t = tmin; t < tmax; )
+            {
+                size_t item = t / numTexels;
+                size_t imin = t - item * numTexels;
+                size_t imax = std::min(numTexels, tmax - item * numTexels);
+                Encode(format, current.data() + 4 * item * numTexels, imin, imax,
+                    texture.GetDataFor(static_cast<uint32_t>(item), level));
+                t = item * numTexels + imax;
+            }
+        });
+    }
+}
+
+bool MipmapGenerator::IsSupported(uint32_t format)
+{
+    if (format == DF_UNKNOWN || format >= DF_NUM_FORMATS || DataFormat::IsDepth(format))
+    {
+        return false;
+    }
+
+    uint32_t channelSize;
+    switch (GetChannelType(format))
+    {
+    case DF_BYTE:
+    case DF_UBYTE:
+        channelSize = 1;
+        break;
+    case DF_SHORT:
+    case DF_USHORT:
+    case DF_HALF_FLOAT:
+        channelSize = 2;
+        break;
+    case DF_INT:
+    case DF_UINT:
+    case DF_FLOAT:
+        channelSize = 4;
+        break;
+    default:
+        return false;
+    }
+
+    // Exclude the packed formats whose channels are not a whole number of
+    // bytes.
+    uint32_t const numChannels = DataFormat::GetNumChannels(format);
+    return numChannels >= 1 && numChannels <= 4
+        && numChannels * channelSize == DataFormat::GetNumBytesPerStruct(format);
+}
+
+bool MipmapGenerator::IsSRGB(uint32_t format)
+{
+    return format == DF_R8G8B8A8_UNORM_SRGB
+        || format == DF_B8G8R8A8_UNORM_SRGB
+        || format == DF_B8G8R8X8_UNORM_SRGB;
+}
+
+uint32_t MipmapGenerator::GetChannelType(uint32_t format)
+{
+    // The DataFormat channel types of the 8-bit BGRA formats are not
+    // specified, but the channels are normalized unsigned bytes.
+    if (format == DF_B8G8R8A8_UNORM
+        || format == DF_B8G8R8X8_UNORM
+        || format == DF_B8G8R8A8_UNORM_SRGB
+        || format == DF_B8G8R8X8_UNORM_SRGB)
+    {
+        return DF_UBYTE;
+    }
+    return DataFormat::GetChannelType(format);
+}
+
+void MipmapGenerator::ComputeWeights(uint32_t srcDimension, uint32_t dstDimension,
+    Weights& weights) const
+{
+    weights.first.resize(static_cast<size_t>(dstDimension) + 1);
+    weights.index.clear();
+    weights.weight.clear();
+
+    // Destination texel i covers the source interval
+    // [i*scale,(i+1)*scale], where the source texel j covers [j,j+1].
+    float const scale = static_cast<float>(srcDimension) / static_cast<float>(dstDimension);
+    int32_t const maxIndex = static_cast<int32_t>(srcDimension) - 1;
+    for (uint32_t i = 0; i < dstDimension; ++i)
+    {
+        size_t const first = weights.weight.size();
+        weights.first[i] = static_cast<uint32_t>(first);
+
+        float xmin, xmax;
+        if (mFilter == Filter::BOX)
+        {
+            xmin = static_cast<float>(i) * scale;
+            xmax = xmin + scale;
+        }
+        else
+        {
+            // The filters have radius 3 in destination texels.
+            float const center = (static_cast<float>(i) + 0.5f) * scale;
+            xmin = center - 3.0f * scale;
+            xmax = center + 3.0f * scale;
+        }
+
+        int32_t const jmin = static_cast<int32_t>(std::floor(xmin));
+        int32_t const jmax = static_cast<int32_t>(std::ceil(xmax)) - 1;
+        float sum = 0.0f;
+        for (int32_t j = jmin; j <= jmax; ++j)
+        {
+            float w;
+            if (mFilter == Filter::BOX)
+            {
+                // The length of the overlap of the source and destination
+                // texel intervals.
+                w = std::min(xmax, static_cast<float>(j + 1)) - std::max(xmin, static_cast<float>(j));
+            }
+            else
+            {
+                float const center = 0.5f * (xmin + xmax);
+                w = Evaluate((static_cast<float>(j) + 0.5f - center) / scale);
+            }
+
+            if (w != 0.0f)
+            {
+                weights.index.push_back(static_cast<uint32_t>(std::min(std::max(j, 0), maxIndex)));
+                weights.weight.push_back(w);
+                sum += w;
+            }
+        }
+
+        for (size_t k = first; k < weights.weight.size(); ++k)
+        {
+            weights.weight[k] /= sum;
+        }
+    }
+    weights.first[dstDimension] = static_cast<uint32_t>(weights.weight.size());
+}
+
+float MipmapGenerator::Evaluate(float x) const
+{
+    float const radius = 3.0f;
+    float const absX = std::fabs(x);
+    if (absX >= radius)
+    {
+        return 0.0f;
+    }
+
+    float sinc = 1.0f;
+    if (absX > 0.0f)
+    {
+        float const piX = static_cast<float>(GTE_C_PI) * x;
+        sinc = std::sin(piX) / piX;
+    }
+
+    float window;
+    if (mFilter == Filter::KAISER)
+    {
+        // The Kaiser window is I0(alpha*sqrt(1-(x/r)^2))/I0(alpha) where I0
+        // is the modified Bessel function of the first kind of order 0,
+        // evaluated by its power series.
+        auto I0 = [](float t)
+        {
+            float sum = 1.0f, term = 1.0f, halfT = 0.5f * t;
+            for (int32_t k = 1; k < 32 && term > 1e-7f * sum; ++k)
+            {
+                float factor = halfT / static_cast<float>(k);
+                term *= factor * factor;
+                sum += term;
+            }
+            return sum;
+        };
+
+        float const alpha = 4.0f;
+        float const ratio = x / radius;
+        window = I0(alpha * std::sqrt(1.0f - ratio * ratio)) / I0(alpha);
+    }
+    else  // mFilter == Filter::LANCZOS
+    {
+        float const piX = static_cast<float>(GTE_C_PI) * x / radius;
+        window = (absX > 0.0f ? std::sin(piX) / piX : 1.0f);
+    }
+    return sinc * window;
+}
+
+void MipmapGenerator::Resample(size_t numOuter, uint32_t srcDimension,
+    uint32_t dstDimension, size_t numInner, std::vector<float> const& source,
+    std::vector<float>& target) const
+{
+    Weights weights;
+    ComputeWeights(srcDimension, dstDimension, weights);
+
+    target.resize(4 * numOuter * dstDimension * numInner);
+    size_t const spanSize = 4 * numInner;
+    Execute(numOuter * dstDimension, [&](size_t tmin, size_t tmax)
+    {
+        for (size_t t = tmin; t < tmax; ++t)
+        {
+            // The destination span is a row of texels for the y-axis or a
+            // slice of texels for the z-axis, so the inner loops are over
+            // contiguous memory. For the x-axis the span is a single texel.
+            size_t const outer = t / dstDimension;
+            size_t const i = t - outer * dstDimension;
+            float const* srcBlock = source.data() + outer * srcDimension * spanSize;
+            float* dstSpan = target.data() + t * spanSize;
+            std::fill(dstSpan, dstSpan + spanSize, 0.0f);
+            for (uint32_t k = weights.first[i]; k < weights.first[i + 1]; ++k)
+            {
+                float const w = weights.weight[k];
+                float const* srcSpan = srcBlock + weights.index[k] * spanSize;
+                for (size_t s = 0; s < spanSize; ++s)
+                {
+                    dstSpan[s] += w * srcSpan[s];
+                }
+            }
+        }
+    });
+}
+
+void MipmapGenerator::Decode(uint32_t format, char const* data, size_t imin,
+    size_t imax, float* rgba)
+{
+    uint32_t const numChannels = DataFormat::GetNumChannels(format);
+    bool const normalized = DataFormat::ConvertChannel(format);
+    for (size_t i = imin; i < imax; ++i)
+    {
+        float* target = rgba + 4 * i;
+        target[0] = 0.0f;
+        target[1] = 0.0f;
+        target[2] = 0.0f;
+        target[3] = 1.0f;
+    }
+
+    switch (GetChannelType(format))
+    {
+    case DF_BYTE:
+        DecodeInteger(reinterpret_cast<int8_t const*>(data), imin, imax, numChannels, normalized, rgba);
+        break;
+    case DF_UBYTE:
+        DecodeInteger(reinterpret_cast<uint8_t const*>(data), imin, imax, numChannels, normalized, rgba);
+        break;
+    case DF_SHORT:
+        DecodeInteger(reinterpret_cast<int16_t const*>(data), imin, imax, numChannels, normalized, rgba);
+        break;
+    case DF_USHORT:
+        DecodeInteger(reinterpret_cast<uint16_t const*>(data), imin, imax, numChannels, normalized, rgba);
+        break;
+    case DF_INT:
+        DecodeInteger(reinterpret_cast<int32_t const*>(data), imin, imax, numChannels, false, rgba);
+        break;
+    case DF_UINT:
+        DecodeInteger(reinterpret_cast<uint32_t const*>(data), imin, imax, numChannels, false, rgba);
+        break;
+    case DF_HALF_FLOAT:
+    {
+        uint16_t const* texels = reinterpret_cast<uint16_t const*>(data);
+        for (size_t i = imin; i < imax; ++i)
+        {
+            for (uint32_t c = 0; c < numChannels; ++c)
+            {
+                rgba[4 * i + c] = static_cast<float>(IEEEBinary16(texels[i * numChannels + c]));
+            }
+        }
+        break;
+    }
+    case DF_FLOAT:
+    {
+        float const* texels = reinterpret_cast<float const*>(data);
+        for (size_t i = imin; i < imax; ++i)
+        {
+            for (uint32_t c = 0; c < numChannels; ++c)
+            {
+                rgba[4 * i + c] = texels[i * numChannels + c];
+            }
+        }
+        break;
+    }
+    default:
+        LogError("Unsupported format " + DataFormat::GetName(format) + ".");
+    }
+
+    if (IsSRGB(format))
+    {
+        // The 8-bit sRGB values are converted by table lookup.
+        static std::array<float, 256> const table = []()
+        {
+            std::array<float, 256> values{};
+            for (size_t j = 0; j < values.size(); ++j)
+            {
+                values[j] = SRGBToLinear(static_cast<float>(j) / 255.0f);
+            }
+            return values;
+        }();
+
+        for (size_t i = imin; i < imax; ++i)
+        {
+            for (size_t c = 0; c < 3; ++c)
+            {
+                float& value = rgba[4 * i + c];
+                value = table[static_cast<size_t>(std::lround(255.0f * value))];
+            }
+        }
+    }
+}
+
+void MipmapGenerator::Encode(uint32_t format, float const* rgba, size_t imin,
+    size_t imax, char* data)
+{
+    uint32_t const numChannels = DataFormat::GetNumChannels(format);
+    bool const normalized = DataFormat::ConvertChannel(format);
+
+    std::vector<float> converted;
+    if (IsSRGB(format))
+    {
+        // Convert the color channels to sRGB and clamp all channels to
+        // [0,1]. The texels are stored at their indices in 'converted'
+        // relative to imin.
+        converted.resize(4 * (imax - imin));
+        for (size_t i = imin; i < imax; ++i)
+        {
+            float* target = &converted[4 * (i - imin)];
+            for (size_t c = 0; c < 4; ++c)
+            {
+                float value = std::min(std::max(rgba[4 * i + c], 0.0f), 1.0f);
+                target[c] = (c < 3 ? LinearToSRGB(value) : value);
+            }
+        }
+        rgba = converted.data() - 4 * imin;
+    }
+
+    switch (GetChannelType(format))
+    {
+    case DF_BYTE:
+        EncodeInteger(rgba, imin, imax, numChannels, normalized, reinterpret_cast<int8_t*>(data));
+        break;
+    case DF_UBYTE:
+        EncodeInteger(rgba, imin, imax, numChannels, normalized, reinterpret_cast<uint8_t*>(data));
+        break;
+    case DF_SHORT:
+        EncodeInteger(rgba, imin, imax, numChannels, normalized, reinterpret_cast<int16_t*>(data));
+        break;
+    case DF_USHORT:
+        EncodeInteger(rgba, imin, imax, numChannels, normalized, reinterpret_cast<uint16_t*>(data));
+        break;
+    case DF_INT:
+        EncodeInteger(rgba, imin, imax, numChannels, false, reinterpret_cast<int32_t*>(data));
+        break;
+    case DF_UINT:
+        EncodeInteger(rgba, imin, imax, numChannels, false, reinterpret_cast<uint32_t*>(data));
+        break;
+    case DF_HALF_FLOAT:
+    {
+        uint16_t* texels = reinterpret_cast<uint16_t*>(data);
+        for (size_t i = imin; i < imax; ++i)
+        {
+            for (uint32_t c = 0; c < numChannels; ++c)
+            {
+                texels[i * numChannels + c] = IEEEBinary16(rgba[4 * i + c]).encoding;
+            }
+        }
+        break;
+    }
+    case DF_FLOAT:
+    {
+        float* texels = reinterpret_cast<float*>(data);
+        for (size_t i = imin; i < imax; ++i)
+        {
+            for (uint32_t c = 0; c < numChannels; ++c)
+            {
+                texels[i * numChannels + c] = rgba[4 * i + c];
+            }
+        }
+        break;
+    }
+    default:
+        LogError("Unsupported format " + DataFormat::GetName(format) + ".");
+    }
+}
+
+void MipmapGenerator::Execute(size_t numTasks,
+    std::function<void(size_t, size_t)> const& function) const
+{
+    size_t const numThreads = std::min(mNumThreads, numTasks);
+    if (numThreads > 0)
+    {
+        std::vector<std::thread> process(numThreads);
+        for (size_t t = 0; t < numThreads; ++t)
+        {
+            size_t tmin = t * numTasks / numThreads;
+            size_t tmax = (t + 1) * numTasks / numThreads;
+            process[t] = std::thread([&function, tmin, tmax]()
+            {
+                function(tmin, tmax);
+            });
+        }
+        for (size_t t = 0; t < numThreads; ++t)
+        {
+            process[t].join();
+        }
+    }
+    else
+    {
+        function(0, numTasks);
+    }
+}
@@ -0,0 +1,123 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2022
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 6.3.2026.10.17
+
+#pragma once
+
+#include <Graphics/Texture.h>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Compute the mipmap levels of a texture on the CPU. Texture::
+// AutogenerateMipmaps requests that the GPU compute the levels, which is
+// not possible for applications that do not have a GPU, for example, for
+// offline processing of textures. The level-0 data of each item of the
+// texture (the single item of Texture1, Texture2 or Texture3, the items of
+// a texture array, the faces of a cube map) is converted to 32-bit
+// floating-point channels, each level is computed from the previous level
+// with a separable filter and is written to the texture storage in the
+// texture format. The filtering of the items is independent, so the faces
+// of a cube map are filtered without regard to their neighbors.
+//
+// The formats with _SRGB suffixes have red, green and blue channels that
+// are converted to linear values before filtering and converted back to
+// sRGB afterwards. The alpha channel is always linear. The supported
+// formats have 8-bit, 16-bit or 32-bit integer channels, 16-bit or 32-bit
+// floating-point channels; see IsSupported. Block-compressed, packed,
+// video and depth formats are not supported.
+//
+// The dimension of level L+1 is max(1, floor(d/2)) for level L dimension
+// d, so the ratio of dimensions is not 2 when d is odd. The filters are
+// scaled by the ratio of dimensions and the texels outside the level are
+// obtained by clamping to the edges.
+
+namespace gte
+{
+    class MipmapGenerator
+    {
+    public:
+        enum class Filter
+        {
+            // The average of the texels covered by a destination texel.
+            BOX,
+
+            // A sinc function windowed by a Kaiser window with radius 3
+            // and alpha 4.
+            KAISER,
+
+            // A sinc function windowed by sinc(x/3) with radius 3.
+            LANCZOS
+        };
+
+        // To compute in the main thread only, choose numThreads to be 0.
+        // For multithreading, choose numThreads > 0. The threads process
+        // the rows (or columns or slices) of all items of a level
+        // simultaneously.
+        MipmapGenerator(Filter filter = Filter::BOX, size_t numThreads = 0);
+
+        // Compute levels 1 through texture.GetNumLevels()-1 of all the
+        // items of the texture from their level-0 data. The texture must
+        // have mipmaps, CPU storage and a supported format.
+        void operator()(Texture& texture) const;
+
+        // Member access.
+        inline void SetFilter(Filter filter)
+        {
+            mFilter = filter;
+        }
+
+        inline Filter GetFilter() const
+        {
+            return mFilter;
+        }
+
+        static bool IsSupported(uint32_t format);
+
+        static bool IsSRGB(uint32_t format);
+
+    private:
+        static uint32_t GetChannelType(uint32_t format);
+
+        // The contributions of the texels of a source line to a texel of
+        // the destination line, where the contribution to destination
+        // texel i is sum_{k=first[i]}^{first[i+1]-1} weight[k]*texel[index[k]].
+        struct Weights
+        {
+            std::vector<uint32_t> first;
+            std::vector<uint32_t> index;
+            std::vector<float> weight;
+        };
+
+        void ComputeWeights(uint32_t srcDimension, uint32_t dstDimension,
+            Weights& weights) const;
+
+        float Evaluate(float x) const;
+
+        // Resample the RGBA float texels along an axis. The texels are
+        // stored as numOuter blocks of srcDimension (dstDimension) spans
+        // of numInner texels, where the spans are indexed by the texel
+        // coordinate along the axis.
+        void Resample(size_t numOuter, uint32_t srcDimension, uint32_t dstDimension,
+            size_t numInner, std::vector<float> const& source, std::vector<float>& target) const;
+
+        // Conversion between the texture format and RGBA floats for the
+        // texels [imin,imax) of a subresource.
+        static void Decode(uint32_t format, char const* data, size_t imin,
+            size_t imax, float* rgba);
+
+        static void Encode(uint32_t format, float const* rgba, size_t imin,
+            size_t imax, char* data);
+
+        // Partition [0,numTasks) among the threads and call
+        // function(tmin,tmax) for each subset.
+        void Execute(size_t numTasks, std::function<void(size_t, size_t)> const& function) const;
+
+        Filter mFilter;
+        size_t mNumThreads;
+    };
+}
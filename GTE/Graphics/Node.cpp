@@ -3,13 +3,15 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 6.0.2022.01.06
+// Version: 6.3.2026.10.17
 
 #include <Graphics/GTGraphicsPCH.h>
 #include <Graphics/Node.h>
 #include <Mathematics/Logger.h>
 using namespace gte;
 
+std::shared_ptr<Spatial> const Node::msNullChild{};
+
 Node::~Node()
 {
     for (auto& child : mChild)
@@ -128,13 +130,13 @@ std::shared_ptr<Spatial> Node::SetChild(int32_t i,
     return nullptr;
 }
 
-std::shared_ptr<Spatial> Node::GetChild(int32_t i)
+std::shared_ptr<Spatial> const& Node::GetChild(int32_t i) const
 {
     if (0 <= i && i < static_cast<int32_t>(mChild.size()))
     {
         return mChild[i];
     }
-    return nullptr;
+    return msNullChild;
 }
 
 Spatial* Node::GetChildPtr(int32_t i)
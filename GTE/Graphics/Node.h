@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 6.0.2022.01.06
+// Version: 6.3.2026.10.17
 
 #pragma once
 
@@ -83,11 +83,10 @@ namespace gte
         // Get the child at the specified index. If 0 <= i < GetNumChildren(),
         // the function succeeds and returns the child at that index.  Keep in
         // mind that child[i] could very well be null.  If i is out of range,
-        // the function returns null.
-        std::shared_ptr<Spatial> GetChild(int32_t i);
+        // the function returns null.  The child is returned by reference, so
+        // traversals do not modify its reference count.
+        std::shared_ptr<Spatial> const& GetChild(int32_t i) const;
 
-        // TODO: Redesign Node to return a 'std::shared_ptr<Spatial> const&'
-        // from GetChild(int32_t).
         Spatial* GetChildPtr(int32_t i);
 
     protected:
@@ -101,5 +100,8 @@ namespace gte
 
         // Child pointers.
         std::vector<std::shared_ptr<Spatial>> mChild;
+
+        // The null child returned by GetChild(i) for out-of-range i.
+        static std::shared_ptr<Spatial> const msNullChild;
     };
 }
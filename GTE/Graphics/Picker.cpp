@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 6.0.2022.01.06
+// Version: 6.3.2026.10.17
 
 #include <Graphics/GTGraphicsPCH.h>
 #include <Graphics/Picker.h>
@@ -174,11 +174,15 @@ PickRecord const& Picker::GetClosestNonpositive() const
 
 void Picker::ExecuteRecursive(std::shared_ptr<Spatial> const& object)
 {
-    auto visual = std::dynamic_pointer_cast<Visual>(object);
-    if (visual)
+    // The types are tested with raw pointers. A shared pointer to the
+    // visual, which is stored in the pick records, is created only when
+    // the bound of the visual is intersected.
+    if (dynamic_cast<Visual*>(object.get()) != nullptr)
     {
-        if (visual->worldBound.TestIntersection(HProject(mOrigin), HProject(mDirection), mTMin, mTMax))
+        if (object->worldBound.TestIntersection(HProject(mOrigin), HProject(mDirection), mTMin, mTMax))
         {
+            auto visual = std::static_pointer_cast<Visual>(object);
+
             // Convert the linear component to model-space coordinates.
             Matrix4x4<float> const& invWorldMatrix = visual->worldTransform.GetHInverse();
             Line3<float> line;
@@ -226,7 +230,7 @@ void Picker::ExecuteRecursive(std::shared_ptr<Spatial> const& object)
         return;
     }
 
-    auto node = std::dynamic_pointer_cast<Node>(object);
+    auto node = dynamic_cast<Node*>(object.get());
     if (node)
     {
         if (node->worldBound.TestIntersection(HProject(mOrigin), HProject(mDirection), mTMin, mTMax))
@@ -234,7 +238,7 @@ void Picker::ExecuteRecursive(std::shared_ptr<Spatial> const& object)
             int32_t const numChildren = node->GetNumChildren();
             for (int32_t i = 0; i < numChildren; ++i)
             {
-                std::shared_ptr<Spatial> child = node->GetChild(i);
+                auto const& child = node->GetChild(i);
                 if (child)
                 {
                     ExecuteRecursive(child);
@@ -0,0 +1,219 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2022
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 6.3.2026.10.17
+
+#pragma once
+
+#include <Mathematics/Logger.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// Optional pooled allocation of scene graph objects (Spatial, Node, Visual,
+// Controller, VisualEffect and any other class), which replaces the many
+// small heap allocations of std::make_shared when large scenes are built
+// and torn down. The objects are created by
+//   ScenePool pool;
+//   auto node = MakeShared<Node>(pool);
+//   auto visual = MakeShared<Visual>(pool, vbuffer, ibuffer, effect);
+// The objects are std::shared_ptr as usual, where the object and its
+// reference count are allocated in one block of the pool by
+// std::allocate_shared. The pooled and heap-allocated objects can be mixed
+// in a scene.
+//
+// The pool memory consists of chunks that are partitioned into blocks of
+// equal size. The block sizes are multiples of 16 bytes up to
+// MAX_BLOCK_SIZE; larger requests are passed to operator new. A freed block
+// is put on the free list for its size and reused by the next allocation of
+// that size. The chunks are released when the pool and all the objects
+// allocated from it are destroyed, so the objects may outlive the ScenePool
+// object. The pool is thread safe.
+
+namespace gte
+{
+    class ScenePool
+    {
+    public:
+        enum
+        {
+            BLOCK_ALIGNMENT = 16,
+            MAX_BLOCK_SIZE = 1024
+        };
+
+        // The number of blocks of a chunk, which must be positive.
+        ScenePool(size_t blocksPerChunk = 256)
+            :
+            mState(std::make_shared<State>(blocksPerChunk))
+        {
+            LogAssert(blocksPerChunk > 0, "The chunks must have blocks.");
+        }
+
+        inline void* Allocate(size_t numBytes)
+        {
+            return mState->Allocate(numBytes);
+        }
+
+        inline void Deallocate(void* block, size_t numBytes)
+        {
+            mState->Deallocate(block, numBytes);
+        }
+
+        // The number of bytes allocated for chunks.
+        inline size_t GetNumChunkBytes() const
+        {
+            std::lock_guard<std::mutex> lock(mState->mutex);
+            return mState->numChunkBytes;
+        }
+
+    private:
+        template <typename T> friend class ScenePoolAllocator;
+
+        enum
+        {
+            NUM_SIZE_CLASSES = MAX_BLOCK_SIZE / BLOCK_ALIGNMENT
+        };
+
+        // A free block stores the pointer to the next free block.
+        struct FreeBlock
+        {
+            FreeBlock* next;
+        };
+
+        struct State
+        {
+            State(size_t inBlocksPerChunk)
+                :
+                blocksPerChunk(inBlocksPerChunk),
+                numChunkBytes(0),
+                freeList{},
+                chunks{},
+                mutex{}
+            {
+                freeList.fill(nullptr);
+            }
+
+            void* Allocate(size_t numBytes)
+            {
+                if (numBytes > MAX_BLOCK_SIZE)
+                {
+                    return ::operator new(numBytes);
+                }
+
+                size_t const sizeClass = GetSizeClass(numBytes);
+                std::lock_guard<std::mutex> lock(mutex);
+                FreeBlock* block = freeList[sizeClass];
+                if (block == nullptr)
+                {
+                    // Partition a new chunk into blocks. The chunk memory
+                    // from operator new is aligned for std::max_align_t.
+                    size_t const blockSize = (sizeClass + 1) * BLOCK_ALIGNMENT;
+                    size_t const chunkSize = blockSize * blocksPerChunk;
+                    chunks.emplace_back(new char[chunkSize]);
+                    numChunkBytes += chunkSize;
+                    char* chunk = chunks.back().get();
+                    for (size_t i = blocksPerChunk; i > 0; --i)
+                    {
+                        FreeBlock* free = reinterpret_cast<FreeBlock*>(chunk + (i - 1) * blockSize);
+                        free->next = block;
+                        block = free;
+                    }
+                }
+                freeList[sizeClass] = block->next;
+                return block;
+            }
+
+            void Deallocate(void* block, size_t numBytes)
+            {
+                if (numBytes > MAX_BLOCK_SIZE)
+                {
+                    ::operator delete(block);
+                    return;
+                }
+
+                size_t const sizeClass = GetSizeClass(numBytes);
+                std::lock_guard<std::mutex> lock(mutex);
+                FreeBlock* free = static_cast<FreeBlock*>(block);
+                free->next = freeList[sizeClass];
+                freeList[sizeClass] = free;
+            }
+
+            static inline size_t GetSizeClass(size_t numBytes)
+            {
+                return (numBytes > 0 ? (numBytes - 1) / BLOCK_ALIGNMENT : 0);
+            }
+
+            size_t blocksPerChunk, numChunkBytes;
+            std::array<FreeBlock*, NUM_SIZE_CLASSES> freeList;
+            std::vector<std::unique_ptr<char[]>> chunks;
+            mutable std::mutex mutex;
+        };
+
+        std::shared_ptr<State> mState;
+    };
+
+    // A standard allocator for the blocks of a ScenePool. The allocator
+    // shares ownership of the pool memory.
+    template <typename T>
+    class ScenePoolAllocator
+    {
+    public:
+        using value_type = T;
+
+        ScenePoolAllocator(ScenePool const& pool)
+            :
+            mState(pool.mState)
+        {
+        }
+
+        template <typename U>
+        ScenePoolAllocator(ScenePoolAllocator<U> const& allocator)
+            :
+            mState(allocator.mState)
+        {
+        }
+
+        T* allocate(size_t n)
+        {
+            static_assert(alignof(T) <= ScenePool::BLOCK_ALIGNMENT,
+                "The alignment of the type is not supported.");
+            return static_cast<T*>(mState->Allocate(n * sizeof(T)));
+        }
+
+        void deallocate(T* p, size_t n)
+        {
+            mState->Deallocate(p, n * sizeof(T));
+        }
+
+        template <typename U>
+        inline bool operator==(ScenePoolAllocator<U> const& allocator) const
+        {
+            return mState == allocator.mState;
+        }
+
+        template <typename U>
+        inline bool operator!=(ScenePoolAllocator<U> const& allocator) const
+        {
+            return mState != allocator.mState;
+        }
+
+    private:
+        template <typename U> friend class ScenePoolAllocator;
+
+        std::shared_ptr<ScenePool::State> mState;
+    };
+
+    // The replacement for std::make_shared<T>(args...).
+    template <typename T, typename... Args>
+    std::shared_ptr<T> MakeShared(ScenePool const& pool, Args&&... args)
+    {
+        return std::allocate_shared<T>(ScenePoolAllocator<T>(pool),
+            std::forward<Args>(args)...);
+    }
+}
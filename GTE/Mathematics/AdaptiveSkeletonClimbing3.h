@@ -3,18 +3,20 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 6.0.2022.01.06
+// Version: 6.3.2026.10.17
 
 #pragma once
 
 #include <GTE/Mathematics/Logger.h>
 #include <GTE/Mathematics/Array2.h>
+#include <GTE/Mathematics/HashCombine.h>
 #include <GTE/Mathematics/Math.h>
 #include <GTE/Mathematics/TriangleKey.h>
-#include <map>
+#include <array>
 #include <memory>
 #include <ostream>
 #include <set>
+#include <unordered_map>
 
 // Extract level surfaces using an adaptive approach to reduce the triangle
 // count.  The implementation is for the algorithm described in the paper
@@ -43,7 +45,9 @@ namespace gte
         // large to process by itself can be partitioned into smaller
         // subimages and the adaptive skeleton climbing applied to each
         // subimage.  By forcing highest resolution on the boundary,
-        // adjacent subimages will not have any cracking problems.
+        // adjacent subimages will not have any cracking problems.  See
+        // SetSubimage and TiledAdaptiveSkeletonClimbing3 for the
+        // partitioning.
         AdaptiveSkeletonClimbing3(int32_t N, T const* inputVoxels,
             bool fixBoundary = false)
             :
@@ -53,6 +57,8 @@ namespace gte
             mInputVoxels(inputVoxels),
             mLevel((Real)0),
             mFixBoundary(fixBoundary),
+            mOrigin{ 0, 0, 0 },
+            mNumCells{ mTwoPowerN, mTwoPowerN, mTwoPowerN },
             mXMerge(mSize, mSize),
             mYMerge(mSize, mSize),
             mZMerge(mSize, mSize)
@@ -80,6 +86,36 @@ namespace gte
         typedef std::array<int32_t, 2> Edge;
         typedef TriangleKey<true> Triangle;
 
+        // Support for hashing vertices in std::unordered* containers.
+        struct VertexHash
+        {
+            std::size_t operator()(Vertex const& v) const
+            {
+                return HashValue(v[0], v[1], v[2]);
+            }
+        };
+
+        // Support for partitioning a large image into subimages.  The
+        // 'origin' is the location of the subimage in the large image and
+        // is added to the vertex coordinates, so vertices shared by
+        // adjacent subimages have identical coordinates.  Only the voxels
+        // (x,y,z) with x < numCells[0], y < numCells[1] and z < numCells[2]
+        // are tessellated, which allows a subimage that extends beyond the
+        // large image to be padded.  When 'fixBoundary' is 'true', the
+        // voxels on both sides of the planes x = numCells[0],
+        // y = numCells[1] and z = numCells[2] are not allowed to merge, so
+        // the voxels that are tessellated are not merged with padding.
+        void SetSubimage(std::array<int32_t, 3> const& origin,
+            std::array<int32_t, 3> const& numCells)
+        {
+            for (int32_t i = 0; i < 3; ++i)
+            {
+                LogAssert(1 <= numCells[i] && numCells[i] <= mTwoPowerN, "Invalid number of cells.");
+            }
+            mOrigin = origin;
+            mNumCells = numCells;
+        }
+
         void Extract(Real level, int32_t depth,
             std::vector<Vertex>& vertices, std::vector<Triangle>& triangles)
         {
@@ -107,7 +143,8 @@ namespace gte
 
             // Compute the map of unique vertices and assign to them new and
             // unique indices.
-            std::map<Vertex, int32_t> vmap;
+            std::unordered_map<Vertex, int32_t, VertexHash> vmap;
+            vmap.reserve(numVertices / 2);
             int32_t nextVertex = 0;
             for (size_t v = 0; v < numVertices; ++v)
             {
@@ -121,7 +158,8 @@ namespace gte
 
             // Compute the map of unique triangles and assign to them new and
             // unique indices.
-            std::map<Triangle, int32_t> tmap;
+            std::unordered_map<Triangle, int32_t, Triangle, Triangle> tmap;
+            tmap.reserve(numTriangles);
             int32_t nextTriangle = 0;
             for (size_t t = 0; t < numTriangles; ++t)
             {
@@ -1019,7 +1057,7 @@ namespace gte
             }
             else  // leaf nodes
             {
-                if (mFixBoundary)
+                if (mFixBoundary && IsBoundaryVoxel(x0, y0, z0))
                 {
                     // Do not allow boundary voxels to merge with any other
                     // voxels.
@@ -1211,6 +1249,22 @@ namespace gte
             return true;
         }
 
+        // A voxel is on the boundary when it is on the image boundary or
+        // adjacent to a plane that bounds the voxels to be tessellated.
+        bool IsBoundaryVoxel(int32_t x, int32_t y, int32_t z) const
+        {
+            int32_t const v[3] = { x, y, z };
+            for (int32_t i = 0; i < 3; ++i)
+            {
+                if (v[i] == 0 || v[i] == mTwoPowerN - 1 ||
+                    v[i] == mNumCells[i] - 1 || v[i] == mNumCells[i])
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
         void AddBox(int32_t x0, int32_t y0, int32_t z0, int32_t dx, int32_t dy, int32_t dz, int32_t LX, int32_t LY, int32_t LZ)
         {
             OctBox box(x0, y0, z0, dx, dy, dz, LX, LY, LZ);
@@ -1238,6 +1292,11 @@ namespace gte
             for (size_t i = 0; i < mBoxes.size(); ++i)
             {
                 OctBox const& box = mBoxes[i];
+                if (box.x0 >= mNumCells[0] || box.y0 >= mNumCells[1] || box.z0 >= mNumCells[2])
+                {
+                    // The box is in the padding of a subimage.
+                    continue;
+                }
 
                 // Get vertices on edges of box.
                 VETable table;
@@ -1285,13 +1344,29 @@ namespace gte
             }
         }
 
+        // Vertex coordinates for the image coordinates.
+        inline Real GetX(int32_t x) const
+        {
+            return static_cast<Real>(x + mOrigin[0]);
+        }
+
+        inline Real GetY(int32_t y) const
+        {
+            return static_cast<Real>(y + mOrigin[1]);
+        }
+
+        inline Real GetZ(int32_t z) const
+        {
+            return static_cast<Real>(z + mOrigin[2]);
+        }
+
         Real GetXInterp(int32_t x, int32_t y, int32_t z) const
         {
             int32_t index = x + mSize * (y + mSize * z);
             Real f0 = static_cast<Real>(mInputVoxels[index]);
             ++index;
             Real f1 = static_cast<Real>(mInputVoxels[index]);
-            return static_cast<Real>(x) + (mLevel - f0) / (f1 - f0);
+            return GetX(x) + (mLevel - f0) / (f1 - f0);
         }
 
         Real GetYInterp(int32_t x, int32_t y, int32_t z) const
@@ -1300,7 +1375,7 @@ namespace gte
             Real f0 = static_cast<Real>(mInputVoxels[index]);
             index += mSize;
             Real f1 = static_cast<Real>(mInputVoxels[index]);
-            return static_cast<Real>(y) + (mLevel - f0) / (f1 - f0);
+            return GetY(y) + (mLevel - f0) / (f1 - f0);
         }
 
         Real GetZInterp(int32_t x, int32_t y, int32_t z) const
@@ -1309,7 +1384,7 @@ namespace gte
             Real f0 = static_cast<Real>(mInputVoxels[index]);
             index += mSizeSqr;
             Real f1 = static_cast<Real>(mInputVoxels[index]);
-            return static_cast<Real>(z) + (mLevel - f0) / (f1 - f0);
+            return GetZ(z) + (mLevel - f0) / (f1 - f0);
         }
 
         void GetVertices(OctBox const& box, uint32_t& type, VETable& table)
@@ -1323,8 +1398,8 @@ namespace gte
             {
                 type |= EB_XMIN_YMIN;
                 table.Insert(EI_XMIN_YMIN,
-                    static_cast<float>(box.x0),
-                    static_cast<float>(box.y0),
+                    GetX(box.x0),
+                    GetY(box.y0),
                     GetZInterp(box.x0, box.y0, root));
             }
 
@@ -1334,8 +1409,8 @@ namespace gte
             {
                 type |= EB_XMIN_YMAX;
                 table.Insert(EI_XMIN_YMAX,
-                    static_cast<float>(box.x0),
-                    static_cast<float>(box.y1),
+                    GetX(box.x0),
+                    GetY(box.y1),
                     GetZInterp(box.x0, box.y1, root));
             }
 
@@ -1345,8 +1420,8 @@ namespace gte
             {
                 type |= EB_XMAX_YMIN;
                 table.Insert(EI_XMAX_YMIN,
-                    static_cast<float>(box.x1),
-                    static_cast<float>(box.y0),
+                    GetX(box.x1),
+                    GetY(box.y0),
                     GetZInterp(box.x1, box.y0, root));
             }
 
@@ -1356,8 +1431,8 @@ namespace gte
             {
                 type |= EB_XMAX_YMAX;
                 table.Insert(EI_XMAX_YMAX,
-                    static_cast<float>(box.x1),
-                    static_cast<float>(box.y1),
+                    GetX(box.x1),
+                    GetY(box.y1),
                     GetZInterp(box.x1, box.y1, root));
             }
 
@@ -1367,9 +1442,9 @@ namespace gte
             {
                 type |= EB_XMIN_ZMIN;
                 table.Insert(EI_XMIN_ZMIN,
-                    static_cast<float>(box.x0),
+                    GetX(box.x0),
                     GetYInterp(box.x0, root, box.z0),
-                    static_cast<float>(box.z0));
+                    GetZ(box.z0));
             }
 
             // xmin-zmax edge
@@ -1378,9 +1453,9 @@ namespace gte
             {
                 type |= EB_XMIN_ZMAX;
                 table.Insert(EI_XMIN_ZMAX,
-                    static_cast<float>(box.x0),
+                    GetX(box.x0),
                     GetYInterp(box.x0, root, box.z1),
-                    static_cast<float>(box.z1));
+                    GetZ(box.z1));
             }
 
             // xmax-zmin edge
@@ -1389,9 +1464,9 @@ namespace gte
             {
                 type |= EB_XMAX_ZMIN;
                 table.Insert(EI_XMAX_ZMIN,
-                    static_cast<float>(box.x1),
+                    GetX(box.x1),
                     GetYInterp(box.x1, root, box.z0),
-                    static_cast<float>(box.z0));
+                    GetZ(box.z0));
             }
 
             // xmax-zmax edge
@@ -1400,9 +1475,9 @@ namespace gte
             {
                 type |= EB_XMAX_ZMAX;
                 table.Insert(EI_XMAX_ZMAX,
-                    static_cast<float>(box.x1),
+                    GetX(box.x1),
                     GetYInterp(box.x1, root, box.z1),
-                    static_cast<float>(box.z1));
+                    GetZ(box.z1));
             }
 
             // ymin-zmin edge
@@ -1412,8 +1487,8 @@ namespace gte
                 type |= EB_YMIN_ZMIN;
                 table.Insert(EI_YMIN_ZMIN,
                     GetXInterp(root, box.y0, box.z0),
-                    static_cast<float>(box.y0),
-                    static_cast<float>(box.z0));
+                    GetY(box.y0),
+                    GetZ(box.z0));
             }
 
             // ymin-zmax edge
@@ -1423,8 +1498,8 @@ namespace gte
                 type |= EB_YMIN_ZMAX;
                 table.Insert(EI_YMIN_ZMAX,
                     GetXInterp(root, box.y0, box.z1),
-                    static_cast<float>(box.y0),
-                    static_cast<float>(box.z1));
+                    GetY(box.y0),
+                    GetZ(box.z1));
             }
 
             // ymax-zmin edge
@@ -1434,8 +1509,8 @@ namespace gte
                 type |= EB_YMAX_ZMIN;
                 table.Insert(EI_YMAX_ZMIN,
                     GetXInterp(root, box.y1, box.z0),
-                    static_cast<float>(box.y1),
-                    static_cast<float>(box.z0));
+                    GetY(box.y1),
+                    GetZ(box.z0));
             }
 
             // ymax-zmax edge
@@ -1445,8 +1520,8 @@ namespace gte
                 type |= EB_YMAX_ZMAX;
                 table.Insert(EI_YMAX_ZMAX,
                     GetXInterp(root, box.y1, box.z1),
-                    static_cast<float>(box.y1),
-                    static_cast<float>(box.z1));
+                    GetY(box.y1),
+                    GetZ(box.z1));
             }
         }
 
@@ -2147,9 +2222,9 @@ namespace gte
                 {
                     int32_t root = merge->GetZeroBase(box.LY);
                     vSet.insert(Vertex{
-                        static_cast<Real>(x),
+                        GetX(x),
                         GetYInterp(x, root, box.z0),
-                        static_cast<Real>(box.z0) });
+                        GetZ(box.z0) });
                 }
             }
 
@@ -2161,8 +2236,8 @@ namespace gte
                     int32_t root = merge->GetZeroBase(box.LX);
                     vSet.insert(Vertex{
                         GetXInterp(root, y, box.z0),
-                        static_cast<Real>(y),
-                        static_cast<Real>(box.z0) });
+                        GetY(y),
+                        GetZ(box.z0) });
                 }
             }
 
@@ -2262,9 +2337,9 @@ namespace gte
                 {
                     int32_t root = merge->GetZeroBase(box.LY);
                     vSet.insert(Vertex{
-                        static_cast<Real>(x),
+                        GetX(x),
                         GetYInterp(x, root, box.z1),
-                        static_cast<Real>(box.z1) });
+                        GetZ(box.z1) });
                 }
             }
 
@@ -2276,8 +2351,8 @@ namespace gte
                     int32_t root = merge->GetZeroBase(box.LX);
                     vSet.insert(Vertex{
                         GetXInterp(root, y, box.z1),
-                        static_cast<Real>(y),
-                        static_cast<Real>(box.z1) });
+                        GetY(y),
+                        GetZ(box.z1) });
                 }
             }
 
@@ -2377,8 +2452,8 @@ namespace gte
                 {
                     int32_t root = merge->GetZeroBase(box.LZ);
                     vSet.insert(Vertex{
-                        static_cast<Real>(x),
-                        static_cast<Real>(box.y0),
+                        GetX(x),
+                        GetY(box.y0),
                         GetZInterp(x, box.y0, root) });
                 }
             }
@@ -2391,8 +2466,8 @@ namespace gte
                     int32_t root = merge->GetZeroBase(box.LX);
                     vSet.insert(Vertex{
                         GetXInterp(root, box.y0, z),
-                        static_cast<Real>(box.y0),
-                        static_cast<Real>(z) });
+                        GetY(box.y0),
+                        GetZ(z) });
                 }
             }
 
@@ -2492,8 +2567,8 @@ namespace gte
                 {
                     int32_t root = merge->GetZeroBase(box.LZ);
                     vSet.insert(Vertex{
-                        static_cast<Real>(x),
-                        static_cast<Real>(box.y1),
+                        GetX(x),
+                        GetY(box.y1),
                         GetZInterp(x, box.y1, root) });
                 }
             }
@@ -2506,8 +2581,8 @@ namespace gte
                     int32_t root = merge->GetZeroBase(box.LX);
                     vSet.insert(Vertex{
                         GetXInterp(root, box.y1, z),
-                        static_cast<Real>(box.y1),
-                        static_cast<Real>(z) });
+                        GetY(box.y1),
+                        GetZ(z) });
                 }
             }
 
@@ -2607,9 +2682,9 @@ namespace gte
                 {
                     int32_t root = merge->GetZeroBase(box.LY);
                     vSet.insert(Vertex{
-                        static_cast<Real>(box.x0),
+                        GetX(box.x0),
                         GetYInterp(box.x0, root, z),
-                        static_cast<Real>(z) });
+                        GetZ(z) });
                 }
             }
 
@@ -2620,8 +2695,8 @@ namespace gte
                 {
                     int32_t root = merge->GetZeroBase(box.LZ);
                     vSet.insert(Vertex{
-                        static_cast<Real>(box.x0),
-                        static_cast<Real>(y),
+                        GetX(box.x0),
+                        GetY(y),
                         GetZInterp(box.x0, y, root) });
                 }
             }
@@ -2722,9 +2797,9 @@ namespace gte
                 {
                     int32_t root = merge->GetZeroBase(box.LY);
                     vSet.insert(Vertex{
-                        static_cast<Real>(box.x1),
+                        GetX(box.x1),
                         GetYInterp(box.x1, root, z),
-                        static_cast<Real>(z) });
+                        GetZ(z) });
                 }
             }
 
@@ -2735,8 +2810,8 @@ namespace gte
                 {
                     int32_t root = merge->GetZeroBase(box.LZ);
                     vSet.insert(Vertex{
-                        static_cast<Real>(box.x1),
-                        static_cast<Real>(y),
+                        GetX(box.x1),
+                        GetY(y),
                         GetZInterp(box.x1, y, root) });
                 }
             }
@@ -2779,19 +2854,19 @@ namespace gte
         Vertex GetGradient(Vertex const& position) const
         {
             Vertex vzero = { (Real)0, (Real)0, (Real)0 };
-            int32_t x = static_cast<int32_t>(position[0]);
+            int32_t x = static_cast<int32_t>(position[0]) - mOrigin[0];
             if (x < 0 || x >= mTwoPowerN)
             {
                 return vzero;
             }
 
-            int32_t y = static_cast<int32_t>(position[1]);
+            int32_t y = static_cast<int32_t>(position[1]) - mOrigin[1];
             if (y < 0 || y >= mTwoPowerN)
             {
                 return vzero;
             }
 
-            int32_t z = static_cast<int32_t>(position[2]);
+            int32_t z = static_cast<int32_t>(position[2]) - mOrigin[2];
             if (z < 0 || z >= mTwoPowerN)
             {
                 return vzero;
@@ -2814,9 +2889,9 @@ namespace gte
             Real f011 = static_cast<Real>(mInputVoxels[i011]);
             Real f111 = static_cast<Real>(mInputVoxels[i111]);
 
-            Real fx = position[0] - static_cast<Real>(x);
-            Real fy = position[1] - static_cast<Real>(y);
-            Real fz = position[2] - static_cast<Real>(z);
+            Real fx = position[0] - GetX(x);
+            Real fy = position[1] - GetY(y);
+            Real fz = position[2] - GetZ(z);
             Real oneMinusX = (Real)1 - fx;
             Real oneMinusY = (Real)1 - fy;
             Real oneMinusZ = (Real)1 - fz;
@@ -2833,7 +2908,7 @@ namespace gte
 
             tmp0 = oneMinusX * (f001 - f000) + fx * (f101 - f100);
             tmp1 = oneMinusX * (f011 - f010) + fx * (f111 - f110);
-            gradient[2] = oneMinusY * tmp0 + oneMinusY * tmp1;
+            gradient[2] = oneMinusY * tmp0 + fy * tmp1;
 
             return gradient;
         }
@@ -2887,6 +2962,9 @@ namespace gte
 
         bool mFixBoundary;
 
+        // Subimage location and the number of voxels to tessellate.
+        std::array<int32_t, 3> mOrigin, mNumCells;
+
         // Trees for linear merging.
         Array2<std::shared_ptr<LinearMergeTree>> mXMerge, mYMerge, mZMerge;
 
@@ -0,0 +1,523 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2022
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 6.3.2026.10.17
+
+#pragma once
+
+#include <GTE/Mathematics/Logger.h>
+#include <GTE/Mathematics/Vector3.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <thread>
+#include <vector>
+
+// Distance queries for large batches of pairs of segments, of points and
+// triangles and of pairs of triangles in 3D. The queries
+// DCPQuery<T, Segment<N,T>, Segment<N,T>>, DCPQuery<T, Vector<N,T>,
+// Triangle<N,T>> and DCPQuery<T, Triangle3<T>, Triangle3<T>> process one
+// pair per call and return all the members of their Result structures. The
+// batch queries read the inputs from structure-of-arrays (SoA) storage, one
+// array per coordinate, and write only the outputs whose pointers are not
+// null. The kernels select among the candidate solutions with conditional
+// expressions instead of the nested if-then-else statements of the
+// single-pair queries, so the loops over the pairs can be vectorized by the
+// compiler. The pairs are partitioned among threads when numThreads > 0.
+//
+// The kernels are designed for floating-point types. The results agree with
+// those of the single-pair queries up to rounding errors; when there are
+// infinitely many pairs of closest points, a different pair might be
+// reported. The exception is segment-segment for parallel segments, where
+// DCPQuery<T, Segment<N,T>, Segment<N,T>> can return a pair of points that
+// is not closest, so its distance can be larger than the minimum. The batch
+// kernel returns the minimum in that case.
+//
+// Segment-segment: The segments are P0[i] + s * (P1[i] - P0[i]) and
+// Q0[i] + t * (Q1[i] - Q0[i]) for s and t in [0,1]. The minimum of the
+// convex quadratic squared-distance function is computed by clamping the
+// unconstrained minimizer s, computing the minimizing t for that s, and,
+// when t must be clamped, computing the minimizing s for the clamped t.
+//
+// Point-triangle: The triangle point closest to X[i] is
+// V0[i] + s * (V1[i] - V0[i]) + t * (V2[i] - V0[i]) with barycentric
+// coordinates (1-s-t,s,t). When the projection of X[i] onto the plane of
+// the triangle is inside the triangle, it is the closest point; otherwise,
+// the closest point is the closest of the closest points on the three
+// edges.
+//
+// Triangle-triangle: The triangles are separated or intersecting. When
+// separated, the closest points are attained by an edge-edge pair or by a
+// vertex-triangle pair. When intersecting, an edge of one triangle crosses
+// the other triangle or, for coplanar triangles, the edge-edge or
+// vertex-triangle distance is zero. The kernel computes the minimum over
+// the 9 edge-edge pairs, the 6 vertex-triangle pairs and the 6 edge-crossing
+// tests.
+
+namespace gte
+{
+    template <typename T>
+    class BatchDistance3
+    {
+    public:
+        // The pairs are processed in blocks. The kernels are applied to the
+        // pairs of a block and the requested outputs are written afterwards,
+        // so the kernel loops have no branches.
+        enum
+        {
+            BLOCK_SIZE = 64
+        };
+
+        // The x-, y- and z-coordinates of the points of a batch.
+        using Input = std::array<T const*, 3>;
+        using Output = std::array<T*, 3>;
+
+        // The outputs are written only for the non-null pointers.
+        struct SegmentSegmentOutput
+        {
+            SegmentSegmentOutput()
+                :
+                distance(nullptr),
+                sqrDistance(nullptr),
+                parameter{ nullptr, nullptr },
+                closest{}
+            {
+                closest[0] = { nullptr, nullptr, nullptr };
+                closest[1] = { nullptr, nullptr, nullptr };
+            }
+
+            T* distance;
+            T* sqrDistance;
+            std::array<T*, 2> parameter;
+            std::array<Output, 2> closest;
+        };
+
+        struct PointTriangleOutput
+        {
+            PointTriangleOutput()
+                :
+                distance(nullptr),
+                sqrDistance(nullptr),
+                barycentric{ nullptr, nullptr, nullptr },
+                closest{ nullptr, nullptr, nullptr }
+            {
+            }
+
+            T* distance;
+            T* sqrDistance;
+            std::array<T*, 3> barycentric;
+            Output closest;
+        };
+
+        struct TriangleTriangleOutput
+        {
+            TriangleTriangleOutput()
+                :
+                distance(nullptr),
+                sqrDistance(nullptr),
+                closest{}
+            {
+                closest[0] = { nullptr, nullptr, nullptr };
+                closest[1] = { nullptr, nullptr, nullptr };
+            }
+
+            T* distance;
+            T* sqrDistance;
+            std::array<Output, 2> closest;
+        };
+
+        // To compute in the main thread only, choose numThreads to be 0.
+        // For multithreading, choose numThreads > 0.
+        static void SegmentSegment(size_t numPairs, Input const& P0, Input const& P1,
+            Input const& Q0, Input const& Q1, SegmentSegmentOutput const& output,
+            size_t numThreads = 0)
+        {
+            Execute(numPairs, numThreads, [&](size_t imin, size_t imax)
+            {
+                std::array<T, BLOCK_SIZE> s{}, t{}, sqrDistance{};
+                for (size_t i0 = imin; i0 < imax; i0 += BLOCK_SIZE)
+                {
+                    size_t const n = std::min(static_cast<size_t>(BLOCK_SIZE), imax - i0);
+                    for (size_t k = 0; k < n; ++k)
+                    {
+                        size_t i = i0 + k;
+                        Vector3<T> p0 = Load(P0, i), q0 = Load(Q0, i);
+                        Vector3<T> D0 = Load(P1, i) - p0, D1 = Load(Q1, i) - q0;
+                        GetSegmentSegmentParameters(p0, D0, q0, D1, s[k], t[k]);
+                        Vector3<T> diff = (p0 + s[k] * D0) - (q0 + t[k] * D1);
+                        sqrDistance[k] = Dot(diff, diff);
+                    }
+
+                    StoreDistance(output.distance, output.sqrDistance, i0, n, sqrDistance);
+                    StoreScalar(output.parameter[0], i0, n, s);
+                    StoreScalar(output.parameter[1], i0, n, t);
+                    StorePoint(output.closest[0], i0, n, P0, P1, s);
+                    StorePoint(output.closest[1], i0, n, Q0, Q1, t);
+                }
+            });
+        }
+
+        static void PointTriangle(size_t numPairs, Input const& X, Input const& V0,
+            Input const& V1, Input const& V2, PointTriangleOutput const& output,
+            size_t numThreads = 0)
+        {
+            Execute(numPairs, numThreads, [&](size_t imin, size_t imax)
+            {
+                T const one = static_cast<T>(1);
+                std::array<T, BLOCK_SIZE> s{}, t{}, sqrDistance{};
+                for (size_t i0 = imin; i0 < imax; i0 += BLOCK_SIZE)
+                {
+                    size_t const n = std::min(static_cast<size_t>(BLOCK_SIZE), imax - i0);
+                    for (size_t k = 0; k < n; ++k)
+                    {
+                        size_t i = i0 + k;
+                        Vector3<T> x = Load(X, i), v0 = Load(V0, i);
+                        Vector3<T> E0 = Load(V1, i) - v0, E1 = Load(V2, i) - v0;
+                        GetPointTriangleParameters(x, v0, E0, E1, s[k], t[k]);
+                        Vector3<T> diff = x - (v0 + s[k] * E0 + t[k] * E1);
+                        sqrDistance[k] = Dot(diff, diff);
+                    }
+
+                    StoreDistance(output.distance, output.sqrDistance, i0, n, sqrDistance);
+                    if (output.barycentric[0])
+                    {
+                        for (size_t k = 0; k < n; ++k)
+                        {
+                            output.barycentric[0][i0 + k] = one - s[k] - t[k];
+                        }
+                    }
+                    StoreScalar(output.barycentric[1], i0, n, s);
+                    StoreScalar(output.barycentric[2], i0, n, t);
+                    if (output.closest[0])
+                    {
+                        for (size_t k = 0; k < n; ++k)
+                        {
+                            size_t i = i0 + k;
+                            Vector3<T> v0 = Load(V0, i);
+                            Vector3<T> closest = v0 + s[k] * (Load(V1, i) - v0)
+                                + t[k] * (Load(V2, i) - v0);
+                            for (int32_t j = 0; j < 3; ++j)
+                            {
+                                output.closest[j][i] = closest[j];
+                            }
+                        }
+                    }
+                }
+            });
+        }
+
+        static void TriangleTriangle(size_t numPairs, std::array<Input, 3> const& U,
+            std::array<Input, 3> const& V, TriangleTriangleOutput const& output,
+            size_t numThreads = 0)
+        {
+            Execute(numPairs, numThreads, [&](size_t imin, size_t imax)
+            {
+                Block block{};
+                for (size_t i0 = imin; i0 < imax; i0 += BLOCK_SIZE)
+                {
+                    size_t const n = std::min(static_cast<size_t>(BLOCK_SIZE), imax - i0);
+                    block.sqrDistance.fill(std::numeric_limits<T>::max());
+
+                    // Each candidate is processed for all pairs of the block
+                    // before the next candidate, so the loops over the pairs
+                    // are vectorizable.
+
+                    // The edge-edge pairs.
+                    for (int32_t e0 = 0; e0 < 3; ++e0)
+                    {
+                        for (int32_t e1 = 0; e1 < 3; ++e1)
+                        {
+                            for (size_t k = 0; k < n; ++k)
+                            {
+                                size_t i = i0 + k;
+                                Vector3<T> p0 = Load(U[e0], i), q0 = Load(V[e1], i);
+                                Vector3<T> D0 = Load(U[(e0 + 1) % 3], i) - p0;
+                                Vector3<T> D1 = Load(V[(e1 + 1) % 3], i) - q0;
+                                T s, t;
+                                GetSegmentSegmentParameters(p0, D0, q0, D1, s, t);
+                                Vector3<T> closest0 = p0 + s * D0;
+                                Vector3<T> closest1 = q0 + t * D1;
+                                Vector3<T> diff = closest0 - closest1;
+                                block.Update(k, Dot(diff, diff), closest0, closest1);
+                            }
+                        }
+                    }
+
+                    // The vertex-triangle pairs and the crossings of the
+                    // edges of one triangle through the other triangle.
+                    UpdateVertexTriangle<false>(U, V, i0, n, block);
+                    UpdateVertexTriangle<true>(V, U, i0, n, block);
+
+                    StoreDistance(output.distance, output.sqrDistance, i0, n, block.sqrDistance);
+                    for (int32_t c = 0; c < 2; ++c)
+                    {
+                        for (int32_t j = 0; j < 3; ++j)
+                        {
+                            StoreScalar(output.closest[c][j], i0, n, block.closest[c][j]);
+                        }
+                    }
+                }
+            });
+        }
+
+        // The single-pair kernels. The segment-segment kernel computes the
+        // parameters s and t of the closest points p0 + s * D0 and
+        // q0 + t * D1. The point-triangle kernel computes the parameters s
+        // and t of the closest point v0 + s * E0 + t * E1 to x.
+        static inline void GetSegmentSegmentParameters(Vector3<T> const& p0,
+            Vector3<T> const& D0, Vector3<T> const& q0, Vector3<T> const& D1,
+            T& s, T& t)
+        {
+            T const zero = static_cast<T>(0);
+            T const one = static_cast<T>(1);
+            Vector3<T> r = p0 - q0;
+            T a = Dot(D0, D0);
+            T b = Dot(D0, D1);
+            T c = Dot(D1, D1);
+            T d = Dot(D0, r);
+            T e = Dot(D1, r);
+            T det = a * c - b * b;
+
+            // The divisions are computed unconditionally with safe
+            // denominators so that the code has no branches.
+            T invA = (a > zero ? one : zero) / (a > zero ? a : one);
+            T invC = (c > zero ? one : zero) / (c > zero ? c : one);
+            T sInterior = (b * e - c * d) / (det > zero ? det : one);
+
+            // For nonparallel segments, clamp the unconstrained minimizer s.
+            // For parallel segments, any s on the minimum line may be used;
+            // choose s = 0.
+            s = (det > zero ? Clamp01(sInterior) : zero);
+
+            // Minimize over t for the chosen s. When the second segment is
+            // degenerate, force t = 0.
+            t = (c > zero ? (b * s + e) * invC : -one);
+
+            // When t is clamped, minimize over s for the clamped t.
+            T sForT0 = Clamp01(-d * invA);
+            T sForT1 = Clamp01((b - d) * invA);
+            s = (t < zero ? sForT0 : (t > one ? sForT1 : s));
+            t = Clamp01(t);
+        }
+
+        static inline void GetPointTriangleParameters(Vector3<T> const& x,
+            Vector3<T> const& v0, Vector3<T> const& E0, Vector3<T> const& E1,
+            T& s, T& t)
+        {
+            T const zero = static_cast<T>(0);
+            T const one = static_cast<T>(1);
+            T const two = static_cast<T>(2);
+            Vector3<T> diff = v0 - x;
+            T a00 = Dot(E0, E0);
+            T a01 = Dot(E0, E1);
+            T a11 = Dot(E1, E1);
+            T b0 = Dot(diff, E0);
+            T b1 = Dot(diff, E1);
+            T det = a00 * a11 - a01 * a01;
+
+            // The minimizer of the quadratic, which is the closest point
+            // when it is in the triangle.
+            T invDet = (det > zero ? one : zero) / (det > zero ? det : one);
+            T sInterior = (a01 * b1 - a11 * b0) * invDet;
+            T tInterior = (a01 * b0 - a00 * b1) * invDet;
+            // The bitwise operators avoid the branches of && operators.
+            bool inside = (det > zero) & (sInterior >= zero) & (tInterior >= zero)
+                & (sInterior + tInterior <= one);
+
+            // The closest points on the edges <V0,V1>, <V0,V2> and <V1,V2>.
+            // The quadratic q(s,t) = a00*s^2 + 2*a01*s*t + a11*t^2 +
+            // 2*b0*s + 2*b1*t is the squared distance minus a constant, so
+            // it is used to select the closest edge point.
+            T invA00 = (a00 > zero ? one : zero) / (a00 > zero ? a00 : one);
+            T invA11 = (a11 > zero ? one : zero) / (a11 > zero ? a11 : one);
+            T a22 = a00 - two * a01 + a11;
+            T invA22 = (a22 > zero ? one : zero) / (a22 > zero ? a22 : one);
+            T u = Clamp01(-b0 * invA00);
+            T v = Clamp01(-b1 * invA11);
+            T w = Clamp01((a00 - a01 + b0 - b1) * invA22);
+            T qu = u * (a00 * u + two * b0);
+            T qv = v * (a11 * v + two * b1);
+            T omw = one - w;
+            T qw = a00 * omw * omw + two * a01 * omw * w + a11 * w * w
+                + two * b0 * omw + two * b1 * w;
+
+            T sEdge = (qu <= qv ? u : zero);
+            T tEdge = (qu <= qv ? zero : v);
+            T qEdge = (qu <= qv ? qu : qv);
+            sEdge = (qw < qEdge ? omw : sEdge);
+            tEdge = (qw < qEdge ? w : tEdge);
+
+            s = (inside ? sInterior : sEdge);
+            t = (inside ? tInterior : tEdge);
+        }
+
+    private:
+        static inline T Clamp01(T x)
+        {
+            T const zero = static_cast<T>(0);
+            T const one = static_cast<T>(1);
+            return (x < zero ? zero : (x > one ? one : x));
+        }
+
+        static inline Vector3<T> Load(Input const& input, size_t i)
+        {
+            return Vector3<T>{ input[0][i], input[1][i], input[2][i] };
+        }
+
+        // Write the outputs for the block of n pairs starting at pair i0
+        // when the output pointers are not null.
+        static void StoreScalar(T* output, size_t i0, size_t n,
+            std::array<T, BLOCK_SIZE> const& value)
+        {
+            if (output)
+            {
+                std::copy(value.begin(), value.begin() + n, output + i0);
+            }
+        }
+
+        static void StoreDistance(T* distance, T* sqrDistance, size_t i0, size_t n,
+            std::array<T, BLOCK_SIZE> const& value)
+        {
+            StoreScalar(sqrDistance, i0, n, value);
+            if (distance)
+            {
+                for (size_t k = 0; k < n; ++k)
+                {
+                    distance[i0 + k] = std::sqrt(value[k]);
+                }
+            }
+        }
+
+        // Write the points A0[i] + s[i] * (A1[i] - A0[i]).
+        static void StorePoint(Output const& output, size_t i0, size_t n,
+            Input const& A0, Input const& A1, std::array<T, BLOCK_SIZE> const& s)
+        {
+            if (output[0])
+            {
+                for (int32_t j = 0; j < 3; ++j)
+                {
+                    for (size_t k = 0; k < n; ++k)
+                    {
+                        size_t i = i0 + k;
+                        output[j][i] = A0[j][i] + s[k] * (A1[j][i] - A0[j][i]);
+                    }
+                }
+            }
+        }
+
+        // The minimum squared distances and the closest points for a block
+        // of triangle pairs.
+        struct Block
+        {
+            inline void Update(size_t k, T candidate, Vector3<T> const& closest0,
+                Vector3<T> const& closest1)
+            {
+                bool smaller = (candidate < sqrDistance[k]);
+                sqrDistance[k] = (smaller ? candidate : sqrDistance[k]);
+                for (int32_t j = 0; j < 3; ++j)
+                {
+                    closest[0][j][k] = (smaller ? closest0[j] : closest[0][j][k]);
+                    closest[1][j][k] = (smaller ? closest1[j] : closest[1][j][k]);
+                }
+            }
+
+            std::array<T, BLOCK_SIZE> sqrDistance;
+            std::array<std::array<std::array<T, BLOCK_SIZE>, 3>, 2> closest;
+        };
+
+        // Update the block with the vertices of triangle A and triangle B
+        // and with the crossings of the edges of A through B. The closest
+        // points are swapped when A is the second triangle of the query.
+        template <bool Swap>
+        static void UpdateVertexTriangle(std::array<Input, 3> const& A,
+            std::array<Input, 3> const& B, size_t i0, size_t n, Block& block)
+        {
+            T const zero = static_cast<T>(0);
+            T const one = static_cast<T>(1);
+            // Local copies of the input pointers allow the compiler to
+            // hoist their loads out of the loops.
+            Input const B0 = B[0], B1 = B[1], B2 = B[2];
+            for (int32_t j = 0; j < 3; ++j)
+            {
+                Input const A0 = A[j], A1 = A[(j + 1) % 3];
+                for (size_t k = 0; k < n; ++k)
+                {
+                    size_t i = i0 + k;
+                    Vector3<T> a = Load(A0, i), b0 = Load(B0, i);
+                    Vector3<T> E0 = Load(B1, i) - b0, E1 = Load(B2, i) - b0;
+                    T s, t;
+                    GetPointTriangleParameters(a, b0, E0, E1, s, t);
+                    Vector3<T> closest = b0 + s * E0 + t * E1;
+                    Vector3<T> diff = a - closest;
+                    if (Swap)
+                    {
+                        block.Update(k, Dot(diff, diff), closest, a);
+                    }
+                    else
+                    {
+                        block.Update(k, Dot(diff, diff), a, closest);
+                    }
+                }
+
+                // The edge <A[j],A[j+1]> crosses the plane of B when the
+                // heights of its endpoints have opposite signs. The crossing
+                // point is a point of intersection when it is in B, in which
+                // case the distance is zero.
+                for (size_t k = 0; k < n; ++k)
+                {
+                    size_t i = i0 + k;
+                    Vector3<T> a0 = Load(A0, i), a1 = Load(A1, i);
+                    Vector3<T> b0 = Load(B0, i);
+                    Vector3<T> E0 = Load(B1, i) - b0, E1 = Load(B2, i) - b0;
+                    Vector3<T> normal = Cross(E0, E1);
+                    T h0 = Dot(normal, a0 - b0), h1 = Dot(normal, a1 - b0);
+                    T lambda = h0 / (h0 != h1 ? h0 - h1 : one);
+                    Vector3<T> X = a0 + lambda * (a1 - a0);
+
+                    // The unnormalized barycentric coordinates of X.
+                    Vector3<T> diff = b0 - X;
+                    T a00 = Dot(E0, E0), a01 = Dot(E0, E1), a11 = Dot(E1, E1);
+                    T c0 = Dot(diff, E0), c1 = Dot(diff, E1);
+                    T det = a00 * a11 - a01 * a01;
+                    T s = a01 * c1 - a11 * c0;
+                    T t = a01 * c0 - a00 * c1;
+                    T margin = std::min(std::min(s, t), det - s - t);
+                    bool intersects = (h0 * h1 <= zero) & (h0 != h1) & (det > zero) & (margin >= zero);
+                    block.Update(k, intersects ? zero : std::numeric_limits<T>::max(), X, X);
+                }
+            }
+        }
+
+        static void Execute(size_t numPairs, size_t numThreads,
+            std::function<void(size_t, size_t)> const& function)
+        {
+            numThreads = std::min(numThreads, numPairs);
+            if (numThreads > 0)
+            {
+                std::vector<std::thread> process(numThreads);
+                for (size_t t = 0; t < numThreads; ++t)
+                {
+                    size_t imin = t * numPairs / numThreads;
+                    size_t imax = (t + 1) * numPairs / numThreads;
+                    process[t] = std::thread([&function, imin, imax]()
+                    {
+                        function(imin, imax);
+                    });
+                }
+                for (size_t t = 0; t < numThreads; ++t)
+                {
+                    process[t].join();
+                }
+            }
+            else
+            {
+                function(0, numPairs);
+            }
+        }
+    };
+}
@@ -0,0 +1,711 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2022
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 6.3.2026.10.17
+
+#pragma once
+
+#include <GTE/Mathematics/Math.h>
+#include <GTE/Mathematics/Logger.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <thread>
+#include <vector>
+
+// Real-valued roots of large batches of quadratic, cubic and quartic
+// polynomials. The functions RootsPolynomial<Real>::Solve* process one
+// polynomial per call, classify the roots with exact rational arithmetic
+// when a rational type is used and return the roots in a std::map. The
+// batch solvers read the coefficients from structure-of-arrays (SoA)
+// storage, one array per power of the variable, and classify the roots with
+// floating-point tests. The cases are selected with conditional expressions
+// instead of branches, so the loops over the polynomials of a block can be
+// vectorized by the compiler. The loops that call math functions are
+// vectorized only when the compiler has vector versions of them, which for
+// GCC and Clang requires -fno-math-errno (std::sqrt), and a vector math
+// library for std::cbrt, std::acos and std::cos (cubic polynomials and the
+// resolvent cubics of quartic polynomials). The polynomials are partitioned
+// among threads when numThreads > 0.
+//
+// The polynomial i is p[0][i] + p[1][i]*t + ... + p[d][i]*t^d for degree d,
+// where p[d][i] must be nonzero. The outputs are the number of distinct
+// real-valued roots, numRoots[i], the roots root[0][i] < ... <
+// root[numRoots[i]-1][i] and their multiplicities. The unused root and
+// multiplicity slots are set to 0.
+//
+// Multiple roots are classified with tolerances relative to the magnitudes
+// of the terms of the discriminants, where the relative tolerance is
+// epsilon. The roots of a quartic are computed from two quadratic factors;
+// adjacent roots of the factors are merged into one root when the depressed
+// quartic is zero at their average up to rounding errors. The simple roots
+// are polished by Newton's method. Roots whose distance is on the order of
+// sqrt(epsilon) times their magnitude are not distinguishable from a multiple
+// root, which for T = float applies to roots that differ in the third or
+// fourth significant digit. For polynomials whose multiple roots must be
+// classified correctly regardless of rounding errors, use
+// RootsPolynomial<Real>::Solve* with a rational type.
+//
+// Quadratic: The monic polynomial is t^2 + a1*t + a0. The discriminant is
+// D = (a1/2)^2 - a0. The roots are computed by the formula that avoids
+// subtractive cancellation.
+//
+// Cubic: The depressed polynomial is x^3 + d1*x + d0 with t = x - a2/3. The
+// discriminant is -(4*d1^3 + 27*d0^2). Three simple roots are computed by
+// the trigonometric formula, one simple root by Cardano's formula, and a
+// simple root and a double root by x = 3*d0/d1 and x = -3*d0/(2*d1).
+//
+// Quartic: The depressed polynomial is x^4 + d2*x^2 + d1*x + d0 with
+// t = x - a3/4. For the largest root m of the resolvent cubic
+// m^3 + d2*m^2 + (d2^2/4 - d0)*m - d1^2/8, which is positive when d1 is not
+// zero, the polynomial factors into x^2 - w*x + d2/2 + m + d1/(2*w) and
+// x^2 + w*x + d2/2 + m - d1/(2*w) with w = sqrt(2*m). When d1 is zero, the
+// polynomial is a quadratic in x^2.
+
+namespace gte
+{
+    template <typename T>
+    class BatchRootsPolynomial
+    {
+    public:
+        // The polynomials are processed in blocks. The roots of the
+        // polynomials of a block are computed and the outputs are written
+        // afterwards, so the kernel loops have no branches.
+        enum
+        {
+            BLOCK_SIZE = 64
+        };
+
+        // The arrays of coefficients of a batch, p[k] for the power t^k.
+        using QuadraticInput = std::array<T const*, 3>;
+        using CubicInput = std::array<T const*, 4>;
+        using QuarticInput = std::array<T const*, 5>;
+
+        // The arrays numRoots and root[k] for k less than the degree must
+        // not be null. The multiplicities are written only when the
+        // pointers are not null.
+        struct Output
+        {
+            Output()
+                :
+                numRoots(nullptr),
+                root{ nullptr, nullptr, nullptr, nullptr },
+                multiplicity{ nullptr, nullptr, nullptr, nullptr }
+            {
+            }
+
+            int32_t* numRoots;
+            std::array<T*, 4> root;
+            std::array<int32_t*, 4> multiplicity;
+        };
+
+        static T GetDefaultEpsilon()
+        {
+            return static_cast<T>(16) * std::numeric_limits<T>::epsilon();
+        }
+
+        // To compute in the main thread only, choose numThreads to be 0.
+        // For multithreading, choose numThreads > 0.
+        static void SolveQuadratic(size_t numPolynomials, QuadraticInput const& p,
+            Output const& output, size_t numThreads = 0,
+            T epsilon = GetDefaultEpsilon())
+        {
+            Validate(output, 2);
+            Execute(numPolynomials, numThreads, [&](size_t imin, size_t imax)
+            {
+                QuadraticInput const P = p;
+                Block block{};
+                std::array<Array, 2> a{};
+                for (size_t i0 = imin; i0 < imax; i0 += BLOCK_SIZE)
+                {
+                    size_t const n = std::min(static_cast<size_t>(BLOCK_SIZE), imax - i0);
+                    for (size_t k = 0; k < n; ++k)
+                    {
+                        T const inv = static_cast<T>(1) / P[2][i0 + k];
+                        a[0][k] = P[0][i0 + k] * inv;
+                        a[1][k] = P[1][i0 + k] * inv;
+                    }
+                    Quadratic(n, a[0], a[1], epsilon, block.root[0], block.root[1],
+                        block.multiplicity[0], block.multiplicity[1]);
+                    block.Store(i0, n, 2, output);
+                }
+            });
+        }
+
+        static void SolveCubic(size_t numPolynomials, CubicInput const& p,
+            Output const& output, size_t numThreads = 0,
+            T epsilon = GetDefaultEpsilon())
+        {
+            Validate(output, 3);
+            Execute(numPolynomials, numThreads, [&](size_t imin, size_t imax)
+            {
+                CubicInput const P = p;
+                Block block{};
+                std::array<Array, 3> a{};
+                for (size_t i0 = imin; i0 < imax; i0 += BLOCK_SIZE)
+                {
+                    size_t const n = std::min(static_cast<size_t>(BLOCK_SIZE), imax - i0);
+                    for (size_t k = 0; k < n; ++k)
+                    {
+                        T const inv = static_cast<T>(1) / P[3][i0 + k];
+                        a[0][k] = P[0][i0 + k] * inv;
+                        a[1][k] = P[1][i0 + k] * inv;
+                        a[2][k] = P[2][i0 + k] * inv;
+                    }
+                    Cubic(n, a[0], a[1], a[2], epsilon,
+                        block.root[0], block.root[1], block.root[2],
+                        block.multiplicity[0], block.multiplicity[1], block.multiplicity[2]);
+                    block.Store(i0, n, 3, output);
+                }
+            });
+        }
+
+        static void SolveQuartic(size_t numPolynomials, QuarticInput const& p,
+            Output const& output, size_t numThreads = 0,
+            T epsilon = GetDefaultEpsilon())
+        {
+            Validate(output, 4);
+            Execute(numPolynomials, numThreads, [&](size_t imin, size_t imax)
+            {
+                QuarticInput const P = p;
+                Block block{};
+                std::array<Array, 4> a{};
+                for (size_t i0 = imin; i0 < imax; i0 += BLOCK_SIZE)
+                {
+                    size_t const n = std::min(static_cast<size_t>(BLOCK_SIZE), imax - i0);
+                    for (size_t k = 0; k < n; ++k)
+                    {
+                        T const inv = static_cast<T>(1) / P[4][i0 + k];
+                        a[0][k] = P[0][i0 + k] * inv;
+                        a[1][k] = P[1][i0 + k] * inv;
+                        a[2][k] = P[2][i0 + k] * inv;
+                        a[3][k] = P[3][i0 + k] * inv;
+                    }
+                    Quartic(n, a, epsilon, block);
+                    block.Store(i0, n, 4, output);
+                }
+            });
+        }
+
+    private:
+        // The kernels are sequences of loops over the polynomials of a
+        // block. The math functions are called in loops of their own, so
+        // the loops of arithmetic operations are vectorized even when the
+        // compiler has no vector versions of the math functions.
+        using Array = std::array<T, BLOCK_SIZE>;
+        using Multiplicity = std::array<int32_t, BLOCK_SIZE>;
+
+        struct Block
+        {
+            void Store(size_t i0, size_t n, size_t degree, Output const& output) const
+            {
+                for (size_t k = 0; k < n; ++k)
+                {
+                    int32_t numRoots = 0;
+                    for (size_t j = 0; j < degree; ++j)
+                    {
+                        numRoots += (multiplicity[j][k] > 0 ? 1 : 0);
+                    }
+                    output.numRoots[i0 + k] = numRoots;
+                }
+
+                for (size_t j = 0; j < degree; ++j)
+                {
+                    std::copy(root[j].begin(), root[j].begin() + n, output.root[j] + i0);
+                    if (output.multiplicity[j])
+                    {
+                        std::copy(multiplicity[j].begin(), multiplicity[j].begin() + n,
+                            output.multiplicity[j] + i0);
+                    }
+                }
+            }
+
+            std::array<Array, 4> root{};
+            std::array<Multiplicity, 4> multiplicity{};
+        };
+
+        static void Validate(Output const& output, size_t degree)
+        {
+            LogAssert(output.numRoots != nullptr, "The numRoots array must exist.");
+            for (size_t j = 0; j < degree; ++j)
+            {
+                LogAssert(output.root[j] != nullptr, "The root arrays must exist.");
+            }
+        }
+
+        // The roots of t^2 + a1*t + a0, sorted, with multiplicities m0 and
+        // m1. The unused slots are 0.
+        static void Quadratic(size_t n, Array const& a0, Array const& a1, T epsilon,
+            Array& r0, Array& r1, Multiplicity& m0, Multiplicity& m1)
+        {
+            T const zero = static_cast<T>(0), one = static_cast<T>(1);
+            Array h{}, discr{}, s{};
+            for (size_t k = 0; k < n; ++k)
+            {
+                h[k] = static_cast<T>(0.5) * a1[k];
+                discr[k] = h[k] * h[k] - a0[k];
+                s[k] = std::max(discr[k], zero);
+            }
+
+            for (size_t k = 0; k < n; ++k)
+            {
+                s[k] = std::sqrt(s[k]);
+            }
+
+            for (size_t k = 0; k < n; ++k)
+            {
+                T const hsqr = h[k] * h[k];
+                bool const isDouble = (std::fabs(discr[k]) <= epsilon * (hsqr + std::fabs(a0[k])));
+                bool const isSimple = (!isDouble) & (discr[k] > zero);
+
+                // When the roots are simple, |q| >= sqrt(discr) > 0.
+                T const q = -(h[k] + (h[k] >= zero ? s[k] : -s[k]));
+                T const ra = q, rb = a0[k] / (q != zero ? q : one);
+                r0[k] = (isDouble ? -h[k] : (isSimple ? std::min(ra, rb) : zero));
+                r1[k] = (isSimple ? std::max(ra, rb) : zero);
+                m0[k] = (isDouble ? 2 : (isSimple ? 1 : 0));
+                m1[k] = (isSimple ? 1 : 0);
+            }
+        }
+
+        // The depressed polynomial x^3 + d1*x + d0 of t^3 + a2*t^2 + a1*t
+        // + a0 with t = x - shift. The type of the roots is 0 (one simple
+        // root), 1 (three simple roots), 2 (a simple root and a double root)
+        // or 3 (a triple root). The type is stored as T and the cases are
+        // selected with T values only, so the loops are vectorized. Three
+        // simple roots (d1 < 0) are x = mult*cos(angle+2*pi*j/3) with
+        // cos(3*angle) = cs, and one simple root is x = u - d1/(3*u), where
+        // u^3 is the term of larger magnitude, which is not zero unless
+        // d0 = d1 = 0.
+        struct DepressedCubic
+        {
+            Array shift{}, d1{}, d0{}, type{}, mult{}, cs{}, u{};
+        };
+
+        static void Depress(size_t n, Array const& a0, Array const& a1, Array const& a2,
+            T epsilon, DepressedCubic& c)
+        {
+            T const zero = static_cast<T>(0), one = static_cast<T>(1);
+            T const two = static_cast<T>(2), three = static_cast<T>(3);
+            T const four = static_cast<T>(4), half = static_cast<T>(0.5);
+            Array b{};
+            for (size_t k = 0; k < n; ++k)
+            {
+                // Discard the rounding errors of the coefficients.
+                c.shift[k] = a2[k] / three;
+                T const scale1 = std::fabs(a1[k]) + std::fabs(a2[k] * c.shift[k]);
+                T const scale0 = std::fabs(a0[k]) + std::fabs(c.shift[k]) *
+                    (std::fabs(a1[k]) + two * c.shift[k] * c.shift[k]);
+                T e1 = a1[k] - a2[k] * c.shift[k];
+                T e0 = a0[k] - c.shift[k] * (a1[k] - two * c.shift[k] * c.shift[k]);
+                e1 = (std::fabs(e1) <= epsilon * scale1 ? zero : e1);
+                e0 = (std::fabs(e0) <= epsilon * scale0 ? zero : e0);
+
+                // The tolerance for the discriminant includes the rounding
+                // errors of d1 and d0, which are relative to scale1 and
+                // scale0.
+                T const e1cube = e1 * e1 * e1;
+                T const e0sqr27 = static_cast<T>(27) * e0 * e0;
+                T const discr = -(four * e1cube + e0sqr27);
+                T const discrScale = four * std::fabs(e1cube) + e0sqr27 +
+                    static_cast<T>(12) * e1 * e1 * scale1 + static_cast<T>(54) * std::fabs(e0) * scale0;
+                T const t0 = (discr > zero ? one : zero);
+                T const t1 = (std::fabs(discr) <= epsilon * discrScale ? two : t0);
+                T const t2 = (e1 == zero ? three : t1);
+                c.type[k] = (e0 == zero ? t2 : t1);
+
+                T const halfE0 = half * e0;
+                c.d1[k] = e1;
+                c.d0[k] = e0;
+                c.mult[k] = std::max(-e1 / three, zero);
+                b[k] = std::max(halfE0 * halfE0 + e1cube / static_cast<T>(27), zero);
+            }
+
+            for (size_t k = 0; k < n; ++k)
+            {
+                c.mult[k] = two * std::sqrt(c.mult[k]);
+                b[k] = std::sqrt(b[k]);
+            }
+
+            for (size_t k = 0; k < n; ++k)
+            {
+                T const denom = c.d1[k] * c.mult[k];
+                c.cs[k] = std::min(std::max(three * c.d0[k] / (denom != zero ? denom : one), -one), one);
+                T const halfD0 = half * c.d0[k];
+                c.u[k] = -halfD0 + (halfD0 <= zero ? b[k] : -b[k]);
+            }
+        }
+
+        // The roots of t^3 + a2*t^2 + a1*t + a0, sorted, with
+        // multiplicities m0, m1 and m2. The unused slots are 0.
+        static void Cubic(size_t n, Array const& a0, Array const& a1, Array const& a2,
+            T epsilon, Array& r0, Array& r1, Array& r2,
+            Multiplicity& m0, Multiplicity& m1, Multiplicity& m2)
+        {
+            T const zero = static_cast<T>(0), one = static_cast<T>(1);
+            T const two = static_cast<T>(2), three = static_cast<T>(3);
+            T const half = static_cast<T>(0.5);
+            DepressedCubic c{};
+            Depress(n, a0, a1, a2, epsilon, c);
+
+            Array x0{}, x1{}, x2{};
+            T const twoPiThirds = static_cast<T>(GTE_C_TWO_PI) / three;
+            for (size_t k = 0; k < n; ++k)
+            {
+                T const angle = std::acos(c.cs[k]) / three;
+                x0[k] = std::cos(angle + twoPiThirds);
+                x1[k] = std::cos(angle - twoPiThirds);
+                x2[k] = std::cos(angle);
+                c.u[k] = std::cbrt(c.u[k]);
+            }
+
+            std::array<Array, 3> root{}, multiplicity{};
+            for (size_t k = 0; k < n; ++k)
+            {
+                T const type = c.type[k], mult = c.mult[k], u = c.u[k];
+                T const x = u - c.d1[k] / (three * (u != zero ? u : one));
+
+                // A simple root and a double root, where d1 != 0.
+                T const ratio = three * c.d0[k] / (c.d1[k] != zero ? c.d1[k] : one);
+                T const xSimple = ratio, xDouble = -half * ratio;
+                T const xMin = std::min(xSimple, xDouble), xMax = std::max(xSimple, xDouble);
+                T const kMin = (xSimple < xDouble ? one : two), kMax = three - kMin;
+
+                T s0 = (type == one ? mult * x0[k] : x);
+                s0 = (type == two ? xMin : s0);
+                s0 = (type == three ? zero : s0);
+                T s1 = (type == one ? mult * x1[k] : zero);
+                s1 = (type == two ? xMax : s1);
+                T const s2 = (type == one ? mult * x2[k] : zero);
+                T k0 = (type == two ? kMin : one);
+                k0 = (type == three ? three : k0);
+                T k1 = (type == one ? one : zero);
+                k1 = (type == two ? kMax : k1);
+                T const k2 = (type == one ? one : zero);
+
+                T const shift = c.shift[k];
+                T const t0 = s0 - shift, t1 = s1 - shift, t2 = s2 - shift;
+                T const p0 = PolishCubic(t0, a0[k], a1[k], a2[k]);
+                T const p1 = PolishCubic(t1, a0[k], a1[k], a2[k]);
+                T const p2 = PolishCubic(t2, a0[k], a1[k], a2[k]);
+                T const q1 = (k1 > zero ? t1 : zero);
+                root[0][k] = (k0 == one ? p0 : t0);
+                root[1][k] = (k1 == one ? p1 : q1);
+                root[2][k] = (k2 == one ? p2 : zero);
+                multiplicity[0][k] = k0;
+                multiplicity[1][k] = k1;
+                multiplicity[2][k] = k2;
+            }
+
+            // The outputs are written by separate loops, so the compiler
+            // does not have to test whether the output arrays overlap.
+            Copy(n, root[0], multiplicity[0], r0, m0);
+            Copy(n, root[1], multiplicity[1], r1, m1);
+            Copy(n, root[2], multiplicity[2], r2, m2);
+        }
+
+        // The largest root of t^3 + a2*t^2 + a1*t + a0, which is the same
+        // as the last root computed by Cubic. Only one cosine is needed for
+        // three simple roots, which halves the cost of the math functions.
+        static void LargestCubicRoot(size_t n, Array const& a0, Array const& a1,
+            Array const& a2, T epsilon, Array& r)
+        {
+            T const zero = static_cast<T>(0), one = static_cast<T>(1);
+            T const two = static_cast<T>(2), three = static_cast<T>(3);
+            T const half = static_cast<T>(0.5);
+            DepressedCubic c{};
+            Depress(n, a0, a1, a2, epsilon, c);
+
+            Array x2{};
+            for (size_t k = 0; k < n; ++k)
+            {
+                x2[k] = std::cos(std::acos(c.cs[k]) / three);
+                c.u[k] = std::cbrt(c.u[k]);
+            }
+
+            for (size_t k = 0; k < n; ++k)
+            {
+                T const type = c.type[k], u = c.u[k];
+                T const x = u - c.d1[k] / (three * (u != zero ? u : one));
+                T const ratio = three * c.d0[k] / (c.d1[k] != zero ? c.d1[k] : one);
+                T const xMax = std::max(ratio, -half * ratio);
+                T s = (type == one ? c.mult[k] * x2[k] : x);
+                s = (type == two ? xMax : s);
+                s = (type == three ? zero : s);
+                T const t = s - c.shift[k];
+                T const p = PolishCubic(t, a0[k], a1[k], a2[k]);
+                T const isSimple = (type < two ? one : zero);
+                r[k] = (isSimple == one ? p : t);
+            }
+        }
+
+        // The roots of t^4 + a[3]*t^3 + a[2]*t^2 + a[1]*t + a[0], sorted,
+        // with multiplicities, are stored in the block. The unused slots
+        // are 0.
+        static void Quartic(size_t n, std::array<Array, 4> const& a, T epsilon, Block& block)
+        {
+            T const zero = static_cast<T>(0), one = static_cast<T>(1);
+            T const two = static_cast<T>(2), half = static_cast<T>(0.5);
+            T const three = static_cast<T>(3), four = static_cast<T>(4);
+            T const six = static_cast<T>(6);
+
+            // Depress the polynomial and discard the rounding errors of
+            // the coefficients. The coefficients of the resolvent cubic are
+            // e0, e1 and e2.
+            Array shift{}, d2{}, d1{}, d0{}, scale2{}, scale1{}, scale0{}, e0{}, e1{};
+            for (size_t k = 0; k < n; ++k)
+            {
+                shift[k] = static_cast<T>(0.25) * a[3][k];
+                T const sqrShift = shift[k] * shift[k];
+                T const absShift = std::fabs(shift[k]);
+                T f2 = a[2][k] - six * sqrShift;
+                T f1 = a[1][k] - two * shift[k] * (a[2][k] - four * sqrShift);
+                T f0 = a[0][k] - shift[k] * (a[1][k] - shift[k] * (a[2][k] - three * sqrShift));
+                scale2[k] = std::fabs(a[2][k]) + six * sqrShift;
+                scale1[k] = std::fabs(a[1][k]) + two * absShift * (std::fabs(a[2][k]) + four * sqrShift);
+                scale0[k] = std::fabs(a[0][k]) + absShift * (std::fabs(a[1][k]) +
+                    absShift * (std::fabs(a[2][k]) + three * sqrShift));
+                f2 = (std::fabs(f2) <= epsilon * scale2[k] ? zero : f2);
+                f1 = (std::fabs(f1) <= epsilon * scale1[k] ? zero : f1);
+                f0 = (std::fabs(f0) <= epsilon * scale0[k] ? zero : f0);
+                d2[k] = f2;
+                d1[k] = f1;
+                d0[k] = f0;
+                e0[k] = static_cast<T>(-0.125) * f1 * f1;
+                e1[k] = static_cast<T>(0.25) * f2 * f2 - f0;
+            }
+
+            // The largest root m of the resolvent cubic.
+            Array m{}, w{};
+            LargestCubicRoot(n, e0, e1, d2, epsilon, m);
+            for (size_t k = 0; k < n; ++k)
+            {
+                w[k] = std::max(two * m[k], zero);
+            }
+
+            for (size_t k = 0; k < n; ++k)
+            {
+                w[k] = std::sqrt(w[k]);
+            }
+
+            // The quadratic factors x^2 + g1*x + g0 and x^2 + h1*x + h0 when
+            // d1 != 0.
+            Array g0{}, g1{}, h0{}, h1{};
+            for (size_t k = 0; k < n; ++k)
+            {
+                T const d1Over2w = d1[k] / (two * (w[k] > zero ? w[k] : one));
+                T const base = half * d2[k] + m[k];
+                g0[k] = base + d1Over2w;
+                g1[k] = -w[k];
+                h0[k] = base - d1Over2w;
+                h1[k] = w[k];
+            }
+
+            std::array<Array, 4> x{};
+            std::array<Multiplicity, 4> mx{};
+            Quadratic(n, g0, g1, epsilon, x[0], x[1], mx[0], mx[1]);
+            Quadratic(n, h0, h1, epsilon, x[2], x[3], mx[2], mx[3]);
+
+            // The roots y of y^2 + d2*y + d0 = 0 when d1 = 0, where
+            // x = -sqrt(y) and x = sqrt(y) for y > 0 and x = 0 for y = 0,
+            // in which case the multiplicity of x = 0 is twice that of y.
+            Array y0{}, y1{}, sqrtY0{}, sqrtY1{};
+            Multiplicity j0{}, j1{};
+            Quadratic(n, d0, d2, epsilon, y0, y1, j0, j1);
+            for (size_t k = 0; k < n; ++k)
+            {
+                sqrtY0[k] = std::sqrt(std::max(y0[k], zero));
+                sqrtY1[k] = std::sqrt(std::max(y1[k], zero));
+            }
+
+            T const unused = std::numeric_limits<T>::max();
+            std::array<Array, 4> root{}, multiplicity{};
+            for (size_t k = 0; k < n; ++k)
+            {
+                T isBiquadratic = (m[k] <= zero ? one : zero);
+                isBiquadratic = (d1[k] == zero ? one : isBiquadratic);
+                T const n0 = static_cast<T>(j0[k]), n1 = static_cast<T>(j1[k]);
+                T q0 = (y0[k] == zero ? two * n0 : zero);
+                q0 = (y0[k] > zero ? n0 : q0);
+                T q1 = (y1[k] == zero ? two * n1 : zero);
+                q1 = (y1[k] > zero ? n1 : q1);
+                T const p0 = (y0[k] > zero ? q0 : zero);
+                T const p1 = (y1[k] > zero ? q1 : zero);
+                T x0 = (isBiquadratic == one ? -sqrtY0[k] : x[0][k]);
+                T x1 = (isBiquadratic == one ? sqrtY0[k] : x[1][k]);
+                T x2 = (isBiquadratic == one ? -sqrtY1[k] : x[2][k]);
+                T x3 = (isBiquadratic == one ? sqrtY1[k] : x[3][k]);
+
+                // The multiplicities are selected by blending with the 0-or-1
+                // value isBiquadratic, which is exact for small integers. A
+                // selection would be compiled to a branch that prevents the
+                // vectorization of the loop.
+                T const c0 = static_cast<T>(mx[0][k]), c1 = static_cast<T>(mx[1][k]);
+                T const c2 = static_cast<T>(mx[2][k]), c3 = static_cast<T>(mx[3][k]);
+                T k0 = c0 + isBiquadratic * (q0 - c0);
+                T k1 = c1 + isBiquadratic * (p0 - c1);
+                T k2 = c2 + isBiquadratic * (q1 - c2);
+                T k3 = c3 + isBiquadratic * (p1 - c3);
+
+                // Sort the roots with a sorting network, where the unused
+                // slots are moved to the end.
+                x0 = (k0 > zero ? x0 : unused);
+                x1 = (k1 > zero ? x1 : unused);
+                x2 = (k2 > zero ? x2 : unused);
+                x3 = (k3 > zero ? x3 : unused);
+                Sort(x0, k0, x1, k1);
+                Sort(x2, k2, x3, k3);
+                Sort(x0, k0, x2, k2);
+                Sort(x1, k1, x3, k3);
+                Sort(x1, k1, x2, k2);
+
+                // Merge adjacent roots of the two factors that are a single
+                // root up to rounding errors. The merged roots are moved to
+                // the end.
+                std::array<T, 3> const d{ d0[k], d1[k], d2[k] };
+                std::array<T, 3> const scale{ scale0[k], scale1[k], scale2[k] };
+                Merge(x2, k2, x3, k3, d, scale, epsilon, unused);
+                Merge(x1, k1, x2, k2, d, scale, epsilon, unused);
+                Merge(x0, k0, x1, k1, d, scale, epsilon, unused);
+                Sort(x1, k1, x2, k2);
+                Sort(x2, k2, x3, k3);
+                Sort(x1, k1, x2, k2);
+
+                T const a0 = a[0][k], a1 = a[1][k], a2 = a[2][k], a3 = a[3][k];
+                x0 -= shift[k];
+                x1 -= shift[k];
+                x2 -= shift[k];
+                x3 -= shift[k];
+                T const r0 = PolishQuartic(x0, a0, a1, a2, a3);
+                T const r1 = PolishQuartic(x1, a0, a1, a2, a3);
+                T const r2 = PolishQuartic(x2, a0, a1, a2, a3);
+                T const r3 = PolishQuartic(x3, a0, a1, a2, a3);
+                x0 = (k0 > zero ? x0 : zero);
+                root[0][k] = (k0 == one ? r0 : x0);
+                x1 = (k1 > zero ? x1 : zero);
+                root[1][k] = (k1 == one ? r1 : x1);
+                x2 = (k2 > zero ? x2 : zero);
+                root[2][k] = (k2 == one ? r2 : x2);
+                x3 = (k3 > zero ? x3 : zero);
+                root[3][k] = (k3 == one ? r3 : x3);
+                multiplicity[0][k] = k0;
+                multiplicity[1][k] = k1;
+                multiplicity[2][k] = k2;
+                multiplicity[3][k] = k3;
+            }
+
+            for (size_t j = 0; j < 4; ++j)
+            {
+                Copy(n, root[j], multiplicity[j], block.root[j], block.multiplicity[j]);
+            }
+        }
+
+        static void Copy(size_t n, Array const& inRoot, Array const& inMultiplicity,
+            Array& root, Multiplicity& multiplicity)
+        {
+            for (size_t k = 0; k < n; ++k)
+            {
+                root[k] = inRoot[k];
+                multiplicity[k] = static_cast<int32_t>(inMultiplicity[k]);
+            }
+        }
+
+        // The multiplicities of the quartic roots are stored as T, so the
+        // selections are made with T values only and the loop that calls
+        // Sort and Merge is vectorized.
+        static inline void Sort(T& x0, T& k0, T& x1, T& k1)
+        {
+            T const xmin = std::min(x0, x1), xmax = std::max(x0, x1);
+            T const kmin = (x1 < x0 ? k1 : k0), kmax = (x1 < x0 ? k0 : k1);
+            x0 = xmin;
+            x1 = xmax;
+            k0 = kmin;
+            k1 = kmax;
+        }
+
+        // Merge the root x1 into x0 when both are used and the depressed
+        // quartic x^4 + d[2]*x^2 + d[1]*x + d[0] is zero at their average
+        // up to rounding errors, in which case the average is a multiple
+        // root. Distinct roots x0 < x1 have a nonzero value at the average
+        // that is proportional to (x1-x0)^2.
+        static inline void Merge(T& x0, T& k0, T& x1, T& k1,
+            std::array<T, 3> const& d, std::array<T, 3> const& scale,
+            T epsilon, T unused)
+        {
+            T const zero = static_cast<T>(0);
+            T const x = static_cast<T>(0.5) * (x0 + (k1 > zero ? x1 : x0));
+            T const absX = std::fabs(x);
+            T const value = ((x * x + d[2]) * x + d[1]) * x + d[0];
+            T const bound = ((absX * absX + scale[2]) * absX + scale[1]) * absX + scale[0];
+            T const isZero = (std::fabs(value) <= epsilon * bound ? k1 : zero);
+            T const merged = (k0 > zero ? isZero : zero);
+            x0 = (merged > zero ? x : x0);
+            k0 = k0 + merged;
+            k1 = k1 - merged;
+            x1 = (merged > zero ? unused : x1);
+        }
+
+        // Newton's method for the simple roots. Two iterations suffice
+        // for the accuracy of the closed-form roots.
+        static inline T PolishCubic(T t, T a0, T a1, T a2)
+        {
+            T const two = static_cast<T>(2), three = static_cast<T>(3);
+            T const zero = static_cast<T>(0), one = static_cast<T>(1);
+            for (int32_t iteration = 0; iteration < 2; ++iteration)
+            {
+                T const f = ((t + a2) * t + a1) * t + a0;
+                T const df = (three * t + two * a2) * t + a1;
+                T const step = f / (df != zero ? df : one);
+                t = (df != zero ? t - step : t);
+            }
+            return t;
+        }
+
+        static inline T PolishQuartic(T t, T a0, T a1, T a2, T a3)
+        {
+            T const two = static_cast<T>(2), three = static_cast<T>(3);
+            T const four = static_cast<T>(4), zero = static_cast<T>(0);
+            T const one = static_cast<T>(1);
+            for (int32_t iteration = 0; iteration < 2; ++iteration)
+            {
+                T const f = (((t + a3) * t + a2) * t + a1) * t + a0;
+                T const df = ((four * t + three * a3) * t + two * a2) * t + a1;
+                T const step = f / (df != zero ? df : one);
+                t = (df != zero ? t - step : t);
+            }
+            return t;
+        }
+
+        static void Execute(size_t numPolynomials, size_t numThreads,
+            std::function<void(size_t, size_t)> const& function)
+        {
+            numThreads = std::min(numThreads, numPolynomials);
+            if (numThreads > 0)
+            {
+                std::vector<std::thread> process(numThreads);
+                for (size_t t = 0; t < numThreads; ++t)
+                {
+                    size_t imin = t * numPolynomials / numThreads;
+                    size_t imax = (t + 1) * numPolynomials / numThreads;
+                    process[t] = std::thread([&function, imin, imax]()
+                    {
+                        function(imin, imax);
+                    });
+                }
+                for (size_t t = 0; t < numThreads; ++t)
+                {
+                    process[t].join();
+                }
+            }
+            else
+            {
+                function(0, numPolynomials);
+            }
+        }
+    };
+}
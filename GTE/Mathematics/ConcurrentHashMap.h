@@ -0,0 +1,359 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2022
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 6.3.2026.10.17
+
+#pragma once
+
+#include <GTE/Mathematics/Logger.h>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// A hash map for concurrent access by many threads, for example a cache
+// shared by worker threads. The elements are partitioned into shards by
+// their hash values. Each shard is a std::unordered_map with a
+// reader-writer lock, so threads that access different shards do not
+// contend and threads that read the same shard do not block each other.
+//
+// The operations on single elements lock one shard. Bulk insertion locks
+// each shard once. Snapshot, ForEach and GatherAll lock all the shards for
+// reading, so they see a consistent state of the map: each insertion or
+// removal by another thread is either completely visible or not visible.
+// GetNumElements and HasElements lock the shards one at a time, so their
+// results are exact only when no other thread modifies the map.
+
+namespace gte
+{
+    template <typename Key, typename Value, typename Hash = std::hash<Key>,
+        typename KeyEqual = std::equal_to<Key>>
+    class ConcurrentHashMap
+    {
+    public:
+        enum
+        {
+            DEFAULT_NUM_SHARDS = 64
+        };
+
+        // Construction and destruction. The number of shards is rounded up
+        // to a power of two. More shards reduce contention at the cost of
+        // memory and of the locking by the operations on all elements.
+        ConcurrentHashMap(size_t numShards = DEFAULT_NUM_SHARDS)
+            :
+            mLogNumShards(0),
+            mShards{},
+            mHash{}
+        {
+            LogAssert(numShards > 0, "The map must have shards.");
+            while ((static_cast<size_t>(1) << mLogNumShards) < numShards)
+            {
+                ++mLogNumShards;
+            }
+            mShards.reset(new Shard[GetNumShards()]);
+        }
+
+        virtual ~ConcurrentHashMap() = default;
+
+        // Disallow copying and moving. Use Snapshot to copy the elements.
+        ConcurrentHashMap(ConcurrentHashMap const&) = delete;
+        ConcurrentHashMap& operator=(ConcurrentHashMap const&) = delete;
+        ConcurrentHashMap(ConcurrentHashMap&&) = delete;
+        ConcurrentHashMap& operator=(ConcurrentHashMap&&) = delete;
+
+        inline size_t GetNumShards() const
+        {
+            return static_cast<size_t>(1) << mLogNumShards;
+        }
+
+        // All the operations are thread-safe.
+        bool HasElements() const
+        {
+            for (size_t i = 0; i < GetNumShards(); ++i)
+            {
+                std::shared_lock<std::shared_timed_mutex> lock(mShards[i].mutex);
+                if (mShards[i].map.size() > 0)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        size_t GetNumElements() const
+        {
+            size_t numElements = 0;
+            for (size_t i = 0; i < GetNumShards(); ++i)
+            {
+                std::shared_lock<std::shared_timed_mutex> lock(mShards[i].mutex);
+                numElements += mShards[i].map.size();
+            }
+            return numElements;
+        }
+
+        bool Exists(Key const& key) const
+        {
+            Shard const& shard = GetShard(key);
+            std::shared_lock<std::shared_timed_mutex> lock(shard.mutex);
+            return shard.map.find(key) != shard.map.end();
+        }
+
+        bool Get(Key const& key, Value& value) const
+        {
+            Shard const& shard = GetShard(key);
+            std::shared_lock<std::shared_timed_mutex> lock(shard.mutex);
+            auto iter = shard.map.find(key);
+            if (iter != shard.map.end())
+            {
+                value = iter->second;
+                return true;
+            }
+            return false;
+        }
+
+        // Insert the element or replace the value of an existing element.
+        void Insert(Key const& key, Value const& value)
+        {
+            Shard& shard = GetShard(key);
+            std::lock_guard<std::shared_timed_mutex> lock(shard.mutex);
+            shard.map[key] = value;
+        }
+
+        void Insert(Key const& key, Value&& value)
+        {
+            Shard& shard = GetShard(key);
+            std::lock_guard<std::shared_timed_mutex> lock(shard.mutex);
+            shard.map[key] = std::move(value);
+        }
+
+        // Insert the (key, value) pairs of [begin, end), replacing the
+        // values of existing elements. When a key occurs multiple times in
+        // the range, its last value is stored. The pairs are grouped by
+        // shard, so each shard is locked once.
+        template <typename Iterator>
+        void InsertRange(Iterator begin, Iterator end)
+        {
+            size_t const numShards = GetNumShards();
+            size_t const numPairs = static_cast<size_t>(std::distance(begin, end));
+            if (numPairs == 0)
+            {
+                return;
+            }
+
+            // Sort the pairs by shard (a counting sort that preserves the
+            // order of the pairs of a shard).
+            std::vector<Iterator> pairs(numPairs);
+            std::vector<size_t> shardIndices(numPairs);
+            std::vector<size_t> offsets(numShards + 1, 0);
+            size_t p = 0;
+            for (Iterator iter = begin; iter != end; ++iter, ++p)
+            {
+                shardIndices[p] = GetShardIndex(iter->first);
+                ++offsets[shardIndices[p] + 1];
+            }
+            for (size_t i = 0; i < numShards; ++i)
+            {
+                offsets[i + 1] += offsets[i];
+            }
+            std::vector<size_t> current(offsets.begin(), offsets.end() - 1);
+            p = 0;
+            for (Iterator iter = begin; iter != end; ++iter, ++p)
+            {
+                pairs[current[shardIndices[p]]++] = iter;
+            }
+
+            for (size_t i = 0; i < numShards; ++i)
+            {
+                if (offsets[i] < offsets[i + 1])
+                {
+                    Shard& shard = mShards[i];
+                    std::lock_guard<std::shared_timed_mutex> lock(shard.mutex);
+                    for (size_t j = offsets[i]; j < offsets[i + 1]; ++j)
+                    {
+                        shard.map[pairs[j]->first] = pairs[j]->second;
+                    }
+                }
+            }
+        }
+
+        // Return the value of the element with the key. If the element does
+        // not exist, it is inserted with the value create(). The function
+        // is called at most once while the shard is locked, so each key
+        // is created only once even when threads request it concurrently.
+        // The function must not access the map.
+        template <typename Create>
+        Value GetOrInsert(Key const& key, Create create)
+        {
+            Shard& shard = GetShard(key);
+            {
+                std::shared_lock<std::shared_timed_mutex> lock(shard.mutex);
+                auto iter = shard.map.find(key);
+                if (iter != shard.map.end())
+                {
+                    return iter->second;
+                }
+            }
+
+            std::lock_guard<std::shared_timed_mutex> lock(shard.mutex);
+            auto iter = shard.map.find(key);
+            if (iter == shard.map.end())
+            {
+                iter = shard.map.emplace(key, create()).first;
+            }
+            return iter->second;
+        }
+
+        bool Remove(Key const& key, Value& value)
+        {
+            Shard& shard = GetShard(key);
+            std::lock_guard<std::shared_timed_mutex> lock(shard.mutex);
+            auto iter = shard.map.find(key);
+            if (iter != shard.map.end())
+            {
+                value = std::move(iter->second);
+                shard.map.erase(iter);
+                return true;
+            }
+            return false;
+        }
+
+        bool Remove(Key const& key)
+        {
+            Shard& shard = GetShard(key);
+            std::lock_guard<std::shared_timed_mutex> lock(shard.mutex);
+            return shard.map.erase(key) > 0;
+        }
+
+        void RemoveAll()
+        {
+            for (size_t i = 0; i < GetNumShards(); ++i)
+            {
+                std::lock_guard<std::shared_timed_mutex> lock(mShards[i].mutex);
+                mShards[i].map.clear();
+            }
+        }
+
+        // Call visitor(key, value) for each element of a consistent state
+        // of the map. The order of the elements is unspecified. The visitor
+        // must not access the map, and the other threads cannot modify the
+        // map until ForEach returns.
+        template <typename Visitor>
+        void ForEach(Visitor visitor) const
+        {
+            SharedLockAll lock(*this);
+            for (size_t i = 0; i < GetNumShards(); ++i)
+            {
+                for (auto const& element : mShards[i].map)
+                {
+                    visitor(element.first, element.second);
+                }
+            }
+        }
+
+        // Copy the elements of a consistent state of the map. The order of
+        // the elements is unspecified.
+        void Snapshot(std::vector<std::pair<Key, Value>>& elements) const
+        {
+            SharedLockAll lock(*this);
+            elements.clear();
+            elements.reserve(lock.GetNumElements());
+            for (size_t i = 0; i < GetNumShards(); ++i)
+            {
+                elements.insert(elements.end(), mShards[i].map.begin(), mShards[i].map.end());
+            }
+        }
+
+        void GatherAll(std::vector<Value>& values) const
+        {
+            SharedLockAll lock(*this);
+            values.clear();
+            values.reserve(lock.GetNumElements());
+            for (size_t i = 0; i < GetNumShards(); ++i)
+            {
+                for (auto const& element : mShards[i].map)
+                {
+                    values.push_back(element.second);
+                }
+            }
+        }
+
+    private:
+        // The shards are padded to avoid false sharing of the locks.
+        struct Shard
+        {
+            mutable std::shared_timed_mutex mutex;
+            std::unordered_map<Key, Value, Hash, KeyEqual> map;
+            char padding[64];
+        };
+
+        // Lock all the shards for reading. The shards are locked in
+        // increasing order of index. The other operations lock at most one
+        // shard at a time, so there is no deadlock.
+        class SharedLockAll
+        {
+        public:
+            SharedLockAll(ConcurrentHashMap const& map)
+                :
+                mMap(map)
+            {
+                for (size_t i = 0; i < mMap.GetNumShards(); ++i)
+                {
+                    mMap.mShards[i].mutex.lock_shared();
+                }
+            }
+
+            ~SharedLockAll()
+            {
+                for (size_t i = mMap.GetNumShards(); i > 0; --i)
+                {
+                    mMap.mShards[i - 1].mutex.unlock_shared();
+                }
+            }
+
+            size_t GetNumElements() const
+            {
+                size_t numElements = 0;
+                for (size_t i = 0; i < mMap.GetNumShards(); ++i)
+                {
+                    numElements += mMap.mShards[i].map.size();
+                }
+                return numElements;
+            }
+
+        private:
+            ConcurrentHashMap const& mMap;
+        };
+
+        // The hash values are mixed by Fibonacci hashing, because many
+        // std::hash implementations are the identity for integers. The
+        // high-order bits select the shard, and std::unordered_map uses
+        // the low-order bits of the unmixed hash value.
+        inline size_t GetShardIndex(Key const& key) const
+        {
+            uint64_t const h = static_cast<uint64_t>(mHash(key)) * UINT64_C(0x9E3779B97F4A7C15);
+            return (mLogNumShards > 0 ? static_cast<size_t>(h >> (64 - mLogNumShards)) : 0);
+        }
+
+        inline Shard& GetShard(Key const& key)
+        {
+            return mShards[GetShardIndex(key)];
+        }
+
+        inline Shard const& GetShard(Key const& key) const
+        {
+            return mShards[GetShardIndex(key)];
+        }
+
+        size_t mLogNumShards;
+        std::unique_ptr<Shard[]> mShards;
+        Hash mHash;
+    };
+}
@@ -3,16 +3,19 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 6.0.2022.01.06
+// Version: 6.3.2026.10.17
 
 #pragma once
 
 #include <GTE/Mathematics/Logger.h>
-#include <GTE/Mathematics/ETManifoldMesh.h>
 #include <GTE/Mathematics/LinearSystem.h>
 #include <GTE/Mathematics/Polynomial1.h>
 #include <GTE/Mathematics/Vector2.h>
 #include <GTE/Mathematics/Vector3.h>
+#include <algorithm>
+#include <array>
+#include <thread>
+#include <utility>
 
 // Conformally map a 2-dimensional manifold mesh with the topology of a sphere
 // to a sphere.  The algorithm is an implementation of the one in the paper
@@ -22,6 +25,13 @@
 //    Volume 6, Number 2, pages 181189, 2000
 // The paper is available at https://ieeexplore.ieee.org/document/856998 but
 // is not freely downloadable.
+//
+// The Laplacian matrix of the mesh is assembled in compressed sparse row
+// format, optionally using multiple threads, and the linear systems for the
+// real and imaginary parts of the map are solved by the conjugate gradient
+// method with a Jacobi preconditioner. The two systems have the same matrix
+// but unrelated right-hand sides, so they are solved concurrently when
+// multithreading is enabled.
 
 namespace gte
 {
@@ -30,14 +40,18 @@ namespace gte
     {
     public:
         // The input mesh should be a closed, manifold surface that has the
-        // topology of a sphere (genus 0 surface).
-        ConformalMapGenus0()
+        // topology of a sphere (genus 0 surface). To run in the main thread
+        // only, choose numThreads to be 0. For multithreading, choose
+        // numThreads > 0.
+        ConformalMapGenus0(size_t numThreads = 0)
             :
+            mNumThreads(numThreads),
             mPlaneCoordinates{},
             mMinPlaneCoordinate(Vector2<Real>::Zero()),
             mMaxPlaneCoordinate(Vector2<Real>::Zero()),
             mSphereCoordinates{},
-            mSphereRadius(0.0f)
+            mSphereRadius(0.0f),
+            mSolution{}
         {
         }
 
@@ -47,75 +61,31 @@ namespace gte
 
         // The returned 'bool' value is 'true' whenever the conjugate gradient
         // algorithm converged.  Even if it did not, the results might still
-        // be acceptable.
+        // be acceptable. When 'warmStart' is 'true' and the previous call
+        // was for a mesh with the same number of positions, the solutions
+        // of the previous call are the initial guesses for the conjugate
+        // gradient algorithm. This is useful for a sequence of deformed
+        // versions of a mesh.
         bool operator()(int32_t numPositions, Vector3<Real> const* positions,
-            int32_t numTriangles, int32_t const* indices, int32_t punctureTriangle)
+            int32_t numTriangles, int32_t const* indices, int32_t punctureTriangle,
+            bool warmStart = false)
         {
+            LogAssert(numPositions >= 4 && positions != nullptr && numTriangles >= 4 &&
+                indices != nullptr && 0 <= punctureTriangle && punctureTriangle < numTriangles,
+                "Invalid argument.");
+
             bool converged = true;
             mPlaneCoordinates.resize(numPositions);
             mSphereCoordinates.resize(numPositions);
 
-            // Construct a triangle-edge representation of mesh.
-            ETManifoldMesh graph;
-            int32_t const* currentIndex = indices;
-            int32_t t;
-            for (t = 0; t < numTriangles; ++t)
-            {
-                int32_t v0 = *currentIndex++;
-                int32_t v1 = *currentIndex++;
-                int32_t v2 = *currentIndex++;
-                graph.Insert(v0, v1, v2);
-            }
-            auto const& emap = graph.GetEdges();
-
-            // Construct the nondiagonal entries of the sparse matrix A.
-            typename LinearSystem<Real>::SparseMatrix A;
-            int32_t v0, v1, v2, i;
-            Vector3<Real> E0, E1;
-            Real value;
-            for (auto const& element : emap)
-            {
-                v0 = element.first.V[0];
-                v1 = element.first.V[1];
-
-                value = (Real)0;
-                for (int32_t j = 0; j < 2; ++j)
-                {
-                    auto triangle = element.second->T[j];
-                    for (i = 0; i < 3; ++i)
-                    {
-                        v2 = triangle->V[i];
-                        if (v2 != v0 && v2 != v1)
-                        {
-                            E0 = positions[v0] - positions[v2];
-                            E1 = positions[v1] - positions[v2];
-                            value += Dot(E0, E1) / Length(Cross(E0, E1));
-                        }
-                    }
-                }
-
-                value *= -(Real)0.5;
-
-                std::array<int32_t, 2> lookup = { v0, v1 };
-                A[lookup] = value;
-            }
-
-            // Construct the diagonal entries of the sparse matrix A.
-            std::vector<Real> tmp(numPositions, (Real)0);
-            for (auto const& element : A)
-            {
-                tmp[element.first[0]] -= element.second;
-                tmp[element.first[1]] -= element.second;
-            }
-            for (i = 0; i < numPositions; ++i)
-            {
-                std::array<int32_t, 2> lookup = { i, i };
-                A[lookup] = tmp[i];
-            }
-            LogAssert(static_cast<size_t>(numPositions) + emap.size() == A.size(), "Mismatched sizes.");
+            // Construct the sparse matrix A.
+            typename LinearSystem<Real>::CSRMatrix A;
+            AssembleLaplacian(numPositions, positions, numTriangles, indices, A);
 
             // Construct the sparse column vector B.
-            currentIndex = &indices[3 * punctureTriangle];
+            int32_t const* currentIndex = &indices[3 * punctureTriangle];
+            int32_t v0, v1, v2, i, t;
+            Vector3<Real> E0, E1;
             v0 = *currentIndex++;
             v1 = *currentIndex++;
             v2 = *currentIndex++;
@@ -138,39 +108,56 @@ namespace gte
             Real re2 = (Real)0;
             Real im2 = -len10 * invLenNormal;
 
-            // Solve the sparse system for the real parts.
+            // Solve the sparse systems for the real parts and for the
+            // imaginary parts.
             uint32_t const maxIterations = 1024;
             Real const tolerance = 1e-06f;
-            std::fill(tmp.begin(), tmp.end(), (Real)0);
-            tmp[v0] = re0;
-            tmp[v1] = re1;
-            tmp[v2] = re2;
-            std::vector<Real> result(numPositions);
-            uint32_t iterations = LinearSystem<Real>().SolveSymmetricCG(
-                numPositions, A, tmp.data(), result.data(), maxIterations, tolerance);
-            if (iterations >= maxIterations)
+            bool const useInitialX = (warmStart &&
+                mSolution[0].size() == static_cast<size_t>(numPositions));
+            std::array<std::vector<Real>, 2> B;
+            for (int32_t j = 0; j < 2; ++j)
             {
-                converged = false;
+                B[j].resize(numPositions);
+                std::fill(B[j].begin(), B[j].end(), (Real)0);
+                mSolution[j].resize(numPositions);
             }
-            for (i = 0; i < numPositions; ++i)
+            B[0][v0] = re0;
+            B[0][v1] = re1;
+            B[0][v2] = re2;
+            B[1][v0] = -im0;
+            B[1][v1] = -im1;
+            B[1][v2] = -im2;
+
+            std::array<uint32_t, 2> iterations = { 0, 0 };
+            auto solve = [this, numPositions, &A, &B, tolerance, useInitialX, &iterations](int32_t j)
             {
-                mPlaneCoordinates[i][0] = result[i];
-            }
+                iterations[j] = LinearSystem<Real>::SolveSymmetricPCG(numPositions,
+                    A, B[j].data(), mSolution[j].data(), maxIterations, tolerance,
+                    useInitialX);
+            };
 
-            // Solve the sparse system for the imaginary parts.
-            std::fill(tmp.begin(), tmp.end(), (Real)0);
-            tmp[v0] = -im0;
-            tmp[v1] = -im1;
-            tmp[v2] = -im2;
-            iterations = LinearSystem<Real>().SolveSymmetricCG(numPositions, A,
-                tmp.data(), result.data(), maxIterations, tolerance);
-            if (iterations >= maxIterations)
+            if (mNumThreads > 0)
             {
-                converged = false;
+                std::thread process(solve, 1);
+                solve(0);
+                process.join();
             }
-            for (i = 0; i < numPositions; ++i)
+            else
             {
-                mPlaneCoordinates[i][1] = result[i];
+                solve(0);
+                solve(1);
+            }
+
+            for (int32_t j = 0; j < 2; ++j)
+            {
+                if (iterations[j] >= maxIterations)
+                {
+                    converged = false;
+                }
+                for (i = 0; i < numPositions; ++i)
+                {
+                    mPlaneCoordinates[i][j] = mSolution[j][i];
+                }
             }
 
             // Scale to [-1,1]^2 for numerical conditioning in later steps.
@@ -309,6 +296,153 @@ namespace gte
         }
 
     private:
+        // The nondiagonal entry of A for an edge (v0,v1) is -1/2 times the
+        // sum of the cotangents of the angles opposite the edge in its two
+        // triangles. The diagonal entries are chosen so that the row sums
+        // are zero. The cotangents are computed for triangles in parallel.
+        // The entries are then sorted by row, and the rows are sorted by
+        // column and merged in parallel.
+        void AssembleLaplacian(int32_t numPositions, Vector3<Real> const* positions,
+            int32_t numTriangles, int32_t const* indices,
+            typename LinearSystem<Real>::CSRMatrix& A)
+        {
+            std::vector<Real> weights(3 * static_cast<size_t>(numTriangles));
+            Parallel(numTriangles, [positions, indices, &weights](int32_t tmin, int32_t tmax)
+            {
+                for (int32_t t = tmin; t < tmax; ++t)
+                {
+                    int32_t const* triangle = &indices[3 * t];
+                    for (int32_t i0 = 0; i0 < 3; ++i0)
+                    {
+                        int32_t i1 = (i0 + 1) % 3, i2 = (i0 + 2) % 3;
+                        Vector3<Real> E0 = positions[triangle[i0]] - positions[triangle[i2]];
+                        Vector3<Real> E1 = positions[triangle[i1]] - positions[triangle[i2]];
+                        weights[3 * static_cast<size_t>(t) + i0] =
+                            -(Real)0.5 * Dot(E0, E1) / Length(Cross(E0, E1));
+                    }
+                }
+            });
+
+            // Each triangle edge contributes its weight to the entries
+            // (v0,v1) and (v1,v0). The entries of row r are stored in
+            // entries[start[r]] through entries[start[r+1]-1], where one
+            // extra slot per row is reserved for the diagonal entry.
+            std::vector<int32_t> start(static_cast<size_t>(numPositions) + 1, 0);
+            for (int32_t k = 0; k < 3 * numTriangles; ++k)
+            {
+                int32_t v = indices[k];
+                LogAssert(0 <= v && v < numPositions, "Invalid index.");
+                start[static_cast<size_t>(v) + 1] += 2;
+            }
+            for (int32_t r = 0; r < numPositions; ++r)
+            {
+                start[static_cast<size_t>(r) + 1] += start[r] + 1;
+            }
+
+            std::vector<std::pair<int32_t, Real>> entries(start[numPositions]);
+            std::vector<int32_t> next(start.begin(), start.end() - 1);
+            for (int32_t t = 0; t < numTriangles; ++t)
+            {
+                int32_t const* triangle = &indices[3 * t];
+                for (int32_t i0 = 0; i0 < 3; ++i0)
+                {
+                    int32_t v0 = triangle[i0], v1 = triangle[(i0 + 1) % 3];
+                    Real weight = weights[3 * static_cast<size_t>(t) + i0];
+                    entries[next[v0]++] = std::make_pair(v1, weight);
+                    entries[next[v1]++] = std::make_pair(v0, weight);
+                }
+            }
+
+            // Merge the duplicate entries of each row. In a closed manifold
+            // mesh, each edge is shared by exactly two triangles. The merged
+            // row, including the diagonal entry, is stored at the beginning
+            // of the range of the row.
+            std::vector<int32_t> rowSize(numPositions);
+            std::vector<int32_t> invalidRow(numPositions, 0);
+            Parallel(numPositions, [&start, &next, &entries, &rowSize, &invalidRow](int32_t rmin, int32_t rmax)
+            {
+                for (int32_t r = rmin; r < rmax; ++r)
+                {
+                    auto first = entries.begin() + start[r];
+                    auto last = entries.begin() + next[r];
+                    std::sort(first, last,
+                        [](std::pair<int32_t, Real> const& e0, std::pair<int32_t, Real> const& e1)
+                        {
+                            return e0.first < e1.first;
+                        });
+
+                    Real diagonal = (Real)0;
+                    int32_t size = 0;
+                    for (auto iter = first; iter != last; iter += 2)
+                    {
+                        if ((iter + 1)->first != iter->first ||
+                            (iter + 2 != last && (iter + 2)->first == iter->first))
+                        {
+                            invalidRow[r] = 1;
+                            break;
+                        }
+                        Real value = iter->second + (iter + 1)->second;
+                        first[size++] = std::make_pair(iter->first, value);
+                        diagonal -= value;
+                    }
+                    first[size++] = std::make_pair(r, diagonal);
+                    rowSize[r] = size;
+                }
+            });
+            LogAssert(std::find(invalidRow.begin(), invalidRow.end(), 1) == invalidRow.end(),
+                "The mesh must be closed and manifold.");
+
+            A.rowStart.resize(static_cast<size_t>(numPositions) + 1);
+            A.rowStart[0] = 0;
+            for (int32_t r = 0; r < numPositions; ++r)
+            {
+                A.rowStart[static_cast<size_t>(r) + 1] = A.rowStart[r] + rowSize[r];
+            }
+            A.columns.resize(A.rowStart[numPositions]);
+            A.values.resize(A.rowStart[numPositions]);
+            Parallel(numPositions, [&start, &entries, &A](int32_t rmin, int32_t rmax)
+            {
+                for (int32_t r = rmin; r < rmax; ++r)
+                {
+                    auto source = entries.begin() + start[r];
+                    for (int32_t k = A.rowStart[r]; k < A.rowStart[r + 1]; ++k, ++source)
+                    {
+                        A.columns[k] = source->first;
+                        A.values[k] = source->second;
+                    }
+                }
+            });
+        }
+
+        // Partition [0,numItems) into subranges, one per thread, and call
+        // function(imin,imax) for each subrange.
+        template <typename Function>
+        void Parallel(int32_t numItems, Function const& function) const
+        {
+            size_t const numThreads = std::min(mNumThreads, static_cast<size_t>(numItems));
+            if (numThreads > 0)
+            {
+                std::vector<std::thread> process(numThreads);
+                for (size_t i = 0; i < numThreads; ++i)
+                {
+                    int32_t imin = static_cast<int32_t>(i * numItems / numThreads);
+                    int32_t imax = static_cast<int32_t>((i + 1) * numItems / numThreads);
+                    process[i] = std::thread([&function, imin, imax]()
+                    {
+                        function(imin, imax);
+                    });
+                }
+                for (size_t i = 0; i < numThreads; ++i)
+                {
+                    process[i].join();
+                }
+            }
+            else
+            {
+                function(0, numItems);
+            }
+        }
+
         void ComputeSphereRadius(int32_t v0, int32_t v1, int32_t v2, Real areaFraction)
         {
             Vector2<Real> V0 = mPlaneCoordinates[v0];
@@ -401,6 +535,8 @@ namespace gte
             mSphereRadius = std::sqrt(tmid);
         }
 
+        size_t mNumThreads;
+
         // Conformal mapping to a plane.  The plane's (px,py) points
         // correspond to the mesh's (mx,my,mz) points.
         std::vector<Vector2<Real>> mPlaneCoordinates;
@@ -410,5 +546,10 @@ namespace gte
         // correspond to the mesh's (mx,my,mz) points.
         std::vector<Vector3<Real>> mSphereCoordinates;
         Real mSphereRadius;
+
+        // The solutions of the linear systems for the real parts and for
+        // the imaginary parts, which are the initial guesses for a warm
+        // start.
+        std::array<std::vector<Real>, 2> mSolution;
     };
 }
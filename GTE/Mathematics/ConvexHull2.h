@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 6.0.2022.03.03
+// Version: 6.3.2026.10.17
 
 #pragma once
 
@@ -12,7 +12,18 @@
 // a correct result for the input vertices is to use an exact predicate for
 // computing signs of various expressions. The implementation uses interval
 // arithmetic and rational arithmetic for the predicate.
-
+//
+// For large data sets where most of the points are strictly inside the hull,
+// the Akl-Toussaint heuristic can be enabled to discard such points before
+// the sorting. The extreme points of the input in 8 directions are computed
+// and the points strictly inside the convex polygon of the extreme points
+// are culled. The culling first uses floating-point arithmetic with a static
+// error bound (the orient2d filter of Shewchuk). When that sign is ambiguous,
+// the same interval arithmetic filter as the hull construction is used, and
+// rational arithmetic is used only when the interval sign is also ambiguous.
+// The culling, sorting and removal of duplicates can be multithreaded.
+
+#include <GTE/Mathematics/ParallelAlgorithms.h>
 #include <GTE/Mathematics/ArbitraryPrecision.h>
 #include <GTE/Mathematics/SWInterval.h>
 #include <GTE/Mathematics/Line.h>
@@ -44,6 +55,7 @@ namespace gte
             mLine(Vector2<Real>::Zero(), Vector2<Real>::Zero()),
             mRationalPoints{},
             mConverted{},
+            mRationalIndex{},
             mNumPoints(0),
             mNumUniquePoints(0),
             mPoints(nullptr)
@@ -58,7 +70,17 @@ namespace gte
         // determination is fuzzy: points approximately the same point,
         // approximately on a line, or planar.  The return value is 'true' if
         // and only if the hull construction is successful.
-        bool operator()(int32_t numPoints, Vector2<Real> const* points, Real epsilon)
+        //
+        // When cullInteriorPoints is 'true', the Akl-Toussaint heuristic is
+        // applied to discard points strictly inside the hull; see the
+        // comments at the beginning of this file. The hull is the same
+        // whether or not the culling is applied. The culling, sorting and
+        // removal of duplicates run single-threaded when lgNumThreads = 0.
+        // They run multithreaded when lgNumThreads > 0, where the number of
+        // threads is 2^{lgNumThreads} > 1. The divide-and-conquer merging is
+        // always single-threaded.
+        bool operator()(int32_t numPoints, Vector2<Real> const* points, Real epsilon,
+            bool cullInteriorPoints = false, size_t lgNumThreads = 0)
         {
             mEpsilon = std::max(epsilon, static_cast<Real>(0));
             mDimension = 0;
@@ -93,19 +115,19 @@ namespace gte
 
             mDimension = 2;
 
-            // Allocate storage for any rational points that must be
-            // computed in the exact predicate.
-            mRationalPoints.resize(mNumPoints);
-            mConverted.resize(mNumPoints);
-            std::fill(mConverted.begin(), mConverted.end(), 0u);
-
-            // Sort the points.
             mHull.resize(mNumPoints);
             for (int32_t i = 0; i < mNumPoints; ++i)
             {
                 mHull[i] = i;
             }
-            std::sort(mHull.begin(), mHull.end(),
+
+            if (cullInteriorPoints)
+            {
+                CullInteriorPoints(lgNumThreads);
+            }
+
+            // Sort the points.
+            ParallelSort(mHull.begin(), mHull.end(),
                 [points](int32_t i0, int32_t i1)
                 {
                     if (points[i0][0] < points[i1][0])
@@ -117,19 +139,34 @@ namespace gte
                         return false;
                     }
                     return points[i0][1] < points[i1][1];
-                }
+                },
+                lgNumThreads
             );
 
             // Remove duplicates.
-            auto newEnd = std::unique(mHull.begin(), mHull.end(),
+            auto newEnd = ParallelUnique(mHull.begin(), mHull.end(),
                 [points](int32_t i0, int32_t i1)
                 {
                     return points[i0] == points[i1];
-                }
+                },
+                lgNumThreads
             );
             mHull.erase(newEnd, mHull.end());
             mNumUniquePoints = static_cast<int32_t>(mHull.size());
 
+            // Allocate storage for any rational points that must be
+            // computed in the exact predicate. Only the unique points that
+            // survived the culling can occur in the predicate, so storage is
+            // allocated only for those.
+            mRationalPoints.resize(mNumUniquePoints);
+            mConverted.resize(mNumUniquePoints);
+            std::fill(mConverted.begin(), mConverted.end(), 0u);
+            mRationalIndex.resize(mNumPoints);
+            for (int32_t i = 0; i < mNumUniquePoints; ++i)
+            {
+                mRationalIndex[mHull[i]] = i;
+            }
+
             // Use a divide-and-conquer algorithm. The merge step computes
             // the convex hull of two convex polygons.
             mMerged.resize(mNumUniquePoints);
@@ -165,6 +202,9 @@ namespace gte
             return mNumPoints;
         }
 
+        // The number of unique points that were processed by the
+        // divide-and-conquer algorithm. When interior culling is enabled,
+        // this is the number of unique points that survived the culling.
         inline int32_t GetNumUniquePoints() const
         {
             return mNumUniquePoints;
@@ -346,18 +386,153 @@ namespace gte
 #endif
         }
 
+        // Support for the Akl-Toussaint heuristic. On entry, mHull stores
+        // the indices of all the input points. On exit, the indices of the
+        // points strictly inside the convex polygon of the extreme points
+        // have been removed.
+        struct CullEdge
+        {
+            // The edge has origin A and direction E = B - A, where <A,B> is
+            // a counterclockwise-ordered edge of the culling polygon.
+            Vector2<Real> A, B;
+            Interval iEx, iEy;
+            Vector2<Rational> rA, rE;
+        };
+
+        void CullInteriorPoints(size_t lgNumThreads)
+        {
+            // Compute the extreme points in the directions (1,0), (1,1),
+            // (0,1), (-1,1), (-1,0), (-1,-1), (0,-1) and (1,-1). The loop
+            // has no data-dependent branches other than the max-selects,
+            // which allows the compiler to vectorize it.
+            std::array<int32_t, 8> extreme{};
+            std::array<Real, 8> maxDot{};
+            for (int32_t i = 0; i < mNumPoints; ++i)
+            {
+                Real const x = mPoints[i][0], y = mPoints[i][1];
+                std::array<Real, 8> const dot = { x, x + y, y, y - x, -x, -x - y, -y, x - y };
+                for (size_t j = 0; j < 8; ++j)
+                {
+                    if (i == 0 || dot[j] > maxDot[j])
+                    {
+                        maxDot[j] = dot[j];
+                        extreme[j] = i;
+                    }
+                }
+            }
+
+            // The culling polygon is the convex hull of the extreme points.
+            // Its vertices are input points, so the polygon is contained in
+            // the convex hull of the input and a point strictly inside the
+            // polygon cannot be a hull vertex.
+            std::array<Vector2<Real>, 8> extremePoints{};
+            for (size_t j = 0; j < 8; ++j)
+            {
+                extremePoints[j] = mPoints[extreme[j]];
+            }
+            ConvexHull2<Real> polygonHull;
+            if (!polygonHull(8, extremePoints.data(), static_cast<Real>(0)))
+            {
+                // The extreme points are collinear, so nothing is culled.
+                return;
+            }
+
+            auto const& polygon = polygonHull.GetHull();
+            size_t const numEdges = polygon.size();
+            std::vector<CullEdge> edges(numEdges);
+            for (size_t i0 = numEdges - 1, i1 = 0; i1 < numEdges; i0 = i1++)
+            {
+                Vector2<Real> const& A = extremePoints[polygon[i0]];
+                Vector2<Real> const& B = extremePoints[polygon[i1]];
+                CullEdge& edge = edges[i0];
+                edge.A = A;
+                edge.B = B;
+                edge.iEx = Interval(B[0]) - A[0];
+                edge.iEy = Interval(B[1]) - A[1];
+                for (int32_t j = 0; j < 2; ++j)
+                {
+                    edge.rA[j] = A[j];
+                    edge.rE[j] = Rational(B[j]) - edge.rA[j];
+                }
+            }
+
+            // The error bound for the floating-point determinant is valid
+            // when no underflow occurs, so the filter is not trusted when
+            // the permanent is too small.
+            Real const u = std::numeric_limits<Real>::epsilon() / static_cast<Real>(2);
+            Real const errorScale = (static_cast<Real>(3) + static_cast<Real>(16) * u) * u;
+            Real const minPermanent = std::numeric_limits<Real>::min() / u;
+
+            auto isInterior = [this, &edges, errorScale, minPermanent](int32_t index)
+            {
+                Vector2<Real> const& P = mPoints[index];
+                for (auto const& edge : edges)
+                {
+                    // P is strictly inside the polygon when DotPerp(E,P-A)
+                    // is positive for all the edges.
+                    Real const left = (edge.A[0] - P[0]) * (edge.B[1] - P[1]);
+                    Real const right = (edge.A[1] - P[1]) * (edge.B[0] - P[0]);
+                    Real const det = left - right;
+                    Real const permanent = std::fabs(left) + std::fabs(right);
+                    if (permanent >= minPermanent)
+                    {
+                        Real const errorBound = errorScale * permanent;
+                        if (det > errorBound)
+                        {
+                            continue;
+                        }
+                        if (det < -errorBound)
+                        {
+                            return false;
+                        }
+                    }
+
+                    // The floating-point sign is ambiguous, so attempt to
+                    // classify the sign using interval arithmetic.
+                    Interval ix = Interval(P[0]) - edge.A[0];
+                    Interval iy = Interval(P[1]) - edge.A[1];
+                    Interval iDet = edge.iEx * iy - edge.iEy * ix;
+                    if (iDet[0] > static_cast<Real>(0))
+                    {
+                        continue;
+                    }
+                    if (iDet[1] <= static_cast<Real>(0))
+                    {
+                        return false;
+                    }
+
+                    // The exact sign of the determinant is not known, so
+                    // compute the determinant using rational arithmetic.
+                    // This happens rarely, so the rational point is not
+                    // memoized.
+                    Vector2<Rational> const rP{ P[0], P[1] };
+                    auto rDet = DotPerp(edge.rE, rP - edge.rA);
+                    if (rDet.GetSign() <= 0)
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            };
+
+            auto newEnd = ParallelRemoveIf(mHull.begin(), mHull.end(),
+                isInterior, lgNumThreads);
+            mHull.erase(newEnd, mHull.end());
+        }
+
         // Memoized access to the rational representation of the points.
         Vector2<Rational> const& GetRationalPoint(int32_t index) const
         {
-            if (mConverted[index] == 0)
+            int32_t slot = mRationalIndex[index];
+            if (mConverted[slot] == 0)
             {
-                mConverted[index] = 1;
+                mConverted[slot] = 1;
                 for (int32_t i = 0; i < 2; ++i)
                 {
-                    mRationalPoints[index][i] = mPoints[index][i];
+                    mRationalPoints[slot][i] = mPoints[index][i];
                 }
             }
-            return mRationalPoints[index];
+            return mRationalPoints[slot];
         }
 
         // An extended classification of the relationship of a point to a line
@@ -557,9 +732,12 @@ namespace gte
         // mConverted[i] is 0. The floating-point vector is converted to
         // a rational number, after which mConverted[1] is set to 1 to
         // avoid converting again if the floating-point vector is
-        // encountered in another predicate computation.
+        // encountered in another predicate computation. The arrays have
+        // one element per unique point. The mRationalIndex array maps an
+        // index into mPoints to the slot of the unique point.
         mutable std::vector<Vector2<Rational>> mRationalPoints;
         mutable std::vector<uint32_t> mConverted;
+        std::vector<int32_t> mRationalIndex;
 
         int32_t mNumPoints;
         int32_t mNumUniquePoints;
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 6.0.2022.01.06
+// Version: 6.3.2026.10.17
 
 #pragma once
 
@@ -30,8 +30,20 @@
 // located. This test uses interval arithmetic to determine an exact sign,
 // if possible. If that test fails, rational arithmetic is used. For typical
 // datasets, the indeterminate sign from interval arithmetic happens rarely.
+//
+// For large data sets where most of the points are strictly inside the hull,
+// the Akl-Toussaint heuristic can be enabled to discard such points before
+// the sorting. The extreme points of the input in the 26 directions (a,b,c)
+// with components in {-1,0,1} are computed and the points strictly inside
+// the convex polyhedron of the extreme points are culled. The culling first
+// uses a floating-point dot product with a face normal and a conservative
+// error bound, which costs about as much as the dot product itself. When
+// that sign is ambiguous, interval arithmetic is used and then rational
+// arithmetic when the interval sign is also ambiguous. Rational points are allocated
+// only for the unique points that survive the culling.
 
 #include <GTE/Mathematics/ConvexHull2.h>
+#include <GTE/Mathematics/ParallelAlgorithms.h>
 #include <GTE/Mathematics/SWInterval.h>
 #include <GTE/Mathematics/Vector3.h>
 #include <GTE/Mathematics/VETManifoldMesh.h>
@@ -59,6 +71,7 @@ namespace gte
             mPoints(nullptr),
             mRPoints{},
             mConverted{},
+            mRationalIndex{},
             mDimension(0),
             mVertices{},
             mHull{},
@@ -69,18 +82,24 @@ namespace gte
         // Compute the exact convex hull using a blend of interval arithmetic
         // and rational arithmetic. The code runs single-threaded when
         // lgNumThreads = 0. It runs multithreaded when lgNumThreads > 0,
-        // where the number of threads is 2^{lgNumThreads} > 1.
+        // where the number of threads is 2^{lgNumThreads} > 1. When
+        // cullInteriorPoints is 'true', the Akl-Toussaint heuristic is
+        // applied to discard points strictly inside the hull; see the
+        // comments at the beginning of this file. The culling, sorting and
+        // removal of duplicates are also multithreaded when
+        // lgNumThreads > 0.
         void operator()(size_t numPoints, Vector3<Real> const* points,
-            size_t lgNumThreads)
+            size_t lgNumThreads, bool cullInteriorPoints = false)
         {
             LogAssert(numPoints > 0 && points != nullptr, "Invalid argument.");
-
-            // Allocate storage for any rational points that must be computed
-            // in the exact sign predicates. The rational points are memoized.
             mPoints = points;
-            mRPoints.resize(numPoints);
-            mConverted.resize(numPoints);
-            std::fill(mConverted.begin(), mConverted.end(), 0);
+
+            std::vector<size_t> sorted(numPoints);
+            std::iota(sorted.begin(), sorted.end(), 0);
+            if (cullInteriorPoints)
+            {
+                CullInteriorPoints(sorted, lgNumThreads);
+            }
 
             // Sort all the points indirectly.
             auto lessThanPoints = [this](size_t s0, size_t s1)
@@ -93,12 +112,24 @@ namespace gte
                 return mPoints[s0] == mPoints[s1];
             };
 
-            std::vector<size_t> sorted(numPoints);
-            std::iota(sorted.begin(), sorted.end(), 0);
-            std::sort(sorted.begin(), sorted.end(), lessThanPoints);
-            auto newEnd = std::unique(sorted.begin(), sorted.end(), equalPoints);
+            ParallelSort(sorted.begin(), sorted.end(), lessThanPoints, lgNumThreads);
+            auto newEnd = ParallelUnique(sorted.begin(), sorted.end(), equalPoints,
+                lgNumThreads);
             sorted.erase(newEnd, sorted.end());
 
+            // Allocate storage for any rational points that must be computed
+            // in the exact sign predicates. The rational points are memoized.
+            // Only the unique points that survived the culling can occur in
+            // the predicates, so storage is allocated only for those.
+            mRPoints.resize(sorted.size());
+            mConverted.resize(sorted.size());
+            std::fill(mConverted.begin(), mConverted.end(), 0);
+            mRationalIndex.resize(numPoints);
+            for (size_t i = 0; i < sorted.size(); ++i)
+            {
+                mRationalIndex[sorted[i]] = i;
+            }
+
             if (lgNumThreads > 0)
             {
                 size_t numThreads = (static_cast<size_t>(1) << lgNumThreads);
@@ -164,9 +195,10 @@ namespace gte
             }
         }
 
-        void operator()(std::vector<Vector3<Real>> const& points, size_t lgNumThreads)
+        void operator()(std::vector<Vector3<Real>> const& points, size_t lgNumThreads,
+            bool cullInteriorPoints = false)
         {
-            operator()(points.size(), points.data(), lgNumThreads);
+            operator()(points.size(), points.data(), lgNumThreads, cullInteriorPoints);
         }
 
         // The dimension is 0 (hull is a single point), 1 (hull is a line
@@ -566,18 +598,263 @@ namespace gte
             }
         }
 
+        // Support for the Akl-Toussaint heuristic. On exit, the indices of
+        // the points strictly inside the convex polyhedron of the extreme
+        // points have been removed from 'indices'.
+        struct CullFace
+        {
+            // The face has origin V0 and outer-pointing normal
+            // N = Cross(V1-V0,V2-V0), where <V0,V1,V2> is a face of the
+            // culling polyhedron.
+            Vector3<Real> V0;
+            Vector3<SWInterval<Real>> sNormal;
+
+            // The floating-point filter uses the midpoint M of sNormal and
+            // per-component weights W for which
+            // |Dot(N,P-V0) - Dot(M,P'-V0)| <= Dot(W,|P'-V0|), where P'-V0
+            // is the floating-point difference.
+            Vector3<Real> midNormal, weight;
+            Vector3<Rational> rV0, rNormal;
+        };
+
+        void CullInteriorPoints(std::vector<size_t>& indices, size_t lgNumThreads)
+        {
+            using SInterval = SWInterval<Real>;
+            using SVector3 = Vector3<SInterval>;
+
+            // Compute the extreme points in the directions (a,b,c) with
+            // components in {-1,0,1}, excluding the zero vector. The loop
+            // has no data-dependent branches other than the max-selects,
+            // which allows the compiler to vectorize it.
+            size_t constexpr numDirections = 26;
+            std::array<Vector3<Real>, numDirections> direction{};
+            for (int32_t c = -1, j = 0; c <= 1; ++c)
+            {
+                for (int32_t b = -1; b <= 1; ++b)
+                {
+                    for (int32_t a = -1; a <= 1; ++a)
+                    {
+                        if (a != 0 || b != 0 || c != 0)
+                        {
+                            direction[j++] = { static_cast<Real>(a),
+                                static_cast<Real>(b), static_cast<Real>(c) };
+                        }
+                    }
+                }
+            }
+
+            std::array<size_t, numDirections> extreme{};
+            std::array<Real, numDirections> maxDot{};
+            for (size_t j = 0; j < numDirections; ++j)
+            {
+                maxDot[j] = Dot(direction[j], mPoints[indices[0]]);
+                extreme[j] = indices[0];
+            }
+            for (auto index : indices)
+            {
+                Vector3<Real> const& P = mPoints[index];
+                for (size_t j = 0; j < numDirections; ++j)
+                {
+                    Real dot = Dot(direction[j], P);
+                    if (dot > maxDot[j])
+                    {
+                        maxDot[j] = dot;
+                        extreme[j] = index;
+                    }
+                }
+            }
+
+            // The culling polyhedron is the convex hull of the extreme
+            // points. Its vertices are input points, so the polyhedron is
+            // contained in the convex hull of the input and a point strictly
+            // inside the polyhedron cannot be a hull vertex.
+            std::array<Vector3<Real>, numDirections> extremePoints{};
+            for (size_t j = 0; j < numDirections; ++j)
+            {
+                extremePoints[j] = mPoints[extreme[j]];
+            }
+            ConvexHull3<Real> polyhedronHull;
+            polyhedronHull(numDirections, extremePoints.data(), 0);
+            if (polyhedronHull.GetDimension() < 3)
+            {
+                // The extreme points are coplanar, so nothing is culled.
+                return;
+            }
+
+            auto const& polyhedron = polyhedronHull.GetHull();
+            size_t const numFaces = polyhedron.size() / 3;
+            // The error bound for the floating-point dot product is valid
+            // when no underflow occurs, so the filter is not trusted when
+            // the bound is too small.
+            Real const u = std::numeric_limits<Real>::epsilon() / static_cast<Real>(2);
+            Real const minBound = std::numeric_limits<Real>::min() / u;
+
+            std::vector<CullFace> faces(numFaces);
+            for (size_t f = 0, k = 0; f < numFaces; ++f)
+            {
+                Vector3<Real> const& V0 = extremePoints[polyhedron[k++]];
+                Vector3<Real> const& V1 = extremePoints[polyhedron[k++]];
+                Vector3<Real> const& V2 = extremePoints[polyhedron[k++]];
+                SVector3 const s0{ V0[0], V0[1], V0[2] };
+                SVector3 const s1{ V1[0], V1[1], V1[2] };
+                SVector3 const s2{ V2[0], V2[1], V2[2] };
+                Vector3<Rational> r1, r2;
+                CullFace& face = faces[f];
+                face.V0 = V0;
+                face.sNormal = Cross(s1 - s0, s2 - s0);
+                for (int32_t i = 0; i < 3; ++i)
+                {
+                    // The rounding errors in the difference P-V0 and in the
+                    // dot product are bounded by 6*u*|M|*|P'-V0|. The
+                    // constants are chosen generously so that the rounding
+                    // errors in computing the bound itself are covered.
+                    Real const lo = face.sNormal[i][0], hi = face.sNormal[i][1];
+                    Real const mid = static_cast<Real>(0.5) * (lo + hi);
+                    Real const radius = std::max(hi - mid, mid - lo);
+                    face.midNormal[i] = mid;
+                    face.weight[i] = (radius + static_cast<Real>(8) * u * std::fabs(mid))
+                        * (static_cast<Real>(1) + static_cast<Real>(8) * u);
+                }
+                for (int32_t i = 0; i < 3; ++i)
+                {
+                    face.rV0[i] = V0[i];
+                    r1[i] = V1[i];
+                    r2[i] = V2[i];
+                }
+                face.rNormal = Cross(r1 - face.rV0, r2 - face.rV0);
+            }
+
+            auto isInsidePolyhedron = [&faces, minBound](Vector3<Real> const& P)
+            {
+                for (auto const& face : faces)
+                {
+                    // P is strictly inside the polyhedron when Dot(N,P-V0)
+                    // is negative for all the faces.
+                    Real const dx = P[0] - face.V0[0];
+                    Real const dy = P[1] - face.V0[1];
+                    Real const dz = P[2] - face.V0[2];
+                    Real const dot = face.midNormal[0] * dx
+                        + face.midNormal[1] * dy + face.midNormal[2] * dz;
+                    Real const errorBound = face.weight[0] * std::fabs(dx)
+                        + face.weight[1] * std::fabs(dy) + face.weight[2] * std::fabs(dz);
+                    if (errorBound >= minBound)
+                    {
+                        if (dot < -errorBound)
+                        {
+                            continue;
+                        }
+                        if (dot > errorBound)
+                        {
+                            return false;
+                        }
+                    }
+
+                    // The floating-point sign is ambiguous, so attempt to
+                    // classify the sign using interval arithmetic.
+                    SVector3 const sDiff
+                    {
+                        SInterval(P[0]) - face.V0[0],
+                        SInterval(P[1]) - face.V0[1],
+                        SInterval(P[2]) - face.V0[2]
+                    };
+                    auto const sDot = Dot(face.sNormal, sDiff);
+                    if (sDot[1] < static_cast<Real>(0))
+                    {
+                        continue;
+                    }
+                    if (sDot[0] >= static_cast<Real>(0))
+                    {
+                        return false;
+                    }
+
+                    // The sign is indeterminate using interval arithmetic.
+                    // This happens rarely, so the rational point is not
+                    // memoized.
+                    Vector3<Rational> const rP{ P[0], P[1], P[2] };
+                    auto const rDot = Dot(face.rNormal, rP - face.rV0);
+                    if (rDot.GetSign() >= 0)
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            };
+
+            // Compute an axis-aligned box strictly inside the polyhedron.
+            // The box is convex, so it is strictly inside the polyhedron
+            // when its 8 corners are. Points strictly inside the box are
+            // culled using only 6 comparisons. The box is the bounding box
+            // of the extreme points, scaled about its center until the
+            // corners are strictly inside the polyhedron.
+            Vector3<Real> center{}, extent{};
+            for (int32_t i = 0; i < 3; ++i)
+            {
+                Real vmin = extremePoints[0][i], vmax = vmin;
+                for (size_t j = 1; j < numDirections; ++j)
+                {
+                    vmin = std::min(vmin, extremePoints[j][i]);
+                    vmax = std::max(vmax, extremePoints[j][i]);
+                }
+                center[i] = static_cast<Real>(0.5) * (vmin + vmax);
+                extent[i] = static_cast<Real>(0.5) * (vmax - vmin);
+            }
+
+            Vector3<Real> boxMin{ static_cast<Real>(1), static_cast<Real>(1), static_cast<Real>(1) };
+            Vector3<Real> boxMax{ static_cast<Real>(0), static_cast<Real>(0), static_cast<Real>(0) };
+            for (int32_t k = 19; k > 0; --k)
+            {
+                Real const scale = static_cast<Real>(0.05) * static_cast<Real>(k);
+                Vector3<Real> const cmin = center - scale * extent;
+                Vector3<Real> const cmax = center + scale * extent;
+                bool allInside = true;
+                for (int32_t corner = 0; corner < 8 && allInside; ++corner)
+                {
+                    Vector3<Real> const C
+                    {
+                        (corner & 1) ? cmax[0] : cmin[0],
+                        (corner & 2) ? cmax[1] : cmin[1],
+                        (corner & 4) ? cmax[2] : cmin[2]
+                    };
+                    allInside = isInsidePolyhedron(C);
+                }
+                if (allInside)
+                {
+                    boxMin = cmin;
+                    boxMax = cmax;
+                    break;
+                }
+            }
+
+            auto isInterior = [this, &boxMin, &boxMax, &isInsidePolyhedron](size_t index)
+            {
+                Vector3<Real> const& P = mPoints[index];
+                if (boxMin[0] < P[0] && P[0] < boxMax[0] &&
+                    boxMin[1] < P[1] && P[1] < boxMax[1] &&
+                    boxMin[2] < P[2] && P[2] < boxMax[2])
+                {
+                    return true;
+                }
+                return isInsidePolyhedron(P);
+            };
+
+            auto newEnd = ParallelRemoveIf(indices.begin(), indices.end(),
+                isInterior, lgNumThreads);
+            indices.erase(newEnd, indices.end());
+        }
+
         // Memoized access to the rational representation of the points.
         Vector3<Rational> const& GetRationalPoint(size_t index)
         {
-            if (mConverted[index] == 0)
+            size_t slot = mRationalIndex[index];
+            if (mConverted[slot] == 0)
             {
-                mConverted[index] = 1;
+                mConverted[slot] = 1;
                 for (int32_t i = 0; i < 3; ++i)
                 {
-                    mRPoints[index][i] = mPoints[index][i];
+                    mRPoints[slot][i] = mPoints[index][i];
                 }
             }
-            return mRPoints[index];
+            return mRPoints[slot];
         }
 
         bool Colocated(size_t v0, size_t v1)
@@ -642,10 +919,13 @@ namespace gte
 
     private:
         // A blend of interval arithmetic and exact arithmetic is used to
-        // ensure correctness.
+        // ensure correctness. The rational arrays have one element per
+        // unique point. The mRationalIndex array maps an index into mPoints
+        // to the slot of the unique point.
         Vector3<Real> const* mPoints;
         std::vector<Vector3<Rational>> mRPoints;
         std::vector<uint32_t> mConverted;
+        std::vector<size_t> mRationalIndex;
 
         // The output data.
         size_t mDimension;
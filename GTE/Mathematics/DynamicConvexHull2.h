@@ -0,0 +1,432 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2022
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 6.3.2026.10.17
+
+#pragma once
+
+// Maintain the convex hull of a dynamic set of 2D points. ConvexHull2 is a
+// batch functor; adding a single point requires recomputing the hull from
+// scratch. This class stores the points and updates the hull as points are
+// inserted or removed.
+//
+// Insertion of a point P locates an edge of the hull that is visible to P,
+// starting the search at the edge from which the previous insertion
+// started. The connected chain of visible edges is replaced by the two
+// edges sharing P. A point that is inside the hull is recorded but does not
+// change the hull. The cost is O(h) for a hull with h vertices.
+//
+// Removal of a point that is not a hull vertex is O(1). Removal of a hull
+// vertex V with hull neighbors A and B requires finding the points in the
+// triangle <A,V,B> that are outside the chord <A,B>. All the active points
+// are tested against the chord, which is O(n), and the convex hull of the
+// points found is spliced into the hull in place of V.
+//
+// The predicates use interval arithmetic and fall back to rational
+// arithmetic when the interval sign is ambiguous, just as ConvexHull2 does.
+// The rational points are not memoized, because the indeterminate case is
+// rare and the memoization for a large dynamic set is memory intensive.
+//
+// When fewer than 3 active points are noncollinear, the hull is computed
+// from scratch by ConvexHull2 after each modification. Once the hull is a
+// convex polygon, the incremental updates are used.
+
+#include <GTE/Mathematics/ConvexHull2.h>
+#include <numeric>
+
+namespace gte
+{
+    // The Real must be 'float' or 'double'.
+    template <typename Real>
+    class DynamicConvexHull2
+    {
+    public:
+        using Rational = typename ConvexHull2<Real>::Rational;
+        using Interval = typename ConvexHull2<Real>::Interval;
+
+        // The lgNumThreads parameter is passed to ConvexHull2 when the hull
+        // must be computed from scratch; see the comments in ConvexHull2.
+        DynamicConvexHull2(size_t lgNumThreads = 0)
+            :
+            mLgNumThreads(lgNumThreads),
+            mPoints{},
+            mActive{},
+            mNumActive(0),
+            mDimension(0),
+            mHull{},
+            mHint(0)
+        {
+            static_assert(std::is_floating_point<Real>::value,
+                "The input type must be 'float' or 'double'.");
+        }
+
+        // Insert a point and return its index. The index is used to remove
+        // the point and is the value stored in the hull array. Indices are
+        // never reused, even after the point is removed.
+        int32_t Insert(Vector2<Real> const& point)
+        {
+            int32_t index = AppendPoint(point);
+            if (mDimension == 2)
+            {
+                InsertIntoHull(index);
+            }
+            else
+            {
+                ComputeHullFromScratch();
+            }
+            return index;
+        }
+
+        // Insert a batch of points. The index of points[i] is the returned
+        // value plus i. When the hull is not yet a convex polygon, it is
+        // computed once for the batch by ConvexHull2 with interior culling.
+        int32_t Insert(int32_t numPoints, Vector2<Real> const* points)
+        {
+            LogAssert(numPoints > 0 && points != nullptr, "Invalid argument.");
+            int32_t first = static_cast<int32_t>(mPoints.size());
+            mPoints.reserve(mPoints.size() + static_cast<size_t>(numPoints));
+            mActive.reserve(mActive.size() + static_cast<size_t>(numPoints));
+            for (int32_t i = 0; i < numPoints; ++i)
+            {
+                int32_t index = AppendPoint(points[i]);
+                if (mDimension == 2)
+                {
+                    InsertIntoHull(index);
+                }
+            }
+            if (mDimension < 2)
+            {
+                ComputeHullFromScratch();
+            }
+            return first;
+        }
+
+        // Remove the point with the specified index. The return value is
+        // 'true' when the point was active; otherwise, the index is invalid
+        // or the point was already removed and 'false' is returned.
+        bool Remove(int32_t index)
+        {
+            if (index < 0 || index >= static_cast<int32_t>(mPoints.size()) ||
+                mActive[index] == 0)
+            {
+                return false;
+            }
+
+            mActive[index] = 0;
+            --mNumActive;
+
+            if (mDimension < 2)
+            {
+                // The hull is not stored for a degenerate point set, so any
+                // removal can change the dimension.
+                ComputeHullFromScratch();
+                return true;
+            }
+
+            auto iter = std::find(mHull.begin(), mHull.end(), index);
+            if (iter == mHull.end())
+            {
+                // The point is not a hull vertex, so the hull is unchanged.
+                return true;
+            }
+
+            RemoveFromHull(static_cast<size_t>(iter - mHull.begin()));
+            return true;
+        }
+
+        // Remove all the points.
+        void Clear()
+        {
+            mPoints.clear();
+            mActive.clear();
+            mNumActive = 0;
+            mDimension = 0;
+            mHull.clear();
+            mHint = 0;
+        }
+
+        // Member access.
+        inline std::vector<Vector2<Real>> const& GetPoints() const
+        {
+            return mPoints;
+        }
+
+        inline bool IsActive(int32_t index) const
+        {
+            return mActive[index] != 0;
+        }
+
+        inline size_t GetNumActivePoints() const
+        {
+            return mNumActive;
+        }
+
+        // The dimension is 0 (active points are the same point), 1 (active
+        // points are collinear) or 2 (the hull is a convex polygon). When
+        // the dimension is 0 or 1, the hull array is empty.
+        inline size_t GetDimension() const
+        {
+            return mDimension;
+        }
+
+        // The convex hull is a convex polygon whose vertices are listed in
+        // counterclockwise order. The values are indices into GetPoints().
+        // As with ConvexHull2, the hull does not have three consecutive
+        // collinear vertices.
+        inline std::vector<int32_t> const& GetHull() const
+        {
+            return mHull;
+        }
+
+    private:
+        int32_t AppendPoint(Vector2<Real> const& point)
+        {
+            int32_t index = static_cast<int32_t>(mPoints.size());
+            mPoints.push_back(point);
+            mActive.push_back(1);
+            ++mNumActive;
+            return index;
+        }
+
+        void ComputeHullFromScratch()
+        {
+            mDimension = 0;
+            mHull.clear();
+            mHint = 0;
+            if (mNumActive == 0)
+            {
+                return;
+            }
+
+            std::vector<int32_t> active(mNumActive);
+            std::vector<Vector2<Real>> points(mNumActive);
+            for (int32_t i = 0, j = 0; i < static_cast<int32_t>(mPoints.size()); ++i)
+            {
+                if (mActive[i] != 0)
+                {
+                    active[j] = i;
+                    points[j] = mPoints[i];
+                    ++j;
+                }
+            }
+
+            if (mNumActive < 3)
+            {
+                // ConvexHull2 requires at least three points.
+                mDimension = (mNumActive == 2 && points[0] != points[1] ? 1 : 0);
+                return;
+            }
+
+            ConvexHull2<Real> ch2;
+            ch2(static_cast<int32_t>(mNumActive), points.data(),
+                static_cast<Real>(0), true, mLgNumThreads);
+            mDimension = static_cast<size_t>(ch2.GetDimension());
+            if (mDimension == 2)
+            {
+                auto const& hull = ch2.GetHull();
+                mHull.resize(hull.size());
+                for (size_t i = 0; i < hull.size(); ++i)
+                {
+                    mHull[i] = active[hull[i]];
+                }
+            }
+        }
+
+        void InsertIntoHull(int32_t index)
+        {
+            // Locate a visible edge <H[i],H[i+1]>, one for which the point
+            // is strictly to the right. The search starts at the hint.
+            size_t const numHull = mHull.size();
+            size_t visible = numHull;
+            for (size_t k = 0; k < numHull; ++k)
+            {
+                size_t i0 = (mHint + k) % numHull;
+                size_t i1 = (i0 + 1) % numHull;
+                if (ToLine(index, mHull[i0], mHull[i1]) < 0)
+                {
+                    visible = i0;
+                    break;
+                }
+            }
+            if (visible == numHull)
+            {
+                // The point is inside the hull or on its boundary.
+                return;
+            }
+
+            // Extend the visible chain in both directions. An edge for
+            // which the point is on the line is included, because the point
+            // is then beyond an endpoint of that edge and the endpoint is no
+            // longer a strict vertex of the hull.
+            size_t first = visible, numVisible = 1;
+            while (numVisible < numHull)
+            {
+                size_t i0 = (first + numHull - 1) % numHull;
+                if (ToLine(index, mHull[i0], mHull[first]) > 0)
+                {
+                    break;
+                }
+                first = i0;
+                ++numVisible;
+            }
+            while (numVisible < numHull)
+            {
+                size_t i0 = (first + numVisible) % numHull;
+                size_t i1 = (i0 + 1) % numHull;
+                if (ToLine(index, mHull[i0], mHull[i1]) > 0)
+                {
+                    break;
+                }
+                ++numVisible;
+            }
+
+            // The edges first through first+numVisible-1 are replaced. The
+            // vertices strictly inside the chain are removed and the point
+            // is inserted between the chain endpoints.
+            std::vector<int32_t> newHull;
+            newHull.reserve(numHull + 1);
+            size_t last = (first + numVisible) % numHull;
+            for (size_t i = last; ; i = (i + 1) % numHull)
+            {
+                newHull.push_back(mHull[i]);
+                if (i == first)
+                {
+                    break;
+                }
+            }
+            newHull.push_back(index);
+            mHull = std::move(newHull);
+            mHint = mHull.size() - 1;
+        }
+
+        void RemoveFromHull(size_t k)
+        {
+            size_t const numHull = mHull.size();
+            int32_t a = mHull[(k + numHull - 1) % numHull];
+            int32_t b = mHull[(k + 1) % numHull];
+
+            // The points that can become hull vertices are those in the
+            // triangle <A,V,B> that are not strictly left of the chord
+            // <A,B>. Points on the same side as V of the supporting lines of
+            // the other hull edges are all inside the triangle.
+            std::vector<Vector2<Real>> candidates;
+            std::vector<int32_t> candidateIndices;
+            candidates.push_back(mPoints[a]);
+            candidateIndices.push_back(a);
+            candidates.push_back(mPoints[b]);
+            candidateIndices.push_back(b);
+            for (int32_t i = 0; i < static_cast<int32_t>(mPoints.size()); ++i)
+            {
+                if (mActive[i] != 0 && i != a && i != b && ToLine(i, a, b) <= 0)
+                {
+                    candidates.push_back(mPoints[i]);
+                    candidateIndices.push_back(i);
+                }
+            }
+
+            std::vector<int32_t> chain;
+            if (candidates.size() >= 3)
+            {
+                ConvexHull2<Real> ch2;
+                if (ch2(static_cast<int32_t>(candidates.size()), candidates.data(),
+                    static_cast<Real>(0)))
+                {
+                    // The subhull is counterclockwise and contains A and B
+                    // as vertices. The chain from A to B (exclusive) is the
+                    // replacement for V. The comparisons are by value,
+                    // because ConvexHull2 might have selected a duplicate of
+                    // A or B.
+                    auto const& hull = ch2.GetHull();
+                    size_t const numSub = hull.size();
+                    size_t start = 0;
+                    while (start < numSub && candidates[hull[start]] != mPoints[a])
+                    {
+                        ++start;
+                    }
+                    LogAssert(start < numSub, "Unexpected condition.");
+                    for (size_t j = (start + 1) % numSub; candidates[hull[j]] != mPoints[b];
+                        j = (j + 1) % numSub)
+                    {
+                        chain.push_back(candidateIndices[hull[j]]);
+                    }
+                }
+            }
+
+            std::vector<int32_t> newHull;
+            newHull.reserve(numHull + chain.size());
+            newHull.insert(newHull.end(), mHull.begin(), mHull.begin() + k);
+            newHull.insert(newHull.end(), chain.begin(), chain.end());
+            newHull.insert(newHull.end(), mHull.begin() + k + 1, mHull.end());
+            mHull = std::move(newHull);
+
+            // A and B might now be collinear with their neighbors.
+            RemoveCollinear(a);
+            RemoveCollinear(b);
+            if (mHull.size() < 3)
+            {
+                ComputeHullFromScratch();
+                return;
+            }
+            mHint = 0;
+        }
+
+        void RemoveCollinear(int32_t vertex)
+        {
+            size_t const numHull = mHull.size();
+            if (numHull <= 3)
+            {
+                return;
+            }
+            auto iter = std::find(mHull.begin(), mHull.end(), vertex);
+            size_t k = static_cast<size_t>(iter - mHull.begin());
+            int32_t prev = mHull[(k + numHull - 1) % numHull];
+            int32_t next = mHull[(k + 1) % numHull];
+            if (ToLine(vertex, prev, next) == 0)
+            {
+                mHull.erase(iter);
+            }
+        }
+
+        // For the directed line through Q0 and Q1, ToLine returns
+        //   +1, P is strictly left of the line
+        //   -1, P is strictly right of the line
+        //    0, P is on the line
+        int32_t ToLine(int32_t p, int32_t q0, int32_t q1) const
+        {
+            Vector2<Real> const& P = mPoints[p];
+            Vector2<Real> const& Q0 = mPoints[q0];
+            Vector2<Real> const& Q1 = mPoints[q1];
+
+            Real const zero(0);
+            Interval ix0 = Interval(Q1[0]) - Q0[0], iy0 = Interval(Q1[1]) - Q0[1];
+            Interval ix1 = Interval(P[0]) - Q0[0], iy1 = Interval(P[1]) - Q0[1];
+            Interval iDet = ix0 * iy1 - ix1 * iy0;
+            if (iDet[0] > zero)
+            {
+                return +1;
+            }
+            if (iDet[1] < zero)
+            {
+                return -1;
+            }
+
+            // The exact sign of the determinant is not known, so compute
+            // the determinant using rational arithmetic.
+            Vector2<Rational> const rP{ P[0], P[1] };
+            Vector2<Rational> const rQ0{ Q0[0], Q0[1] };
+            Vector2<Rational> const rQ1{ Q1[0], Q1[1] };
+            auto const rDet = DotPerp(rQ1 - rQ0, rP - rQ0);
+            return rDet.GetSign();
+        }
+
+        size_t mLgNumThreads;
+        std::vector<Vector2<Real>> mPoints;
+        std::vector<uint32_t> mActive;
+        size_t mNumActive;
+        size_t mDimension;
+        std::vector<int32_t> mHull;
+        size_t mHint;
+    };
+}
@@ -0,0 +1,731 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2022
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 6.3.2026.10.17
+
+#pragma once
+
+// Maintain the convex hull of a dynamic set of 3D points. ConvexHull3 is a
+// batch functor; adding a single point requires recomputing the hull and
+// rebuilding its mesh. This class stores the points and updates the hull
+// mesh as points are inserted or removed. The accessors are the same as
+// those of ConvexHull3.
+//
+// Insertion of a point P must locate a hull triangle visible to P. The
+// search starts at a triangle sharing the most recently inserted hull
+// vertex, which is a good hint when consecutive points are spatially
+// coherent. From there the search walks across triangle adjacencies toward
+// the triangle whose plane is farthest from P. If the walk reaches a local
+// maximum that is not visible, all the triangles are tested, which also
+// proves that a point inside the hull does not change it. Most points of a
+// large cloud are inside the hull, so an axis-aligned box strictly inside
+// the hull is maintained; a point strictly inside the box is rejected with
+// 6 comparisons. Insertions only enlarge the hull, so the box is recomputed
+// only after a removal changes the hull. The connected component of
+// visible triangles is flooded from the located triangle, removed and
+// replaced by the triangles connecting P to the terminator edges, just as
+// in ConvexHull3.
+//
+// Removal of a point that is not a hull vertex does not change the hull.
+// Removal of a hull vertex V requires the hull H0 of the remaining hull
+// vertices. H0 is contained in the new hull, so only the points that are
+// not strictly inside H0 can become hull vertices. Such points are on the
+// nonnegative side of a triangle of H0 that is not a triangle of the old
+// hull, because all points are inside the old hull. The active points are
+// tested against those triangles, which is O(n), and the points found are
+// inserted into H0.
+//
+// The plane-side predicate first uses a floating-point dot product with a
+// conservative error bound. The plane data is cached in the hull triangles.
+// When that sign is ambiguous, interval arithmetic is used and then
+// rational arithmetic when the interval sign is also ambiguous. The
+// rational points are not memoized, because the indeterminate case is rare
+// and the memoization for a large dynamic set is memory intensive.
+//
+// When the active points are coplanar, the hull is computed from scratch by
+// ConvexHull3 after each modification. Once the hull is a convex
+// polyhedron, the incremental updates are used.
+
+#include <GTE/Mathematics/ConvexHull3.h>
+#include <unordered_set>
+
+namespace gte
+{
+    // The Real must be 'float' or 'double'.
+    template <typename Real>
+    class DynamicConvexHull3
+    {
+    public:
+        using Rational = typename ConvexHull3<Real>::Rational;
+        using TrianglePtr = VETManifoldMesh::Triangle*;
+
+        // The lgNumThreads parameter is passed to ConvexHull3 when the hull
+        // must be computed from scratch; see the comments in ConvexHull3.
+        DynamicConvexHull3(size_t lgNumThreads = 0)
+            :
+            mLgNumThreads(lgNumThreads),
+            mPoints{},
+            mActive{},
+            mNumActive(0),
+            mDimension(0),
+            mVertices{},
+            mHull{},
+            mHullMesh(nullptr, nullptr, CreateFace),
+            mHintVertex(-1),
+            mHasInnerBox(false),
+            mInnerMin{},
+            mInnerMax{}
+        {
+            static_assert(std::is_floating_point<Real>::value,
+                "The input type must be 'float' or 'double'.");
+        }
+
+        // Insert a point and return its index. The index is used to remove
+        // the point and is the value stored in the vertex and hull arrays.
+        // Indices are never reused, even after the point is removed.
+        size_t Insert(Vector3<Real> const& point)
+        {
+            size_t index = AppendPoint(point);
+            if (mDimension == 3)
+            {
+                InsertIntoHull(index);
+                UpdateOutput();
+            }
+            else
+            {
+                ComputeHullFromScratch();
+            }
+            return index;
+        }
+
+        // Insert a batch of points. The index of points[i] is the returned
+        // value plus i. The output arrays are updated once for the batch.
+        // When the hull is not yet a convex polyhedron, it is computed once
+        // for the batch by ConvexHull3 with interior culling.
+        size_t Insert(size_t numPoints, Vector3<Real> const* points)
+        {
+            LogAssert(numPoints > 0 && points != nullptr, "Invalid argument.");
+            size_t first = mPoints.size();
+            mPoints.reserve(mPoints.size() + numPoints);
+            mActive.reserve(mActive.size() + numPoints);
+            for (size_t i = 0; i < numPoints; ++i)
+            {
+                size_t index = AppendPoint(points[i]);
+                if (mDimension == 3)
+                {
+                    InsertIntoHull(index);
+                }
+            }
+
+            if (mDimension == 3)
+            {
+                UpdateOutput();
+            }
+            else
+            {
+                ComputeHullFromScratch();
+            }
+            return first;
+        }
+
+        // Remove the point with the specified index. The return value is
+        // 'true' when the point was active; otherwise, the index is invalid
+        // or the point was already removed and 'false' is returned.
+        bool Remove(size_t index)
+        {
+            if (index >= mPoints.size() || mActive[index] == 0)
+            {
+                return false;
+            }
+
+            mActive[index] = 0;
+            --mNumActive;
+
+            if (mDimension < 3)
+            {
+                if (std::find(mVertices.begin(), mVertices.end(), index) != mVertices.end())
+                {
+                    ComputeHullFromScratch();
+                }
+                return true;
+            }
+
+            auto const& vMap = mHullMesh.GetVertices();
+            if (vMap.find(static_cast<int32_t>(index)) == vMap.end())
+            {
+                // The point is not a hull vertex, so the hull is unchanged.
+                return true;
+            }
+
+            RemoveFromHull(index);
+            return true;
+        }
+
+        // Remove all the points.
+        void Clear()
+        {
+            mPoints.clear();
+            mActive.clear();
+            mNumActive = 0;
+            mDimension = 0;
+            mVertices.clear();
+            mHull.clear();
+            mHullMesh.Clear();
+            mHintVertex = -1;
+            mHasInnerBox = false;
+        }
+
+        // Member access.
+        inline std::vector<Vector3<Real>> const& GetPoints() const
+        {
+            return mPoints;
+        }
+
+        inline bool IsActive(size_t index) const
+        {
+            return mActive[index] != 0;
+        }
+
+        inline size_t GetNumActivePoints() const
+        {
+            return mNumActive;
+        }
+
+        // The dimension is 0 (hull is a single point), 1 (hull is a line
+        // segment), 2 (hull is a convex polygon in 3D) or 3 (hull is a convex
+        // polyhedron). The dimension is 0 when there are no active points.
+        inline size_t GetDimension() const
+        {
+            return mDimension;
+        }
+
+        // Get the indices into GetPoints() that correspond to hull vertices.
+        inline std::vector<size_t> const& GetVertices() const
+        {
+            return mVertices;
+        }
+
+        // The hull array is organized according to the hull dimension just
+        // as it is for ConvexHull3::GetHull().
+        inline std::vector<size_t> const& GetHull() const
+        {
+            return mHull;
+        }
+
+        // Get the hull mesh, which is valid only when the dimension is 3.
+        inline VETManifoldMesh const& GetHullMesh() const
+        {
+            return mHullMesh;
+        }
+
+    private:
+        // The hull triangles cache the data for the floating-point filter
+        // of the plane-side predicate. The data is computed the first time
+        // the triangle is used in the predicate.
+        class Face : public VETManifoldMesh::Triangle
+        {
+        public:
+            Face(int32_t v0, int32_t v1, int32_t v2)
+                :
+                VETManifoldMesh::Triangle(v0, v1, v2),
+                hasPlane(false),
+                origin{},
+                midNormal{},
+                weight{},
+                invLength(static_cast<Real>(0))
+            {
+            }
+
+            // The filter uses the midpoint M of the interval-valued normal
+            // N = Cross(V1-V0,V2-V0) and per-component weights W for which
+            // |Dot(N,P-V0) - Dot(M,P'-V0)| <= Dot(W,|P'-V0|), where P'-V0
+            // is the floating-point difference. The inverse length of M
+            // supports estimating the signed distance from P to the plane.
+            bool hasPlane;
+            Vector3<Real> origin, midNormal, weight;
+            Real invLength;
+        };
+
+        static std::unique_ptr<ETManifoldMesh::Triangle> CreateFace(
+            int32_t v0, int32_t v1, int32_t v2)
+        {
+            return std::make_unique<Face>(v0, v1, v2);
+        }
+
+        size_t AppendPoint(Vector3<Real> const& point)
+        {
+            size_t index = mPoints.size();
+            LogAssert(index < static_cast<size_t>(std::numeric_limits<int32_t>::max()),
+                "Too many points for the hull mesh.");
+            mPoints.push_back(point);
+            mActive.push_back(1);
+            ++mNumActive;
+            return index;
+        }
+
+        void ComputeHullFromScratch()
+        {
+            mDimension = 0;
+            mVertices.clear();
+            mHull.clear();
+            mHullMesh.Clear();
+            mHintVertex = -1;
+            mHasInnerBox = false;
+            if (mNumActive == 0)
+            {
+                return;
+            }
+
+            std::vector<size_t> active(mNumActive);
+            std::vector<Vector3<Real>> points(mNumActive);
+            for (size_t i = 0, j = 0; i < mPoints.size(); ++i)
+            {
+                if (mActive[i] != 0)
+                {
+                    active[j] = i;
+                    points[j] = mPoints[i];
+                    ++j;
+                }
+            }
+
+            ConvexHull3<Real> ch3;
+            ch3(points, mLgNumThreads, true);
+            mDimension = ch3.GetDimension();
+            if (mDimension == 3)
+            {
+                auto const& hull = ch3.GetHull();
+                for (size_t t = 0; t < hull.size(); t += 3)
+                {
+                    auto inserted = mHullMesh.Insert(
+                        static_cast<int32_t>(active[hull[t]]),
+                        static_cast<int32_t>(active[hull[t + 1]]),
+                        static_cast<int32_t>(active[hull[t + 2]]));
+                    LogAssert(inserted != nullptr, "Unexpected insertion failure.");
+                }
+                UpdateOutput();
+            }
+            else
+            {
+                for (auto v : ch3.GetVertices())
+                {
+                    mVertices.push_back(active[v]);
+                }
+                for (auto h : ch3.GetHull())
+                {
+                    mHull.push_back(active[h]);
+                }
+            }
+        }
+
+        void UpdateOutput()
+        {
+            auto const& vMap = mHullMesh.GetVertices();
+            mVertices.resize(vMap.size());
+            size_t index = 0;
+            for (auto const& element : vMap)
+            {
+                mVertices[index++] = static_cast<size_t>(element.first);
+            }
+
+            auto const& tMap = mHullMesh.GetTriangles();
+            mHull.resize(3 * tMap.size());
+            index = 0;
+            for (auto const& element : tMap)
+            {
+                mHull[index++] = static_cast<size_t>(element.first.V[0]);
+                mHull[index++] = static_cast<size_t>(element.first.V[1]);
+                mHull[index++] = static_cast<size_t>(element.first.V[2]);
+            }
+        }
+
+        // Locate a triangle visible to the point. The function returns
+        // nullptr when the point is inside the hull or on its boundary.
+        TrianglePtr FindVisible(size_t index)
+        {
+            auto const& tMap = mHullMesh.GetTriangles();
+            auto const& vMap = mHullMesh.GetVertices();
+            TrianglePtr current = nullptr;
+            auto vIter = vMap.find(mHintVertex);
+            if (vIter != vMap.end() && vIter->second->TAdjacent.size() > 0)
+            {
+                current = *vIter->second->TAdjacent.begin();
+            }
+            else
+            {
+                current = tMap.begin()->second.get();
+            }
+
+            // Walk toward the triangle whose plane is farthest from the
+            // point, stopping at a local maximum.
+            Real distance = GetDistanceEstimate(current, index);
+            for (size_t step = 0; step < tMap.size(); ++step)
+            {
+                if (ToPlane(current, index) > 0)
+                {
+                    return current;
+                }
+
+                TrianglePtr next = nullptr;
+                for (size_t i = 0; i < 3; ++i)
+                {
+                    TrianglePtr adj = current->T[i];
+                    Real adjDistance = GetDistanceEstimate(adj, index);
+                    if (adjDistance > distance)
+                    {
+                        distance = adjDistance;
+                        next = adj;
+                    }
+                }
+                if (!next)
+                {
+                    break;
+                }
+                current = next;
+            }
+
+            // Test all the triangles.
+            for (auto const& element : tMap)
+            {
+                if (ToPlane(element.second.get(), index) > 0)
+                {
+                    return element.second.get();
+                }
+            }
+            return nullptr;
+        }
+
+        // Compute an axis-aligned box strictly inside the hull. The box is
+        // convex, so it is strictly inside the hull when its 8 corners are.
+        // The box is the bounding box of the hull vertices, scaled about its
+        // center until the corners are strictly inside the hull. If no
+        // scaling succeeds, the box is empty.
+        void ComputeInnerBox()
+        {
+            auto const& vMap = mHullMesh.GetVertices();
+            Vector3<Real> vmin = mPoints[vMap.begin()->first], vmax = vmin;
+            for (auto const& element : vMap)
+            {
+                Vector3<Real> const& V = mPoints[element.first];
+                for (int32_t i = 0; i < 3; ++i)
+                {
+                    vmin[i] = std::min(vmin[i], V[i]);
+                    vmax[i] = std::max(vmax[i], V[i]);
+                }
+            }
+            Vector3<Real> const center = static_cast<Real>(0.5) * (vmin + vmax);
+            Vector3<Real> const extent = static_cast<Real>(0.5) * (vmax - vmin);
+
+            mInnerMin = { static_cast<Real>(1), static_cast<Real>(1), static_cast<Real>(1) };
+            mInnerMax = { static_cast<Real>(0), static_cast<Real>(0), static_cast<Real>(0) };
+            for (int32_t k = 19; k > 0; --k)
+            {
+                Real const scale = static_cast<Real>(0.05) * static_cast<Real>(k);
+                Vector3<Real> const cmin = center - scale * extent;
+                Vector3<Real> const cmax = center + scale * extent;
+                bool allInside = true;
+                for (int32_t corner = 0; corner < 8 && allInside; ++corner)
+                {
+                    Vector3<Real> const C
+                    {
+                        (corner & 1) ? cmax[0] : cmin[0],
+                        (corner & 2) ? cmax[1] : cmin[1],
+                        (corner & 4) ? cmax[2] : cmin[2]
+                    };
+                    for (auto const& element : mHullMesh.GetTriangles())
+                    {
+                        if (ToPlane(element.second.get(), C) >= 0)
+                        {
+                            allInside = false;
+                            break;
+                        }
+                    }
+                }
+                if (allInside)
+                {
+                    mInnerMin = cmin;
+                    mInnerMax = cmax;
+                    break;
+                }
+            }
+            mHasInnerBox = true;
+        }
+
+        void InsertIntoHull(size_t index)
+        {
+            if (!mHasInnerBox)
+            {
+                ComputeInnerBox();
+            }
+            Vector3<Real> const& P = mPoints[index];
+            if (mInnerMin[0] < P[0] && P[0] < mInnerMax[0] &&
+                mInnerMin[1] < P[1] && P[1] < mInnerMax[1] &&
+                mInnerMin[2] < P[2] && P[2] < mInnerMax[2])
+            {
+                return;
+            }
+
+            TrianglePtr start = FindVisible(index);
+            if (!start)
+            {
+                return;
+            }
+
+            // Flood the connected component of visible triangles. Save the
+            // terminator edges for insertion of the new triangles.
+            std::vector<TrianglePtr> visible;
+            std::unordered_set<TrianglePtr> visited;
+            std::vector<std::array<int32_t, 2>> terminator;
+            visible.push_back(start);
+            visited.insert(start);
+            for (size_t k = 0; k < visible.size(); ++k)
+            {
+                TrianglePtr tri = visible[k];
+                for (size_t i = 0; i < 3; ++i)
+                {
+                    TrianglePtr adj = tri->T[i];
+                    if (visited.find(adj) != visited.end())
+                    {
+                        continue;
+                    }
+                    if (ToPlane(adj, index) > 0)
+                    {
+                        visible.push_back(adj);
+                        visited.insert(adj);
+                    }
+                    else
+                    {
+                        terminator.push_back({ tri->V[i], tri->V[(i + 1) % 3] });
+                    }
+                }
+            }
+
+            for (auto tri : visible)
+            {
+                std::array<int32_t, 3> v = tri->V;
+                bool removed = mHullMesh.Remove(v[0], v[1], v[2]);
+                LogAssert(removed, "Unexpected removal failure.");
+            }
+
+            int32_t h = static_cast<int32_t>(index);
+            for (auto const& edge : terminator)
+            {
+                auto inserted = mHullMesh.Insert(edge[0], edge[1], h);
+                LogAssert(inserted != nullptr, "Unexpected insertion failure.");
+            }
+            mHintVertex = h;
+        }
+
+        void RemoveFromHull(size_t index)
+        {
+            // Compute the hull H0 of the remaining hull vertices.
+            auto const& vMap = mHullMesh.GetVertices();
+            std::vector<size_t> remaining;
+            std::vector<Vector3<Real>> points;
+            remaining.reserve(vMap.size());
+            points.reserve(vMap.size());
+            for (auto const& element : vMap)
+            {
+                size_t v = static_cast<size_t>(element.first);
+                if (v != index)
+                {
+                    remaining.push_back(v);
+                    points.push_back(mPoints[v]);
+                }
+            }
+
+            ConvexHull3<Real> ch3;
+            ch3(points, 0);
+            if (ch3.GetDimension() < 3)
+            {
+                ComputeHullFromScratch();
+                return;
+            }
+
+            // Replace the hull mesh by H0. The triangles of H0 that are not
+            // triangles of the old hull are the only ones that interior
+            // points can be on the nonnegative side of.
+            std::unordered_set<TriangleKey<true>, TriangleKey<true>, TriangleKey<true>> oldKeys;
+            for (auto const& element : mHullMesh.GetTriangles())
+            {
+                oldKeys.insert(element.first);
+            }
+
+            mHullMesh.Clear();
+            std::vector<TrianglePtr> newFaces;
+            auto const& hull = ch3.GetHull();
+            for (size_t t = 0; t < hull.size(); t += 3)
+            {
+                int32_t v0 = static_cast<int32_t>(remaining[hull[t]]);
+                int32_t v1 = static_cast<int32_t>(remaining[hull[t + 1]]);
+                int32_t v2 = static_cast<int32_t>(remaining[hull[t + 2]]);
+                auto inserted = mHullMesh.Insert(v0, v1, v2);
+                LogAssert(inserted != nullptr, "Unexpected insertion failure.");
+                if (oldKeys.find(TriangleKey<true>(v0, v1, v2)) == oldKeys.end())
+                {
+                    newFaces.push_back(inserted);
+                }
+            }
+
+            std::vector<size_t> candidates;
+            auto const& newVMap = mHullMesh.GetVertices();
+            for (size_t i = 0; i < mPoints.size(); ++i)
+            {
+                if (mActive[i] != 0 && newVMap.find(static_cast<int32_t>(i)) == newVMap.end())
+                {
+                    for (auto face : newFaces)
+                    {
+                        if (ToPlane(face, i) >= 0)
+                        {
+                            candidates.push_back(i);
+                            break;
+                        }
+                    }
+                }
+            }
+
+            mHintVertex = -1;
+            mHasInnerBox = false;
+            for (auto c : candidates)
+            {
+                InsertIntoHull(c);
+            }
+            UpdateOutput();
+        }
+
+        Face* GetFace(TrianglePtr tri)
+        {
+            Face* face = static_cast<Face*>(tri);
+            if (!face->hasPlane)
+            {
+                using SInterval = SWInterval<Real>;
+                using SVector3 = Vector3<SInterval>;
+
+                Vector3<Real> const& V0 = mPoints[face->V[0]];
+                Vector3<Real> const& V1 = mPoints[face->V[1]];
+                Vector3<Real> const& V2 = mPoints[face->V[2]];
+                SVector3 const s0{ V0[0], V0[1], V0[2] };
+                SVector3 const s1{ V1[0], V1[1], V1[2] };
+                SVector3 const s2{ V2[0], V2[1], V2[2] };
+                SVector3 const sNormal = Cross(s1 - s0, s2 - s0);
+
+                // The rounding errors in the difference P-V0 and in the dot
+                // product are bounded by 6*u*|M|*|P'-V0|. The constants are
+                // chosen generously so that the rounding errors in
+                // computing the bound itself are covered.
+                Real const u = std::numeric_limits<Real>::epsilon() / static_cast<Real>(2);
+                for (int32_t i = 0; i < 3; ++i)
+                {
+                    Real const lo = sNormal[i][0], hi = sNormal[i][1];
+                    Real const mid = static_cast<Real>(0.5) * (lo + hi);
+                    Real const radius = std::max(hi - mid, mid - lo);
+                    face->midNormal[i] = mid;
+                    face->weight[i] = (radius + static_cast<Real>(8) * u * std::fabs(mid))
+                        * (static_cast<Real>(1) + static_cast<Real>(8) * u);
+                }
+                face->origin = V0;
+                Real length = Length(face->midNormal);
+                face->invLength = (length > static_cast<Real>(0) ?
+                    static_cast<Real>(1) / length : static_cast<Real>(0));
+                face->hasPlane = true;
+            }
+            return face;
+        }
+
+        // The signed distance from the point to the plane of the triangle,
+        // computed in floating-point arithmetic. It is used only to guide
+        // the walk, so it need not be exact.
+        Real GetDistanceEstimate(TrianglePtr tri, size_t p)
+        {
+            Face* face = GetFace(tri);
+            return Dot(face->midNormal, mPoints[p] - face->origin) * face->invLength;
+        }
+
+        // For a triangle <V0,V1,V2> with normal N = Cross(V1-V0,V2-V0),
+        // ToPlane returns
+        //   +1, P on positive side of plane (side to which N points)
+        //   -1, P on negative side of plane (side to which -N points)
+        //    0, P on the plane
+        int32_t ToPlane(TrianglePtr tri, size_t p)
+        {
+            return ToPlane(tri, mPoints[p]);
+        }
+
+        int32_t ToPlane(TrianglePtr tri, Vector3<Real> const& P)
+        {
+            Face* face = GetFace(tri);
+            Real const dx = P[0] - face->origin[0];
+            Real const dy = P[1] - face->origin[1];
+            Real const dz = P[2] - face->origin[2];
+            Real const dot = face->midNormal[0] * dx
+                + face->midNormal[1] * dy + face->midNormal[2] * dz;
+            Real const errorBound = face->weight[0] * std::fabs(dx)
+                + face->weight[1] * std::fabs(dy) + face->weight[2] * std::fabs(dz);
+
+            // The error bound is valid when no underflow occurs, so the
+            // filter is not trusted when the bound is too small.
+            Real const u = std::numeric_limits<Real>::epsilon() / static_cast<Real>(2);
+            if (errorBound >= std::numeric_limits<Real>::min() / u)
+            {
+                if (dot > errorBound)
+                {
+                    return +1;
+                }
+                if (dot < -errorBound)
+                {
+                    return -1;
+                }
+            }
+
+            using SInterval = SWInterval<Real>;
+            using SVector3 = Vector3<SInterval>;
+
+            // Attempt to classify the sign using interval arithmetic.
+            Vector3<Real> const& V0 = mPoints[face->V[0]];
+            Vector3<Real> const& V1 = mPoints[face->V[1]];
+            Vector3<Real> const& V2 = mPoints[face->V[2]];
+            SVector3 const s0{ V0[0], V0[1], V0[2] };
+            SVector3 const s1{ V1[0], V1[1], V1[2] };
+            SVector3 const s2{ V2[0], V2[1], V2[2] };
+            SVector3 const s3{ P[0], P[1], P[2] };
+            auto const sDet = DotCross(s1 - s0, s2 - s0, s3 - s0);
+            if (sDet[0] > static_cast<Real>(0))
+            {
+                return +1;
+            }
+            if (sDet[1] < static_cast<Real>(0))
+            {
+                return -1;
+            }
+
+            // The sign is indeterminate using interval arithmetic.
+            Vector3<Rational> const r0{ V0[0], V0[1], V0[2] };
+            Vector3<Rational> const r1{ V1[0], V1[1], V1[2] };
+            Vector3<Rational> const r2{ V2[0], V2[1], V2[2] };
+            Vector3<Rational> const r3{ P[0], P[1], P[2] };
+            auto const rDet = DotCross(r1 - r0, r2 - r0, r3 - r0);
+            return rDet.GetSign();
+        }
+
+        size_t mLgNumThreads;
+        std::vector<Vector3<Real>> mPoints;
+        std::vector<uint32_t> mActive;
+        size_t mNumActive;
+
+        // The output data.
+        size_t mDimension;
+        std::vector<size_t> mVertices;
+        std::vector<size_t> mHull;
+        VETManifoldMesh mHullMesh;
+
+        // The most recently inserted hull vertex, used as the starting
+        // location for the search for a visible triangle.
+        int32_t mHintVertex;
+
+        // An axis-aligned box strictly inside the hull, used to reject
+        // points quickly. The box is empty when mInnerMin > mInnerMax.
+        bool mHasInnerBox;
+        Vector3<Real> mInnerMin, mInnerMax;
+    };
+}
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 6.0.2022.01.06
+// Version: 6.3.2026.10.17
 
 #pragma once
 
@@ -13,12 +13,30 @@
 #include <algorithm>
 #include <array>
 #include <cstring>
+#include <iterator>
+#include <list>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 // The interpolator is for uniformly spaced(x,y z)-values.  The input samples
 // must be stored in lexicographical order to represent f(x,y,z); that is,
 // F[c + xBound*(r + yBound*s)] corresponds to f(x,y,z), where c is the index
 // corresponding to x, r is the index corresponding to y, and s is the index
 // corresponding to z.
+//
+// The interpolator for a cell is a tricubic polynomial with 64 coefficients
+// that is determined by the function values and the derivative estimates at
+// the 8 cell corners. The derivative estimates at a sample depend only on
+// the samples in a 5x5x5 neighborhood. By default, the polynomials for all
+// the cells are computed by the constructor, which requires storage of
+// 64 numbers per sample. For large volumes, the interpolator can instead be
+// constructed in a lazy mode that stores only a pointer to the samples. The
+// polynomial for a cell is computed from the samples when the cell is
+// evaluated and is stored in a least-recently-used cache of a specified
+// number of cells. Resampling on a regular grid is supported by a batched
+// function that computes each polynomial once for all the grid points in
+// its cell.
 
 namespace gte
 {
@@ -26,10 +44,16 @@ namespace gte
     class IntpAkimaUniform3
     {
     public:
-        // Construction and destruction.
+        // Construction and destruction. When cacheCapacity is 0, the
+        // polynomials for all the cells are computed by the constructor.
+        // When cacheCapacity is positive, the lazy mode is used and at most
+        // cacheCapacity polynomials are stored. The cache is modified by the
+        // const evaluation operators, so in the lazy mode the operators must
+        // not be called concurrently from multiple threads. Resample does
+        // not use the cache and may be called concurrently in either mode.
         IntpAkimaUniform3(int32_t xBound, int32_t yBound, int32_t zBound, Real xMin,
             Real xSpacing, Real yMin, Real ySpacing, Real zMin, Real zSpacing,
-            Real const* F)
+            Real const* F, size_t cacheCapacity = 0)
             :
             mXBound(xBound),
             mYBound(yBound),
@@ -42,42 +66,40 @@ namespace gte
             mZMin(zMin),
             mZSpacing(zSpacing),
             mF(F),
-            mPoly(static_cast<size_t>(xBound) - 1, static_cast<size_t>(yBound) - 1, static_cast<size_t>(zBound) - 1)
+            mPoly(
+                cacheCapacity == 0 ? static_cast<size_t>(xBound) - 1 : 0,
+                cacheCapacity == 0 ? static_cast<size_t>(yBound) - 1 : 0,
+                cacheCapacity == 0 ? static_cast<size_t>(zBound) - 1 : 0),
+            mCacheCapacity(cacheCapacity),
+            mCache{},
+            mCacheMap{}
         {
             // At least a 3x3x3 block of data points is needed to construct
             // the estimates of the boundary derivatives.
             LogAssert(mXBound >= 3 && mYBound >= 3 && mZBound >= 3 && mF != nullptr, "Invalid input.");
             LogAssert(mXSpacing > (Real)0 && mYSpacing > (Real)0 && mZSpacing > (Real)0, "Invalid input.");
 
-            mXMax = mXMin + mXSpacing * static_cast<Real>(mXBound) - static_cast<Real>(1);
-            mYMax = mYMin + mYSpacing * static_cast<Real>(mYBound) - static_cast<Real>(1);
-            mZMax = mZMin + mZSpacing * static_cast<Real>(mZBound) - static_cast<Real>(1);
-
-            // Create a 3D wrapper for the 1D samples.
-            Array3<Real> Fmap(mXBound, mYBound, mZBound, const_cast<Real*>(mF));
-
-            // Construct first-order derivatives.
-            Array3<Real> FX(mXBound, mYBound, mZBound);
-            Array3<Real> FY(mXBound, mYBound, mZBound);
-            Array3<Real> FZ(mXBound, mYBound, mZBound);
-            GetFX(Fmap, FX);
-            GetFX(Fmap, FY);
-            GetFX(Fmap, FZ);
-
-            // Construct second-order derivatives.
-            Array3<Real> FXY(mXBound, mYBound, mZBound);
-            Array3<Real> FXZ(mXBound, mYBound, mZBound);
-            Array3<Real> FYZ(mXBound, mYBound, mZBound);
-            GetFX(Fmap, FXY);
-            GetFX(Fmap, FXZ);
-            GetFX(Fmap, FYZ);
-
-            // Construct third-order derivatives.
-            Array3<Real> FXYZ(mXBound, mYBound, mZBound);
-            GetFXYZ(Fmap, FXYZ);
-
-            // Construct polynomials.
-            GetPolynomials(Fmap, FX, FY, FZ, FXY, FXZ, FYZ, FXYZ);
+            mXMax = mXMin + mXSpacing * static_cast<Real>(mXBound - 1);
+            mYMax = mYMin + mYSpacing * static_cast<Real>(mYBound - 1);
+            mZMax = mZMin + mZSpacing * static_cast<Real>(mZBound - 1);
+
+            if (mCacheCapacity == 0)
+            {
+                for (int32_t iz = 0; iz < mZBound - 1; ++iz)
+                {
+                    for (int32_t iy = 0; iy < mYBound - 1; ++iy)
+                    {
+                        for (int32_t ix = 0; ix < mXBound - 1; ++ix)
+                        {
+                            ComputePolynomial(ix, iy, iz, mPoly[iz][iy][ix]);
+                        }
+                    }
+                }
+            }
+            else
+            {
+                mCacheMap.reserve(mCacheCapacity);
+            }
         }
 
         ~IntpAkimaUniform3() = default;
@@ -153,6 +175,28 @@ namespace gte
             return mZSpacing;
         }
 
+        inline size_t GetCacheCapacity() const
+        {
+            return mCacheCapacity;
+        }
+
+        // The number of bytes used by the polynomials, which is the
+        // interpolator storage in addition to the caller's samples. In the
+        // lazy mode, the cache bookkeeping is included as an estimate.
+        size_t GetPolynomialStorage() const
+        {
+            if (mCacheCapacity == 0)
+            {
+                return mPoly.GetBound0() * mPoly.GetBound1() * mPoly.GetBound2() * sizeof(Polynomial);
+            }
+            else
+            {
+                size_t const listNode = sizeof(std::pair<size_t, Polynomial>) + 2 * sizeof(void*);
+                size_t const mapNode = sizeof(size_t) + 3 * sizeof(void*);
+                return mCache.size() * (listNode + mapNode);
+            }
+        }
+
         // Evaluate the function and its derivatives.  The functions clamp the
         // inputs to xmin <= x <= xmax, ymin <= y <= ymax and
         // zmin <= z <= zmax.  The first operator is for function evaluation.
@@ -171,7 +215,7 @@ namespace gte
             XLookup(x, ix, dx);
             YLookup(y, iy, dy);
             ZLookup(z, iz, dz);
-            return mPoly[iz][iy][ix](dx, dy, dz);
+            return GetPolynomial(ix, iy, iz)(dx, dy, dz);
         }
 
         Real operator()(int32_t xOrder, int32_t yOrder, int32_t zOrder, Real x, Real y, Real z) const
@@ -184,7 +228,175 @@ namespace gte
             XLookup(x, ix, dx);
             YLookup(y, iy, dy);
             ZLookup(z, iz, dz);
-            return mPoly[iz][iy][ix](xOrder, yOrder, zOrder, dx, dy, dz);
+            return GetPolynomial(ix, iy, iz)(xOrder, yOrder, zOrder, dx, dy, dz);
+        }
+
+        // Evaluate the function or a derivative at the numX*numY*numZ points
+        // (x0 + i*xDelta, y0 + j*yDelta, z0 + k*zDelta) of a regular grid,
+        // where 0 <= i < numX, 0 <= j < numY and 0 <= k < numZ. The value
+        // for (i,j,k) is stored in output[i + numX*(j + numY*k)], so output
+        // must have numX*numY*numZ elements. The points are clamped as in
+        // operator(). The grid points are processed a row of cells at a time
+        // and each polynomial of the row is computed at most once, so in the
+        // lazy mode the cost per cell is amortized over all the grid points
+        // in the cell. To run in the main thread only, choose numThreads to
+        // be 0. For multithreading, choose numThreads > 0; each thread
+        // processes a subrange of the k-indices.
+        void Resample(int32_t xOrder, int32_t yOrder, int32_t zOrder,
+            int32_t numX, Real x0, Real xDelta,
+            int32_t numY, Real y0, Real yDelta,
+            int32_t numZ, Real z0, Real zDelta,
+            Real* output, size_t numThreads = 0) const
+        {
+            LogAssert(numX > 0 && numY > 0 && numZ > 0 && output != nullptr, "Invalid input.");
+
+            std::vector<int32_t> xIndex(numX), yIndex(numY), zIndex(numZ);
+            std::vector<Real> xDiff(numX), yDiff(numY), zDiff(numZ);
+            for (int32_t i = 0; i < numX; ++i)
+            {
+                Real x = x0 + xDelta * static_cast<Real>(i);
+                XLookup(std::min(std::max(x, mXMin), mXMax), xIndex[i], xDiff[i]);
+            }
+            for (int32_t j = 0; j < numY; ++j)
+            {
+                Real y = y0 + yDelta * static_cast<Real>(j);
+                YLookup(std::min(std::max(y, mYMin), mYMax), yIndex[j], yDiff[j]);
+            }
+            for (int32_t k = 0; k < numZ; ++k)
+            {
+                Real z = z0 + zDelta * static_cast<Real>(k);
+                ZLookup(std::min(std::max(z, mZMin), mZMax), zIndex[k], zDiff[k]);
+            }
+
+            int32_t const orders[3] = { xOrder, yOrder, zOrder };
+            int32_t const numXY = numX * numY;
+            auto resample = [this, &orders, numX, numY, numXY, &xIndex, &yIndex,
+                &zIndex, &xDiff, &yDiff, &zDiff, output](int32_t kMin, int32_t kSup)
+            {
+                // The polynomials of the current row of cells. A polynomial
+                // is valid when its stamp equals the current row number.
+                std::vector<Polynomial> row(mCacheCapacity > 0 ? static_cast<size_t>(mXBound) - 1 : 0);
+                std::vector<int32_t> stamp(row.size(), -1);
+                int32_t rowNumber = 0;
+
+                // A row of cells has 4 lines of samples. The least recently
+                // used of the 8 lines of the pool is replaced, so the lines
+                // shared by consecutive rows are not recomputed.
+                std::array<SampleLine, 8> pool;
+                size_t useCount = 0;
+                auto getLine = [this, &pool, &useCount](int32_t iy, int32_t iz)
+                {
+                    SampleLine* line = &pool[0];
+                    for (auto& candidate : pool)
+                    {
+                        if (candidate.iy == iy && candidate.iz == iz)
+                        {
+                            line = &candidate;
+                            break;
+                        }
+                        if (candidate.lastUse < line->lastUse)
+                        {
+                            line = &candidate;
+                        }
+                    }
+                    if (line->iy != iy || line->iz != iz)
+                    {
+                        line->iy = iy;
+                        line->iz = iz;
+                        line->D.resize(static_cast<size_t>(mXBound));
+                        line->valid.assign(static_cast<size_t>(mXBound), 0);
+                    }
+                    line->lastUse = ++useCount;
+                    return line;
+                };
+                std::array<SampleLine*, 4> lines{};
+                CornerData corner{};
+
+                // Process the maximal runs of grid points that are in the
+                // same row of cells.
+                for (int32_t k0 = kMin, k1 = kMin; k0 < kSup; k0 = k1)
+                {
+                    int32_t iz = zIndex[k0];
+                    for (k1 = k0 + 1; k1 < kSup && zIndex[k1] == iz; ++k1);
+
+                    for (int32_t j0 = 0, j1 = 0; j0 < numY; j0 = j1, ++rowNumber)
+                    {
+                        int32_t iy = yIndex[j0];
+                        for (j1 = j0 + 1; j1 < numY && yIndex[j1] == iy; ++j1);
+                        if (mCacheCapacity > 0)
+                        {
+                            for (int32_t m = 0; m < 4; ++m)
+                            {
+                                lines[m] = getLine(iy + (m & 1), iz + (m >> 1));
+                            }
+                        }
+
+                        for (int32_t i = 0; i < numX; ++i)
+                        {
+                            int32_t ix = xIndex[i];
+                            Polynomial const* poly;
+                            if (mCacheCapacity == 0)
+                            {
+                                poly = &mPoly[iz][iy][ix];
+                            }
+                            else
+                            {
+                                if (stamp[ix] != rowNumber)
+                                {
+                                    for (size_t c = 0; c < 8; ++c)
+                                    {
+                                        SampleLine& line = *lines[c >> 1];
+                                        int32_t sx = ix + static_cast<int32_t>(c & 1);
+                                        if (!line.valid[sx])
+                                        {
+                                            GetSampleDerivatives(sx, line.iy, line.iz, line.D[sx]);
+                                            line.valid[sx] = 1;
+                                        }
+                                        corner[c] = &line.D[sx];
+                                    }
+                                    ComputePolynomial(corner, row[ix]);
+                                    stamp[ix] = rowNumber;
+                                }
+                                poly = &row[ix];
+                            }
+
+                            for (int32_t k = k0; k < k1; ++k)
+                            {
+                                for (int32_t j = j0; j < j1; ++j)
+                                {
+                                    output[i + numX * j + numXY * k] = (*poly)(
+                                        orders[0], orders[1], orders[2],
+                                        xDiff[i], yDiff[j], zDiff[k]);
+                                }
+                            }
+                        }
+                    }
+                }
+            };
+
+            if (numThreads > 0)
+            {
+                size_t const numSlices = static_cast<size_t>(numZ);
+                numThreads = std::min(numThreads, numSlices);
+                std::vector<std::thread> process(numThreads);
+                for (size_t t = 0; t < numThreads; ++t)
+                {
+                    int32_t kMin = static_cast<int32_t>(t * numSlices / numThreads);
+                    int32_t kSup = static_cast<int32_t>((t + 1) * numSlices / numThreads);
+                    process[t] = std::thread([&resample, kMin, kSup]()
+                    {
+                        resample(kMin, kSup);
+                    });
+                }
+                for (size_t t = 0; t < numThreads; ++t)
+                {
+                    process[t].join();
+                }
+            }
+            else
+            {
+                resample(0, numZ);
+            }
         }
 
     private:
@@ -346,812 +558,221 @@ namespace gte
             std::array<std::array<std::array<Real, 4>, 4>, 4> mCoeff;
         };
 
-        // Support for construction.
-        void GetFX(Array3<Real> const& F, Array3<Real>& FX)
+        // Support for construction. The derivative estimates at a sample
+        // are computed from the samples in its 5x5x5 neighborhood, so the
+        // polynomial for a cell can be computed independently of the other
+        // cells.
+        inline Real GetSample(int32_t ix, int32_t iy, int32_t iz) const
         {
-            Array3<Real> slope(static_cast<size_t>(mXBound) + 3, mYBound, mZBound);
-            Real invDX = (Real)1 / mXSpacing;
-            int32_t ix, iy, iz;
-            for (iz = 0; iz < mZBound; ++iz)
-            {
-                for (iy = 0; iy < mYBound; ++iy)
-                {
-                    for (ix = 0; ix < mXBound - 1; ++ix)
-                    {
-                        slope[iz][iy][ix + 2] = (F[iz][iy][ix + 1] - F[iz][iy][ix]) * invDX;
-                    }
-
-                    slope[iz][iy][1] = (Real)2 * slope[iz][iy][2] - slope[iz][iy][3];
-                    slope[iz][iy][0] = (Real)2 * slope[iz][iy][1] - slope[iz][iy][2];
-                    slope[iz][iy][static_cast<size_t>(mXBound) + 1] = (Real)2 * slope[iz][iy][mXBound] - slope[iz][iy][static_cast<size_t>(mXBound) - 1];
-                    slope[iz][iy][static_cast<size_t>(mXBound) + 2] = (Real)2 * slope[iz][iy][static_cast<size_t>(mXBound) + 1] - slope[iz][iy][mXBound];
-                }
-            }
-
-            for (iz = 0; iz < mZBound; ++iz)
-            {
-                for (iy = 0; iy < mYBound; ++iy)
-                {
-                    for (ix = 0; ix < mXBound; ++ix)
-                    {
-                        FX[iz][iy][ix] = ComputeDerivative(slope[iz][iy] + ix);
-                    }
-                }
-            }
+            return mF[static_cast<size_t>(ix) + static_cast<size_t>(mXBound) *
+                (static_cast<size_t>(iy) + static_cast<size_t>(mYBound) * static_cast<size_t>(iz))];
         }
 
-        void GetFY(Array3<Real> const& F, Array3<Real>& FY)
+        // The Akima estimate of the first derivative at sample i of a line
+        // of 'bound' samples. The index into mF of the first sample of the
+        // line is 'base' and consecutive samples of the line are 'stride'
+        // elements apart. The slopes of the two intervals beyond each end of
+        // the line are extrapolated linearly.
+        Real GetAkimaDerivative(size_t base, size_t stride, int32_t i,
+            int32_t bound, Real invSpacing) const
         {
-            Array3<Real> slope(static_cast<size_t>(mYBound) + 3, mXBound, mZBound);
-            Real invDY = (Real)1 / mYSpacing;
-            int32_t ix, iy, iz;
-            for (iz = 0; iz < mZBound; ++iz)
+            auto difference = [this, base, stride, invSpacing](int32_t j)
             {
-                for (ix = 0; ix < mXBound; ++ix)
-                {
-                    for (iy = 0; iy < mYBound - 1; ++iy)
-                    {
-                        slope[iz][ix][iy + 2] = (F[iz][iy + 1][ix] - F[iz][iy][ix]) * invDY;
-                    }
-
-                    slope[iz][ix][1] = (Real)2 * slope[iz][ix][2] - slope[iz][ix][3];
-                    slope[iz][ix][0] = (Real)2 * slope[iz][ix][1] - slope[iz][ix][2];
-                    slope[iz][ix][static_cast<size_t>(mYBound) + 1] = (Real)2 * slope[iz][ix][mYBound] - slope[iz][ix][static_cast<size_t>(mYBound) - 1];
-                    slope[iz][ix][static_cast<size_t>(mYBound) + 2] = (Real)2 * slope[iz][ix][static_cast<size_t>(mYBound) + 1] - slope[iz][ix][mYBound];
-                }
-            }
+                size_t k = base + static_cast<size_t>(j) * stride;
+                return (mF[k + stride] - mF[k]) * invSpacing;
+            };
 
-            for (iz = 0; iz < mZBound; ++iz)
+            std::array<Real, 4> slope{};
+            for (int32_t m = 0; m < 4; ++m)
             {
-                for (ix = 0; ix < mXBound; ++ix)
+                int32_t j = i - 2 + m;
+                if (0 <= j && j <= bound - 2)
                 {
-                    for (iy = 0; iy < mYBound; ++iy)
-                    {
-                        FY[iz][iy][ix] = ComputeDerivative(slope[iz][ix] + iy);
-                    }
+                    slope[m] = difference(j);
                 }
-            }
-        }
-
-        void GetFZ(Array3<Real> const& F, Array3<Real>& FZ)
-        {
-            Array3<Real> slope(static_cast<size_t>(mZBound) + 3, mXBound, mYBound);
-            Real invDZ = (Real)1 / mZSpacing;
-            int32_t ix, iy, iz;
-            for (iy = 0; iy < mYBound; ++iy)
-            {
-                for (ix = 0; ix < mXBound; ++ix)
+                else if (j < 0)
                 {
-                    for (iz = 0; iz < mZBound - 1; ++iz)
-                    {
-                        slope[iy][ix][iz + 2] = (F[iz + 1][iy][ix] - F[iz][iy][ix]) * invDZ;
-                    }
-
-                    slope[iy][ix][1] = (Real)2 * slope[iy][ix][2] - slope[iy][ix][3];
-                    slope[iy][ix][0] = (Real)2 * slope[iy][ix][1] - slope[iy][ix][2];
-                    slope[iy][ix][static_cast<size_t>(mZBound) + 1] = (Real)2 * slope[iy][ix][mZBound] - slope[iy][ix][static_cast<size_t>(mZBound) - 1];
-                    slope[iy][ix][static_cast<size_t>(mZBound) + 2] = (Real)2 * slope[iy][ix][static_cast<size_t>(mZBound) + 1] - slope[iy][ix][mZBound];
+                    Real d0 = difference(0);
+                    Real sM1 = (Real)2 * d0 - difference(1);
+                    slope[m] = (j == -1 ? sM1 : (Real)2 * sM1 - d0);
                 }
-            }
-
-            for (iy = 0; iy < mYBound; ++iy)
-            {
-                for (ix = 0; ix < mXBound; ++ix)
+                else
                 {
-                    for (iz = 0; iz < mZBound; ++iz)
-                    {
-                        FZ[iz][iy][ix] = ComputeDerivative(slope[iy][ix] + iz);
-                    }
+                    Real d0 = difference(bound - 2);
+                    Real sP1 = (Real)2 * d0 - difference(bound - 3);
+                    slope[m] = (j == bound - 1 ? sP1 : (Real)2 * sP1 - d0);
                 }
             }
+            return ComputeDerivative(slope.data());
         }
 
-        void GetFXY(Array3<Real> const& F, Array3<Real>& FXY)
+        // The weights of an O(h^2) estimate of the first derivative at
+        // sample i of a line of 'bound' samples. The weights apply to the
+        // samples first, first+1 and first+2. The difference is centered
+        // for interior samples and one-sided for the end samples.
+        static void GetDifferenceWeights(int32_t i, int32_t bound,
+            int32_t& first, std::array<Real, 3>& weight)
         {
-            int32_t xBoundM1 = mXBound - 1;
-            int32_t yBoundM1 = mYBound - 1;
-            int32_t ix0 = xBoundM1, ix1 = ix0 - 1, ix2 = ix1 - 1;
-            int32_t iy0 = yBoundM1, iy1 = iy0 - 1, iy2 = iy1 - 1;
-            int32_t ix, iy, iz;
-
-            Real invDXDY = (Real)1 / (mXSpacing * mYSpacing);
-            for (iz = 0; iz < mZBound; ++iz)
+            if (i == 0)
             {
-                // corners of z-slice
-                FXY[iz][0][0] = (Real)0.25 * invDXDY * (
-                    (Real)9 * F[iz][0][0]
-                    - (Real)12 * F[iz][0][1]
-                    + (Real)3 * F[iz][0][2]
-                    - (Real)12 * F[iz][1][0]
-                    + (Real)16 * F[iz][1][1]
-                    - (Real)4 * F[iz][1][2]
-                    + (Real)3 * F[iz][2][0]
-                    - (Real)4 * F[iz][2][1]
-                    + F[iz][2][2]);
-
-                FXY[iz][0][xBoundM1] = (Real)0.25 * invDXDY * (
-                    (Real)9 * F[iz][0][ix0]
-                    - (Real)12 * F[iz][0][ix1]
-                    + (Real)3 * F[iz][0][ix2]
-                    - (Real)12 * F[iz][1][ix0]
-                    + (Real)16 * F[iz][1][ix1]
-                    - (Real)4 * F[iz][1][ix2]
-                    + (Real)3 * F[iz][2][ix0]
-                    - (Real)4 * F[iz][2][ix1]
-                    + F[iz][2][ix2]);
-
-                FXY[iz][yBoundM1][0] = (Real)0.25 * invDXDY * (
-                    (Real)9 * F[iz][iy0][0]
-                    - (Real)12 * F[iz][iy0][1]
-                    + (Real)3 * F[iz][iy0][2]
-                    - (Real)12 * F[iz][iy1][0]
-                    + (Real)16 * F[iz][iy1][1]
-                    - (Real)4 * F[iz][iy1][2]
-                    + (Real)3 * F[iz][iy2][0]
-                    - (Real)4 * F[iz][iy2][1]
-                    + F[iz][iy2][2]);
-
-                FXY[iz][yBoundM1][xBoundM1] = (Real)0.25 * invDXDY * (
-                    (Real)9 * F[iz][iy0][ix0]
-                    - (Real)12 * F[iz][iy0][ix1]
-                    + (Real)3 * F[iz][iy0][ix2]
-                    - (Real)12 * F[iz][iy1][ix0]
-                    + (Real)16 * F[iz][iy1][ix1]
-                    - (Real)4 * F[iz][iy1][ix2]
-                    + (Real)3 * F[iz][iy2][ix0]
-                    - (Real)4 * F[iz][iy2][ix1]
-                    + F[iz][iy2][ix2]);
-
-                // x-edges of z-slice
-                for (ix = 1; ix < xBoundM1; ++ix)
-                {
-                    FXY[iz][0][ix] = (Real)0.25 * invDXDY * (
-                        (Real)3 * (F[iz][0][ix - 1] - F[iz][0][ix + 1]) -
-                        (Real)4 * (F[iz][1][ix - 1] - F[iz][1][ix + 1]) +
-                        (F[iz][2][ix - 1] - F[iz][2][ix + 1]));
-
-                    FXY[iz][yBoundM1][ix] = (Real)0.25 * invDXDY * (
-                        (Real)3 * (F[iz][iy0][ix - 1] - F[iz][iy0][ix + 1])
-                        - (Real)4 * (F[iz][iy1][ix - 1] - F[iz][iy1][ix + 1]) +
-                        (F[iz][iy2][ix - 1] - F[iz][iy2][ix + 1]));
-                }
-
-                // y-edges of z-slice
-                for (iy = 1; iy < yBoundM1; ++iy)
-                {
-                    FXY[iz][iy][0] = (Real)0.25 * invDXDY * (
-                        (Real)3 * (F[iz][iy - 1][0] - F[iz][iy + 1][0]) -
-                        (Real)4 * (F[iz][iy - 1][1] - F[iz][iy + 1][1]) +
-                        (F[iz][iy - 1][2] - F[iz][iy + 1][2]));
-
-                    FXY[iz][iy][xBoundM1] = (Real)0.25 * invDXDY * (
-                        (Real)3 * (F[iz][iy - 1][ix0] - F[iz][iy + 1][ix0])
-                        - (Real)4 * (F[iz][iy - 1][ix1] - F[iz][iy + 1][ix1]) +
-                        (F[iz][iy - 1][ix2] - F[iz][iy + 1][ix2]));
-                }
-
-                // interior of z-slice
-                for (iy = 1; iy < yBoundM1; ++iy)
-                {
-                    for (ix = 1; ix < xBoundM1; ++ix)
-                    {
-                        FXY[iz][iy][ix] = (Real)0.25 * invDXDY * (
-                            F[iz][iy - 1][ix - 1] - F[iz][iy - 1][ix + 1] -
-                            F[iz][iy + 1][ix - 1] + F[iz][iy + 1][ix + 1]);
-                    }
-                }
+                first = 0;
+                weight = { (Real)-1.5, (Real)2, (Real)-0.5 };
             }
-        }
-
-        void GetFXZ(Array3<Real> const& F, Array3<Real> & FXZ)
-        {
-            int32_t xBoundM1 = mXBound - 1;
-            int32_t zBoundM1 = mZBound - 1;
-            int32_t ix0 = xBoundM1, ix1 = ix0 - 1, ix2 = ix1 - 1;
-            int32_t iz0 = zBoundM1, iz1 = iz0 - 1, iz2 = iz1 - 1;
-            int32_t ix, iy, iz;
-
-            Real invDXDZ = (Real)1 / (mXSpacing * mZSpacing);
-            for (iy = 0; iy < mYBound; ++iy)
+            else if (i == bound - 1)
             {
-                // corners of z-slice
-                FXZ[0][iy][0] = (Real)0.25 * invDXDZ * (
-                    (Real)9 * F[0][iy][0]
-                    - (Real)12 * F[0][iy][1]
-                    + (Real)3 * F[0][iy][2]
-                    - (Real)12 * F[1][iy][0]
-                    + (Real)16 * F[1][iy][1]
-                    - (Real)4 * F[1][iy][2]
-                    + (Real)3 * F[2][iy][0]
-                    - (Real)4 * F[2][iy][1]
-                    + F[2][iy][2]);
-
-                FXZ[0][iy][xBoundM1] = (Real)0.25 * invDXDZ * (
-                    (Real)9 * F[0][iy][ix0]
-                    - (Real)12 * F[0][iy][ix1]
-                    + (Real)3 * F[0][iy][ix2]
-                    - (Real)12 * F[1][iy][ix0]
-                    + (Real)16 * F[1][iy][ix1]
-                    - (Real)4 * F[1][iy][ix2]
-                    + (Real)3 * F[2][iy][ix0]
-                    - (Real)4 * F[2][iy][ix1]
-                    + F[2][iy][ix2]);
-
-                FXZ[zBoundM1][iy][0] = (Real)0.25 * invDXDZ * (
-                    (Real)9 * F[iz0][iy][0]
-                    - (Real)12 * F[iz0][iy][1]
-                    + (Real)3 * F[iz0][iy][2]
-                    - (Real)12 * F[iz1][iy][0]
-                    + (Real)16 * F[iz1][iy][1]
-                    - (Real)4 * F[iz1][iy][2]
-                    + (Real)3 * F[iz2][iy][0]
-                    - (Real)4 * F[iz2][iy][1]
-                    + F[iz2][iy][2]);
-
-                FXZ[zBoundM1][iy][xBoundM1] = (Real)0.25 * invDXDZ * (
-                    (Real)9 * F[iz0][iy][ix0]
-                    - (Real)12 * F[iz0][iy][ix1]
-                    + (Real)3 * F[iz0][iy][ix2]
-                    - (Real)12 * F[iz1][iy][ix0]
-                    + (Real)16 * F[iz1][iy][ix1]
-                    - (Real)4 * F[iz1][iy][ix2]
-                    + (Real)3 * F[iz2][iy][ix0]
-                    - (Real)4 * F[iz2][iy][ix1]
-                    + F[iz2][iy][ix2]);
-
-                // x-edges of y-slice
-                for (ix = 1; ix < xBoundM1; ++ix)
-                {
-                    FXZ[0][iy][ix] = (Real)0.25 * invDXDZ * (
-                        (Real)3 * (F[0][iy][ix - 1] - F[0][iy][ix + 1]) -
-                        (Real)4 * (F[1][iy][ix - 1] - F[1][iy][ix + 1]) +
-                        (F[2][iy][ix - 1] - F[2][iy][ix + 1]));
-
-                    FXZ[zBoundM1][iy][ix] = (Real)0.25 * invDXDZ * (
-                        (Real)3 * (F[iz0][iy][ix - 1] - F[iz0][iy][ix + 1])
-                        - (Real)4 * (F[iz1][iy][ix - 1] - F[iz1][iy][ix + 1]) +
-                        (F[iz2][iy][ix - 1] - F[iz2][iy][ix + 1]));
-                }
-
-                // z-edges of y-slice
-                for (iz = 1; iz < zBoundM1; ++iz)
-                {
-                    FXZ[iz][iy][0] = (Real)0.25 * invDXDZ * (
-                        (Real)3 * (F[iz - 1][iy][0] - F[iz + 1][iy][0]) -
-                        (Real)4 * (F[iz - 1][iy][1] - F[iz + 1][iy][1]) +
-                        (F[iz - 1][iy][2] - F[iz + 1][iy][2]));
-
-                    FXZ[iz][iy][xBoundM1] = (Real)0.25 * invDXDZ * (
-                        (Real)3 * (F[iz - 1][iy][ix0] - F[iz + 1][iy][ix0])
-                        - (Real)4 * (F[iz - 1][iy][ix1] - F[iz + 1][iy][ix1]) +
-                        (F[iz - 1][iy][ix2] - F[iz + 1][iy][ix2]));
-                }
-
-                // interior of y-slice
-                for (iz = 1; iz < zBoundM1; ++iz)
-                {
-                    for (ix = 1; ix < xBoundM1; ++ix)
-                    {
-                        FXZ[iz][iy][ix] = ((Real)0.25) * invDXDZ * (
-                            F[iz - 1][iy][ix - 1] - F[iz - 1][iy][ix + 1] -
-                            F[iz + 1][iy][ix - 1] + F[iz + 1][iy][ix + 1]);
-                    }
-                }
+                first = bound - 3;
+                weight = { (Real)0.5, (Real)-2, (Real)1.5 };
             }
-        }
-
-        void GetFYZ(Array3<Real> const& F, Array3<Real> & FYZ)
-        {
-            int32_t yBoundM1 = mYBound - 1;
-            int32_t zBoundM1 = mZBound - 1;
-            int32_t iy0 = yBoundM1, iy1 = iy0 - 1, iy2 = iy1 - 1;
-            int32_t iz0 = zBoundM1, iz1 = iz0 - 1, iz2 = iz1 - 1;
-            int32_t ix, iy, iz;
-
-            Real invDYDZ = (Real)1 / (mYSpacing * mZSpacing);
-            for (ix = 0; ix < mXBound; ++ix)
+            else
             {
-                // corners of x-slice
-                FYZ[0][0][ix] = (Real)0.25 * invDYDZ * (
-                    (Real)9 * F[0][0][ix]
-                    - (Real)12 * F[0][1][ix]
-                    + (Real)3 * F[0][2][ix]
-                    - (Real)12 * F[1][0][ix]
-                    + (Real)16 * F[1][1][ix]
-                    - (Real)4 * F[1][2][ix]
-                    + (Real)3 * F[2][0][ix]
-                    - (Real)4 * F[2][1][ix]
-                    + F[2][2][ix]);
-
-                FYZ[0][yBoundM1][ix] = (Real)0.25 * invDYDZ * (
-                    (Real)9 * F[0][iy0][ix]
-                    - (Real)12 * F[0][iy1][ix]
-                    + (Real)3 * F[0][iy2][ix]
-                    - (Real)12 * F[1][iy0][ix]
-                    + (Real)16 * F[1][iy1][ix]
-                    - (Real)4 * F[1][iy2][ix]
-                    + (Real)3 * F[2][iy0][ix]
-                    - (Real)4 * F[2][iy1][ix]
-                    + F[2][iy2][ix]);
-
-                FYZ[zBoundM1][0][ix] = (Real)0.25 * invDYDZ * (
-                    (Real)9 * F[iz0][0][ix]
-                    - (Real)12 * F[iz0][1][ix]
-                    + (Real)3 * F[iz0][2][ix]
-                    - (Real)12 * F[iz1][0][ix]
-                    + (Real)16 * F[iz1][1][ix]
-                    - (Real)4 * F[iz1][2][ix]
-                    + (Real)3 * F[iz2][0][ix]
-                    - (Real)4 * F[iz2][1][ix]
-                    + F[iz2][2][ix]);
-
-                FYZ[zBoundM1][yBoundM1][ix] = (Real)0.25 * invDYDZ * (
-                    (Real)9 * F[iz0][iy0][ix]
-                    - (Real)12 * F[iz0][iy1][ix]
-                    + (Real)3 * F[iz0][iy2][ix]
-                    - (Real)12 * F[iz1][iy0][ix]
-                    + (Real)16 * F[iz1][iy1][ix]
-                    - (Real)4 * F[iz1][iy2][ix]
-                    + (Real)3 * F[iz2][iy0][ix]
-                    - (Real)4 * F[iz2][iy1][ix]
-                    + F[iz2][iy2][ix]);
-
-                // y-edges of x-slice
-                for (iy = 1; iy < yBoundM1; ++iy)
-                {
-                    FYZ[0][iy][ix] = (Real)0.25 * invDYDZ * (
-                        (Real)3 * (F[0][iy - 1][ix] - F[0][iy + 1][ix]) -
-                        (Real)4 * (F[1][iy - 1][ix] - F[1][iy + 1][ix]) +
-                        (F[2][iy - 1][ix] - F[2][iy + 1][ix]));
-
-                    FYZ[zBoundM1][iy][ix] = (Real)0.25 * invDYDZ * (
-                        (Real)3 * (F[iz0][iy - 1][ix] - F[iz0][iy + 1][ix])
-                        - (Real)4 * (F[iz1][iy - 1][ix] - F[iz1][iy + 1][ix]) +
-                        (F[iz2][iy - 1][ix] - F[iz2][iy + 1][ix]));
-                }
-
-                // z-edges of x-slice
-                for (iz = 1; iz < zBoundM1; ++iz)
-                {
-                    FYZ[iz][0][ix] = (Real)0.25 * invDYDZ * (
-                        (Real)3 * (F[iz - 1][0][ix] - F[iz + 1][0][ix]) -
-                        (Real)4 * (F[iz - 1][1][ix] - F[iz + 1][1][ix]) +
-                        (F[iz - 1][2][ix] - F[iz + 1][2][ix]));
-
-                    FYZ[iz][yBoundM1][ix] = (Real)0.25 * invDYDZ * (
-                        (Real)3 * (F[iz - 1][iy0][ix] - F[iz + 1][iy0][ix])
-                        - (Real)4 * (F[iz - 1][iy1][ix] - F[iz + 1][iy1][ix]) +
-                        (F[iz - 1][iy2][ix] - F[iz + 1][iy2][ix]));
-                }
-
-                // interior of x-slice
-                for (iz = 1; iz < zBoundM1; ++iz)
-                {
-                    for (iy = 1; iy < yBoundM1; ++iy)
-                    {
-                        FYZ[iz][iy][ix] = (Real)0.25 * invDYDZ * (
-                            F[iz - 1][iy - 1][ix] - F[iz - 1][iy + 1][ix] -
-                            F[iz + 1][iy - 1][ix] + F[iz + 1][iy + 1][ix]);
-                    }
-                }
+                first = i - 1;
+                weight = { (Real)-0.5, (Real)0, (Real)0.5 };
             }
         }
 
-        void GetFXYZ(Array3<Real> const& F, Array3<Real> & FXYZ)
+        // Compute the function value and the derivative estimates at a
+        // sample. The output array stores F, FX, FY, FZ, FXY, FXZ, FYZ and
+        // FXYZ in that order.
+        void GetSampleDerivatives(int32_t ix, int32_t iy, int32_t iz,
+            std::array<Real, 8>& D) const
         {
-            int32_t xBoundM1 = mXBound - 1;
-            int32_t yBoundM1 = mYBound - 1;
-            int32_t zBoundM1 = mZBound - 1;
-            int32_t ix, iy, iz, ix0, iy0, iz0;
-
-            Real invDXDYDZ = ((Real)1) / (mXSpacing * mYSpacing * mZSpacing);
-
-            // convolution masks
-            //   centered difference, O(h^2)
-            Real CDer[3] = { -(Real)0.5, (Real)0, (Real)0.5 };
-            //   one-sided difference, O(h^2)
-            Real ODer[3] = { -(Real)1.5, (Real)2, -(Real)0.5 };
-            Real mask;
-
-            // corners
-            FXYZ[0][0][0] = (Real)0;
-            FXYZ[0][0][xBoundM1] = (Real)0;
-            FXYZ[0][yBoundM1][0] = (Real)0;
-            FXYZ[0][yBoundM1][xBoundM1] = (Real)0;
-            FXYZ[zBoundM1][0][0] = (Real)0;
-            FXYZ[zBoundM1][0][xBoundM1] = (Real)0;
-            FXYZ[zBoundM1][yBoundM1][0] = (Real)0;
-            FXYZ[zBoundM1][yBoundM1][xBoundM1] = (Real)0;
-            for (iz = 0; iz <= 2; ++iz)
+            size_t const xBound = static_cast<size_t>(mXBound);
+            size_t const xyBound = xBound * static_cast<size_t>(mYBound);
+            size_t const index = static_cast<size_t>(ix) + xBound * static_cast<size_t>(iy)
+                + xyBound * static_cast<size_t>(iz);
+
+            D[0] = mF[index];
+            D[1] = GetAkimaDerivative(index - static_cast<size_t>(ix), 1,
+                ix, mXBound, (Real)1 / mXSpacing);
+            D[2] = GetAkimaDerivative(index - xBound * static_cast<size_t>(iy), xBound,
+                iy, mYBound, (Real)1 / mYSpacing);
+            D[3] = GetAkimaDerivative(index - xyBound * static_cast<size_t>(iz), xyBound,
+                iz, mZBound, (Real)1 / mZSpacing);
+
+            int32_t x0, y0, z0;
+            std::array<Real, 3> wx, wy, wz;
+            GetDifferenceWeights(ix, mXBound, x0, wx);
+            GetDifferenceWeights(iy, mYBound, y0, wy);
+            GetDifferenceWeights(iz, mZBound, z0, wz);
+
+            Real fxy = (Real)0, fxz = (Real)0, fyz = (Real)0, fxyz = (Real)0;
+            for (int32_t j = 0; j < 3; ++j)
             {
-                for (iy = 0; iy <= 2; ++iy)
+                for (int32_t i = 0; i < 3; ++i)
                 {
-                    for (ix = 0; ix <= 2; ++ix)
-                    {
-                        mask = invDXDYDZ * ODer[ix] * ODer[iy] * ODer[iz];
-                        FXYZ[0][0][0] += mask * F[iz][iy][ix];
-                        FXYZ[0][0][xBoundM1] += mask * F[iz][iy][xBoundM1 - ix];
-                        FXYZ[0][yBoundM1][0] += mask * F[iz][yBoundM1 - iy][ix];
-                        FXYZ[0][yBoundM1][xBoundM1] += mask * F[iz][yBoundM1 - iy][xBoundM1 - ix];
-                        FXYZ[zBoundM1][0][0] += mask * F[zBoundM1 - iz][iy][ix];
-                        FXYZ[zBoundM1][0][xBoundM1] += mask * F[zBoundM1 - iz][iy][xBoundM1 - ix];
-                        FXYZ[zBoundM1][yBoundM1][0] += mask * F[zBoundM1 - iz][yBoundM1 - iy][ix];
-                        FXYZ[zBoundM1][yBoundM1][xBoundM1] += mask * F[zBoundM1 - iz][yBoundM1 - iy][xBoundM1 - ix];
-                    }
+                    fxy += wx[i] * wy[j] * GetSample(x0 + i, y0 + j, iz);
+                    fxz += wx[i] * wz[j] * GetSample(x0 + i, iy, z0 + j);
+                    fyz += wy[i] * wz[j] * GetSample(ix, y0 + i, z0 + j);
                 }
             }
-
-            // x-edges
-            for (ix0 = 1; ix0 < xBoundM1; ++ix0)
+            for (int32_t k = 0; k < 3; ++k)
             {
-                FXYZ[0][0][ix0] = (Real)0;
-                FXYZ[0][yBoundM1][ix0] = (Real)0;
-                FXYZ[zBoundM1][0][ix0] = (Real)0;
-                FXYZ[zBoundM1][yBoundM1][ix0] = (Real)0;
-                for (iz = 0; iz <= 2; ++iz)
+                for (int32_t j = 0; j < 3; ++j)
                 {
-                    for (iy = 0; iy <= 2; ++iy)
+                    for (int32_t i = 0; i < 3; ++i)
                     {
-                        for (ix = 0; ix <= 2; ++ix)
-                        {
-                            mask = invDXDYDZ * CDer[ix] * ODer[iy] * ODer[iz];
-                            FXYZ[0][0][ix0] += mask * F[iz][iy][ix0 + ix - 1];
-                            FXYZ[0][yBoundM1][ix0] += mask * F[iz][yBoundM1 - iy][ix0 + ix - 1];
-                            FXYZ[zBoundM1][0][ix0] += mask * F[zBoundM1 - iz][iy][ix0 + ix - 1];
-                            FXYZ[zBoundM1][yBoundM1][ix0] += mask * F[zBoundM1 - iz][yBoundM1 - iy][ix0 + ix - 1];
-                        }
+                        fxyz += wx[i] * wy[j] * wz[k] * GetSample(x0 + i, y0 + j, z0 + k);
                     }
                 }
             }
+            D[4] = fxy / (mXSpacing * mYSpacing);
+            D[5] = fxz / (mXSpacing * mZSpacing);
+            D[6] = fyz / (mYSpacing * mZSpacing);
+            D[7] = fxyz / (mXSpacing * mYSpacing * mZSpacing);
+        }
 
-            // y-edges
-            for (iy0 = 1; iy0 < yBoundM1; ++iy0)
+        // The derivative estimates at the cell corners are ordered so that
+        // corner[i + 2 * j + 4 * k] is for the sample (ix + i, iy + j, iz + k)
+        // of cell (ix, iy, iz).
+        using CornerData = std::array<std::array<Real, 8> const*, 8>;
+
+        void ComputePolynomial(CornerData const& corner, Polynomial& poly) const
+        {
+            // Note the 'transposing' of the 2x2x2 blocks (to match notation
+            // used in the polynomial definition). G[0] is F, G[1] is FX,
+            // G[2] is FY, G[3] is FZ, G[4] is FXY, G[5] is FXZ, G[6] is FYZ
+            // and G[7] is FXYZ.
+            Real G[8][2][2][2];
+            for (size_t c = 0; c < 8; ++c)
             {
-                FXYZ[0][iy0][0] = (Real)0;
-                FXYZ[0][iy0][xBoundM1] = (Real)0;
-                FXYZ[zBoundM1][iy0][0] = (Real)0;
-                FXYZ[zBoundM1][iy0][xBoundM1] = (Real)0;
-                for (iz = 0; iz <= 2; ++iz)
+                for (size_t m = 0; m < 8; ++m)
                 {
-                    for (iy = 0; iy <= 2; ++iy)
-                    {
-                        for (ix = 0; ix <= 2; ++ix)
-                        {
-                            mask = invDXDYDZ * ODer[ix] * CDer[iy] * ODer[iz];
-                            FXYZ[0][iy0][0] += mask * F[iz][iy0 + iy - 1][ix];
-                            FXYZ[0][iy0][xBoundM1] += mask * F[iz][iy0 + iy - 1][xBoundM1 - ix];
-                            FXYZ[zBoundM1][iy0][0] += mask * F[zBoundM1 - iz][iy0 + iy - 1][ix];
-                            FXYZ[zBoundM1][iy0][xBoundM1] += mask * F[zBoundM1 - iz][iy0 + iy - 1][xBoundM1 - ix];
-                        }
-                    }
+                    G[m][c & 1][(c >> 1) & 1][c >> 2] = (*corner[c])[m];
                 }
             }
+            Construct(poly, G[0], G[1], G[2], G[3], G[4], G[5], G[6], G[7]);
+        }
 
-            // z-edges
-            for (iz0 = 1; iz0 < zBoundM1; ++iz0)
+        void ComputePolynomial(int32_t ix, int32_t iy, int32_t iz, Polynomial& poly) const
+        {
+            std::array<std::array<Real, 8>, 8> D;
+            CornerData corner;
+            for (size_t c = 0; c < 8; ++c)
             {
-                FXYZ[iz0][0][0] = (Real)0;
-                FXYZ[iz0][0][xBoundM1] = (Real)0;
-                FXYZ[iz0][yBoundM1][0] = (Real)0;
-                FXYZ[iz0][yBoundM1][xBoundM1] = (Real)0;
-                for (iz = 0; iz <= 2; ++iz)
-                {
-                    for (iy = 0; iy <= 2; ++iy)
-                    {
-                        for (ix = 0; ix <= 2; ++ix)
-                        {
-                            mask = invDXDYDZ * ODer[ix] * ODer[iy] * CDer[iz];
-                            FXYZ[iz0][0][0] += mask * F[iz0 + iz - 1][iy][ix];
-                            FXYZ[iz0][0][xBoundM1] += mask * F[iz0 + iz - 1][iy][xBoundM1 - ix];
-                            FXYZ[iz0][yBoundM1][0] += mask * F[iz0 + iz - 1][yBoundM1 - iy][ix];
-                            FXYZ[iz0][yBoundM1][xBoundM1] += mask * F[iz0 + iz - 1][yBoundM1 - iy][xBoundM1 - ix];
-                        }
-                    }
-                }
+                GetSampleDerivatives(
+                    ix + static_cast<int32_t>(c & 1),
+                    iy + static_cast<int32_t>((c >> 1) & 1),
+                    iz + static_cast<int32_t>(c >> 2), D[c]);
+                corner[c] = &D[c];
             }
+            ComputePolynomial(corner, poly);
+        }
 
-            // xy-faces
-            for (iy0 = 1; iy0 < yBoundM1; ++iy0)
+        // The derivative estimates for the samples of a line of constant y
+        // and z. Resample computes the estimates on demand and keeps a few
+        // lines, so an estimate is shared by the cells adjacent to the
+        // sample rather than computed once per cell.
+        struct SampleLine
+        {
+            SampleLine()
+                :
+                iy(-1),
+                iz(-1),
+                lastUse(0),
+                D{},
+                valid{}
             {
-                for (ix0 = 1; ix0 < xBoundM1; ++ix0)
-                {
-                    FXYZ[0][iy0][ix0] = (Real)0;
-                    FXYZ[zBoundM1][iy0][ix0] = (Real)0;
-                    for (iz = 0; iz <= 2; ++iz)
-                    {
-                        for (iy = 0; iy <= 2; ++iy)
-                        {
-                            for (ix = 0; ix <= 2; ++ix)
-                            {
-                                mask = invDXDYDZ * CDer[ix] * CDer[iy] * ODer[iz];
-                                FXYZ[0][iy0][ix0] += mask * F[iz][iy0 + iy - 1][ix0 + ix - 1];
-                                FXYZ[zBoundM1][iy0][ix0] += mask * F[zBoundM1 - iz][iy0 + iy - 1][ix0 + ix - 1];
-                            }
-                        }
-                    }
-                }
             }
 
-            // xz-faces
-            for (iz0 = 1; iz0 < zBoundM1; ++iz0)
+            int32_t iy, iz;
+            size_t lastUse;
+            std::vector<std::array<Real, 8>> D;
+            std::vector<uint8_t> valid;
+        };
+
+        // Get the polynomial for a cell. In the lazy mode, the polynomial
+        // is looked up in the cache and computed when it is not found. When
+        // the cache is full, the least recently used polynomial is replaced.
+        Polynomial const& GetPolynomial(int32_t ix, int32_t iy, int32_t iz) const
+        {
+            if (mCacheCapacity == 0)
             {
-                for (ix0 = 1; ix0 < xBoundM1; ++ix0)
-                {
-                    FXYZ[iz0][0][ix0] = (Real)0;
-                    FXYZ[iz0][yBoundM1][ix0] = (Real)0;
-                    for (iz = 0; iz <= 2; ++iz)
-                    {
-                        for (iy = 0; iy <= 2; ++iy)
-                        {
-                            for (ix = 0; ix <= 2; ++ix)
-                            {
-                                mask = invDXDYDZ * CDer[ix] * ODer[iy] * CDer[iz];
-                                FXYZ[iz0][0][ix0] += mask * F[iz0 + iz - 1][iy][ix0 + ix - 1];
-                                FXYZ[iz0][yBoundM1][ix0] += mask * F[iz0 + iz - 1][yBoundM1 - iy][ix0 + ix - 1];
-                            }
-                        }
-                    }
-                }
+                return mPoly[iz][iy][ix];
             }
 
-            // yz-faces
-            for (iz0 = 1; iz0 < zBoundM1; ++iz0)
+            size_t key = static_cast<size_t>(ix) + static_cast<size_t>(mXBound) *
+                (static_cast<size_t>(iy) + static_cast<size_t>(mYBound) * static_cast<size_t>(iz));
+            auto iter = mCacheMap.find(key);
+            if (iter != mCacheMap.end())
             {
-                for (iy0 = 1; iy0 < yBoundM1; ++iy0)
-                {
-                    FXYZ[iz0][iy0][0] = (Real)0;
-                    FXYZ[iz0][iy0][xBoundM1] = (Real)0;
-                    for (iz = 0; iz <= 2; ++iz)
-                    {
-                        for (iy = 0; iy <= 2; ++iy)
-                        {
-                            for (ix = 0; ix <= 2; ++ix)
-                            {
-                                mask = invDXDYDZ * ODer[ix] * CDer[iy] * CDer[iz];
-                                FXYZ[iz0][iy0][0] += mask * F[iz0 + iz - 1][iy0 + iy - 1][ix];
-                                FXYZ[iz0][iy0][xBoundM1] += mask * F[iz0 + iz - 1][iy0 + iy - 1][xBoundM1 - ix];
-                            }
-                        }
-                    }
-                }
+                mCache.splice(mCache.begin(), mCache, iter->second);
+                return iter->second->second;
             }
 
-            // interiors
-            for (iz0 = 1; iz0 < zBoundM1; ++iz0)
+            if (mCache.size() == mCacheCapacity)
             {
-                for (iy0 = 1; iy0 < yBoundM1; ++iy0)
-                {
-                    for (ix0 = 1; ix0 < xBoundM1; ++ix0)
-                    {
-                        FXYZ[iz0][iy0][ix0] = (Real)0;
-
-                        for (iz = 0; iz <= 2; ++iz)
-                        {
-                            for (iy = 0; iy <= 2; ++iy)
-                            {
-                                for (ix = 0; ix <= 2; ++ix)
-                                {
-                                    mask = invDXDYDZ * CDer[ix] * CDer[iy] * CDer[iz];
-                                    FXYZ[iz0][iy0][ix0] += mask * F[iz0 + iz - 1][iy0 + iy - 1][ix0 + ix - 1];
-                                }
-                            }
-                        }
-                    }
-                }
+                // Reuse the node of the least recently used polynomial.
+                mCacheMap.erase(mCache.back().first);
+                mCache.splice(mCache.begin(), mCache, std::prev(mCache.end()));
+                mCache.front().first = key;
             }
-        }
-
-        void GetPolynomials(Array3<Real> const& F, Array3<Real> const& FX,
-            Array3<Real> const& FY, Array3<Real> const& FZ, Array3<Real> const& FXY,
-            Array3<Real> const& FXZ, Array3<Real> const& FYZ, Array3<Real> const& FXYZ)
-        {
-            int32_t xBoundM1 = mXBound - 1;
-            int32_t yBoundM1 = mYBound - 1;
-            int32_t zBoundM1 = mZBound - 1;
-            for (int32_t iz = 0; iz < zBoundM1; ++iz)
+            else
             {
-                for (int32_t iy = 0; iy < yBoundM1; ++iy)
-                {
-                    for (int32_t ix = 0; ix < xBoundM1; ++ix)
-                    {
-                        // Note the 'transposing' of the 2x2x2 blocks (to match
-                        // notation used in the polynomial definition).
-                        Real G[2][2][2] =
-                        {
-                            {
-                                {
-                                    F[iz][iy][ix],
-                                    F[iz + 1][iy][ix]
-                                },
-                                {
-                                    F[iz][iy + 1][ix],
-                                    F[iz + 1][iy + 1][ix]
-                                }
-                            },
-                            {
-                                {
-                                    F[iz][iy][ix + 1],
-                                    F[iz + 1][iy][ix + 1]
-                                },
-                                {
-                                    F[iz][iy + 1][ix + 1],
-                                    F[iz + 1][iy + 1][ix + 1]
-                                }
-                            }
-                        };
-
-                        Real GX[2][2][2] =
-                        {
-                            {
-                                {
-                                    FX[iz][iy][ix],
-                                    FX[iz + 1][iy][ix]
-                                },
-                                {
-                                    FX[iz][iy + 1][ix],
-                                    FX[iz + 1][iy + 1][ix]
-                                }
-                            },
-                            {
-                                {
-                                    FX[iz][iy][ix + 1],
-                                    FX[iz + 1][iy][ix + 1]
-                                },
-                                {
-                                    FX[iz][iy + 1][ix + 1],
-                                    FX[iz + 1][iy + 1][ix + 1]
-                                }
-                            }
-                        };
-
-                        Real GY[2][2][2] =
-                        {
-                            {
-                                {
-                                    FY[iz][iy][ix],
-                                    FY[iz + 1][iy][ix]
-                                },
-                                {
-                                    FY[iz][iy + 1][ix],
-                                    FY[iz + 1][iy + 1][ix]
-                                }
-                            },
-                            {
-                                {
-                                    FY[iz][iy][ix + 1],
-                                    FY[iz + 1][iy][ix + 1]
-                                },
-                                {
-                                    FY[iz][iy + 1][ix + 1],
-                                    FY[iz + 1][iy + 1][ix + 1]
-                                }
-                            }
-                        };
-
-                        Real GZ[2][2][2] =
-                        {
-                            {
-                                {
-                                    FZ[iz][iy][ix],
-                                    FZ[iz + 1][iy][ix]
-                                },
-                                {
-                                    FZ[iz][iy + 1][ix],
-                                    FZ[iz + 1][iy + 1][ix]
-                                }
-                            },
-                            {
-                                {
-                                    FZ[iz][iy][ix + 1],
-                                    FZ[iz + 1][iy][ix + 1]
-                                },
-                                {
-                                    FZ[iz][iy + 1][ix + 1],
-                                    FZ[iz + 1][iy + 1][ix + 1]
-                                }
-                            }
-                        };
-
-                        Real GXY[2][2][2] =
-                        {
-                            {
-                                {
-                                    FXY[iz][iy][ix],
-                                    FXY[iz + 1][iy][ix]
-                                },
-                                {
-                                    FXY[iz][iy + 1][ix],
-                                    FXY[iz + 1][iy + 1][ix]
-                                }
-                            },
-                            {
-                                {
-                                    FXY[iz][iy][ix + 1],
-                                    FXY[iz + 1][iy][ix + 1]
-                                },
-                                {
-                                    FXY[iz][iy + 1][ix + 1],
-                                    FXY[iz + 1][iy + 1][ix + 1]
-                                }
-                            }
-                        };
-
-                        Real GXZ[2][2][2] =
-                        {
-                            {
-                                {
-                                    FXZ[iz][iy][ix],
-                                    FXZ[iz + 1][iy][ix]
-                                },
-                                {
-                                    FXZ[iz][iy + 1][ix],
-                                    FXZ[iz + 1][iy + 1][ix]
-                                }
-                            },
-                            {
-                                {
-                                    FXZ[iz][iy][ix + 1],
-                                    FXZ[iz + 1][iy][ix + 1]
-                                },
-                                {
-                                    FXZ[iz][iy + 1][ix + 1],
-                                    FXZ[iz + 1][iy + 1][ix + 1]
-                                }
-                            }
-                        };
-
-                        Real GYZ[2][2][2] =
-                        {
-                            {
-                                {
-                                    FYZ[iz][iy][ix],
-                                    FYZ[iz + 1][iy][ix]
-                                },
-                                {
-                                    FYZ[iz][iy + 1][ix],
-                                    FYZ[iz + 1][iy + 1][ix]
-                                }
-                            },
-                            {
-                                {
-                                    FYZ[iz][iy][ix + 1],
-                                    FYZ[iz + 1][iy][ix + 1]
-                                },
-                                {
-                                    FYZ[iz][iy + 1][ix + 1],
-                                    FYZ[iz + 1][iy + 1][ix + 1]
-                                }
-                            }
-                        };
-
-                        Real GXYZ[2][2][2] =
-                        {
-                            {
-                                {
-                                    FXYZ[iz][iy][ix],
-                                    FXYZ[iz + 1][iy][ix]
-                                },
-                                {
-                                    FXYZ[iz][iy + 1][ix],
-                                    FXYZ[iz + 1][iy + 1][ix]
-                                }
-                            },
-                            {
-                                {
-                                    FXYZ[iz][iy][ix + 1],
-                                    FXYZ[iz + 1][iy][ix + 1]
-                                },
-                                {
-                                    FXYZ[iz][iy + 1][ix + 1],
-                                    FXYZ[iz + 1][iy + 1][ix + 1]
-                                }
-                            }
-                        };
-
-                        Construct(mPoly[iz][iy][ix], G, GX, GY, GZ, GXY, GXZ, GYZ, GXYZ);
-                    }
-                }
+                mCache.emplace_front(key, Polynomial());
             }
+            ComputePolynomial(ix, iy, iz, mCache.front().second);
+            mCacheMap.insert(std::make_pair(key, mCache.begin()));
+            return mCache.front().second;
         }
 
         Real ComputeDerivative(Real const* slope) const
@@ -1192,220 +813,94 @@ namespace gte
         void Construct(Polynomial& poly,
             Real const F[2][2][2], Real const FX[2][2][2], Real const FY[2][2][2],
             Real const FZ[2][2][2], Real const FXY[2][2][2], Real const FXZ[2][2][2],
-            Real const FYZ[2][2][2], Real const FXYZ[2][2][2])
-        {
-            Real dx = mXSpacing, dy = mYSpacing, dz = mZSpacing;
-            Real invDX = (Real)1 / dx, invDX2 = invDX * invDX;
-            Real invDY = (Real)1 / dy, invDY2 = invDY * invDY;
-            Real invDZ = (Real)1 / dz, invDZ2 = invDZ * invDZ;
-            Real b0, b1, b2, b3, b4, b5, b6, b7;
-
-            poly.A(0, 0, 0) = F[0][0][0];
-            poly.A(1, 0, 0) = FX[0][0][0];
-            poly.A(0, 1, 0) = FY[0][0][0];
-            poly.A(0, 0, 1) = FZ[0][0][0];
-            poly.A(1, 1, 0) = FXY[0][0][0];
-            poly.A(1, 0, 1) = FXZ[0][0][0];
-            poly.A(0, 1, 1) = FYZ[0][0][0];
-            poly.A(1, 1, 1) = FXYZ[0][0][0];
-
-            // solve for Aij0
-            b0 = (F[1][0][0] - poly(0, 0, 0, dx, (Real)0, (Real)0)) * invDX2;
-            b1 = (FX[1][0][0] - poly(1, 0, 0, dx, (Real)0, (Real)0)) * invDX;
-            poly.A(2, 0, 0) = (Real)3 * b0 - b1;
-            poly.A(3, 0, 0) = ((Real)-2 * b0 + b1) * invDX;
-
-            b0 = (F[0][1][0] - poly(0, 0, 0, (Real)0, dy, (Real)0)) * invDY2;
-            b1 = (FY[0][1][0] - poly(0, 1, 0, (Real)0, dy, (Real)0)) * invDY;
-            poly.A(0, 2, 0) = (Real)3 * b0 - b1;
-            poly.A(0, 3, 0) = ((Real)-2 * b0 + b1) * invDY;
-
-            b0 = (FY[1][0][0] - poly(0, 1, 0, dx, (Real)0, (Real)0)) * invDX2;
-            b1 = (FXY[1][0][0] - poly(1, 1, 0, dx, (Real)0, (Real)0)) * invDX;
-            poly.A(2, 1, 0) = (Real)3 * b0 - b1;
-            poly.A(3, 1, 0) = ((Real)-2 * b0 + b1) * invDX;
-
-            b0 = (FX[0][1][0] - poly(1, 0, 0, (Real)0, dy, (Real)0)) * invDY2;
-            b1 = (FXY[0][1][0] - poly(1, 1, 0, (Real)0, dy, (Real)0)) * invDY;
-            poly.A(1, 2, 0) = (Real)3 * b0 - b1;
-            poly.A(1, 3, 0) = ((Real)-2 * b0 + b1) * invDY;
-
-            b0 = (F[1][1][0] - poly(0, 0, 0, dx, dy, (Real)0)) * invDX2 * invDY2;
-            b1 = (FX[1][1][0] - poly(1, 0, 0, dx, dy, (Real)0)) * invDX * invDY2;
-            b2 = (FY[1][1][0] - poly(0, 1, 0, dx, dy, (Real)0)) * invDX2 * invDY;
-            b3 = (FXY[1][1][0] - poly(1, 1, 0, dx, dy, (Real)0)) * invDX * invDY;
-            poly.A(2, 2, 0) = (Real)9 * b0 - (Real)3 * b1 - (Real)3 * b2 + b3;
-            poly.A(3, 2, 0) = ((Real)-6 * b0 + (Real)3 * b1 + (Real)2 * b2 - b3) * invDX;
-            poly.A(2, 3, 0) = ((Real)-6 * b0 + (Real)2 * b1 + (Real)3 * b2 - b3) * invDY;
-            poly.A(3, 3, 0) = ((Real)4 * b0 - (Real)2 * b1 - (Real)2 * b2 + b3) * invDX * invDY;
-
-            // solve for Ai0k
-            b0 = (F[0][0][1] - poly(0, 0, 0, (Real)0, (Real)0, dz)) * invDZ2;
-            b1 = (FZ[0][0][1] - poly(0, 0, 1, (Real)0, (Real)0, dz)) * invDZ;
-            poly.A(0, 0, 2) = (Real)3 * b0 - b1;
-            poly.A(0, 0, 3) = ((Real)-2 * b0 + b1) * invDZ;
-
-            b0 = (FZ[1][0][0] - poly(0, 0, 1, dx, (Real)0, (Real)0)) * invDX2;
-            b1 = (FXZ[1][0][0] - poly(1, 0, 1, dx, (Real)0, (Real)0)) * invDX;
-            poly.A(2, 0, 1) = (Real)3 * b0 - b1;
-            poly.A(3, 0, 1) = ((Real)-2 * b0 + b1) * invDX;
-
-            b0 = (FX[0][0][1] - poly(1, 0, 0, (Real)0, (Real)0, dz)) * invDZ2;
-            b1 = (FXZ[0][0][1] - poly(1, 0, 1, (Real)0, (Real)0, dz)) * invDZ;
-            poly.A(1, 0, 2) = (Real)3 * b0 - b1;
-            poly.A(1, 0, 3) = ((Real)-2 * b0 + b1) * invDZ;
-
-            b0 = (F[1][0][1] - poly(0, 0, 0, dx, (Real)0, dz)) * invDX2 * invDZ2;
-            b1 = (FX[1][0][1] - poly(1, 0, 0, dx, (Real)0, dz)) * invDX * invDZ2;
-            b2 = (FZ[1][0][1] - poly(0, 0, 1, dx, (Real)0, dz)) * invDX2 * invDZ;
-            b3 = (FXZ[1][0][1] - poly(1, 0, 1, dx, (Real)0, dz)) * invDX * invDZ;
-            poly.A(2, 0, 2) = (Real)9 * b0 - (Real)3 * b1 - (Real)3 * b2 + b3;
-            poly.A(3, 0, 2) = ((Real)-6 * b0 + (Real)3 * b1 + (Real)2 * b2 - b3) * invDX;
-            poly.A(2, 0, 3) = ((Real)-6 * b0 + (Real)2 * b1 + (Real)3 * b2 - b3) * invDZ;
-            poly.A(3, 0, 3) = ((Real)4 * b0 - (Real)2 * b1 - (Real)2 * b2 + b3) * invDX * invDZ;
-
-            // solve for A0jk
-            b0 = (FZ[0][1][0] - poly(0, 0, 1, (Real)0, dy, (Real)0)) * invDY2;
-            b1 = (FYZ[0][1][0] - poly(0, 1, 1, (Real)0, dy, (Real)0)) * invDY;
-            poly.A(0, 2, 1) = (Real)3 * b0 - b1;
-            poly.A(0, 3, 1) = ((Real)-2 * b0 + b1) * invDY;
-
-            b0 = (FY[0][0][1] - poly(0, 1, 0, (Real)0, (Real)0, dz)) * invDZ2;
-            b1 = (FYZ[0][0][1] - poly(0, 1, 1, (Real)0, (Real)0, dz)) * invDZ;
-            poly.A(0, 1, 2) = (Real)3 * b0 - b1;
-            poly.A(0, 1, 3) = ((Real)-2 * b0 + b1) * invDZ;
-
-            b0 = (F[0][1][1] - poly(0, 0, 0, (Real)0, dy, dz)) * invDY2 * invDZ2;
-            b1 = (FY[0][1][1] - poly(0, 1, 0, (Real)0, dy, dz)) * invDY * invDZ2;
-            b2 = (FZ[0][1][1] - poly(0, 0, 1, (Real)0, dy, dz)) * invDY2 * invDZ;
-            b3 = (FYZ[0][1][1] - poly(0, 1, 1, (Real)0, dy, dz)) * invDY * invDZ;
-            poly.A(0, 2, 2) = (Real)9 * b0 - (Real)3 * b1 - (Real)3 * b2 + b3;
-            poly.A(0, 3, 2) = ((Real)-6 * b0 + (Real)3 * b1 + (Real)2 * b2 - b3) * invDY;
-            poly.A(0, 2, 3) = ((Real)-6 * b0 + (Real)2 * b1 + (Real)3 * b2 - b3) * invDZ;
-            poly.A(0, 3, 3) = ((Real)4 * b0 - (Real)2 * b1 - (Real)2 * b2 + b3) * invDY * invDZ;
-
-            // solve for Aij1
-            b0 = (FYZ[1][0][0] - poly(0, 1, 1, dx, (Real)0, (Real)0)) * invDX2;
-            b1 = (FXYZ[1][0][0] - poly(1, 1, 1, dx, (Real)0, (Real)0)) * invDX;
-            poly.A(2, 1, 1) = (Real)3 * b0 - b1;
-            poly.A(3, 1, 1) = ((Real)-2 * b0 + b1) * invDX;
-
-            b0 = (FXZ[0][1][0] - poly(1, 0, 1, (Real)0, dy, (Real)0)) * invDY2;
-            b1 = (FXYZ[0][1][0] - poly(1, 1, 1, (Real)0, dy, (Real)0)) * invDY;
-            poly.A(1, 2, 1) = (Real)3 * b0 - b1;
-            poly.A(1, 3, 1) = ((Real)-2 * b0 + b1) * invDY;
-
-            b0 = (FZ[1][1][0] - poly(0, 0, 1, dx, dy, (Real)0)) * invDX2 * invDY2;
-            b1 = (FXZ[1][1][0] - poly(1, 0, 1, dx, dy, (Real)0)) * invDX * invDY2;
-            b2 = (FYZ[1][1][0] - poly(0, 1, 1, dx, dy, (Real)0)) * invDX2 * invDY;
-            b3 = (FXYZ[1][1][0] - poly(1, 1, 1, dx, dy, (Real)0)) * invDX * invDY;
-            poly.A(2, 2, 1) = (Real)9 * b0 - (Real)3 * b1 - (Real)3 * b2 + b3;
-            poly.A(3, 2, 1) = ((Real)-6 * b0 + (Real)3 * b1 + (Real)2 * b2 - b3) * invDX;
-            poly.A(2, 3, 1) = ((Real)-6 * b0 + (Real)2 * b1 + (Real)3 * b2 - b3) * invDY;
-            poly.A(3, 3, 1) = ((Real)4 * b0 - (Real)2 * b1 - (Real)2 * b2 + b3) * invDX * invDY;
-
-            // solve for Ai1k
-            b0 = (FXY[0][0][1] - poly(1, 1, 0, (Real)0, (Real)0, dz)) * invDZ2;
-            b1 = (FXYZ[0][0][1] - poly(1, 1, 1, (Real)0, (Real)0, dz)) * invDZ;
-            poly.A(1, 1, 2) = (Real)3 * b0 - b1;
-            poly.A(1, 1, 3) = ((Real)-2 * b0 + b1) * invDZ;
-
-            b0 = (FY[1][0][1] - poly(0, 1, 0, dx, (Real)0, dz)) * invDX2 * invDZ2;
-            b1 = (FXY[1][0][1] - poly(1, 1, 0, dx, (Real)0, dz)) * invDX * invDZ2;
-            b2 = (FYZ[1][0][1] - poly(0, 1, 1, dx, (Real)0, dz)) * invDX2 * invDZ;
-            b3 = (FXYZ[1][0][1] - poly(1, 1, 1, dx, (Real)0, dz)) * invDX * invDZ;
-            poly.A(2, 1, 2) = (Real)9 * b0 - (Real)3 * b1 - (Real)3 * b2 + b3;
-            poly.A(3, 1, 2) = ((Real)-6 * b0 + (Real)3 * b1 + (Real)2 * b2 - b3) * invDX;
-            poly.A(2, 1, 3) = ((Real)-6 * b0 + (Real)2 * b1 + (Real)3 * b2 - b3) * invDZ;
-            poly.A(3, 1, 3) = ((Real)4 * b0 - (Real)2 * b1 - (Real)2 * b2 + b3) * invDX * invDZ;
-
-            // solve for A1jk
-            b0 = (FX[0][1][1] - poly(1, 0, 0, (Real)0, dy, dz)) * invDY2 * invDZ2;
-            b1 = (FXY[0][1][1] - poly(1, 1, 0, (Real)0, dy, dz)) * invDY * invDZ2;
-            b2 = (FXZ[0][1][1] - poly(1, 0, 1, (Real)0, dy, dz)) * invDY2 * invDZ;
-            b3 = (FXYZ[0][1][1] - poly(1, 1, 1, (Real)0, dy, dz)) * invDY * invDZ;
-            poly.A(1, 2, 2) = (Real)9 * b0 - (Real)3 * b1 - (Real)3 * b2 + b3;
-            poly.A(1, 3, 2) = ((Real)-6 * b0 + (Real)3 * b1 + (Real)2 * b2 - b3) * invDY;
-            poly.A(1, 2, 3) = ((Real)-6 * b0 + (Real)2 * b1 + (Real)3 * b2 - b3) * invDZ;
-            poly.A(1, 3, 3) = ((Real)4 * b0 - (Real)2 * b1 - (Real)2 * b2 + b3) * invDY * invDZ;
-
-            // solve for remaining Aijk with i >= 2, j >= 2, k >= 2
-            b0 = (F[1][1][1] - poly(0, 0, 0, dx, dy, dz)) * invDX2 * invDY2 * invDZ2;
-            b1 = (FX[1][1][1] - poly(1, 0, 0, dx, dy, dz)) * invDX * invDY2 * invDZ2;
-            b2 = (FY[1][1][1] - poly(0, 1, 0, dx, dy, dz)) * invDX2 * invDY * invDZ2;
-            b3 = (FZ[1][1][1] - poly(0, 0, 1, dx, dy, dz)) * invDX2 * invDY2 * invDZ;
-            b4 = (FXY[1][1][1] - poly(1, 1, 0, dx, dy, dz)) * invDX * invDY * invDZ2;
-            b5 = (FXZ[1][1][1] - poly(1, 0, 1, dx, dy, dz)) * invDX * invDY2 * invDZ;
-            b6 = (FYZ[1][1][1] - poly(0, 1, 1, dx, dy, dz)) * invDX2 * invDY * invDZ;
-            b7 = (FXYZ[1][1][1] - poly(1, 1, 1, dx, dy, dz)) * invDX * invDY * invDZ;
-            poly.A(2, 2, 2) = (Real)27 * b0 - (Real)9 * b1 - (Real)9 * b2 -
-                (Real)9 * b3 + (Real)3 * b4 + (Real)3 * b5 + (Real)3 * b6 - b7;
-            poly.A(3, 2, 2) = ((Real)-18 * b0 + (Real)9 * b1 + (Real)6 * b2 +
-                (Real)6 * b3 - (Real)3 * b4 - (Real)3 * b5 - (Real)2 * b6 + b7) * invDX;
-            poly.A(2, 3, 2) = ((Real)-18 * b0 + (Real)6 * b1 + (Real)9 * b2 +
-                (Real)6 * b3 - (Real)3 * b4 - (Real)2 * b5 - (Real)3 * b6 + b7) * invDY;
-            poly.A(2, 2, 3) = ((Real)-18 * b0 + (Real)6 * b1 + (Real)6 * b2 +
-                (Real)9 * b3 - (Real)2 * b4 - (Real)3 * b5 - (Real)3 * b6 + b7) * invDZ;
-            poly.A(3, 3, 2) = ((Real)12 * b0 - (Real)6 * b1 - (Real)6 * b2 -
-                (Real)4 * b3 + (Real)3 * b4 + (Real)2 * b5 + (Real)2 * b6 - b7) *
-                invDX * invDY;
-            poly.A(3, 2, 3) = ((Real)12 * b0 - (Real)6 * b1 - (Real)4 * b2 -
-                (Real)6 * b3 + (Real)2 * b4 + (Real)3 * b5 + (Real)2 * b6 - b7) *
-                invDX * invDZ;
-            poly.A(2, 3, 3) = ((Real)12 * b0 - (Real)4 * b1 - (Real)6 * b2 -
-                (Real)6 * b3 + (Real)2 * b4 + (Real)2 * b5 + (Real)3 * b6 - b7) *
-                invDY * invDZ;
-            poly.A(3, 3, 3) = ((Real)-8 * b0 + (Real)4 * b1 + (Real)4 * b2 +
-                (Real)4 * b3 - (Real)2 * b4 - (Real)2 * b5 - (Real)2 * b6 + b7) *
-                invDX * invDY * invDZ;
-        }
-
-        void XLookup(Real x, int32_t& xIndex, Real& dx) const
+            Real const FYZ[2][2][2], Real const FXYZ[2][2][2]) const
         {
-            int32_t xIndexP1;
-            for (xIndex = 0, xIndexP1 = 1; xIndexP1 < mXBound; ++xIndex, ++xIndexP1)
+            // The polynomial is the tensor product of cubic Hermite
+            // interpolants. The corner data are stored in a 4x4x4 tensor.
+            // The tensor index per dimension is 0 for the value at 0, 1 for
+            // the value at the spacing, 2 for the derivative at 0 or 3 for
+            // the derivative at the spacing. Each dimension is then
+            // converted from Hermite data to power-basis coefficients, which
+            // requires 16 transformations per dimension.
+            Real const (*data[8])[2][2] = { F, FX, FY, FXY, FZ, FXZ, FYZ, FXYZ };
+            Real T[4][4][4];
+            for (int32_t a = 0; a < 4; ++a)
             {
-                if (x < mXMin + mXSpacing * static_cast<Real>(xIndexP1))
+                for (int32_t b = 0; b < 4; ++b)
                 {
-                    dx = x - (mXMin + mXSpacing * xIndex);
-                    return;
+                    for (int32_t c = 0; c < 4; ++c)
+                    {
+                        int32_t derivative = (a >> 1) | (b & 2) | ((c & 2) << 1);
+                        T[a][b][c] = data[derivative][a & 1][b & 1][c & 1];
+                    }
                 }
             }
 
-            --xIndex;
-            dx = x - (mXMin + mXSpacing * xIndex);
-        }
-
-        void YLookup(Real y, int32_t& yIndex, Real & dy) const
-        {
-            int32_t yIndexP1;
-            for (yIndex = 0, yIndexP1 = 1; yIndexP1 < mYBound; ++yIndex, ++yIndexP1)
+            // Convert (v0, v1, d0, d1) to the coefficients of the cubic with
+            // those values and derivatives at 0 and h.
+            auto convert = [](Real h, Real& v0, Real& v1, Real& d0, Real& d1)
+            {
+                Real invH = (Real)1 / h;
+                Real slope = (v1 - v0) * invH;
+                Real c2 = ((Real)3 * slope - (Real)2 * d0 - d1) * invH;
+                Real c3 = (d0 + d1 - (Real)2 * slope) * invH * invH;
+                v1 = d0;
+                d0 = c2;
+                d1 = c3;
+            };
+
+            for (int32_t j = 0; j < 4; ++j)
             {
-                if (y < mYMin + mYSpacing * static_cast<Real>(yIndexP1))
+                for (int32_t k = 0; k < 4; ++k)
                 {
-                    dy = y - (mYMin + mYSpacing * yIndex);
-                    return;
+                    convert(mXSpacing, T[0][j][k], T[1][j][k], T[2][j][k], T[3][j][k]);
+                }
+            }
+            for (int32_t i = 0; i < 4; ++i)
+            {
+                for (int32_t k = 0; k < 4; ++k)
+                {
+                    convert(mYSpacing, T[i][0][k], T[i][1][k], T[i][2][k], T[i][3][k]);
+                }
+            }
+            for (int32_t i = 0; i < 4; ++i)
+            {
+                for (int32_t j = 0; j < 4; ++j)
+                {
+                    convert(mZSpacing, T[i][j][0], T[i][j][1], T[i][j][2], T[i][j][3]);
                 }
             }
 
-            --yIndex;
-            dy = y - (mYMin + mYSpacing * yIndex);
-        }
-
-        void ZLookup(Real z, int32_t& zIndex, Real & dz) const
-        {
-            int32_t zIndexP1;
-            for (zIndex = 0, zIndexP1 = 1; zIndexP1 < mZBound; ++zIndex, ++zIndexP1)
+            for (int32_t i = 0; i < 4; ++i)
             {
-                if (z < mZMin + mZSpacing * static_cast<Real>(zIndexP1))
+                for (int32_t j = 0; j < 4; ++j)
                 {
-                    dz = z - (mZMin + mZSpacing * zIndex);
-                    return;
+                    for (int32_t k = 0; k < 4; ++k)
+                    {
+                        poly.A(i, j, k) = T[i][j][k];
+                    }
                 }
             }
+        }
 
-            --zIndex;
-            dz = z - (mZMin + mZSpacing * zIndex);
+        // The cell index is clamped to the last cell, so the maximum sample
+        // is interpolated by the polynomial of the last cell.
+        void XLookup(Real x, int32_t& xIndex, Real& dx) const
+        {
+            xIndex = std::min(static_cast<int32_t>((x - mXMin) / mXSpacing), mXBound - 2);
+            dx = x - (mXMin + mXSpacing * static_cast<Real>(xIndex));
+        }
+
+        void YLookup(Real y, int32_t& yIndex, Real& dy) const
+        {
+            yIndex = std::min(static_cast<int32_t>((y - mYMin) / mYSpacing), mYBound - 2);
+            dy = y - (mYMin + mYSpacing * static_cast<Real>(yIndex));
+        }
+
+        void ZLookup(Real z, int32_t& zIndex, Real& dz) const
+        {
+            zIndex = std::min(static_cast<int32_t>((z - mZMin) / mZSpacing), mZBound - 2);
+            dz = z - (mZMin + mZSpacing * static_cast<Real>(zIndex));
         }
 
         int32_t mXBound, mYBound, mZBound, mQuantity;
@@ -1413,6 +908,16 @@ namespace gte
         Real mYMin, mYMax, mYSpacing;
         Real mZMin, mZMax, mZSpacing;
         Real const* mF;
+
+        // The polynomials for all the cells when the cache capacity is 0.
         Array3<Polynomial> mPoly;
+
+        // The least-recently-used cache of the lazy mode. The list is
+        // ordered from most to least recently used and the map stores the
+        // list position for a cell index.
+        using CacheList = std::list<std::pair<size_t, Polynomial>>;
+        size_t mCacheCapacity;
+        mutable CacheList mCache;
+        mutable std::unordered_map<size_t, typename CacheList::iterator> mCacheMap;
     };
 }
@@ -3,12 +3,15 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 6.0.2022.01.06
+// Version: 6.3.2026.10.17
 
 #pragma once
 
 #include <GTE/Mathematics/Logger.h>
+#include <algorithm>
 #include <array>
+#include <thread>
+#include <vector>
 
 // The interpolator is for uniformly spaced(x,y z)-values.  The input samples
 // must be stored in lexicographical order to represent f(x,y,z); that is,
@@ -18,6 +21,11 @@
 // to 'true', giving you the Catmull-Rom blending matrix.  If a smooth
 // interpolation is desired, set catmullRom to 'false' to obtain B-spline
 // blending.
+//
+// The interpolator stores only a pointer to the samples. Resampling on a
+// regular grid is supported by a batched function. The blending weights
+// are separable, so the weights for each grid coordinate are computed once
+// rather than once per grid point.
 
 namespace gte
 {
@@ -48,11 +56,11 @@ namespace gte
                 && xSpacing > (Real)0 && ySpacing > (Real)0 && zSpacing > (Real)0,
                 "Invalid input.");
 
-            mXMax = mXMin + mXSpacing * static_cast<Real>(mXBound) - static_cast<Real>(1);
+            mXMax = mXMin + mXSpacing * static_cast<Real>(mXBound - 1);
             mInvXSpacing = (Real)1 / mXSpacing;
-            mYMax = mYMin + mYSpacing * static_cast<Real>(mYBound) - static_cast<Real>(1);
+            mYMax = mYMin + mYSpacing * static_cast<Real>(mYBound - 1);
             mInvYSpacing = (Real)1 / mYSpacing;
-            mZMax = mZMin + mZSpacing * static_cast<Real>(mZBound) - static_cast<Real>(1);
+            mZMax = mZMin + mZSpacing * static_cast<Real>(mZBound - 1);
             mInvZSpacing = (Real)1 / mZSpacing;
 
             if (catmullRom)
@@ -517,7 +525,175 @@ namespace gte
             return result;
         }
 
+        // Evaluate the function or a derivative at the numX*numY*numZ points
+        // (x0 + i*xDelta, y0 + j*yDelta, z0 + k*zDelta) of a regular grid,
+        // where 0 <= i < numX, 0 <= j < numY and 0 <= k < numZ. The value
+        // for (i,j,k) is stored in output[i + numX*(j + numY*k)], so output
+        // must have numX*numY*numZ elements. The values are those of the
+        // second operator(). To run in the main thread only, choose
+        // numThreads to be 0. For multithreading, choose numThreads > 0;
+        // each thread processes a subrange of the k-indices.
+        void Resample(int32_t xOrder, int32_t yOrder, int32_t zOrder,
+            int32_t numX, Real x0, Real xDelta,
+            int32_t numY, Real y0, Real yDelta,
+            int32_t numZ, Real z0, Real zDelta,
+            Real* output, size_t numThreads = 0) const
+        {
+            LogAssert(numX > 0 && numY > 0 && numZ > 0 && output != nullptr, "Invalid input.");
+
+            size_t const sizeX = static_cast<size_t>(numX);
+            size_t const sizeY = static_cast<size_t>(numY);
+            size_t const sizeZ = static_cast<size_t>(numZ);
+            if (xOrder < 0 || xOrder > 3 || yOrder < 0 || yOrder > 3 || zOrder < 0 || zOrder > 3)
+            {
+                std::fill(output, output + sizeX * sizeY * sizeZ, (Real)0);
+                return;
+            }
+
+            // The x-offsets are sample indices, the y-offsets are multiples
+            // of xBound and the z-offsets are multiples of xBound*yBound.
+            std::vector<std::array<size_t, 4>> xOffset(sizeX), yOffset(sizeY), zOffset(sizeZ);
+            std::vector<std::array<Real, 4>> xWeight(sizeX), yWeight(sizeY), zWeight(sizeZ);
+            size_t const xBound = static_cast<size_t>(mXBound);
+            size_t const xyBound = xBound * static_cast<size_t>(mYBound);
+            for (size_t i = 0; i < sizeX; ++i)
+            {
+                Real x = x0 + xDelta * static_cast<Real>(i);
+                GetWeights(xOrder, (x - mXMin) * mInvXSpacing, mXBound, mInvXSpacing,
+                    1, xOffset[i], xWeight[i]);
+            }
+            for (size_t j = 0; j < sizeY; ++j)
+            {
+                Real y = y0 + yDelta * static_cast<Real>(j);
+                GetWeights(yOrder, (y - mYMin) * mInvYSpacing, mYBound, mInvYSpacing,
+                    xBound, yOffset[j], yWeight[j]);
+            }
+            for (size_t k = 0; k < sizeZ; ++k)
+            {
+                Real z = z0 + zDelta * static_cast<Real>(k);
+                GetWeights(zOrder, (z - mZMin) * mInvZSpacing, mZBound, mInvZSpacing,
+                    xyBound, zOffset[k], zWeight[k]);
+            }
+
+            auto resample = [this, sizeX, sizeY, &xOffset, &yOffset, &zOffset,
+                &xWeight, &yWeight, &zWeight, output](size_t kMin, size_t kSup)
+            {
+                for (size_t k = kMin; k < kSup; ++k)
+                {
+                    for (size_t j = 0; j < sizeY; ++j)
+                    {
+                        // Blend the 16 lines of samples in z and y, and then
+                        // blend the line in x for each grid point.
+                        std::array<Real const*, 16> line;
+                        std::array<Real, 16> lineWeight;
+                        for (size_t slice = 0; slice < 4; ++slice)
+                        {
+                            for (size_t row = 0; row < 4; ++row)
+                            {
+                                line[row + 4 * slice] = mF + zOffset[k][slice] + yOffset[j][row];
+                                lineWeight[row + 4 * slice] = zWeight[k][slice] * yWeight[j][row];
+                            }
+                        }
+
+                        Real* current = output + sizeX * (j + sizeY * k);
+                        for (size_t i = 0; i < sizeX; ++i)
+                        {
+                            std::array<size_t, 4> const& offset = xOffset[i];
+                            std::array<Real, 4> const& weight = xWeight[i];
+                            Real result = (Real)0;
+                            for (size_t m = 0; m < 16; ++m)
+                            {
+                                Real const* F = line[m];
+                                result += lineWeight[m] * (
+                                    weight[0] * F[offset[0]] + weight[1] * F[offset[1]] +
+                                    weight[2] * F[offset[2]] + weight[3] * F[offset[3]]);
+                            }
+                            current[i] = result;
+                        }
+                    }
+                }
+            };
+
+            if (numThreads > 0)
+            {
+                numThreads = std::min(numThreads, sizeZ);
+                std::vector<std::thread> process(numThreads);
+                for (size_t t = 0; t < numThreads; ++t)
+                {
+                    size_t kMin = t * sizeZ / numThreads;
+                    size_t kSup = (t + 1) * sizeZ / numThreads;
+                    process[t] = std::thread([&resample, kMin, kSup]()
+                    {
+                        resample(kMin, kSup);
+                    });
+                }
+                for (size_t t = 0; t < numThreads; ++t)
+                {
+                    process[t].join();
+                }
+            }
+            else
+            {
+                resample(0, sizeZ);
+            }
+        }
+
     private:
+        // Compute the blending weights and the clamped sample offsets for
+        // one dimension, where 'index' is the continuous sample index of the
+        // coordinate and 'stride' is the distance between consecutive
+        // samples in that dimension. The derivative scale factor is
+        // included in the weights. The order must be in {0,1,2,3}.
+        void GetWeights(int32_t order, Real index, int32_t bound, Real invSpacing,
+            size_t stride, std::array<size_t, 4>& offset, std::array<Real, 4>& weight) const
+        {
+            int32_t i = static_cast<int32_t>(index);
+            if (i < 0)
+            {
+                i = 0;
+            }
+            else if (i >= bound)
+            {
+                i = bound - 1;
+            }
+
+            Real d = index - static_cast<Real>(i);
+            std::array<Real, 4> U;
+            Real mult;
+            switch (order)
+            {
+            case 0:
+                U = { (Real)1, d, d * d, d * d * d };
+                mult = (Real)1;
+                break;
+            case 1:
+                U = { (Real)0, (Real)1, (Real)2 * d, (Real)3 * d * d };
+                mult = invSpacing;
+                break;
+            case 2:
+                U = { (Real)0, (Real)0, (Real)2, (Real)6 * d };
+                mult = invSpacing * invSpacing;
+                break;
+            default:
+                U = { (Real)0, (Real)0, (Real)0, (Real)6 };
+                mult = invSpacing * invSpacing * invSpacing;
+                break;
+            }
+
+            for (int32_t row = 0; row < 4; ++row)
+            {
+                weight[row] = (Real)0;
+                for (int32_t col = 0; col < 4; ++col)
+                {
+                    weight[row] += mBlend[row][col] * U[col];
+                }
+                weight[row] *= mult;
+
+                int32_t clamp = std::min(std::max(i - 1 + row, 0), bound - 1);
+                offset[row] = static_cast<size_t>(clamp) * stride;
+            }
+        }
+
         int32_t mXBound, mYBound, mZBound, mQuantity;
         Real mXMin, mXMax, mXSpacing, mInvXSpacing;
         Real mYMin, mYMax, mYSpacing, mInvYSpacing;
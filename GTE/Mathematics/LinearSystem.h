@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 6.0.2022.01.06
+// Version: 6.3.2026.10.17
 
 #pragma once
 
@@ -12,6 +12,7 @@
 #include <GTE/Mathematics/Matrix4x4.h>
 #include <GTE/Mathematics/GaussianElimination.h>
 #include <map>
+#include <vector>
 
 // Solve linear systems of equations where the matrix A is NxN.  The return
 // value of a function is 'true' when A is invertible.  In this case the
@@ -269,6 +270,107 @@ namespace gte
             return iteration;
         }
 
+        // A sparse matrix in compressed sparse row (CSR) format. The nonzero
+        // entries of row r are values[k] in columns columns[k] for
+        // rowStart[r] <= k < rowStart[r+1], so rowStart has N+1 elements.
+        // Unlike SparseMatrix, both (i,j) and (j,i) are stored for a
+        // symmetric matrix, which allows the rows of a matrix-vector
+        // product to be computed independently.
+        struct CSRMatrix
+        {
+            CSRMatrix()
+                :
+                rowStart{},
+                columns{},
+                values{}
+            {
+            }
+
+            std::vector<int32_t> rowStart;
+            std::vector<int32_t> columns;
+            std::vector<Real> values;
+        };
+
+        // Solve A*X = B using the conjugate gradient method preconditioned
+        // by the diagonal of A (Jacobi preconditioner), where A is sparse,
+        // symmetric and has nonnegative diagonal entries. The termination
+        // criterion is the same as that of SolveSymmetricCG: the iterations
+        // stop when |B-A*X| <= tolerance*|B|. When useInitialX is 'true',
+        // the input X is the initial guess (warm start); otherwise, the
+        // initial guess is zero.
+        static uint32_t SolveSymmetricPCG(int32_t N, CSRMatrix const& A,
+            Real const* B, Real* X, uint32_t maxIterations, Real tolerance,
+            bool useInitialX = false)
+        {
+            LogAssert(N > 0 && A.rowStart.size() == static_cast<size_t>(N) + 1,
+                "Invalid argument.");
+
+            // The inverse diagonal is the preconditioner. Zero-valued
+            // diagonal entries are not preconditioned.
+            std::vector<Real> invDiagonal(N, (Real)1);
+            for (int32_t row = 0; row < N; ++row)
+            {
+                for (int32_t k = A.rowStart[row]; k < A.rowStart[row + 1]; ++k)
+                {
+                    if (A.columns[k] == row && A.values[k] > (Real)0)
+                    {
+                        invDiagonal[row] = (Real)1 / A.values[k];
+                    }
+                }
+            }
+
+            std::vector<Real> tmpR(N), tmpZ(N), tmpP(N), tmpW(N);
+            Real* R = tmpR.data();
+            Real* Z = tmpZ.data();
+            Real* P = tmpP.data();
+            Real* W = tmpW.data();
+            size_t numBytes = N * sizeof(Real);
+            if (useInitialX)
+            {
+                Mul(N, A, X, W);
+                for (int32_t i = 0; i < N; ++i)
+                {
+                    R[i] = B[i] - W[i];
+                }
+            }
+            else
+            {
+                std::memset(X, 0, numBytes);
+                std::memcpy(R, B, numBytes);
+            }
+
+            Real const bound = tolerance * std::sqrt(Dot(N, B, B));
+            uint32_t iteration;
+            Real rho0 = (Real)0;
+            for (iteration = 0; iteration < maxIterations; ++iteration)
+            {
+                if (std::sqrt(Dot(N, R, R)) <= bound)
+                {
+                    break;
+                }
+
+                for (int32_t i = 0; i < N; ++i)
+                {
+                    Z[i] = invDiagonal[i] * R[i];
+                }
+                Real rho1 = Dot(N, R, Z);
+                if (iteration == 0)
+                {
+                    std::memcpy(P, Z, numBytes);
+                }
+                else
+                {
+                    UpdateP(N, P, rho1 / rho0, Z);
+                }
+                Mul(N, A, P, W);
+                Real alpha = rho1 / Dot(N, P, W);
+                UpdateX(N, X, alpha, P);
+                UpdateR(N, R, alpha, W);
+                rho0 = rho1;
+            }
+            return iteration;
+        }
+
     private:
         // Support for the conjugate gradient method.
         static Real Dot(int32_t N, Real const* U, Real const* V)
@@ -315,6 +417,19 @@ namespace gte
             }
         }
 
+        static void Mul(int32_t N, CSRMatrix const& A, Real const* X, Real* P)
+        {
+            for (int32_t row = 0; row < N; ++row)
+            {
+                Real sum = (Real)0;
+                for (int32_t k = A.rowStart[row]; k < A.rowStart[row + 1]; ++k)
+                {
+                    sum += A.values[k] * X[A.columns[k]];
+                }
+                P[row] = sum;
+            }
+        }
+
         static void UpdateX(int32_t N, Real* X, Real alpha, Real const* P)
         {
             for (int32_t i = 0; i < N; ++i)
@@ -0,0 +1,576 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2022
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 6.3.2026.10.17
+
+#pragma once
+
+#include <GTE/Mathematics/Logger.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+// Bounded lock-free ring-buffer queues. SPSCQueue supports one producer
+// thread and one consumer thread. MPMCQueue supports any number of producer
+// and consumer threads; it is the algorithm of Dmitry Vyukov, where each
+// ring slot has a sequence number that tells the producers and consumers
+// whether the slot is ready for them, so the threads contend only on the
+// atomic increments of the enqueue and dequeue positions.
+//
+// Push and Pop never block. They return 'false' when the queue is full or
+// empty, respectively, in which case the input element of Push is not
+// moved from. WaitPush and WaitPop block until the operation succeeds or,
+// for the overloads with a timeout, until the time has elapsed. A waiting
+// thread spins briefly and then sleeps on a condition variable. The
+// producers and consumers lock the mutex of the condition variable only
+// when threads are sleeping on it.
+//
+// The elements need only be movable (and copyable when the Push overload
+// for const references is used). The indices of the producers and of the
+// consumers are in different cache lines to avoid false sharing.
+
+namespace gte
+{
+    // The blocking support shared by the queues.
+    class QueueWaiter
+    {
+    public:
+        enum
+        {
+            NUM_SPINS = 64
+        };
+
+        QueueWaiter()
+            :
+            mNumWaiters(0),
+            mEpoch(0),
+            mMutex{},
+            mCondition{}
+        {
+        }
+
+        // Call this after a queue operation succeeds, which might allow a
+        // sleeping thread to succeed. The fence orders the operation before
+        // the load of the number of waiters. Without it a waiter could
+        // register after the load and then miss the operation.
+        void Notify()
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (mNumWaiters.load(std::memory_order_relaxed) > 0)
+            {
+                // A waiter whose attempt failed before the operation either
+                // sees the new epoch or is sleeping when it is notified.
+                mMutex.lock();
+                mEpoch.fetch_add(1, std::memory_order_release);
+                mMutex.unlock();
+                mCondition.notify_all();
+            }
+        }
+
+        // Wait until tryOperation() returns 'true'. The operation is not
+        // called while the mutex is locked, because it notifies the waiter
+        // for the opposite operation.
+        template <typename Operation>
+        void Wait(Operation tryOperation)
+        {
+            if (Spin(tryOperation))
+            {
+                return;
+            }
+
+            Register();
+            for (;;)
+            {
+                uint64_t const epoch = mEpoch.load(std::memory_order_acquire);
+                if (tryOperation())
+                {
+                    break;
+                }
+
+                std::unique_lock<std::mutex> lock(mMutex);
+                while (mEpoch.load(std::memory_order_relaxed) == epoch)
+                {
+                    mCondition.wait(lock);
+                }
+            }
+            Unregister();
+        }
+
+        // Wait until tryOperation() returns 'true' or until the deadline.
+        // The return value is the last result of tryOperation().
+        template <typename Operation, typename Clock, typename Duration>
+        bool WaitUntil(Operation tryOperation,
+            std::chrono::time_point<Clock, Duration> const& deadline)
+        {
+            if (Spin(tryOperation))
+            {
+                return true;
+            }
+
+            Register();
+            bool succeeded = false;
+            for (;;)
+            {
+                uint64_t const epoch = mEpoch.load(std::memory_order_acquire);
+                succeeded = tryOperation();
+                if (succeeded)
+                {
+                    break;
+                }
+
+                std::unique_lock<std::mutex> lock(mMutex);
+                bool timedOut = false;
+                while (!timedOut && mEpoch.load(std::memory_order_relaxed) == epoch)
+                {
+                    timedOut = (mCondition.wait_until(lock, deadline) == std::cv_status::timeout);
+                }
+                if (timedOut)
+                {
+                    lock.unlock();
+                    succeeded = tryOperation();
+                    break;
+                }
+            }
+            Unregister();
+            return succeeded;
+        }
+
+    private:
+        template <typename Operation>
+        static bool Spin(Operation& tryOperation)
+        {
+            for (int32_t i = 0; i < NUM_SPINS; ++i)
+            {
+                if (tryOperation())
+                {
+                    return true;
+                }
+                std::this_thread::yield();
+            }
+            return false;
+        }
+
+        inline void Register()
+        {
+            mNumWaiters.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+
+        inline void Unregister()
+        {
+            mNumWaiters.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        // The epoch is incremented by each notification while waiters
+        // are registered.
+        std::atomic<int32_t> mNumWaiters;
+        std::atomic<uint64_t> mEpoch;
+        std::mutex mMutex;
+        std::condition_variable mCondition;
+    };
+
+    // The number of bytes that separates data accessed by different threads.
+    // It is at least the size of a cache line on current CPUs.
+    size_t constexpr queueCacheLineSize = 64;
+
+    template <typename Element>
+    class SPSCQueue
+    {
+    public:
+        // Construction and destruction. The maximum number of elements must
+        // be positive.
+        SPSCQueue(size_t maxNumElements)
+            :
+            mMaxNumElements(maxNumElements),
+            mNumSlots(maxNumElements + 1),
+            mSlots(new Slot[maxNumElements + 1]),
+            mHead(0),
+            mCachedTail(0),
+            mTail(0),
+            mCachedHead(0),
+            mNotEmpty{},
+            mNotFull{}
+        {
+            LogAssert(maxNumElements > 0, "The queue must have positive capacity.");
+        }
+
+        ~SPSCQueue()
+        {
+            size_t const tail = mTail.load(std::memory_order_relaxed);
+            for (size_t head = mHead.load(std::memory_order_relaxed); head != tail;
+                head = GetNext(head))
+            {
+                GetElement(head)->~Element();
+            }
+        }
+
+        // Disallow copying and moving.
+        SPSCQueue(SPSCQueue const&) = delete;
+        SPSCQueue& operator=(SPSCQueue const&) = delete;
+        SPSCQueue(SPSCQueue&&) = delete;
+        SPSCQueue& operator=(SPSCQueue&&) = delete;
+
+        inline size_t GetMaxNumElements() const
+        {
+            return mMaxNumElements;
+        }
+
+        // The number is exact only when the producer and consumer are idle.
+        size_t GetNumElements() const
+        {
+            size_t const head = mHead.load(std::memory_order_acquire);
+            size_t const tail = mTail.load(std::memory_order_acquire);
+            return (tail >= head ? tail - head : tail + mNumSlots - head);
+        }
+
+        // Call these only from the producer thread.
+        inline bool Push(Element const& element)
+        {
+            return TryPush(element);
+        }
+
+        inline bool Push(Element&& element)
+        {
+            return TryPush(std::move(element));
+        }
+
+        void WaitPush(Element&& element)
+        {
+            mNotFull.Wait([this, &element]() { return TryPush(std::move(element)); });
+        }
+
+        void WaitPush(Element const& element)
+        {
+            mNotFull.Wait([this, &element]() { return TryPush(element); });
+        }
+
+        template <typename Rep, typename Period>
+        bool WaitPush(Element&& element, std::chrono::duration<Rep, Period> const& timeout)
+        {
+            return mNotFull.WaitUntil(
+                [this, &element]() { return TryPush(std::move(element)); },
+                std::chrono::steady_clock::now() + timeout);
+        }
+
+        template <typename Rep, typename Period>
+        bool WaitPush(Element const& element, std::chrono::duration<Rep, Period> const& timeout)
+        {
+            return mNotFull.WaitUntil([this, &element]() { return TryPush(element); },
+                std::chrono::steady_clock::now() + timeout);
+        }
+
+        // Call these only from the consumer thread.
+        bool Pop(Element& element)
+        {
+            size_t const head = mHead.load(std::memory_order_relaxed);
+            if (head == mCachedTail)
+            {
+                mCachedTail = mTail.load(std::memory_order_acquire);
+                if (head == mCachedTail)
+                {
+                    return false;
+                }
+            }
+
+            Element* stored = GetElement(head);
+            element = std::move(*stored);
+            stored->~Element();
+            mHead.store(GetNext(head), std::memory_order_release);
+            mNotFull.Notify();
+            return true;
+        }
+
+        void WaitPop(Element& element)
+        {
+            mNotEmpty.Wait([this, &element]() { return Pop(element); });
+        }
+
+        template <typename Rep, typename Period>
+        bool WaitPop(Element& element, std::chrono::duration<Rep, Period> const& timeout)
+        {
+            return mNotEmpty.WaitUntil([this, &element]() { return Pop(element); },
+                std::chrono::steady_clock::now() + timeout);
+        }
+
+    private:
+        using Slot = typename std::aligned_storage<sizeof(Element), alignof(Element)>::type;
+
+        template <typename Input>
+        bool TryPush(Input&& element)
+        {
+            size_t const tail = mTail.load(std::memory_order_relaxed);
+            size_t const next = GetNext(tail);
+            if (next == mCachedHead)
+            {
+                mCachedHead = mHead.load(std::memory_order_acquire);
+                if (next == mCachedHead)
+                {
+                    return false;
+                }
+            }
+
+            new (&mSlots[tail]) Element(std::forward<Input>(element));
+            mTail.store(next, std::memory_order_release);
+            mNotEmpty.Notify();
+            return true;
+        }
+
+        inline size_t GetNext(size_t index) const
+        {
+            return (index + 1 < mNumSlots ? index + 1 : 0);
+        }
+
+        inline Element* GetElement(size_t index)
+        {
+            return reinterpret_cast<Element*>(&mSlots[index]);
+        }
+
+        // Read-only data. One slot is always empty to distinguish a full
+        // queue from an empty one.
+        size_t mMaxNumElements, mNumSlots;
+        std::unique_ptr<Slot[]> mSlots;
+        char mPad0[queueCacheLineSize];
+
+        // The consumer data, where mCachedTail is the last loaded value of
+        // mTail.
+        std::atomic<size_t> mHead;
+        size_t mCachedTail;
+        char mPad1[queueCacheLineSize];
+
+        // The producer data, where mCachedHead is the last loaded value of
+        // mHead.
+        std::atomic<size_t> mTail;
+        size_t mCachedHead;
+        char mPad2[queueCacheLineSize];
+
+        QueueWaiter mNotEmpty, mNotFull;
+    };
+
+    template <typename Element>
+    class MPMCQueue
+    {
+    public:
+        // Construction and destruction. The maximum number of elements must
+        // be positive. A power of two avoids a division per operation.
+        MPMCQueue(size_t maxNumElements)
+            :
+            mMaxNumElements(maxNumElements),
+            mIndexMask(0),
+            mCells(new Cell[maxNumElements]),
+            mEnqueuePosition(0),
+            mDequeuePosition(0),
+            mNotEmpty{},
+            mNotFull{}
+        {
+            LogAssert(maxNumElements > 0, "The queue must have positive capacity.");
+
+            if ((maxNumElements & (maxNumElements - 1)) == 0)
+            {
+                mIndexMask = maxNumElements - 1;
+            }
+            for (size_t i = 0; i < maxNumElements; ++i)
+            {
+                mCells[i].sequence.store(2 * i, std::memory_order_relaxed);
+            }
+        }
+
+        ~MPMCQueue()
+        {
+            size_t const enqueuePosition = mEnqueuePosition.load(std::memory_order_relaxed);
+            for (size_t position = mDequeuePosition.load(std::memory_order_relaxed);
+                position != enqueuePosition; ++position)
+            {
+                GetElement(mCells[GetIndex(position)])->~Element();
+            }
+        }
+
+        // Disallow copying and moving.
+        MPMCQueue(MPMCQueue const&) = delete;
+        MPMCQueue& operator=(MPMCQueue const&) = delete;
+        MPMCQueue(MPMCQueue&&) = delete;
+        MPMCQueue& operator=(MPMCQueue&&) = delete;
+
+        inline size_t GetMaxNumElements() const
+        {
+            return mMaxNumElements;
+        }
+
+        // The number is exact only when the producers and consumers are
+        // idle. It counts elements for which a Push is in progress.
+        size_t GetNumElements() const
+        {
+            size_t const dequeuePosition = mDequeuePosition.load(std::memory_order_acquire);
+            size_t const enqueuePosition = mEnqueuePosition.load(std::memory_order_acquire);
+            return (enqueuePosition > dequeuePosition ? enqueuePosition - dequeuePosition : 0);
+        }
+
+        inline bool Push(Element const& element)
+        {
+            return TryPush(element);
+        }
+
+        inline bool Push(Element&& element)
+        {
+            return TryPush(std::move(element));
+        }
+
+        void WaitPush(Element&& element)
+        {
+            mNotFull.Wait([this, &element]() { return TryPush(std::move(element)); });
+        }
+
+        void WaitPush(Element const& element)
+        {
+            mNotFull.Wait([this, &element]() { return TryPush(element); });
+        }
+
+        template <typename Rep, typename Period>
+        bool WaitPush(Element&& element, std::chrono::duration<Rep, Period> const& timeout)
+        {
+            return mNotFull.WaitUntil(
+                [this, &element]() { return TryPush(std::move(element)); },
+                std::chrono::steady_clock::now() + timeout);
+        }
+
+        template <typename Rep, typename Period>
+        bool WaitPush(Element const& element, std::chrono::duration<Rep, Period> const& timeout)
+        {
+            return mNotFull.WaitUntil([this, &element]() { return TryPush(element); },
+                std::chrono::steady_clock::now() + timeout);
+        }
+
+        bool Pop(Element& element)
+        {
+            Cell* cell;
+            size_t position = mDequeuePosition.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                cell = &mCells[GetIndex(position)];
+                size_t const sequence = cell->sequence.load(std::memory_order_acquire);
+                std::ptrdiff_t const difference =
+                    static_cast<std::ptrdiff_t>(sequence - (2 * position + 1));
+                if (difference == 0)
+                {
+                    if (mDequeuePosition.compare_exchange_weak(position, position + 1,
+                        std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                }
+                else if (difference < 0)
+                {
+                    // The queue is empty.
+                    return false;
+                }
+                else
+                {
+                    // Another consumer has taken the element.
+                    position = mDequeuePosition.load(std::memory_order_relaxed);
+                }
+            }
+
+            Element* stored = GetElement(*cell);
+            element = std::move(*stored);
+            stored->~Element();
+            cell->sequence.store(2 * (position + mMaxNumElements), std::memory_order_release);
+            mNotFull.Notify();
+            return true;
+        }
+
+        void WaitPop(Element& element)
+        {
+            mNotEmpty.Wait([this, &element]() { return Pop(element); });
+        }
+
+        template <typename Rep, typename Period>
+        bool WaitPop(Element& element, std::chrono::duration<Rep, Period> const& timeout)
+        {
+            return mNotEmpty.WaitUntil([this, &element]() { return Pop(element); },
+                std::chrono::steady_clock::now() + timeout);
+        }
+
+    private:
+        using Slot = typename std::aligned_storage<sizeof(Element), alignof(Element)>::type;
+
+        // The sequence number is '2 * position' when the cell is ready for
+        // the producer at 'position' and '2 * position + 1' when the cell is
+        // ready for the consumer at 'position'. The factor 2 distinguishes
+        // the states when the queue has one cell.
+        struct Cell
+        {
+            std::atomic<size_t> sequence;
+            Slot storage;
+        };
+
+        template <typename Input>
+        bool TryPush(Input&& element)
+        {
+            Cell* cell;
+            size_t position = mEnqueuePosition.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                cell = &mCells[GetIndex(position)];
+                size_t const sequence = cell->sequence.load(std::memory_order_acquire);
+                std::ptrdiff_t const difference =
+                    static_cast<std::ptrdiff_t>(sequence - 2 * position);
+                if (difference == 0)
+                {
+                    if (mEnqueuePosition.compare_exchange_weak(position, position + 1,
+                        std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                }
+                else if (difference < 0)
+                {
+                    // The queue is full.
+                    return false;
+                }
+                else
+                {
+                    // Another producer has taken the cell.
+                    position = mEnqueuePosition.load(std::memory_order_relaxed);
+                }
+            }
+
+            new (&cell->storage) Element(std::forward<Input>(element));
+            cell->sequence.store(2 * position + 1, std::memory_order_release);
+            mNotEmpty.Notify();
+            return true;
+        }
+
+        inline size_t GetIndex(size_t position) const
+        {
+            return (mIndexMask > 0 ? position & mIndexMask : position % mMaxNumElements);
+        }
+
+        static inline Element* GetElement(Cell& cell)
+        {
+            return reinterpret_cast<Element*>(&cell.storage);
+        }
+
+        // Read-only data. The mask is nonzero when the number of cells is
+        // a power of two larger than 1.
+        size_t mMaxNumElements, mIndexMask;
+        std::unique_ptr<Cell[]> mCells;
+        char mPad0[queueCacheLineSize];
+
+        std::atomic<size_t> mEnqueuePosition;
+        char mPad1[queueCacheLineSize];
+
+        std::atomic<size_t> mDequeuePosition;
+        char mPad2[queueCacheLineSize];
+
+        QueueWaiter mNotEmpty, mNotFull;
+    };
+}
@@ -0,0 +1,647 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2022
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 6.3.2026.10.17
+
+#pragma once
+
+#include <GTE/Mathematics/AlignedBox.h>
+#include <GTE/Mathematics/EdgeKey.h>
+#include <GTE/Mathematics/IntrTriangle3Triangle3.h>
+#include <GTE/Mathematics/Logger.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <thread>
+#include <vector>
+
+// Intersection of two triangle meshes. The queries
+// TIQuery<T, Triangle3<T>, Triangle3<T>> and
+// FIQuery<T, Triangle3<T>, Triangle3<T>> process one pair of triangles per
+// call. For meshes with many triangles, each mesh is stored in a bounding
+// volume hierarchy (BVH) of axis-aligned boxes. The two hierarchies are
+// traversed simultaneously and the triangle-triangle queries are applied
+// only to the pairs of triangles whose bounding boxes overlap. The pairs of
+// subtrees are distributed among threads when numThreads > 0.
+//
+// The test-intersection query reports whether the meshes intersect and
+// stops at the first intersecting pair of triangles, which is what
+// collision detection requires. The find-intersection query reports all
+// intersecting pairs of triangles and their sets of intersection. The
+// segments of intersection are connected into polylines, the intersection
+// curves of the meshes. The endpoints of the segments are computed
+// independently for each pair of triangles, so endpoints are merged when
+// their distance is at most the weld tolerance.
+//
+// The meshes are not required to be manifold or closed. A Mesh object
+// stores copies of its triangles, so it can be reused in queries against
+// many other meshes.
+
+namespace gte
+{
+    template <typename T>
+    class MeshIntersection3
+    {
+    public:
+        class Mesh
+        {
+        public:
+            struct Node
+            {
+                // The bounding box of the triangles of the subtree.
+                AlignedBox3<T> box;
+
+                // For an interior node, the indices of the children in the
+                // node array. For a leaf node, child[0] = child[1] = -1.
+                std::array<int32_t, 2> child;
+
+                // The triangles of the subtree are those in the triangle
+                // array with indices in [first,first+count).
+                uint32_t first, count;
+            };
+
+            // The triangles of the mesh are triangles[t] with vertices
+            // vertices[triangles[t][i]] for 0 <= i <= 2. A leaf of the BVH
+            // has at most leafSize triangles. An interior node is split at
+            // the median of the triangle centroids along the axis of the
+            // largest extent of the centroids.
+            Mesh(std::vector<Vector3<T>> const& vertices,
+                std::vector<std::array<int32_t, 3>> const& triangles,
+                uint32_t leafSize = 4)
+                :
+                mTriangles(triangles.size()),
+                mBoxes(triangles.size()),
+                mIndices(triangles.size()),
+                mNodes{}
+            {
+                LogAssert(triangles.size() > 0 && leafSize > 0, "Invalid input.");
+
+                uint32_t const numTriangles = static_cast<uint32_t>(triangles.size());
+                std::vector<Triangle3<T>> inTriangles(numTriangles);
+                std::vector<AlignedBox3<T>> inBoxes(numTriangles);
+                std::vector<Vector3<T>> centroids(numTriangles);
+                T const third = static_cast<T>(1) / static_cast<T>(3);
+                for (uint32_t t = 0; t < numTriangles; ++t)
+                {
+                    for (int32_t i = 0; i < 3; ++i)
+                    {
+                        int32_t v = triangles[t][i];
+                        LogAssert(0 <= v && static_cast<size_t>(v) < vertices.size(),
+                            "Invalid vertex index.");
+                        inTriangles[t].v[i] = vertices[v];
+                    }
+                    inBoxes[t] = GetBox(inTriangles[t]);
+                    centroids[t] = (inTriangles[t].v[0] + inTriangles[t].v[1] +
+                        inTriangles[t].v[2]) * third;
+                    mIndices[t] = static_cast<int32_t>(t);
+                }
+
+                // Build the tree in the order of a depth-first traversal.
+                // The stack stores the indices of nodes whose triangles
+                // have been assigned but that are not yet processed.
+                mNodes.reserve(2 * static_cast<size_t>(numTriangles / leafSize + 1));
+                mNodes.push_back(Node{ AlignedBox3<T>{}, { -1, -1 }, 0, numTriangles });
+                std::vector<int32_t> stack{ 0 };
+                while (stack.size() > 0)
+                {
+                    int32_t n = stack.back();
+                    stack.pop_back();
+                    uint32_t const first = mNodes[n].first;
+                    uint32_t const count = mNodes[n].count;
+                    auto begin = mIndices.begin() + first;
+                    auto end = begin + count;
+
+                    AlignedBox3<T> box = inBoxes[*begin];
+                    Vector3<T> cmin = centroids[*begin], cmax = cmin;
+                    for (auto iter = begin + 1; iter != end; ++iter)
+                    {
+                        Merge(inBoxes[*iter], box);
+                        for (int32_t j = 0; j < 3; ++j)
+                        {
+                            cmin[j] = std::min(cmin[j], centroids[*iter][j]);
+                            cmax[j] = std::max(cmax[j], centroids[*iter][j]);
+                        }
+                    }
+                    mNodes[n].box = box;
+
+                    if (count <= leafSize)
+                    {
+                        continue;
+                    }
+
+                    Vector3<T> extent = cmax - cmin;
+                    int32_t axis = 0;
+                    if (extent[1] > extent[axis])
+                    {
+                        axis = 1;
+                    }
+                    if (extent[2] > extent[axis])
+                    {
+                        axis = 2;
+                    }
+                    if (extent[axis] == static_cast<T>(0))
+                    {
+                        // The centroids are the same point, so the
+                        // triangles cannot be separated by a split.
+                        continue;
+                    }
+
+                    uint32_t const half = count / 2;
+                    std::nth_element(begin, begin + half, end,
+                        [&centroids, axis](int32_t t0, int32_t t1)
+                        {
+                            return centroids[t0][axis] < centroids[t1][axis];
+                        });
+
+                    int32_t child0 = static_cast<int32_t>(mNodes.size());
+                    int32_t child1 = child0 + 1;
+                    mNodes[n].child = { child0, child1 };
+                    mNodes.push_back(Node{ AlignedBox3<T>{}, { -1, -1 }, first, half });
+                    mNodes.push_back(Node{ AlignedBox3<T>{}, { -1, -1 }, first + half, count - half });
+                    stack.push_back(child1);
+                    stack.push_back(child0);
+                }
+
+                // Store the triangles in the order of the leaves so that
+                // the triangles of a subtree are contiguous in memory.
+                for (uint32_t t = 0; t < numTriangles; ++t)
+                {
+                    mTriangles[t] = inTriangles[mIndices[t]];
+                    mBoxes[t] = inBoxes[mIndices[t]];
+                }
+            }
+
+            // Member access. The triangles and their bounding boxes are
+            // stored in the order of the leaves of the tree. The original
+            // index of the triangle i is GetIndices()[i].
+            inline std::vector<Triangle3<T>> const& GetTriangles() const
+            {
+                return mTriangles;
+            }
+
+            inline std::vector<AlignedBox3<T>> const& GetBoxes() const
+            {
+                return mBoxes;
+            }
+
+            inline std::vector<int32_t> const& GetIndices() const
+            {
+                return mIndices;
+            }
+
+            // The root of the tree is GetNodes()[0].
+            inline std::vector<Node> const& GetNodes() const
+            {
+                return mNodes;
+            }
+
+        private:
+            std::vector<Triangle3<T>> mTriangles;
+            std::vector<AlignedBox3<T>> mBoxes;
+            std::vector<int32_t> mIndices;
+            std::vector<Node> mNodes;
+        };
+
+        // The intersection of a pair of triangles. The triangle indices are
+        // those of the input triangle arrays of mesh0 and mesh1. The set of
+        // intersection is that of the FIQuery for triangles: a point, a
+        // segment or, for coplanar triangles, a convex polygon.
+        struct Contact
+        {
+            std::array<int32_t, 2> triangle;
+            std::vector<Vector3<T>> intersection;
+        };
+
+        // A connected component of the segments of intersection. The
+        // segment <vertices[i],vertices[i+1]> is the intersection of the
+        // pair of triangles triangles[i]. For a closed polyline, the last
+        // segment is <vertices[n-1],vertices[0]>, where n is the number of
+        // vertices, so vertices and triangles have the same number of
+        // elements. For an open polyline, triangles has one element less
+        // than vertices. The polylines are split at the vertices shared by
+        // more than two segments.
+        struct Polyline
+        {
+            std::vector<Vector3<T>> vertices;
+            std::vector<std::array<int32_t, 2>> triangles;
+            bool closed;
+        };
+
+        struct Result
+        {
+            Result()
+                :
+                intersect(false),
+                contacts{},
+                polylines{}
+            {
+            }
+
+            bool intersect;
+
+            // The contacts are sorted by the triangle indices, so the
+            // result does not depend on the number of threads.
+            std::vector<Contact> contacts;
+            std::vector<Polyline> polylines;
+        };
+
+        // To execute the queries in the main thread only, choose numThreads
+        // to be 0. For multithreading, choose numThreads > 0. The weld
+        // tolerance for the endpoints of the segments of intersection is
+        // relativeTolerance times the length of the diagonal of the
+        // bounding box of the two meshes. For exact arithmetic, choose
+        // relativeTolerance to be 0, in which case only endpoints that are
+        // equal are merged.
+        MeshIntersection3(size_t numThreads = 0,
+            T relativeTolerance = static_cast<T>(1e-06))
+            :
+            mNumThreads(numThreads),
+            mRelativeTolerance(relativeTolerance)
+        {
+            LogAssert(relativeTolerance >= static_cast<T>(0), "Invalid tolerance.");
+        }
+
+        // Test-intersection query for collision detection.
+        bool Test(Mesh const& mesh0, Mesh const& mesh1)
+        {
+            auto const& triangles0 = mesh0.GetTriangles();
+            auto const& triangles1 = mesh1.GetTriangles();
+            std::atomic<bool> intersect(false);
+            Execute(mesh0, mesh1,
+                [&triangles0, &triangles1, &intersect](size_t, uint32_t t0, uint32_t t1)
+                {
+                    TIQuery<T, Triangle3<T>, Triangle3<T>> query{};
+                    if (query(triangles0[t0], triangles1[t1]).intersect)
+                    {
+                        intersect = true;
+                    }
+                    return !intersect;
+                });
+            return intersect;
+        }
+
+        // Find-intersection query for the intersection curves.
+        Result Find(Mesh const& mesh0, Mesh const& mesh1)
+        {
+            auto const& triangles0 = mesh0.GetTriangles();
+            auto const& triangles1 = mesh1.GetTriangles();
+            auto const& indices0 = mesh0.GetIndices();
+            auto const& indices1 = mesh1.GetIndices();
+            std::vector<std::vector<Contact>> threadContacts(std::max(mNumThreads, static_cast<size_t>(1)));
+            Execute(mesh0, mesh1,
+                [&](size_t thread, uint32_t t0, uint32_t t1)
+                {
+                    FIQuery<T, Triangle3<T>, Triangle3<T>> query{};
+                    auto output = query(triangles0[t0], triangles1[t1]);
+                    if (output.intersect && output.intersection.size() > 0)
+                    {
+                        threadContacts[thread].push_back(Contact{
+                            { indices0[t0], indices1[t1] }, std::move(output.intersection) });
+                    }
+                    return true;
+                });
+
+            Result result{};
+            for (auto& contacts : threadContacts)
+            {
+                result.contacts.insert(result.contacts.end(),
+                    std::make_move_iterator(contacts.begin()),
+                    std::make_move_iterator(contacts.end()));
+            }
+            std::sort(result.contacts.begin(), result.contacts.end(),
+                [](Contact const& contact0, Contact const& contact1)
+                {
+                    return contact0.triangle < contact1.triangle;
+                });
+            result.intersect = (result.contacts.size() > 0);
+
+            AlignedBox3<T> box = mesh0.GetNodes()[0].box;
+            Merge(mesh1.GetNodes()[0].box, box);
+            T tolerance = mRelativeTolerance * Length(box.max - box.min);
+            result.polylines = GetPolylines(result.contacts, tolerance);
+            return result;
+        }
+
+    private:
+        static AlignedBox3<T> GetBox(Triangle3<T> const& triangle)
+        {
+            AlignedBox3<T> box{ triangle.v[0], triangle.v[0] };
+            for (int32_t i = 1; i < 3; ++i)
+            {
+                for (int32_t j = 0; j < 3; ++j)
+                {
+                    box.min[j] = std::min(box.min[j], triangle.v[i][j]);
+                    box.max[j] = std::max(box.max[j], triangle.v[i][j]);
+                }
+            }
+            return box;
+        }
+
+        static void Merge(AlignedBox3<T> const& input, AlignedBox3<T>& box)
+        {
+            for (int32_t j = 0; j < 3; ++j)
+            {
+                box.min[j] = std::min(box.min[j], input.min[j]);
+                box.max[j] = std::max(box.max[j], input.max[j]);
+            }
+        }
+
+        static bool Overlap(AlignedBox3<T> const& box0, AlignedBox3<T> const& box1)
+        {
+            return box0.min[0] <= box1.max[0] && box1.min[0] <= box0.max[0]
+                && box0.min[1] <= box1.max[1] && box1.min[1] <= box0.max[1]
+                && box0.min[2] <= box1.max[2] && box1.min[2] <= box0.max[2];
+        }
+
+        // The function is called for the pairs of triangles whose bounding
+        // boxes overlap, (thread, t0, t1) where t0 and t1 are indices into
+        // the triangle arrays of the meshes. The traversal stops when the
+        // function returns 'false'.
+        using Visitor = std::function<bool(size_t, uint32_t, uint32_t)>;
+        using NodePair = std::array<int32_t, 2>;
+
+        // Descend into the larger (in number of triangles) of two
+        // overlapping subtrees. The child pairs whose boxes overlap are
+        // appended to 'pairs'. The function returns 'false' when both nodes
+        // are leaves.
+        static bool Split(Mesh const& mesh0, Mesh const& mesh1,
+            NodePair const& pair, std::function<void(NodePair const&)> const& append)
+        {
+            auto const& node0 = mesh0.GetNodes()[pair[0]];
+            auto const& node1 = mesh1.GetNodes()[pair[1]];
+            bool isLeaf0 = (node0.child[0] < 0), isLeaf1 = (node1.child[0] < 0);
+            if (isLeaf0 && isLeaf1)
+            {
+                return false;
+            }
+
+            if (isLeaf1 || (!isLeaf0 && node0.count >= node1.count))
+            {
+                for (int32_t c = 0; c < 2; ++c)
+                {
+                    if (Overlap(mesh0.GetNodes()[node0.child[c]].box, node1.box))
+                    {
+                        append(NodePair{ node0.child[c], pair[1] });
+                    }
+                }
+            }
+            else
+            {
+                for (int32_t c = 0; c < 2; ++c)
+                {
+                    if (Overlap(node0.box, mesh1.GetNodes()[node1.child[c]].box))
+                    {
+                        append(NodePair{ pair[0], node1.child[c] });
+                    }
+                }
+            }
+            return true;
+        }
+
+        static bool Traverse(Mesh const& mesh0, Mesh const& mesh1,
+            NodePair const& task, size_t thread, Visitor const& visitor)
+        {
+            auto const& boxes0 = mesh0.GetBoxes();
+            auto const& boxes1 = mesh1.GetBoxes();
+            std::vector<NodePair> stack{ task };
+            auto append = [&stack](NodePair const& pair) { stack.push_back(pair); };
+            while (stack.size() > 0)
+            {
+                NodePair pair = stack.back();
+                stack.pop_back();
+                if (!Split(mesh0, mesh1, pair, append))
+                {
+                    auto const& node0 = mesh0.GetNodes()[pair[0]];
+                    auto const& node1 = mesh1.GetNodes()[pair[1]];
+                    for (uint32_t t0 = node0.first; t0 < node0.first + node0.count; ++t0)
+                    {
+                        if (!Overlap(boxes0[t0], node1.box))
+                        {
+                            continue;
+                        }
+                        for (uint32_t t1 = node1.first; t1 < node1.first + node1.count; ++t1)
+                        {
+                            if (Overlap(boxes0[t0], boxes1[t1]) && !visitor(thread, t0, t1))
+                            {
+                                return false;
+                            }
+                        }
+                    }
+                }
+            }
+            return true;
+        }
+
+        void Execute(Mesh const& mesh0, Mesh const& mesh1, Visitor const& visitor)
+        {
+            if (!Overlap(mesh0.GetNodes()[0].box, mesh1.GetNodes()[0].box))
+            {
+                return;
+            }
+
+            NodePair const root{ 0, 0 };
+            if (mNumThreads == 0)
+            {
+                Traverse(mesh0, mesh1, root, 0, visitor);
+                return;
+            }
+
+            // Expand the pairs of subtrees breadth first until there are
+            // enough tasks to balance the load among the threads. The pairs
+            // of leaves are tasks that cannot be expanded.
+            size_t const minNumTasks = 16 * mNumThreads;
+            std::deque<NodePair> frontier{ root };
+            std::vector<NodePair> tasks;
+            auto append = [&frontier](NodePair const& pair) { frontier.push_back(pair); };
+            while (frontier.size() > 0 && frontier.size() + tasks.size() < minNumTasks)
+            {
+                NodePair pair = frontier.front();
+                frontier.pop_front();
+                if (!Split(mesh0, mesh1, pair, append))
+                {
+                    tasks.push_back(pair);
+                }
+            }
+            tasks.insert(tasks.end(), frontier.begin(), frontier.end());
+
+            // The threads take the tasks in order. A thread stops taking
+            // tasks when the visitor stops the traversal.
+            std::atomic<size_t> next(0);
+            std::atomic<bool> stop(false);
+            std::vector<std::thread> process(mNumThreads);
+            for (size_t thread = 0; thread < mNumThreads; ++thread)
+            {
+                process[thread] = std::thread(
+                    [&mesh0, &mesh1, &visitor, &tasks, &next, &stop, thread]()
+                    {
+                        size_t i;
+                        while (!stop && (i = next++) < tasks.size())
+                        {
+                            if (!Traverse(mesh0, mesh1, tasks[i], thread, visitor))
+                            {
+                                stop = true;
+                            }
+                        }
+                    });
+            }
+            for (size_t thread = 0; thread < mNumThreads; ++thread)
+            {
+                process[thread].join();
+            }
+        }
+
+        // Merge the endpoints of the segments of intersection and connect
+        // the segments into polylines.
+        static std::vector<Polyline> GetPolylines(std::vector<Contact> const& contacts, T tolerance)
+        {
+            // Weld the endpoints. For a positive tolerance, the points are
+            // stored in a grid of cells whose size is the tolerance, so the
+            // points within the tolerance of a point are in the 3x3x3 block
+            // of cells that contains it.
+            std::vector<Vector3<T>> vertices;
+            std::map<Vector3<T>, int32_t> exactMap;
+            std::map<std::array<int64_t, 3>, std::vector<int32_t>> grid;
+            T const sqrTolerance = tolerance * tolerance;
+            auto weld = [&](Vector3<T> const& point)
+            {
+                if (tolerance == static_cast<T>(0))
+                {
+                    auto inserted = exactMap.insert(std::make_pair(point,
+                        static_cast<int32_t>(vertices.size())));
+                    if (inserted.second)
+                    {
+                        vertices.push_back(point);
+                    }
+                    return inserted.first->second;
+                }
+
+                std::array<int64_t, 3> cell{};
+                for (int32_t j = 0; j < 3; ++j)
+                {
+                    cell[j] = static_cast<int64_t>(std::floor(point[j] / tolerance));
+                }
+                std::array<int64_t, 3> neighbor{};
+                for (neighbor[2] = cell[2] - 1; neighbor[2] <= cell[2] + 1; ++neighbor[2])
+                {
+                    for (neighbor[1] = cell[1] - 1; neighbor[1] <= cell[1] + 1; ++neighbor[1])
+                    {
+                        for (neighbor[0] = cell[0] - 1; neighbor[0] <= cell[0] + 1; ++neighbor[0])
+                        {
+                            auto iter = grid.find(neighbor);
+                            if (iter != grid.end())
+                            {
+                                for (auto v : iter->second)
+                                {
+                                    Vector3<T> diff = vertices[v] - point;
+                                    if (Dot(diff, diff) <= sqrTolerance)
+                                    {
+                                        return v;
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+                int32_t v = static_cast<int32_t>(vertices.size());
+                vertices.push_back(point);
+                grid[cell].push_back(v);
+                return v;
+            };
+
+            // Create the graph whose edges are the distinct segments. A
+            // segment on an edge shared by two triangles of one mesh is
+            // reported by both triangles, in which case the first pair
+            // (in sorted order) is used.
+            std::vector<std::array<int32_t, 2>> edges;
+            std::vector<std::array<int32_t, 2>> edgeTriangles;
+            std::map<EdgeKey<false>, int32_t> edgeMap;
+            for (auto const& contact : contacts)
+            {
+                if (contact.intersection.size() != 2)
+                {
+                    continue;
+                }
+
+                int32_t v0 = weld(contact.intersection[0]);
+                int32_t v1 = weld(contact.intersection[1]);
+                if (v0 != v1 && edgeMap.insert(std::make_pair(EdgeKey<false>(v0, v1),
+                    static_cast<int32_t>(edges.size()))).second)
+                {
+                    edges.push_back({ v0, v1 });
+                    edgeTriangles.push_back(contact.triangle);
+                }
+            }
+
+            std::vector<std::vector<int32_t>> adjacent(vertices.size());
+            for (size_t e = 0; e < edges.size(); ++e)
+            {
+                adjacent[edges[e][0]].push_back(static_cast<int32_t>(e));
+                adjacent[edges[e][1]].push_back(static_cast<int32_t>(e));
+            }
+
+            // Walk along the chains of vertices with two edges. The open
+            // polylines start at the vertices with one edge or with more
+            // than two edges. The remaining edges form closed polylines.
+            std::vector<Polyline> polylines;
+            std::vector<bool> visited(edges.size(), false);
+            auto walk = [&](int32_t vStart, int32_t eStart)
+            {
+                Polyline polyline{};
+                int32_t v = vStart, e = eStart;
+                polyline.vertices.push_back(vertices[v]);
+                for (;;)
+                {
+                    visited[e] = true;
+                    polyline.triangles.push_back(edgeTriangles[e]);
+                    v = (edges[e][0] == v ? edges[e][1] : edges[e][0]);
+                    if (v == vStart)
+                    {
+                        polyline.closed = true;
+                        break;
+                    }
+                    polyline.vertices.push_back(vertices[v]);
+                    if (adjacent[v].size() != 2)
+                    {
+                        polyline.closed = false;
+                        break;
+                    }
+                    e = (adjacent[v][0] == e ? adjacent[v][1] : adjacent[v][0]);
+                }
+                polylines.push_back(std::move(polyline));
+            };
+
+            for (size_t v = 0; v < vertices.size(); ++v)
+            {
+                if (adjacent[v].size() != 2)
+                {
+                    for (auto e : adjacent[v])
+                    {
+                        if (!visited[e])
+                        {
+                            walk(static_cast<int32_t>(v), e);
+                        }
+                    }
+                }
+            }
+
+            for (size_t e = 0; e < edges.size(); ++e)
+            {
+                if (!visited[e])
+                {
+                    walk(edges[e][0], static_cast<int32_t>(e));
+                }
+            }
+            return polylines;
+        }
+
+        size_t mNumThreads;
+        T mRelativeTolerance;
+    };
+}
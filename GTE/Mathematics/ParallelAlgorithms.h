@@ -0,0 +1,784 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2022
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 6.3.2026.10.17
+
+#pragma once
+
+// Multithreaded versions of some of the standard algorithms for
+// random-access ranges. The range is partitioned into 2^{lgNumThreads}
+// blocks of nearly equal size. Each block is processed in its own thread,
+// after which the blocks are combined. The code runs single-threaded when
+// lgNumThreads = 0, in which case the functions are equivalent to their
+// std counterparts. The threading convention matches that of ConvexHull3.
+// The file also has scans (prefix sums), segmented scans, stream
+// compaction and a radix sort, which are building blocks for parallelizing
+// algorithms whose outputs have data-dependent sizes.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <numeric>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace gte
+{
+    // Sort the elements in [begin,end) using the comparison function
+    // 'less'. The blocks are sorted concurrently and then merged pairwise,
+    // the merges at each level also executed concurrently.
+    template <typename RandomIt, typename Compare>
+    void ParallelSort(RandomIt begin, RandomIt end, Compare less,
+        size_t lgNumThreads)
+    {
+        size_t const numElements = static_cast<size_t>(end - begin);
+        size_t numThreads = (static_cast<size_t>(1) << lgNumThreads);
+        if (numThreads <= 1 || numElements < 2 * numThreads)
+        {
+            std::sort(begin, end, less);
+            return;
+        }
+
+        // Block b has elements [bound[b],bound[b+1]).
+        std::vector<size_t> bound(numThreads + 1);
+        for (size_t b = 0; b <= numThreads; ++b)
+        {
+            bound[b] = b * numElements / numThreads;
+        }
+
+        std::vector<std::thread> process(numThreads);
+        for (size_t b = 0; b < numThreads; ++b)
+        {
+            process[b] = std::thread(
+                [begin, less, b, &bound]()
+                {
+                    std::sort(begin + bound[b], begin + bound[b + 1], less);
+                });
+        }
+        for (size_t b = 0; b < numThreads; ++b)
+        {
+            process[b].join();
+        }
+
+        // Merge adjacent sorted blocks until a single block remains.
+        for (size_t step = 1; step < numThreads; step *= 2)
+        {
+            size_t numMerges = 0;
+            for (size_t b = 0; b + step < numThreads; b += 2 * step)
+            {
+                size_t b2 = std::min(b + 2 * step, numThreads);
+                RandomIt first = begin + bound[b];
+                RandomIt middle = begin + bound[b + step];
+                RandomIt last = begin + bound[b2];
+                process[numMerges++] = std::thread(
+                    [first, middle, last, less]()
+                    {
+                        std::inplace_merge(first, middle, last, less);
+                    });
+            }
+            for (size_t m = 0; m < numMerges; ++m)
+            {
+                process[m].join();
+            }
+        }
+    }
+
+    // Remove consecutive duplicates from the sorted range [begin,end) using
+    // the equality function 'equal'. The function returns the new end of
+    // the range, just as std::unique does. Each block is compacted in its
+    // own thread. The compacted blocks are then moved to be contiguous,
+    // discarding the first element of a block when it equals the last
+    // element kept from the previous block.
+    template <typename RandomIt, typename Equal>
+    RandomIt ParallelUnique(RandomIt begin, RandomIt end, Equal equal,
+        size_t lgNumThreads)
+    {
+        size_t const numElements = static_cast<size_t>(end - begin);
+        size_t numThreads = (static_cast<size_t>(1) << lgNumThreads);
+        if (numThreads <= 1 || numElements < 2 * numThreads)
+        {
+            return std::unique(begin, end, equal);
+        }
+
+        std::vector<size_t> bound(numThreads + 1);
+        for (size_t b = 0; b <= numThreads; ++b)
+        {
+            bound[b] = b * numElements / numThreads;
+        }
+
+        std::vector<RandomIt> blockEnd(numThreads);
+        std::vector<std::thread> process(numThreads);
+        for (size_t b = 0; b < numThreads; ++b)
+        {
+            process[b] = std::thread(
+                [begin, equal, b, &bound, &blockEnd]()
+                {
+                    blockEnd[b] = std::unique(begin + bound[b],
+                        begin + bound[b + 1], equal);
+                });
+        }
+        for (size_t b = 0; b < numThreads; ++b)
+        {
+            process[b].join();
+        }
+
+        RandomIt target = blockEnd[0];
+        for (size_t b = 1; b < numThreads; ++b)
+        {
+            RandomIt first = begin + bound[b];
+            if (first != blockEnd[b] && equal(*(target - 1), *first))
+            {
+                ++first;
+            }
+            target = std::move(first, blockEnd[b], target);
+        }
+        return target;
+    }
+
+    // Remove the elements of [begin,end) for which 'remove' is true,
+    // preserving the relative order of the remaining elements. The function
+    // returns the new end of the range, just as std::remove_if does. The
+    // predicate is evaluated concurrently, so it must be safe to call from
+    // multiple threads.
+    template <typename RandomIt, typename Predicate>
+    RandomIt ParallelRemoveIf(RandomIt begin, RandomIt end, Predicate remove,
+        size_t lgNumThreads)
+    {
+        size_t const numElements = static_cast<size_t>(end - begin);
+        size_t numThreads = (static_cast<size_t>(1) << lgNumThreads);
+        if (numThreads <= 1 || numElements < 2 * numThreads)
+        {
+            return std::remove_if(begin, end, remove);
+        }
+
+        std::vector<size_t> bound(numThreads + 1);
+        for (size_t b = 0; b <= numThreads; ++b)
+        {
+            bound[b] = b * numElements / numThreads;
+        }
+
+        std::vector<RandomIt> blockEnd(numThreads);
+        std::vector<std::thread> process(numThreads);
+        for (size_t b = 0; b < numThreads; ++b)
+        {
+            process[b] = std::thread(
+                [begin, remove, b, &bound, &blockEnd]()
+                {
+                    blockEnd[b] = std::remove_if(begin + bound[b],
+                        begin + bound[b + 1], remove);
+                });
+        }
+        for (size_t b = 0; b < numThreads; ++b)
+        {
+            process[b].join();
+        }
+
+        RandomIt target = blockEnd[0];
+        for (size_t b = 1; b < numThreads; ++b)
+        {
+            target = std::move(begin + bound[b], blockEnd[b], target);
+        }
+        return target;
+    }
+
+    // Call function(b) for each block b in [0,numBlocks), each block in its
+    // own thread. When numBlocks is 1, the function is called in the
+    // calling thread.
+    template <typename Function>
+    void ParallelForBlocks(size_t numBlocks, Function function)
+    {
+        if (numBlocks == 1)
+        {
+            function(0);
+            return;
+        }
+
+        std::vector<std::thread> process(numBlocks);
+        for (size_t b = 0; b < numBlocks; ++b)
+        {
+            process[b] = std::thread([&function, b]() { function(b); });
+        }
+        for (size_t b = 0; b < numBlocks; ++b)
+        {
+            process[b].join();
+        }
+    }
+
+    // The scans, reductions and compaction below use two passes over the
+    // blocks. The first pass computes a summary of each block (a
+    // reduction or a count), the summaries are combined serially into the
+    // initial values of the blocks, and the second pass processes the
+    // blocks independently. The inner loops are simple so that the compiler
+    // can vectorize them for arithmetic types. The binary operation 'op'
+    // must be associative. For floating-point addition, the results
+    // differ from the serial ones by rounding errors, because the
+    // operations are grouped by block. The output range may be the input
+    // range (the operation is in place) but must not otherwise overlap
+    // the input range.
+
+    // Return init op *begin op ... op *(end-1).
+    template <typename RandomIt, typename T, typename BinaryOp>
+    T ParallelReduce(RandomIt begin, RandomIt end, T init, BinaryOp op,
+        size_t lgNumThreads)
+    {
+        size_t const numElements = static_cast<size_t>(end - begin);
+        size_t numThreads = (static_cast<size_t>(1) << lgNumThreads);
+        if (numThreads <= 1 || numElements < 2 * numThreads)
+        {
+            return std::accumulate(begin, end, init, op);
+        }
+
+        std::vector<size_t> bound(numThreads + 1);
+        for (size_t b = 0; b <= numThreads; ++b)
+        {
+            bound[b] = b * numElements / numThreads;
+        }
+
+        std::vector<T> partial(numThreads, init);
+        ParallelForBlocks(numThreads, [begin, op, &bound, &partial](size_t b)
+        {
+            RandomIt first = begin + bound[b], last = begin + bound[b + 1];
+            T sum = *first;
+            for (++first; first != last; ++first)
+            {
+                sum = op(sum, *first);
+            }
+            partial[b] = sum;
+        });
+
+        for (size_t b = 0; b < numThreads; ++b)
+        {
+            init = op(init, partial[b]);
+        }
+        return init;
+    }
+
+    // Compute output[i] = begin[0] op ... op begin[i], as std::partial_sum
+    // does. The function returns the end of the output range.
+    template <typename RandomInIt, typename RandomOutIt, typename BinaryOp>
+    RandomOutIt ParallelInclusiveScan(RandomInIt begin, RandomInIt end,
+        RandomOutIt output, BinaryOp op, size_t lgNumThreads)
+    {
+        using T = typename std::iterator_traits<RandomInIt>::value_type;
+
+        size_t const numElements = static_cast<size_t>(end - begin);
+        size_t numThreads = (static_cast<size_t>(1) << lgNumThreads);
+        if (numThreads <= 1 || numElements < 2 * numThreads)
+        {
+            return std::partial_sum(begin, end, output, op);
+        }
+
+        std::vector<size_t> bound(numThreads + 1);
+        for (size_t b = 0; b <= numThreads; ++b)
+        {
+            bound[b] = b * numElements / numThreads;
+        }
+
+        // partial[b] is the reduction of block b, which the serial pass
+        // converts to the reduction of blocks 0 through b. The last block
+        // is not needed.
+        std::vector<T> partial(numThreads - 1, *begin);
+        ParallelForBlocks(numThreads - 1, [begin, op, &bound, &partial](size_t b)
+        {
+            RandomInIt first = begin + bound[b], last = begin + bound[b + 1];
+            T sum = *first;
+            for (++first; first != last; ++first)
+            {
+                sum = op(sum, *first);
+            }
+            partial[b] = sum;
+        });
+        for (size_t b = 1; b + 1 < numThreads; ++b)
+        {
+            partial[b] = op(partial[b - 1], partial[b]);
+        }
+
+        ParallelForBlocks(numThreads, [begin, output, op, &bound, &partial](size_t b)
+        {
+            size_t i = bound[b];
+            T sum = begin[i];
+            if (b > 0)
+            {
+                sum = op(partial[b - 1], sum);
+            }
+            output[i] = sum;
+            for (++i; i < bound[b + 1]; ++i)
+            {
+                sum = op(sum, begin[i]);
+                output[i] = sum;
+            }
+        });
+        return output + numElements;
+    }
+
+    // Compute output[0] = init and output[i] = init op begin[0] op ... op
+    // begin[i-1] for i > 0. The function returns the end of the output
+    // range.
+    template <typename RandomInIt, typename RandomOutIt, typename T, typename BinaryOp>
+    RandomOutIt ParallelExclusiveScan(RandomInIt begin, RandomInIt end,
+        RandomOutIt output, T init, BinaryOp op, size_t lgNumThreads)
+    {
+        size_t const numElements = static_cast<size_t>(end - begin);
+        size_t numThreads = (static_cast<size_t>(1) << lgNumThreads);
+        if (numThreads <= 1 || numElements < 2 * numThreads)
+        {
+            numThreads = 1;
+        }
+
+        std::vector<size_t> bound(numThreads + 1);
+        for (size_t b = 0; b <= numThreads; ++b)
+        {
+            bound[b] = b * numElements / numThreads;
+        }
+
+        // carry[b] is the value of the output at the first element of
+        // block b.
+        std::vector<T> carry(numThreads, init);
+        if (numThreads > 1)
+        {
+            ParallelForBlocks(numThreads - 1, [begin, op, &bound, &carry](size_t b)
+            {
+                RandomInIt first = begin + bound[b], last = begin + bound[b + 1];
+                T sum = *first;
+                for (++first; first != last; ++first)
+                {
+                    sum = op(sum, *first);
+                }
+                carry[b + 1] = sum;
+            });
+            for (size_t b = 1; b < numThreads; ++b)
+            {
+                carry[b] = op(carry[b - 1], carry[b]);
+            }
+        }
+
+        ParallelForBlocks(numThreads, [begin, output, op, &bound, &carry](size_t b)
+        {
+            T sum = carry[b];
+            for (size_t i = bound[b]; i < bound[b + 1]; ++i)
+            {
+                T value = begin[i];
+                output[i] = sum;
+                sum = op(sum, value);
+            }
+        });
+        return output + numElements;
+    }
+
+    // Segmented scans. The element i starts a segment when flags[i] is
+    // 'true', and element 0 always starts a segment. Each segment is
+    // scanned independently: the inclusive scan computes output[i] =
+    // begin[s] op ... op begin[i] and the exclusive scan computes output[i]
+    // = init op begin[s] op ... op begin[i-1], where s is the first element
+    // of the segment that contains i. For example, a segmented exclusive
+    // sum of the vertex counts of faces, with a flag at the first face of
+    // each mesh, produces the offsets of the vertices of the faces within
+    // their meshes. The flags are accessed as flags[i] and must be
+    // convertible to bool.
+    template <typename RandomInIt, typename RandomFlagIt, typename RandomOutIt, typename BinaryOp>
+    RandomOutIt ParallelSegmentedInclusiveScan(RandomInIt begin, RandomInIt end,
+        RandomFlagIt flags, RandomOutIt output, BinaryOp op, size_t lgNumThreads)
+    {
+        using T = typename std::iterator_traits<RandomInIt>::value_type;
+
+        size_t const numElements = static_cast<size_t>(end - begin);
+        size_t numThreads = (static_cast<size_t>(1) << lgNumThreads);
+        if (numThreads <= 1 || numElements < 2 * numThreads)
+        {
+            numThreads = 1;
+        }
+        if (numElements == 0)
+        {
+            return output;
+        }
+
+        std::vector<size_t> bound(numThreads + 1);
+        for (size_t b = 0; b <= numThreads; ++b)
+        {
+            bound[b] = b * numElements / numThreads;
+        }
+
+        // tail[b] is the reduction of the elements of block b starting at
+        // its last segment start, or of all its elements when no segment
+        // starts in block b (hasStart[b] is 0). The serial pass converts
+        // tail[b] to the inclusive-scan value at the last element of block
+        // b. The flags are stored as char, because std::vector<bool> is not
+        // safe for concurrent writes.
+        std::vector<T> tail(numThreads, *begin);
+        std::vector<char> hasStart(numThreads, 0);
+        if (numThreads > 1)
+        {
+            ParallelForBlocks(numThreads - 1, [begin, flags, op, &bound, &tail, &hasStart](size_t b)
+            {
+                size_t i = bound[b];
+                T sum = begin[i];
+                char start = (flags[i] ? 1 : 0);
+                for (++i; i < bound[b + 1]; ++i)
+                {
+                    if (flags[i])
+                    {
+                        sum = begin[i];
+                        start = 1;
+                    }
+                    else
+                    {
+                        sum = op(sum, begin[i]);
+                    }
+                }
+                tail[b] = sum;
+                hasStart[b] = start;
+            });
+            for (size_t b = 1; b + 1 < numThreads; ++b)
+            {
+                if (!hasStart[b])
+                {
+                    tail[b] = op(tail[b - 1], tail[b]);
+                }
+            }
+        }
+
+        ParallelForBlocks(numThreads, [begin, flags, output, op, &bound, &tail](size_t b)
+        {
+            size_t i = bound[b];
+            T sum = begin[i];
+            if (b > 0 && !flags[i])
+            {
+                sum = op(tail[b - 1], sum);
+            }
+            output[i] = sum;
+            for (++i; i < bound[b + 1]; ++i)
+            {
+                sum = (flags[i] ? begin[i] : op(sum, begin[i]));
+                output[i] = sum;
+            }
+        });
+        return output + numElements;
+    }
+
+    template <typename RandomInIt, typename RandomFlagIt, typename RandomOutIt, typename T, typename BinaryOp>
+    RandomOutIt ParallelSegmentedExclusiveScan(RandomInIt begin, RandomInIt end,
+        RandomFlagIt flags, RandomOutIt output, T init, BinaryOp op, size_t lgNumThreads)
+    {
+        size_t const numElements = static_cast<size_t>(end - begin);
+        size_t numThreads = (static_cast<size_t>(1) << lgNumThreads);
+        if (numThreads <= 1 || numElements < 2 * numThreads)
+        {
+            numThreads = 1;
+        }
+
+        std::vector<size_t> bound(numThreads + 1);
+        for (size_t b = 0; b <= numThreads; ++b)
+        {
+            bound[b] = b * numElements / numThreads;
+        }
+
+        // carry[b] is the exclusive-scan value at the first element of
+        // block b, ignoring a segment start at that element. It is
+        // computed from the reductions of the blocks after their last
+        // segment starts, as for the inclusive scan.
+        std::vector<T> carry(numThreads, init);
+        if (numThreads > 1)
+        {
+            std::vector<T> tail(numThreads - 1, init);
+            std::vector<char> hasStart(numThreads - 1, 0);
+            ParallelForBlocks(numThreads - 1, [begin, flags, op, &bound, &tail, &hasStart](size_t b)
+            {
+                size_t i = bound[b];
+                T sum = begin[i];
+                char start = (flags[i] ? 1 : 0);
+                for (++i; i < bound[b + 1]; ++i)
+                {
+                    if (flags[i])
+                    {
+                        sum = begin[i];
+                        start = 1;
+                    }
+                    else
+                    {
+                        sum = op(sum, begin[i]);
+                    }
+                }
+                tail[b] = sum;
+                hasStart[b] = start;
+            });
+            for (size_t b = 1; b < numThreads; ++b)
+            {
+                carry[b] = op(hasStart[b - 1] ? init : carry[b - 1], tail[b - 1]);
+            }
+        }
+
+        ParallelForBlocks(numThreads, [begin, flags, output, init, op, &bound, &carry](size_t b)
+        {
+            T sum = carry[b];
+            for (size_t i = bound[b]; i < bound[b + 1]; ++i)
+            {
+                if (flags[i])
+                {
+                    sum = init;
+                }
+                T value = begin[i];
+                output[i] = sum;
+                sum = op(sum, value);
+            }
+        });
+        return output + numElements;
+    }
+
+    // Copy the elements of [begin,end) for which 'keep' is true to the
+    // output, preserving their relative order, as std::copy_if does (stream
+    // compaction). The function returns the end of the output range. The
+    // predicate is evaluated once per element concurrently, so it must be
+    // safe to call from multiple threads. The output range must not
+    // overlap the input range. For in-place compaction, use
+    // ParallelRemoveIf.
+    template <typename RandomInIt, typename RandomOutIt, typename Predicate>
+    RandomOutIt ParallelCopyIf(RandomInIt begin, RandomInIt end,
+        RandomOutIt output, Predicate keep, size_t lgNumThreads)
+    {
+        size_t const numElements = static_cast<size_t>(end - begin);
+        size_t numThreads = (static_cast<size_t>(1) << lgNumThreads);
+        if (numThreads <= 1 || numElements < 2 * numThreads)
+        {
+            return std::copy_if(begin, end, output, keep);
+        }
+
+        std::vector<size_t> bound(numThreads + 1);
+        for (size_t b = 0; b <= numThreads; ++b)
+        {
+            bound[b] = b * numElements / numThreads;
+        }
+
+        // The offset of block b in the output is the exclusive scan of the
+        // numbers of kept elements of the blocks.
+        std::vector<char> kept(numElements);
+        std::vector<size_t> offset(numThreads + 1, 0);
+        ParallelForBlocks(numThreads, [begin, keep, &bound, &kept, &offset](size_t b)
+        {
+            size_t count = 0;
+            for (size_t i = bound[b]; i < bound[b + 1]; ++i)
+            {
+                kept[i] = (keep(begin[i]) ? 1 : 0);
+                count += static_cast<size_t>(kept[i]);
+            }
+            offset[b + 1] = count;
+        });
+        for (size_t b = 0; b < numThreads; ++b)
+        {
+            offset[b + 1] += offset[b];
+        }
+
+        ParallelForBlocks(numThreads, [begin, output, &bound, &kept, &offset](size_t b)
+        {
+            RandomOutIt target = output + offset[b];
+            for (size_t i = bound[b]; i < bound[b + 1]; ++i)
+            {
+                if (kept[i])
+                {
+                    *target++ = begin[i];
+                }
+            }
+        });
+        return output + offset[numThreads];
+    }
+
+    // Unsigned integer keys for ParallelRadixSort whose order is that of
+    // the input numbers. The floating-point keys order -0 before +0 and
+    // order the NaNs by their sign and payload, after +infinity for
+    // positive NaNs.
+    inline uint32_t GetRadixSortKey(uint32_t value)
+    {
+        return value;
+    }
+
+    inline uint64_t GetRadixSortKey(uint64_t value)
+    {
+        return value;
+    }
+
+    inline uint32_t GetRadixSortKey(int32_t value)
+    {
+        return static_cast<uint32_t>(value) ^ UINT32_C(0x80000000);
+    }
+
+    inline uint64_t GetRadixSortKey(int64_t value)
+    {
+        return static_cast<uint64_t>(value) ^ UINT64_C(0x8000000000000000);
+    }
+
+    inline uint32_t GetRadixSortKey(float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits ^ ((bits & UINT32_C(0x80000000)) ? UINT32_C(0xFFFFFFFF) : UINT32_C(0x80000000));
+    }
+
+    inline uint64_t GetRadixSortKey(double value)
+    {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits ^ ((bits & UINT64_C(0x8000000000000000)) ? UINT64_C(0xFFFFFFFFFFFFFFFF) : UINT64_C(0x8000000000000000));
+    }
+
+    // Sort the elements in [begin,end) by the unsigned integer keys
+    // key(element), which must be uint32_t or uint64_t. The sort is a
+    // stable least-significant-digit radix sort with 8-bit digits. Each
+    // pass computes the digit counts of the blocks concurrently and then
+    // moves the elements of the blocks concurrently to a buffer of the same
+    // size as the range, so the elements must be default constructible
+    // and movable. The passes for digits that are the same for all keys are
+    // skipped. Use GetRadixSortKey to sort signed integers and
+    // floating-point numbers, for example,
+    //   ParallelRadixSort(points.begin(), points.end(),
+    //       [](Vector2<float> const& p) { return GetRadixSortKey(p[0]); },
+    //       lgNumThreads);
+    // The key function is called concurrently, so it must be safe to call
+    // from multiple threads.
+    template <typename RandomIt, typename KeyFunction>
+    void ParallelRadixSort(RandomIt begin, RandomIt end, KeyFunction key,
+        size_t lgNumThreads)
+    {
+        using T = typename std::iterator_traits<RandomIt>::value_type;
+        using Key = typename std::decay<decltype(key(*begin))>::type;
+        static_assert(std::is_same<Key, uint32_t>::value || std::is_same<Key, uint64_t>::value,
+            "The keys must be uint32_t or uint64_t.");
+        size_t const numDigits = sizeof(Key);
+        size_t const numBins = 256;
+
+        size_t const numElements = static_cast<size_t>(end - begin);
+        if (numElements < 2)
+        {
+            return;
+        }
+        size_t numThreads = (static_cast<size_t>(1) << lgNumThreads);
+        if (numThreads <= 1 || numElements < 2 * numThreads)
+        {
+            numThreads = 1;
+        }
+
+        std::vector<size_t> bound(numThreads + 1);
+        for (size_t b = 0; b <= numThreads; ++b)
+        {
+            bound[b] = b * numElements / numThreads;
+        }
+
+        // Count the digits of all the passes to determine which passes can
+        // be skipped.
+        std::vector<size_t> counts(numThreads * numDigits * numBins, 0);
+        ParallelForBlocks(numThreads, [begin, key, numDigits, numBins, &bound, &counts](size_t b)
+        {
+            size_t* blockCounts = &counts[b * numDigits * numBins];
+            for (size_t i = bound[b]; i < bound[b + 1]; ++i)
+            {
+                Key k = key(begin[i]);
+                for (size_t d = 0; d < numDigits; ++d, k >>= 8)
+                {
+                    ++blockCounts[d * numBins + (k & 0xFF)];
+                }
+            }
+        });
+
+        std::vector<size_t> passes;
+        for (size_t d = 0; d < numDigits; ++d)
+        {
+            for (size_t bin = 0; bin < numBins; ++bin)
+            {
+                size_t total = 0;
+                for (size_t b = 0; b < numThreads; ++b)
+                {
+                    total += counts[(b * numDigits + d) * numBins + bin];
+                }
+                if (total > 0)
+                {
+                    if (total < numElements)
+                    {
+                        passes.push_back(d);
+                    }
+                    break;
+                }
+            }
+        }
+        if (passes.size() == 0)
+        {
+            return;
+        }
+
+        // The offsets of the bins of the blocks in the target are the
+        // exclusive scan of the counts ordered by bin and then by block,
+        // which makes the sort stable. The counts of the first pass are
+        // already known; the counts of the other passes are computed for
+        // the new order of the elements.
+        std::vector<T> buffer(numElements);
+        std::vector<size_t> offsets(numThreads * numBins);
+        auto pass = [key, numBins, numThreads, &bound, &counts, &offsets](
+            auto source, auto target, size_t digit, bool isFirstPass)
+        {
+            size_t const shift = 8 * digit;
+            size_t const stride = (isFirstPass ? sizeof(Key) * numBins : numBins);
+            size_t const first = (isFirstPass ? digit * numBins : 0);
+            if (!isFirstPass)
+            {
+                ParallelForBlocks(numThreads, [source, key, shift, numBins, &bound, &counts](size_t b)
+                {
+                    size_t* blockCounts = &counts[b * numBins];
+                    std::fill(blockCounts, blockCounts + numBins, static_cast<size_t>(0));
+                    for (size_t i = bound[b]; i < bound[b + 1]; ++i)
+                    {
+                        ++blockCounts[(key(source[i]) >> shift) & 0xFF];
+                    }
+                });
+            }
+
+            size_t sum = 0;
+            for (size_t bin = 0; bin < numBins; ++bin)
+            {
+                for (size_t b = 0; b < numThreads; ++b)
+                {
+                    offsets[b * numBins + bin] = sum;
+                    sum += counts[b * stride + first + bin];
+                }
+            }
+
+            ParallelForBlocks(numThreads, [source, target, key, shift, numBins, &bound, &offsets](size_t b)
+            {
+                size_t* blockOffsets = &offsets[b * numBins];
+                for (size_t i = bound[b]; i < bound[b + 1]; ++i)
+                {
+                    target[blockOffsets[(key(source[i]) >> shift) & 0xFF]++] = std::move(source[i]);
+                }
+            });
+        };
+
+        for (size_t p = 0; p < passes.size(); ++p)
+        {
+            if (p % 2 == 0)
+            {
+                pass(begin, buffer.begin(), passes[p], p == 0);
+            }
+            else
+            {
+                pass(buffer.begin(), begin, passes[p], false);
+            }
+        }
+
+        if (passes.size() % 2 == 1)
+        {
+            ParallelForBlocks(numThreads, [begin, &bound, &buffer](size_t b)
+            {
+                std::move(buffer.begin() + bound[b], buffer.begin() + bound[b + 1], begin + bound[b]);
+            });
+        }
+    }
+
+    // Sort unsigned integers (uint32_t or uint64_t) with ParallelRadixSort.
+    template <typename RandomIt>
+    void ParallelRadixSort(RandomIt begin, RandomIt end, size_t lgNumThreads)
+    {
+        using T = typename std::iterator_traits<RandomIt>::value_type;
+        ParallelRadixSort(begin, end, [](T const& value) { return value; }, lgNumThreads);
+    }
+}
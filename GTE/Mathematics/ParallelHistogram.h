@@ -0,0 +1,407 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2022
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 6.3.2026.10.17
+
+#pragma once
+
+#include <GTE/Mathematics/Logger.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// A histogram for large sets of samples of any arithmetic type. Unlike
+// Histogram, the bucket counts are 64-bit, the bucket range is specified
+// by the caller so that histograms of different data sets can be merged,
+// and the samples may be removed as well as inserted, which supports
+// sliding-window updates: insert the samples that enter the window and
+// remove the samples that leave it.
+//
+// The buckets partition the interval [minValue,maxValue] into numBuckets
+// subintervals of equal length. Bucket i contains the values v for which
+// i = floor(numBuckets*(v-minValue)/(maxValue-minValue)), except that
+// maxValue is in the last bucket. Values smaller than minValue are counted
+// by GetExcessLess() and values larger than maxValue (or NaN) are counted
+// by GetExcessGreater().
+//
+// The batch Insert and Remove functions partition the samples among
+// threads. Each thread counts its samples in its own sub-histogram and the
+// sub-histograms are then added to the histogram. When T is an integer type
+// of at most 16 bits and each bucket corresponds to a single integer, that
+// is, numBuckets = maxValue-minValue+1, the bucket index is the sample
+// value minus minValue. For 8-bit samples, the counting uses four
+// interleaved count arrays so that consecutive equal samples do not create
+// a dependency chain of increments of the same counter.
+
+namespace gte
+{
+    template <typename T>
+    class ParallelHistogram
+    {
+    public:
+        static_assert(std::is_arithmetic<T>::value, "T must be an arithmetic type.");
+
+        ParallelHistogram(int32_t numBuckets, T minValue, T maxValue)
+            :
+            mMinValue(minValue),
+            mMaxValue(maxValue),
+            mMultiplier(0.0),
+            mDirect(false),
+            mBuckets(numBuckets),
+            mExcessLess(0),
+            mExcessGreater(0)
+        {
+            LogAssert(numBuckets > 0 && minValue < maxValue, "Invalid input.");
+
+            mMultiplier = static_cast<double>(numBuckets) /
+                (static_cast<double>(maxValue) - static_cast<double>(minValue));
+
+            mDirect = (std::is_integral<T>::value && sizeof(T) <= 2 &&
+                static_cast<int32_t>(maxValue) - static_cast<int32_t>(minValue) + 1 == numBuckets);
+
+            Clear();
+        }
+
+        void Clear()
+        {
+            std::fill(mBuckets.begin(), mBuckets.end(), 0);
+            mExcessLess = 0;
+            mExcessGreater = 0;
+        }
+
+        // Get the bucket index of a value. The return value is -1 when the
+        // value is smaller than minValue and numBuckets when the value is
+        // larger than maxValue or is NaN.
+        inline int32_t GetIndex(T value) const
+        {
+            if (mMinValue <= value && value <= mMaxValue)
+            {
+                if (mDirect)
+                {
+                    return static_cast<int32_t>(value) - static_cast<int32_t>(mMinValue);
+                }
+
+                int32_t const last = static_cast<int32_t>(mBuckets.size()) - 1;
+                int32_t index = static_cast<int32_t>(mMultiplier *
+                    (static_cast<double>(value) - static_cast<double>(mMinValue)));
+                return std::min(index, last);
+            }
+            return (value < mMinValue ? -1 : static_cast<int32_t>(mBuckets.size()));
+        }
+
+        // Insert or remove a single sample. A removed sample must have been
+        // inserted previously.
+        void Insert(T value)
+        {
+            Update(GetIndex(value), 1);
+        }
+
+        void Remove(T value)
+        {
+            Update(GetIndex(value), static_cast<uint64_t>(-1));
+        }
+
+        // Insert or remove a batch of samples. To run in the main thread
+        // only, choose numThreads to be 0. For multithreading, choose
+        // numThreads > 0.
+        void Insert(size_t numSamples, T const* samples, size_t numThreads = 0)
+        {
+            LogAssert(numSamples == 0 || samples != nullptr, "Invalid input.");
+            Accumulate(numSamples, samples, numThreads, true);
+        }
+
+        void Remove(size_t numSamples, T const* samples, size_t numThreads = 0)
+        {
+            LogAssert(numSamples == 0 || samples != nullptr, "Invalid input.");
+            Accumulate(numSamples, samples, numThreads, false);
+        }
+
+        // Add the counts of a histogram with the same buckets, for example,
+        // one computed for another part of a data set.
+        void Merge(ParallelHistogram const& other)
+        {
+            LogAssert(other.mBuckets.size() == mBuckets.size() &&
+                other.mMinValue == mMinValue && other.mMaxValue == mMaxValue,
+                "The histograms must have the same buckets.");
+
+            for (size_t i = 0; i < mBuckets.size(); ++i)
+            {
+                mBuckets[i] += other.mBuckets[i];
+            }
+            mExcessLess += other.mExcessLess;
+            mExcessGreater += other.mExcessGreater;
+        }
+
+        // Member access.
+        inline std::vector<uint64_t> const& GetBuckets() const
+        {
+            return mBuckets;
+        }
+
+        inline uint64_t GetExcessLess() const
+        {
+            return mExcessLess;
+        }
+
+        inline uint64_t GetExcessGreater() const
+        {
+            return mExcessGreater;
+        }
+
+        inline T GetMinValue() const
+        {
+            return mMinValue;
+        }
+
+        inline T GetMaxValue() const
+        {
+            return mMaxValue;
+        }
+
+        // The number of samples in the buckets, which excludes the excess
+        // counts.
+        uint64_t GetNumSamples() const
+        {
+            uint64_t numSamples = 0;
+            for (auto count : mBuckets)
+            {
+                numSamples += count;
+            }
+            return numSamples;
+        }
+
+        // The tails have the same meaning as those of Histogram, where
+        // cdf(V) = sum_{i=0}^{V} bucket[i] and N = cdf(B-1) for B buckets.
+
+        // Get the lower tail of the histogram. The returned index L has the
+        // properties:  cdf(L-1)/N < tailAmount and cdf(L)/N >= tailAmount.
+        int32_t GetLowerTail(double tailAmount) const
+        {
+            uint64_t const tailSum = static_cast<uint64_t>(tailAmount *
+                static_cast<double>(GetNumSamples()));
+            int32_t const numBuckets = static_cast<int32_t>(mBuckets.size());
+            uint64_t lowerSum = 0;
+            int32_t lower;
+            for (lower = 0; lower < numBuckets; ++lower)
+            {
+                lowerSum += mBuckets[lower];
+                if (lowerSum >= tailSum)
+                {
+                    break;
+                }
+            }
+            return lower;
+        }
+
+        // Get the upper tail of the histogram. The returned index U has the
+        // properties:  cdf(U)/N >= 1-tailAmount and cdf(U+1) < 1-tailAmount.
+        int32_t GetUpperTail(double tailAmount) const
+        {
+            uint64_t const tailSum = static_cast<uint64_t>(tailAmount *
+                static_cast<double>(GetNumSamples()));
+            uint64_t upperSum = 0;
+            int32_t upper;
+            for (upper = static_cast<int32_t>(mBuckets.size()) - 1; upper >= 0; --upper)
+            {
+                upperSum += mBuckets[upper];
+                if (upperSum >= tailSum)
+                {
+                    break;
+                }
+            }
+            return upper;
+        }
+
+        // Get the lower and upper tails of the histogram, each containing
+        // half of tailAmount.
+        void GetTails(double tailAmount, int32_t& lower, int32_t& upper) const
+        {
+            lower = GetLowerTail(0.5 * tailAmount);
+            upper = GetUpperTail(0.5 * tailAmount);
+        }
+
+        // Estimate the value at the specified fraction q in [0,1] of the
+        // samples in the buckets. The samples of the bucket that contains
+        // the quantile are assumed to be uniformly distributed in the
+        // bucket. The function returns minValue when the buckets are empty.
+        double GetQuantile(double q) const
+        {
+            q = std::min(std::max(q, 0.0), 1.0);
+            double const target = q * static_cast<double>(GetNumSamples());
+            double const width = 1.0 / mMultiplier;
+            double cdf = 0.0;
+            for (size_t i = 0; i < mBuckets.size(); ++i)
+            {
+                double count = static_cast<double>(mBuckets[i]);
+                if (count > 0.0 && cdf + count >= target)
+                {
+                    double t = (target - cdf) / count;
+                    return static_cast<double>(mMinValue) + width * (static_cast<double>(i) + t);
+                }
+                cdf += count;
+            }
+            return static_cast<double>(mMinValue);
+        }
+
+    private:
+        inline void Update(int32_t index, uint64_t increment)
+        {
+            if (index < 0)
+            {
+                mExcessLess += increment;
+            }
+            else if (index < static_cast<int32_t>(mBuckets.size()))
+            {
+                mBuckets[index] += increment;
+            }
+            else
+            {
+                mExcessGreater += increment;
+            }
+        }
+
+        // The counts of a subset of the samples. The last two counts are
+        // the excess counts.
+        void Count(T const* samples, size_t numSamples, std::vector<uint64_t>& counts) const
+        {
+            size_t const numBuckets = mBuckets.size();
+            counts.resize(numBuckets + 2);
+            std::fill(counts.begin(), counts.end(), 0);
+            uint64_t* excess = &counts[numBuckets];
+
+            if (mDirect && sizeof(T) == 1)
+            {
+                std::array<std::vector<uint64_t>, 3> extra;
+                for (auto& e : extra)
+                {
+                    e.resize(numBuckets);
+                    std::fill(e.begin(), e.end(), 0);
+                }
+
+                size_t const numQuads = numSamples / 4;
+                T const* current = samples;
+                for (size_t i = 0; i < numQuads; ++i, current += 4)
+                {
+                    CountDirect(current[0], counts.data(), excess);
+                    CountDirect(current[1], extra[0].data(), excess);
+                    CountDirect(current[2], extra[1].data(), excess);
+                    CountDirect(current[3], extra[2].data(), excess);
+                }
+                for (size_t i = 4 * numQuads; i < numSamples; ++i)
+                {
+                    CountDirect(samples[i], counts.data(), excess);
+                }
+
+                for (auto const& e : extra)
+                {
+                    for (size_t i = 0; i < numBuckets; ++i)
+                    {
+                        counts[i] += e[i];
+                    }
+                }
+            }
+            else if (mDirect)
+            {
+                for (size_t i = 0; i < numSamples; ++i)
+                {
+                    CountDirect(samples[i], counts.data(), excess);
+                }
+            }
+            else
+            {
+                int32_t const last = static_cast<int32_t>(numBuckets) - 1;
+                for (size_t i = 0; i < numSamples; ++i)
+                {
+                    int32_t index = GetIndex(samples[i]);
+                    if (index < 0)
+                    {
+                        ++excess[0];
+                    }
+                    else if (index > last)
+                    {
+                        ++excess[1];
+                    }
+                    else
+                    {
+                        ++counts[index];
+                    }
+                }
+            }
+        }
+
+        inline void CountDirect(T value, uint64_t* counts, uint64_t* excess) const
+        {
+            int32_t index = static_cast<int32_t>(value) - static_cast<int32_t>(mMinValue);
+            if (0 <= index && index < static_cast<int32_t>(mBuckets.size()))
+            {
+                ++counts[index];
+            }
+            else
+            {
+                ++excess[index < 0 ? 0 : 1];
+            }
+        }
+
+        void Accumulate(size_t numSamples, T const* samples, size_t numThreads, bool insert)
+        {
+            numThreads = std::min(numThreads, numSamples);
+            size_t const numParts = std::max(numThreads, static_cast<size_t>(1));
+            std::vector<std::vector<uint64_t>> counts(numParts);
+            if (numThreads > 0)
+            {
+                std::vector<std::thread> process(numThreads);
+                for (size_t t = 0; t < numThreads; ++t)
+                {
+                    size_t imin = t * numSamples / numThreads;
+                    size_t imax = (t + 1) * numSamples / numThreads;
+                    process[t] = std::thread([this, samples, imin, imax, &counts, t]()
+                    {
+                        Count(samples + imin, imax - imin, counts[t]);
+                    });
+                }
+                for (size_t t = 0; t < numThreads; ++t)
+                {
+                    process[t].join();
+                }
+            }
+            else
+            {
+                Count(samples, numSamples, counts[0]);
+            }
+
+            size_t const numBuckets = mBuckets.size();
+            for (auto const& c : counts)
+            {
+                if (insert)
+                {
+                    for (size_t i = 0; i < numBuckets; ++i)
+                    {
+                        mBuckets[i] += c[i];
+                    }
+                    mExcessLess += c[numBuckets];
+                    mExcessGreater += c[numBuckets + 1];
+                }
+                else
+                {
+                    for (size_t i = 0; i < numBuckets; ++i)
+                    {
+                        mBuckets[i] -= c[i];
+                    }
+                    mExcessLess -= c[numBuckets];
+                    mExcessGreater -= c[numBuckets + 1];
+                }
+            }
+        }
+
+        T mMinValue, mMaxValue;
+        double mMultiplier;
+        bool mDirect;
+        std::vector<uint64_t> mBuckets;
+        uint64_t mExcessLess, mExcessGreater;
+    };
+}
@@ -0,0 +1,1059 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2022
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 6.3.2026.10.17
+
+#pragma once
+
+#include <GTE/Mathematics/Logger.h>
+#include <GTE/Mathematics/PolygonTree.h>
+#include <GTE/Mathematics/Vector2.h>
+#include <algorithm>
+#include <atomic>
+#include <array>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <queue>
+#include <set>
+#include <thread>
+#include <vector>
+
+// Boolean operations on polygons with holes using a plane sweep. The
+// algorithm is that of
+//   F. Martinez, A.J. Rueda, F.R. Feito, "A new algorithm for computing
+//   Boolean operations on polygons", Computers & Geosciences 35 (2009),
+//   pp. 1177-1185.
+// The edges of both polygons are swept from left to right. The sweep line
+// stores the edges that intersect it, sorted from bottom to top, and the
+// edges are split at their intersections with their neighbors in the sweep
+// line. When an edge is inserted, the edge immediately below it determines
+// whether the regions above and below the edge are inside its polygon and
+// whether the edge is inside the other polygon. This information selects
+// the edges of the result. The run time is O((n+k) log n), where n is the
+// number of edges and k is the number of edge intersections. BSPPolygon2
+// also supports Boolean operations, but its binary space partitioning can
+// split edges many times, and its run time is much larger for polygons with
+// many edges.
+//
+// A polygon is a set of contours, each contour a closed polyline whose last
+// point is connected to its first point. The contours may be listed in any
+// order and with any winding order. A point is inside the polygon when a
+// ray from the point crosses the contours an odd number of times. The
+// contours of a polygon may touch at points but must not otherwise
+// intersect or overlap.
+//
+// The geometric queries are exact when ComputeType is an arbitrary-precision
+// type; the intersection points involve a division, so ComputeType must be
+// rational-based, say, BSRational. The intersection of two edges is computed
+// from the input segments that contain them, so the sizes of the rational
+// numbers do not grow with the number of times an edge is split. The queries
+// are not exact when ComputeType is a floating-point type.
+//
+// The result is a set of vertices and a forest of PolygonTree objects whose
+// 'polygon' members are indices into the vertices. The root of each tree
+// is an outer polygon with counterclockwise-ordered vertices. The children
+// of an outer polygon are inner polygons (holes) with clockwise-ordered
+// vertices, and the children of an inner polygon are outer polygons. The
+// trees may be passed to TriangulateEC or TriangulateCDT. Contours of the
+// result that touch at a vertex are reported as separate polygons.
+
+namespace gte
+{
+    template <typename InputType, typename ComputeType>
+    class PolygonBoolean2
+    {
+    public:
+        enum class Operation
+        {
+            INTERSECTION,
+            UNION,
+            DIFFERENCE,
+            EXCLUSIVE_OR
+        };
+
+        typedef std::vector<Vector2<InputType>> Contour;
+        typedef std::vector<Contour> Polygon;
+
+        struct Result
+        {
+            Result()
+                :
+                vertices{},
+                trees{}
+            {
+            }
+
+            std::vector<Vector2<ComputeType>> vertices;
+            std::vector<std::shared_ptr<PolygonTree>> trees;
+        };
+
+        // A Boolean operation for the batch interface. The subject and clip
+        // polygons are not owned by the task.
+        struct Task
+        {
+            Task()
+                :
+                subject(nullptr),
+                clip(nullptr),
+                operation(Operation::INTERSECTION),
+                result{}
+            {
+            }
+
+            Polygon const* subject;
+            Polygon const* clip;
+            Operation operation;
+            Result result;
+        };
+
+        PolygonBoolean2()
+            :
+            mOperation(Operation::INTERSECTION),
+            mNextOrder(0)
+        {
+        }
+
+        // Compute 'subject operation clip'. For DIFFERENCE, the result is
+        // the set of points in 'subject' that are not in 'clip'.
+        void operator()(Polygon const& subject, Polygon const& clip,
+            Operation operation, Result& result)
+        {
+            mOperation = operation;
+            mNextOrder = 0;
+            mPoints.clear();
+            mEvents.clear();
+            mProcessed.clear();
+            mQueue = std::priority_queue<Event*, std::vector<Event*>, EventGreater>();
+            result.vertices.clear();
+            result.trees.clear();
+
+            // Create the sweep events and compute the bounding boxes of
+            // the polygons.
+            std::array<Vector2<ComputeType>, 2> subjectBox, clipBox;
+            bool const subjectExists = CreateEvents(subject, true, subjectBox);
+            bool const clipExists = CreateEvents(clip, false, clipBox);
+
+            // Handle the cases when the result is trivially computed.
+            if (!subjectExists || !clipExists ||
+                subjectBox[1][0] < clipBox[0][0] || clipBox[1][0] < subjectBox[0][0] ||
+                subjectBox[1][1] < clipBox[0][1] || clipBox[1][1] < subjectBox[0][1])
+            {
+                if (operation == Operation::INTERSECTION ||
+                    (operation == Operation::DIFFERENCE && !subjectExists))
+                {
+                    return;
+                }
+            }
+
+            // The sweep can stop after the events that are right of the
+            // bounding box that contains the result. The box of a polygon
+            // is defined only when the polygon exists.
+            if (!subjectExists && !clipExists)
+            {
+                return;
+            }
+
+            ComputeType xmax;
+            if (!clipExists)
+            {
+                xmax = subjectBox[1][0];
+            }
+            else if (!subjectExists)
+            {
+                xmax = clipBox[1][0];
+            }
+            else if (operation == Operation::INTERSECTION)
+            {
+                xmax = std::min(subjectBox[1][0], clipBox[1][0]);
+            }
+            else if (operation == Operation::DIFFERENCE)
+            {
+                xmax = subjectBox[1][0];
+            }
+            else
+            {
+                xmax = std::max(subjectBox[1][0], clipBox[1][0]);
+            }
+
+            Sweep(xmax);
+            CreateResult(result);
+        }
+
+        // Execute a batch of Boolean operations. To run in the main thread
+        // only, choose numThreads to be 0. For multithreading, choose
+        // numThreads > 0. Each thread has its own PolygonBoolean2 object.
+        static void Execute(std::vector<Task>& tasks, size_t numThreads)
+        {
+            std::atomic<size_t> nextTask(0);
+            auto execute = [&tasks, &nextTask]()
+            {
+                PolygonBoolean2 boolean;
+                for (;;)
+                {
+                    size_t t = nextTask++;
+                    if (t >= tasks.size())
+                    {
+                        break;
+                    }
+                    Task& task = tasks[t];
+                    LogAssert(task.subject != nullptr && task.clip != nullptr,
+                        "Invalid task.");
+                    boolean(*task.subject, *task.clip, task.operation, task.result);
+                }
+            };
+
+            if (numThreads > 0)
+            {
+                numThreads = std::min(numThreads, tasks.size());
+                std::vector<std::thread> process(numThreads);
+                for (size_t i = 0; i < numThreads; ++i)
+                {
+                    process[i] = std::thread(execute);
+                }
+                for (size_t i = 0; i < numThreads; ++i)
+                {
+                    process[i].join();
+                }
+            }
+            else
+            {
+                execute();
+            }
+        }
+
+    private:
+        // The edge types of the Martinez algorithm. An edge that overlaps
+        // an edge of the other polygon is represented by one edge of type
+        // SAME_TRANSITION or DIFFERENT_TRANSITION, depending on whether the
+        // two polygons are on the same side of the edges, and the other
+        // edge has type NON_CONTRIBUTING.
+        enum EdgeType
+        {
+            NORMAL,
+            NON_CONTRIBUTING,
+            SAME_TRANSITION,
+            DIFFERENT_TRANSITION
+        };
+
+        struct Event;
+
+        struct SegmentLess
+        {
+            bool operator()(Event const* e0, Event const* e1) const
+            {
+                return CompareSegments(e0, e1) < 0;
+            }
+        };
+
+        struct EventGreater
+        {
+            bool operator()(Event const* e0, Event const* e1) const
+            {
+                return CompareEvents(e0, e1) > 0;
+            }
+        };
+
+        typedef std::set<Event*, SegmentLess> SweepLine;
+
+        // Each edge has a left event and a right event. The left endpoint
+        // of an edge is the lexicographically smaller endpoint. The members
+        // inOut, otherInOut, type and prevInResult are used only for left
+        // events.
+        struct Event
+        {
+            Event()
+                :
+                point{},
+                other(nullptr),
+                prevInResult(nullptr),
+                segment(0),
+                contour(0),
+                order(0),
+                index(-1),
+                vertex(-1),
+                edge(-1),
+                type(NORMAL),
+                left(false),
+                isSubject(false),
+                inOut(false),
+                otherInOut(false),
+                position{}
+            {
+            }
+
+            Vector2<ComputeType> point;
+            Event* other;
+            Event* prevInResult;
+
+            // The index of the input segment that contains the edge, the
+            // index of the contour of the input segment and the creation
+            // order of the event, the latter used to make the orderings of
+            // events and edges strict. The 'index' is the position of the
+            // event in the processing order.
+            int32_t segment, contour, order, index;
+
+            // The index of the vertex at the event point and the index of
+            // the result edge for a left event.
+            int32_t vertex, edge;
+
+            EdgeType type;
+            bool left, isSubject;
+
+            // The inOut member is 'true' when a vertical ray from below
+            // the edge exits the polygon of the edge when it crosses the
+            // edge. The otherInOut member is 'true' when the edge is
+            // outside the other polygon.
+            bool inOut, otherInOut;
+
+            // The location of the edge in the sweep line.
+            typename SweepLine::iterator position;
+        };
+
+        // The result edges directed so that the result is on the left.
+        struct Edge
+        {
+            int32_t v0, v1, contour;
+            bool used;
+        };
+
+        // A contour of the result.
+        struct ResultContour
+        {
+            std::vector<int32_t> vertices;
+            int32_t firstEvent, parent;
+            bool isOuter;
+            std::shared_ptr<PolygonTree> tree;
+        };
+
+        static ComputeType SignedArea(Vector2<ComputeType> const& p0,
+            Vector2<ComputeType> const& p1, Vector2<ComputeType> const& p2)
+        {
+            return (p0[0] - p2[0]) * (p1[1] - p2[1]) - (p1[0] - p2[0]) * (p0[1] - p2[1]);
+        }
+
+        // Test whether the edge of 'e' is below the point.
+        static bool IsBelow(Event const* e, Vector2<ComputeType> const& p)
+        {
+            ComputeType const zero = static_cast<ComputeType>(0);
+            return e->left ?
+                SignedArea(e->point, e->other->point, p) > zero :
+                SignedArea(e->other->point, e->point, p) > zero;
+        }
+
+        // Test whether the edge of the left event e0 is above the line of
+        // the edge of the left event e1. The edges are not collinear.
+        static bool IsAbove(Event const* e0, Event const* e1)
+        {
+            ComputeType const zero = static_cast<ComputeType>(0);
+            ComputeType area = SignedArea(e1->point, e1->other->point, e0->point);
+            if (area == zero)
+            {
+                area = SignedArea(e1->point, e1->other->point, e0->other->point);
+            }
+            return area > zero;
+        }
+
+        static bool IsVertical(Event const* e)
+        {
+            return e->point[0] == e->other->point[0];
+        }
+
+        // The order in which the events are processed. The return value is
+        // -1 when e0 is processed before e1 and +1 otherwise. The events at
+        // the same point are ordered with right events first and then from
+        // bottom to top.
+        static int32_t CompareEvents(Event const* e0, Event const* e1)
+        {
+            if (e0 == e1)
+            {
+                return 0;
+            }
+            if (e0->point[0] != e1->point[0])
+            {
+                return (e0->point[0] > e1->point[0] ? 1 : -1);
+            }
+            if (e0->point[1] != e1->point[1])
+            {
+                return (e0->point[1] > e1->point[1] ? 1 : -1);
+            }
+            if (e0->left != e1->left)
+            {
+                return (e0->left ? 1 : -1);
+            }
+            ComputeType const zero = static_cast<ComputeType>(0);
+            if (SignedArea(e0->point, e0->other->point, e1->other->point) != zero)
+            {
+                return (IsBelow(e0, e1->other->point) ? -1 : 1);
+            }
+            if (e0->isSubject != e1->isSubject)
+            {
+                return (e0->isSubject ? -1 : 1);
+            }
+            return (e0->order < e1->order ? -1 : 1);
+        }
+
+        // The order of the edges in the sweep line from bottom to top for
+        // left events e0 and e1. The return value is -1 when the edge of e0
+        // is below that of e1, +1 when it is above and 0 when e0 = e1.
+        static int32_t CompareSegments(Event const* e0, Event const* e1)
+        {
+            if (e0 == e1)
+            {
+                return 0;
+            }
+
+            ComputeType const zero = static_cast<ComputeType>(0);
+            if (SignedArea(e0->point, e0->other->point, e1->point) != zero ||
+                SignedArea(e0->point, e0->other->point, e1->other->point) != zero)
+            {
+                // The edges are not collinear.
+                if (e0->point == e1->point)
+                {
+                    return (IsBelow(e0, e1->other->point) ? -1 : 1);
+                }
+                if (e0->point[0] == e1->point[0])
+                {
+                    return (e0->point[1] < e1->point[1] ? -1 : 1);
+                }
+
+                // Compare the left endpoint of the edge that was inserted
+                // later with the line of the other edge. When the endpoint
+                // is on the line, the right endpoint is compared instead.
+                if (CompareEvents(e0, e1) > 0)
+                {
+                    return (IsAbove(e0, e1) ? 1 : -1);
+                }
+                return (IsAbove(e1, e0) ? -1 : 1);
+            }
+
+            // The edges are collinear.
+            if (e0->isSubject != e1->isSubject)
+            {
+                return (e0->isSubject ? -1 : 1);
+            }
+            if (e0->point == e1->point && e0->other->point == e1->other->point)
+            {
+                if (e0->contour != e1->contour)
+                {
+                    return (e0->contour < e1->contour ? -1 : 1);
+                }
+                return (e0->order < e1->order ? -1 : 1);
+            }
+            return (CompareEvents(e0, e1) > 0 ? 1 : -1);
+        }
+
+        Event* NewEvent(Vector2<ComputeType> const& point, bool left, Event* other,
+            int32_t segment, int32_t contour, bool isSubject)
+        {
+            mEvents.emplace_back();
+            Event* e = &mEvents.back();
+            e->point = point;
+            e->left = left;
+            e->other = other;
+            e->segment = segment;
+            e->contour = contour;
+            e->isSubject = isSubject;
+            e->order = mNextOrder++;
+            return e;
+        }
+
+        bool CreateEvents(Polygon const& polygon, bool isSubject,
+            std::array<Vector2<ComputeType>, 2>& box)
+        {
+            bool exists = false;
+            int32_t contour = 0;
+            for (auto const& input : polygon)
+            {
+                size_t const numPoints = input.size();
+                if (numPoints < 3)
+                {
+                    ++contour;
+                    continue;
+                }
+
+                for (size_t i0 = numPoints - 1, i1 = 0; i1 < numPoints; i0 = i1++)
+                {
+                    Vector2<ComputeType> p0{ input[i0][0], input[i0][1] };
+                    Vector2<ComputeType> p1{ input[i1][0], input[i1][1] };
+                    if (p0 == p1)
+                    {
+                        continue;
+                    }
+
+                    for (int32_t j = 0; j < 2; ++j)
+                    {
+                        if (!exists || p1[j] < box[0][j])
+                        {
+                            box[0][j] = p1[j];
+                        }
+                        if (!exists || p1[j] > box[1][j])
+                        {
+                            box[1][j] = p1[j];
+                        }
+                    }
+                    exists = true;
+
+                    int32_t segment = static_cast<int32_t>(mPoints.size());
+                    mPoints.push_back({ p0, p1 });
+                    Event* e0 = NewEvent(p0, true, nullptr, segment, contour, isSubject);
+                    Event* e1 = NewEvent(p1, true, e0, segment, contour, isSubject);
+                    e0->other = e1;
+                    if (CompareEvents(e0, e1) < 0)
+                    {
+                        e1->left = false;
+                    }
+                    else
+                    {
+                        e0->left = false;
+                    }
+                    mQueue.push(e0);
+                    mQueue.push(e1);
+                }
+                ++contour;
+            }
+            return exists;
+        }
+
+        void Sweep(ComputeType const& xmax)
+        {
+            SweepLine sweepLine;
+            while (mQueue.size() > 0)
+            {
+                Event* e = mQueue.top();
+                mQueue.pop();
+                if (e->point[0] > xmax)
+                {
+                    // The remaining events cannot contribute to the result.
+                    while (mQueue.size() > 0)
+                    {
+                        mQueue.pop();
+                    }
+                    break;
+                }
+                e->index = static_cast<int32_t>(mProcessed.size());
+                mProcessed.push_back(e);
+
+                if (e->left)
+                {
+                    e->position = sweepLine.insert(e).first;
+                    Event* prev = (e->position != sweepLine.begin() ?
+                        *std::prev(e->position) : nullptr);
+                    auto nextIter = std::next(e->position);
+                    Event* next = (nextIter != sweepLine.end() ? *nextIter : nullptr);
+
+                    ComputeFields(e, prev);
+                    if (next && PossibleIntersection(e, next) == 2)
+                    {
+                        ComputeFields(e, prev);
+                        ComputeFields(next, e);
+                    }
+                    if (prev && PossibleIntersection(prev, e) == 2)
+                    {
+                        Event* prevPrev = (prev->position != sweepLine.begin() ?
+                            *std::prev(prev->position) : nullptr);
+                        ComputeFields(prev, prevPrev);
+                        ComputeFields(e, prev);
+                    }
+                }
+                else
+                {
+                    Event* s = e->other;
+                    Event* prev = (s->position != sweepLine.begin() ?
+                        *std::prev(s->position) : nullptr);
+                    auto nextIter = std::next(s->position);
+                    Event* next = (nextIter != sweepLine.end() ? *nextIter : nullptr);
+                    sweepLine.erase(s->position);
+                    if (prev && next)
+                    {
+                        PossibleIntersection(prev, next);
+                    }
+                }
+            }
+        }
+
+        void ComputeFields(Event* e, Event* prev) const
+        {
+            if (prev == nullptr)
+            {
+                e->inOut = false;
+                e->otherInOut = true;
+                e->prevInResult = nullptr;
+                return;
+            }
+
+            if (e->isSubject == prev->isSubject)
+            {
+                e->inOut = !prev->inOut;
+                e->otherInOut = prev->otherInOut;
+            }
+            else
+            {
+                e->inOut = !prev->otherInOut;
+                e->otherInOut = (IsVertical(prev) ? !prev->inOut : prev->inOut);
+            }
+
+            bool above;
+            e->prevInResult = (!InResult(prev, above) || IsVertical(prev) ?
+                prev->prevInResult : prev);
+        }
+
+        bool Apply(bool inSubject, bool inClip) const
+        {
+            switch (mOperation)
+            {
+            case Operation::INTERSECTION:
+                return inSubject && inClip;
+            case Operation::UNION:
+                return inSubject || inClip;
+            case Operation::DIFFERENCE:
+                return inSubject && !inClip;
+            default:  // Operation::EXCLUSIVE_OR
+                return inSubject != inClip;
+            }
+        }
+
+        // Determine whether the edge of the left event is an edge of the
+        // result. If it is, 'above' is set to 'true' when the result is
+        // above the edge and to 'false' when the result is below the edge.
+        bool InResult(Event const* e, bool& above) const
+        {
+            bool subjectAbove, clipAbove, subjectBelow, clipBelow;
+            bool const ownAbove = !e->inOut;
+            switch (e->type)
+            {
+            case NORMAL:
+            {
+                bool const otherInside = !e->otherInOut;
+                subjectAbove = (e->isSubject ? ownAbove : otherInside);
+                subjectBelow = (e->isSubject ? !ownAbove : otherInside);
+                clipAbove = (e->isSubject ? otherInside : ownAbove);
+                clipBelow = (e->isSubject ? otherInside : !ownAbove);
+                break;
+            }
+            case SAME_TRANSITION:
+                subjectAbove = ownAbove;
+                clipAbove = ownAbove;
+                subjectBelow = !ownAbove;
+                clipBelow = !ownAbove;
+                break;
+            case DIFFERENT_TRANSITION:
+                subjectAbove = (e->isSubject ? ownAbove : !ownAbove);
+                clipAbove = !subjectAbove;
+                subjectBelow = !subjectAbove;
+                clipBelow = subjectAbove;
+                break;
+            default:  // NON_CONTRIBUTING
+                above = false;
+                return false;
+            }
+
+            above = Apply(subjectAbove, clipAbove);
+            return above != Apply(subjectBelow, clipBelow);
+        }
+
+        // Split the edge of the left event e at the point p, which is
+        // strictly between the endpoints of the edge.
+        void DivideSegment(Event* e, Vector2<ComputeType> const& p)
+        {
+            Event* r = NewEvent(p, false, e, e->segment, e->contour, e->isSubject);
+            Event* l = NewEvent(p, true, e->other, e->segment, e->contour, e->isSubject);
+            e->other->other = l;
+            e->other = r;
+            mQueue.push(l);
+            mQueue.push(r);
+        }
+
+        // Compute the intersection of the edges of left events e0 and e1,
+        // which are adjacent in the sweep line, and split the edges at the
+        // intersection. The return value is 0 when the edges do not
+        // intersect or intersect only at an endpoint of both edges, 1 when
+        // they intersect at a single point, 2 when they overlap and share
+        // the left endpoint and 3 for the other overlaps.
+        int32_t PossibleIntersection(Event* e0, Event* e1)
+        {
+            Vector2<ComputeType> const& a0 = e0->point;
+            Vector2<ComputeType> const& a1 = e0->other->point;
+            Vector2<ComputeType> const& b0 = e1->point;
+            Vector2<ComputeType> const& b1 = e1->other->point;
+            ComputeType const zero = static_cast<ComputeType>(0);
+
+            ComputeType s0 = SignedArea(a0, a1, b0);
+            ComputeType s1 = SignedArea(a0, a1, b1);
+            if (s0 != zero || s1 != zero)
+            {
+                // The edges are not collinear.
+                if ((s0 > zero && s1 > zero) || (s0 < zero && s1 < zero))
+                {
+                    return 0;
+                }
+                ComputeType t0 = SignedArea(b0, b1, a0);
+                ComputeType t1 = SignedArea(b0, b1, a1);
+                if ((t0 > zero && t1 > zero) || (t0 < zero && t1 < zero))
+                {
+                    return 0;
+                }
+
+                // The edges intersect at a single point. When the edges
+                // share an endpoint, that point is the intersection.
+                if (a0 == b0 || a1 == b1)
+                {
+                    return 0;
+                }
+
+                Vector2<ComputeType> p;
+                if (s0 == zero)
+                {
+                    p = b0;
+                }
+                else if (s1 == zero)
+                {
+                    p = b1;
+                }
+                else if (t0 == zero)
+                {
+                    p = a0;
+                }
+                else if (t1 == zero)
+                {
+                    p = a1;
+                }
+                else
+                {
+                    p = ComputeIntersection(e0->segment, e1->segment);
+                }
+
+                if (p != a0 && p != a1)
+                {
+                    DivideSegment(e0, p);
+                }
+                if (p != b0 && p != b1)
+                {
+                    DivideSegment(e1, p);
+                }
+                return 1;
+            }
+
+            // The edges are collinear. Test whether they overlap in more
+            // than a point.
+            int32_t const j = (a0[0] != a1[0] ? 0 : 1);
+            ComputeType const& umin = std::max(a0[j], b0[j]);
+            ComputeType const& umax = std::min(a1[j], b1[j]);
+            if (umin > umax)
+            {
+                return 0;
+            }
+            if (umin == umax)
+            {
+                // The edges touch at an endpoint of both edges.
+                return 0;
+            }
+            if (e0->isSubject == e1->isSubject)
+            {
+                // The edges of a polygon overlap, which is invalid input.
+                return 0;
+            }
+
+            // The edges overlap. Sort the endpoint events and split the
+            // edges so that the overlap is a pair of identical edges.
+            std::array<Event*, 4> events{};
+            int32_t numEvents = 0;
+            bool const leftCoincide = (a0 == b0);
+            bool const rightCoincide = (a1 == b1);
+            if (!leftCoincide)
+            {
+                if (CompareEvents(e0, e1) > 0)
+                {
+                    events[numEvents++] = e1;
+                    events[numEvents++] = e0;
+                }
+                else
+                {
+                    events[numEvents++] = e0;
+                    events[numEvents++] = e1;
+                }
+            }
+            if (!rightCoincide)
+            {
+                if (CompareEvents(e0->other, e1->other) > 0)
+                {
+                    events[numEvents++] = e1->other;
+                    events[numEvents++] = e0->other;
+                }
+                else
+                {
+                    events[numEvents++] = e0->other;
+                    events[numEvents++] = e1->other;
+                }
+            }
+
+            if (leftCoincide)
+            {
+                // The edges are equal or share the left endpoint.
+                e1->type = NON_CONTRIBUTING;
+                e0->type = (e1->inOut == e0->inOut ? SAME_TRANSITION : DIFFERENT_TRANSITION);
+                if (!rightCoincide)
+                {
+                    DivideSegment(events[1]->other, events[0]->point);
+                }
+                return 2;
+            }
+
+            if (rightCoincide)
+            {
+                // The edges share the right endpoint.
+                DivideSegment(events[0], events[1]->point);
+                return 3;
+            }
+
+            if (events[0] != events[3]->other)
+            {
+                // Neither edge contains the other.
+                DivideSegment(events[0], events[1]->point);
+                DivideSegment(events[1], events[2]->point);
+                return 3;
+            }
+
+            // One edge contains the other.
+            DivideSegment(events[0], events[1]->point);
+            DivideSegment(events[3]->other, events[2]->point);
+            return 3;
+        }
+
+        // Compute the intersection of the lines containing input segments
+        // s0 and s1, which are known to intersect at a single point.
+        Vector2<ComputeType> ComputeIntersection(int32_t s0, int32_t s1) const
+        {
+            Vector2<ComputeType> const& a0 = mPoints[s0][0];
+            Vector2<ComputeType> const& a1 = mPoints[s0][1];
+            Vector2<ComputeType> const& b0 = mPoints[s1][0];
+            Vector2<ComputeType> const& b1 = mPoints[s1][1];
+            Vector2<ComputeType> da = a1 - a0, db = b1 - b0;
+            ComputeType t = DotPerp(b0 - a0, db) / DotPerp(da, db);
+            return a0 + t * da;
+        }
+
+        void CreateResult(Result& result)
+        {
+            // Assign vertex indices to the event points. The events are
+            // processed in lexicographic order of the points, so equal
+            // points are consecutive.
+            int32_t numVertices = 0;
+            for (size_t i = 0; i < mProcessed.size(); ++i)
+            {
+                if (i > 0 && mProcessed[i]->point != mProcessed[i - 1]->point)
+                {
+                    ++numVertices;
+                }
+                mProcessed[i]->vertex = numVertices;
+            }
+            ++numVertices;
+
+            // Collect the result edges and direct them so that the result
+            // is on the left side of each edge.
+            std::vector<Edge> edges;
+            std::vector<Event*> edgeEvents;
+            std::vector<bool> edgeAbove;
+            std::vector<int32_t> outCount(static_cast<size_t>(numVertices) + 1, 0);
+            for (auto e : mProcessed)
+            {
+                bool above;
+                if (e->left && e->other->vertex >= 0 && InResult(e, above))
+                {
+                    e->edge = static_cast<int32_t>(edges.size());
+                    Edge edge{};
+                    edge.v0 = (above ? e->vertex : e->other->vertex);
+                    edge.v1 = (above ? e->other->vertex : e->vertex);
+                    edge.contour = -1;
+                    edge.used = false;
+                    edges.push_back(edge);
+                    edgeEvents.push_back(e);
+                    edgeAbove.push_back(above);
+                    ++outCount[static_cast<size_t>(edge.v0) + 1];
+                }
+            }
+            if (edges.size() == 0)
+            {
+                return;
+            }
+
+            // Store the outgoing edges of each vertex contiguously.
+            for (int32_t v = 0; v < numVertices; ++v)
+            {
+                outCount[static_cast<size_t>(v) + 1] += outCount[v];
+            }
+            std::vector<int32_t> outEdges(edges.size());
+            std::vector<int32_t> next(outCount.begin(), outCount.end() - 1);
+            for (size_t i = 0; i < edges.size(); ++i)
+            {
+                outEdges[next[edges[i].v0]++] = static_cast<int32_t>(i);
+            }
+
+            // The points of the vertices.
+            std::vector<Vector2<ComputeType> const*> points(static_cast<size_t>(numVertices));
+            for (auto e : mProcessed)
+            {
+                points[e->vertex] = &e->point;
+            }
+
+            // Link the edges into contours. When a vertex has multiple
+            // outgoing edges, the next edge is the first edge clockwise
+            // from the reversed incoming edge, which keeps the contours that
+            // touch at the vertex separate.
+            std::vector<ResultContour> contours;
+            for (size_t i = 0; i < edges.size(); ++i)
+            {
+                if (edges[i].used)
+                {
+                    continue;
+                }
+
+                ResultContour contour;
+                int32_t const contourIndex = static_cast<int32_t>(contours.size());
+                contour.firstEvent = edgeEvents[i]->index;
+                int32_t current = static_cast<int32_t>(i);
+                int32_t const start = edges[i].v0;
+                for (;;)
+                {
+                    Edge& edge = edges[current];
+                    edge.used = true;
+                    edge.contour = contourIndex;
+                    contour.vertices.push_back(edge.v0);
+                    contour.firstEvent = std::min(contour.firstEvent, edgeEvents[current]->index);
+                    if (edge.v1 == start)
+                    {
+                        break;
+                    }
+
+                    current = GetNextEdge(edge, edges, outEdges, outCount, points);
+                    if (current == -1)
+                    {
+                        // This occurs only for invalid input.
+                        break;
+                    }
+                }
+
+                // The signed area determines whether the contour is outer
+                // (counterclockwise) or inner (clockwise).
+                ComputeType area = static_cast<ComputeType>(0);
+                size_t const numContourVertices = contour.vertices.size();
+                for (size_t k0 = numContourVertices - 1, k1 = 0; k1 < numContourVertices; k0 = k1++)
+                {
+                    area += DotPerp(*points[contour.vertices[k0]], *points[contour.vertices[k1]]);
+                }
+                contour.isOuter = (area > static_cast<ComputeType>(0));
+                contour.parent = -1;
+                contours.push_back(std::move(contour));
+            }
+
+            // Determine the nesting of the contours. The first edge of a
+            // contour in the sweep order is inserted at the leftmost point
+            // of the contour, and the nearest result edge below that point
+            // belongs to the parent or to a sibling of the contour. The
+            // contours are processed in sweep order, so the parent of the
+            // contour of that edge is known.
+            std::vector<int32_t> sorted(contours.size());
+            for (size_t c = 0; c < contours.size(); ++c)
+            {
+                sorted[c] = static_cast<int32_t>(c);
+            }
+            std::sort(sorted.begin(), sorted.end(), [&contours](int32_t c0, int32_t c1)
+            {
+                return contours[c0].firstEvent < contours[c1].firstEvent;
+            });
+
+
+            for (auto c : sorted)
+            {
+                ResultContour& contour = contours[c];
+                Event const* first = mProcessed[contour.firstEvent];
+                Event const* below = first->prevInResult;
+                int32_t parent = -1;
+                if (below != nullptr && below->edge >= 0)
+                {
+                    int32_t q = edges[below->edge].contour;
+                    parent = (edgeAbove[below->edge] == contours[q].isOuter ?
+                        q : contours[q].parent);
+                }
+                while (parent != -1 && contours[parent].isOuter == contour.isOuter)
+                {
+                    parent = contours[parent].parent;
+                }
+                contour.parent = parent;
+            }
+
+            // Compact the vertices and create the trees.
+            std::vector<int32_t> remap(static_cast<size_t>(numVertices), -1);
+            for (auto c : sorted)
+            {
+                ResultContour& contour = contours[c];
+                contour.tree = std::make_shared<PolygonTree>();
+                contour.tree->polygon.reserve(contour.vertices.size());
+                for (auto v : contour.vertices)
+                {
+                    if (remap[v] == -1)
+                    {
+                        remap[v] = static_cast<int32_t>(result.vertices.size());
+                        result.vertices.push_back(*points[v]);
+                    }
+                    contour.tree->polygon.push_back(remap[v]);
+                }
+
+                if (contour.parent == -1)
+                {
+                    result.trees.push_back(contour.tree);
+                }
+                else
+                {
+                    contours[contour.parent].tree->child.push_back(contour.tree);
+                }
+            }
+        }
+
+        int32_t GetNextEdge(Edge const& incoming, std::vector<Edge> const& edges,
+            std::vector<int32_t> const& outEdges, std::vector<int32_t> const& outCount,
+            std::vector<Vector2<ComputeType> const*> const& points) const
+        {
+            int32_t const v = incoming.v1;
+            int32_t best = -1;
+            Vector2<ComputeType> const& origin = *points[v];
+            Vector2<ComputeType> reference = *points[incoming.v0] - origin;
+            Vector2<ComputeType> bestDirection{};
+            int32_t bestHalf = 0;
+            ComputeType const zero = static_cast<ComputeType>(0);
+            for (int32_t k = outCount[v]; k < outCount[static_cast<size_t>(v) + 1]; ++k)
+            {
+                int32_t candidate = outEdges[k];
+                if (edges[candidate].used)
+                {
+                    continue;
+                }
+
+                // Half 0 contains the directions clockwise from the
+                // reference direction by an angle in (0,pi]. Half 1
+                // contains the directions clockwise by an angle in
+                // (pi,2*pi].
+                Vector2<ComputeType> direction = *points[edges[candidate].v1] - origin;
+                ComputeType cross = DotPerp(reference, direction);
+                int32_t half = (cross < zero || (cross == zero && Dot(reference, direction) < zero) ? 0 : 1);
+                if (best == -1 || half < bestHalf ||
+                    (half == bestHalf && DotPerp(direction, bestDirection) < zero))
+                {
+                    best = candidate;
+                    bestDirection = direction;
+                    bestHalf = half;
+                }
+            }
+            return best;
+        }
+
+        Operation mOperation;
+        int32_t mNextOrder;
+        std::vector<std::array<Vector2<ComputeType>, 2>> mPoints;
+        std::deque<Event> mEvents;
+        std::priority_queue<Event*, std::vector<Event*>, EventGreater> mQueue;
+        std::vector<Event*> mProcessed;
+    };
+}
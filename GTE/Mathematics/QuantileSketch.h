@@ -0,0 +1,326 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2022
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 6.3.2026.10.17
+
+#pragma once
+
+#include <GTE/Mathematics/Logger.h>
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// A streaming sketch for estimating the quantiles of a large set of
+// floating-point samples using memory that grows only logarithmically with
+// the number of samples. The sketch is a hierarchy of compactors. The
+// samples are inserted into level 0. Each sample stored in level h
+// represents 2^h samples. When a level has 'capacity' samples, it is sorted
+// and every other sample, starting with the first or second sample
+// alternately, is moved to level h+1 while the others are discarded. The
+// rank of a sample in the sketch differs from its rank in the input by
+// O(log(n/capacity)/capacity) times the number n of samples, and in
+// practice the error is much smaller than this bound. The minimum and
+// maximum are exact. For an introduction to compactor-based sketches, see
+//   Z. Karnin, K. Lang and E. Liberty, "Optimal Quantile Approximation in
+//   Streams", IEEE 57th Annual Symposium on Foundations of Computer
+//   Science (FOCS), 2016, pp. 71-78.
+//
+// Sketches can be merged, so the samples may be partitioned among threads
+// and the per-thread sketches merged at the end. NaN samples are ignored.
+
+namespace gte
+{
+    template <typename Real>
+    class QuantileSketch
+    {
+    public:
+        QuantileSketch(size_t capacity = 256)
+            :
+            mCapacity(capacity),
+            mNumSamples(0),
+            mMinValue((Real)0),
+            mMaxValue((Real)0),
+            mLevels{},
+            mOffsets{}
+        {
+            LogAssert(capacity >= 2, "Invalid capacity.");
+        }
+
+        void Clear()
+        {
+            mNumSamples = 0;
+            mLevels.clear();
+            mOffsets.clear();
+        }
+
+        void Insert(Real value)
+        {
+            if (value != value)
+            {
+                // Ignore NaN samples.
+                return;
+            }
+
+            if (mNumSamples == 0)
+            {
+                mMinValue = value;
+                mMaxValue = value;
+            }
+            else if (value < mMinValue)
+            {
+                mMinValue = value;
+            }
+            else if (value > mMaxValue)
+            {
+                mMaxValue = value;
+            }
+            ++mNumSamples;
+
+            if (mLevels.size() == 0)
+            {
+                AddLevel();
+            }
+            mLevels[0].push_back(value);
+            if (mLevels[0].size() >= mCapacity)
+            {
+                Compress();
+            }
+        }
+
+        // Insert a batch of samples. To run in the main thread only, choose
+        // numThreads to be 0. For multithreading, choose numThreads > 0.
+        // Each thread inserts its samples into its own sketch and the
+        // sketches are merged into this one.
+        void Insert(size_t numSamples, Real const* samples, size_t numThreads = 0)
+        {
+            LogAssert(numSamples == 0 || samples != nullptr, "Invalid input.");
+
+            numThreads = std::min(numThreads, numSamples);
+            if (numThreads > 0)
+            {
+                std::vector<QuantileSketch> sketches(numThreads, QuantileSketch(mCapacity));
+                std::vector<std::thread> process(numThreads);
+                for (size_t t = 0; t < numThreads; ++t)
+                {
+                    size_t imin = t * numSamples / numThreads;
+                    size_t imax = (t + 1) * numSamples / numThreads;
+                    process[t] = std::thread([samples, imin, imax, &sketches, t]()
+                    {
+                        for (size_t i = imin; i < imax; ++i)
+                        {
+                            sketches[t].Insert(samples[i]);
+                        }
+                    });
+                }
+                for (size_t t = 0; t < numThreads; ++t)
+                {
+                    process[t].join();
+                }
+                for (auto const& sketch : sketches)
+                {
+                    Merge(sketch);
+                }
+            }
+            else
+            {
+                for (size_t i = 0; i < numSamples; ++i)
+                {
+                    Insert(samples[i]);
+                }
+            }
+        }
+
+        // Merge a sketch for another set of samples into this one. The
+        // sketches must have the same capacity.
+        void Merge(QuantileSketch const& other)
+        {
+            LogAssert(other.mCapacity == mCapacity, "The sketches must have the same capacity.");
+
+            if (other.mNumSamples == 0)
+            {
+                return;
+            }
+
+            if (mNumSamples == 0)
+            {
+                mMinValue = other.mMinValue;
+                mMaxValue = other.mMaxValue;
+            }
+            else
+            {
+                mMinValue = std::min(mMinValue, other.mMinValue);
+                mMaxValue = std::max(mMaxValue, other.mMaxValue);
+            }
+            mNumSamples += other.mNumSamples;
+
+            while (mLevels.size() < other.mLevels.size())
+            {
+                AddLevel();
+            }
+            for (size_t h = 0; h < other.mLevels.size(); ++h)
+            {
+                mLevels[h].insert(mLevels[h].end(), other.mLevels[h].begin(),
+                    other.mLevels[h].end());
+            }
+            Compress();
+        }
+
+        // Member access.
+        inline size_t GetCapacity() const
+        {
+            return mCapacity;
+        }
+
+        inline uint64_t GetNumSamples() const
+        {
+            return mNumSamples;
+        }
+
+        // The extremes are exact. They are valid only when the sketch has
+        // samples.
+        inline Real GetMinValue() const
+        {
+            return mMinValue;
+        }
+
+        inline Real GetMaxValue() const
+        {
+            return mMaxValue;
+        }
+
+        // Estimate the value at the specified fraction q in [0,1] of the
+        // samples, that is, the smallest stored value whose estimated rank
+        // is at least q*n. The function returns 0 when the sketch has no
+        // samples.
+        Real GetQuantile(double q) const
+        {
+            std::vector<Real> quantiles;
+            GetQuantiles(std::vector<double>{ q }, quantiles);
+            return quantiles[0];
+        }
+
+        // Estimate several quantiles with a single pass over the samples
+        // of the sketch.
+        void GetQuantiles(std::vector<double> const& q, std::vector<Real>& quantiles) const
+        {
+            quantiles.resize(q.size());
+            if (mNumSamples == 0)
+            {
+                std::fill(quantiles.begin(), quantiles.end(), (Real)0);
+                return;
+            }
+
+            std::vector<std::pair<Real, uint64_t>> weighted;
+            for (size_t h = 0; h < mLevels.size(); ++h)
+            {
+                uint64_t weight = static_cast<uint64_t>(1) << h;
+                for (auto value : mLevels[h])
+                {
+                    weighted.push_back(std::make_pair(value, weight));
+                }
+            }
+            std::sort(weighted.begin(), weighted.end(),
+                [](std::pair<Real, uint64_t> const& w0, std::pair<Real, uint64_t> const& w1)
+                {
+                    return w0.first < w1.first;
+                });
+
+            uint64_t total = 0;
+            for (auto const& w : weighted)
+            {
+                total += w.second;
+            }
+
+            for (size_t j = 0; j < q.size(); ++j)
+            {
+                double fraction = std::min(std::max(q[j], 0.0), 1.0);
+                if (fraction == 0.0)
+                {
+                    quantiles[j] = mMinValue;
+                    continue;
+                }
+                if (fraction == 1.0)
+                {
+                    quantiles[j] = mMaxValue;
+                    continue;
+                }
+
+                double const target = fraction * static_cast<double>(total);
+                uint64_t rank = 0;
+                quantiles[j] = mMaxValue;
+                for (auto const& w : weighted)
+                {
+                    rank += w.second;
+                    if (static_cast<double>(rank) >= target)
+                    {
+                        quantiles[j] = w.first;
+                        break;
+                    }
+                }
+            }
+        }
+
+    private:
+        void AddLevel()
+        {
+            mLevels.emplace_back();
+            mLevels.back().reserve(mCapacity);
+            mOffsets.push_back(0);
+        }
+
+        // Compact every level that is full, moving half of its samples to
+        // the next level.
+        void Compress()
+        {
+            for (size_t h = 0; h < mLevels.size(); ++h)
+            {
+                if (mLevels[h].size() < mCapacity)
+                {
+                    continue;
+                }
+
+                if (h + 1 == mLevels.size())
+                {
+                    AddLevel();
+                }
+
+                auto& level = mLevels[h];
+                auto& nextLevel = mLevels[h + 1];
+                std::sort(level.begin(), level.end());
+
+                // An odd sample is kept in this level so that the total
+                // weight is preserved.
+                size_t numCompacted = level.size() & ~static_cast<size_t>(1);
+                for (size_t i = mOffsets[h]; i < numCompacted; i += 2)
+                {
+                    nextLevel.push_back(level[i]);
+                }
+                mOffsets[h] = 1 - mOffsets[h];
+
+                if (numCompacted < level.size())
+                {
+                    level[0] = level.back();
+                    level.resize(1);
+                }
+                else
+                {
+                    level.clear();
+                }
+            }
+        }
+
+        size_t mCapacity;
+        uint64_t mNumSamples;
+        Real mMinValue, mMaxValue;
+
+        // The samples of level h have weight 2^h.
+        std::vector<std::vector<Real>> mLevels;
+
+        // The alternating offsets of the compactions of the levels.
+        std::vector<size_t> mOffsets;
+    };
+}
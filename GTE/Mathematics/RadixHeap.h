@@ -0,0 +1,143 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2022
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 6.3.2026.10.17
+
+#pragma once
+
+#include <GTE/Mathematics/BitHacks.h>
+#include <GTE/Mathematics/Logger.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// A radix heap is a monotone priority queue for unsigned integer keys. The
+// key of each inserted element must be at least the key of the last removed
+// element, which is the case for the distances of Dijkstra's algorithm.
+// The elements are stored in buckets: bucket 0 has the elements whose keys
+// equal the last removed key and bucket i > 0 has the elements whose keys
+// first differ from the last removed key at bit i-1. Insertion is O(1).
+// Removal is amortized O(b) for b-bit keys, because an element moves only
+// to lower buckets. Unlike MinHeap, keys cannot be modified. To decrease
+// the key of a value, insert the value again and ignore the stale element
+// when it is removed.
+//
+// Nonnegative IEEE floating-point numbers have the same order as their
+// binary encodings as unsigned integers, so float and double keys can be
+// stored as uint32_t and uint64_t keys.
+
+namespace gte
+{
+    template <typename Key, typename Value>
+    class RadixHeap
+    {
+    public:
+        static_assert(std::is_same<Key, uint32_t>::value || std::is_same<Key, uint64_t>::value,
+            "The key must be uint32_t or uint64_t.");
+
+        enum
+        {
+            NUM_BUCKETS = 8 * sizeof(Key) + 1
+        };
+
+        // Construction.
+        RadixHeap()
+            :
+            mNumElements(0),
+            mLast(0),
+            mBuckets{}
+        {
+        }
+
+        // Member access.
+        inline size_t GetNumElements() const
+        {
+            return mNumElements;
+        }
+
+        // The key of the last removed element, which is a lower bound for
+        // the keys of the elements in the heap.
+        inline Key GetLastKey() const
+        {
+            return mLast;
+        }
+
+        // Remove all elements and allow keys starting at 0.
+        void Reset()
+        {
+            for (auto& bucket : mBuckets)
+            {
+                bucket.clear();
+            }
+            mNumElements = 0;
+            mLast = 0;
+        }
+
+        // The key must be at least GetLastKey().
+        void Insert(Key key, Value const& value)
+        {
+            LogAssert(key >= mLast, "The key is smaller than the last removed key.");
+            mBuckets[GetBucket(key)].emplace_back(key, value);
+            ++mNumElements;
+        }
+
+        // Remove an element with the minimum key. The function returns
+        // 'false' when the heap is empty. When several elements have the
+        // minimum key, they are removed in an unspecified order.
+        bool Remove(Key& key, Value& value)
+        {
+            if (mNumElements == 0)
+            {
+                return false;
+            }
+
+            if (mBuckets[0].empty())
+            {
+                // Find the first nonempty bucket and distribute its elements
+                // to lower buckets relative to its minimum key.
+                size_t i = 1;
+                while (mBuckets[i].empty())
+                {
+                    ++i;
+                }
+
+                auto& bucket = mBuckets[i];
+                mLast = bucket[0].first;
+                for (auto const& element : bucket)
+                {
+                    if (element.first < mLast)
+                    {
+                        mLast = element.first;
+                    }
+                }
+                for (auto const& element : bucket)
+                {
+                    mBuckets[GetBucket(element.first)].push_back(element);
+                }
+                bucket.clear();
+            }
+
+            auto const& element = mBuckets[0].back();
+            key = element.first;
+            value = element.second;
+            mBuckets[0].pop_back();
+            --mNumElements;
+            return true;
+        }
+
+    private:
+        inline size_t GetBucket(Key key) const
+        {
+            return (key == mLast ? 0 : static_cast<size_t>(BitHacks::GetLeadingBit(key ^ mLast)) + 1);
+        }
+
+        size_t mNumElements;
+        Key mLast;
+        std::array<std::vector<std::pair<Key, Value>>, NUM_BUCKETS> mBuckets;
+    };
+}
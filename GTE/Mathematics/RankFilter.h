@@ -0,0 +1,473 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2022
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 6.3.2026.10.17
+
+#pragma once
+
+#include <GTE/Mathematics/Logger.h>
+#include <GTE/Mathematics/Image2.h>
+#include <GTE/Mathematics/Image3.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Median and rank (percentile) filters for Image2 and Image3 objects with
+// 8-bit or 16-bit unsigned pixels. The window is the square (cube) of
+// pixels (voxels) with coordinates within 'radius' of the center. The
+// image is extended by replicating its boundary pixels, so every window
+// has (2*radius+1)^2 (or (2*radius+1)^3) elements. The output at a pixel
+// is the element of rank k of the sorted window elements, where
+// k = round(quantile * (numElements - 1)) for a quantile in [0,1]. The
+// median is quantile 0.5.
+//
+// The 2D filter is the algorithm of
+//   S. Perreault and P. Hebert, "Median Filtering in Constant Time",
+//   IEEE Transactions on Image Processing, 16(9):2389-2394, 2007.
+// Each image column has a histogram of its pixels in the window rows. The
+// histogram of the window is updated from one pixel to the next by adding
+// the column histogram that enters the window and subtracting the one that
+// leaves it, so the cost of this update does not depend on the radius. The
+// histograms are two-level: a pixel value v is counted in coarse bin
+// v >> B and in fine bin v, where B = 4 for 8-bit pixels and B = 8 for
+// 16-bit pixels. The window histogram of the fine bins of a coarse bin is
+// updated only when the rank search reaches that coarse bin, which for
+// natural images is a small subset of the coarse bins.
+//
+// The 3D filter uses the same algorithm, where the column histograms count
+// the voxels of a (2*radius+1)x(2*radius+1) square in the (y,z) plane.
+// Updating a column histogram from one row to the next costs O(radius)
+// per voxel, which is small compared to the histogram operations.
+//
+// The image columns are partitioned into strips of STRIP_WIDTH columns
+// (and the 3D images into slices), which are processed in parallel when
+// numThreads > 0. Each strip also maintains the column histograms of the
+// 2*radius columns that overlap its neighbors, and each row of a strip
+// starts with a window histogram built from 2*radius+1 column histograms.
+// The cost per pixel is therefore O(1 + 2*radius/STRIP_WIDTH) histogram
+// operations, which is nearly constant for 8-bit pixels (STRIP_WIDTH is
+// 1024) but grows with the radius for 16-bit pixels (STRIP_WIDTH is 64,
+// which bounds the memory of the larger histograms). The memory for the
+// column histograms of a 16-bit filter is approximately
+// (STRIP_WIDTH + 2*radius) * 2^17 bytes per thread. The column histograms
+// have 16-bit counts, so the radius is at most 32767 for 2D images and at
+// most 127 for 3D images.
+
+namespace gte
+{
+    template <typename PixelType>
+    class RankFilter
+    {
+    public:
+        static_assert(std::is_same<PixelType, uint8_t>::value ||
+            std::is_same<PixelType, uint16_t>::value,
+            "The pixel type must be uint8_t or uint16_t.");
+
+        enum
+        {
+            NUM_BITS = 8 * sizeof(PixelType),
+            NUM_FINE_BITS = NUM_BITS / 2,
+            NUM_COARSE = 1 << (NUM_BITS - NUM_FINE_BITS),
+            NUM_FINE = 1 << NUM_FINE_BITS,
+            NUM_VALUES = 1 << NUM_BITS,
+            STRIP_WIDTH = (NUM_BITS == 8 ? 1024 : 64)
+        };
+
+        // The output image must be an object different from the input
+        // image. It is resized to the dimensions of the input image. To
+        // compute in the main thread only, choose numThreads to be 0. For
+        // multithreading, choose numThreads > 0.
+        static void Execute(Image2<PixelType> const& input, int32_t radius,
+            double quantile, size_t numThreads, Image2<PixelType>& output)
+        {
+            LogAssert(radius >= 0 && quantile >= 0.0 && quantile <= 1.0, "Invalid argument.");
+            LogAssert(&input != &output, "The output must be a different object.");
+
+            int32_t const dim0 = input.GetDimension(0);
+            int32_t const dim1 = input.GetDimension(1);
+            output.Reconstruct(dim0, dim1);
+            if (input.GetNumPixels() == 0)
+            {
+                return;
+            }
+
+            int32_t const width = 2 * radius + 1;
+            LogAssert(width <= UINT16_MAX, "The radius is too large.");
+            uint32_t const rank = GetRank(static_cast<uint64_t>(width) * width, quantile);
+            int32_t const numStrips = (dim0 + STRIP_WIDTH - 1) / STRIP_WIDTH;
+            PixelType const* source = input.GetPixels().data();
+            PixelType* target = output.GetPixels().data();
+
+            RunTasks(static_cast<size_t>(numStrips), numThreads, radius, GetNumCoarse(input),
+                [&](Sweep& sweep, size_t task)
+                {
+                    int32_t const x0 = static_cast<int32_t>(task) * STRIP_WIDTH;
+                    int32_t const x1 = std::min(x0 + STRIP_WIDTH, dim0);
+                    int32_t const numColumns = x1 - x0 + 2 * radius;
+
+                    // column[j] is the image column of histogram j.
+                    std::vector<int32_t> column(numColumns);
+                    for (int32_t j = 0; j < numColumns; ++j)
+                    {
+                        column[j] = Clamp(x0 - radius + j, dim0);
+                    }
+
+                    for (int32_t y = 0; y < dim1; ++y)
+                    {
+                        if (y == 0)
+                        {
+                            for (int32_t dy = -radius; dy <= radius; ++dy)
+                            {
+                                PixelType const* row = source + static_cast<size_t>(Clamp(dy, dim1)) * dim0;
+                                for (int32_t j = 0; j < numColumns; ++j)
+                                {
+                                    sweep.Add(j, row[column[j]]);
+                                }
+                            }
+                        }
+                        else
+                        {
+                            PixelType const* rowOut = source + static_cast<size_t>(Clamp(y - radius - 1, dim1)) * dim0;
+                            PixelType const* rowIn = source + static_cast<size_t>(Clamp(y + radius, dim1)) * dim0;
+                            for (int32_t j = 0; j < numColumns; ++j)
+                            {
+                                sweep.Remove(j, rowOut[column[j]]);
+                                sweep.Add(j, rowIn[column[j]]);
+                            }
+                        }
+
+                        sweep.ComputeRow(x1 - x0, rank, target + static_cast<size_t>(y) * dim0 + x0);
+                    }
+
+                    // Restore the zero histograms for the next task.
+                    for (int32_t dy = dim1 - 1 - radius; dy <= dim1 - 1 + radius; ++dy)
+                    {
+                        PixelType const* row = source + static_cast<size_t>(Clamp(dy, dim1)) * dim0;
+                        for (int32_t j = 0; j < numColumns; ++j)
+                        {
+                            sweep.Remove(j, row[column[j]]);
+                        }
+                    }
+                });
+        }
+
+        static void Execute(Image3<PixelType> const& input, int32_t radius,
+            double quantile, size_t numThreads, Image3<PixelType>& output)
+        {
+            LogAssert(radius >= 0 && quantile >= 0.0 && quantile <= 1.0, "Invalid argument.");
+            LogAssert(&input != &output, "The output must be a different object.");
+
+            int32_t const dim0 = input.GetDimension(0);
+            int32_t const dim1 = input.GetDimension(1);
+            int32_t const dim2 = input.GetDimension(2);
+            output.Reconstruct(dim0, dim1, dim2);
+            if (input.GetNumPixels() == 0)
+            {
+                return;
+            }
+
+            int32_t const width = 2 * radius + 1;
+            uint64_t const numElements = static_cast<uint64_t>(width) * width * width;
+            LogAssert(width * width <= UINT16_MAX, "The radius is too large.");
+            uint32_t const rank = GetRank(numElements, quantile);
+            int32_t const numStrips = (dim0 + STRIP_WIDTH - 1) / STRIP_WIDTH;
+            size_t const sliceSize = static_cast<size_t>(dim0) * dim1;
+            PixelType const* source = input.GetPixels().data();
+            PixelType* target = output.GetPixels().data();
+
+            RunTasks(static_cast<size_t>(numStrips) * dim2, numThreads, radius, GetNumCoarse(input),
+                [&](Sweep& sweep, size_t task)
+                {
+                    int32_t const z = static_cast<int32_t>(task / numStrips);
+                    int32_t const x0 = static_cast<int32_t>(task % numStrips) * STRIP_WIDTH;
+                    int32_t const x1 = std::min(x0 + STRIP_WIDTH, dim0);
+                    int32_t const numColumns = x1 - x0 + 2 * radius;
+
+                    std::vector<int32_t> column(numColumns);
+                    for (int32_t j = 0; j < numColumns; ++j)
+                    {
+                        column[j] = Clamp(x0 - radius + j, dim0);
+                    }
+
+                    // slice[k] is the first voxel of the image slice k of
+                    // the window.
+                    std::vector<PixelType const*> slice(width);
+                    for (int32_t k = 0; k < width; ++k)
+                    {
+                        slice[k] = source + static_cast<size_t>(Clamp(z - radius + k, dim2)) * sliceSize;
+                    }
+
+                    for (int32_t y = 0; y < dim1; ++y)
+                    {
+                        if (y == 0)
+                        {
+                            for (int32_t dy = -radius; dy <= radius; ++dy)
+                            {
+                                size_t const offset = static_cast<size_t>(Clamp(dy, dim1)) * dim0;
+                                for (int32_t k = 0; k < width; ++k)
+                                {
+                                    PixelType const* row = slice[k] + offset;
+                                    for (int32_t j = 0; j < numColumns; ++j)
+                                    {
+                                        sweep.Add(j, row[column[j]]);
+                                    }
+                                }
+                            }
+                        }
+                        else
+                        {
+                            size_t const offsetOut = static_cast<size_t>(Clamp(y - radius - 1, dim1)) * dim0;
+                            size_t const offsetIn = static_cast<size_t>(Clamp(y + radius, dim1)) * dim0;
+                            for (int32_t k = 0; k < width; ++k)
+                            {
+                                PixelType const* rowOut = slice[k] + offsetOut;
+                                PixelType const* rowIn = slice[k] + offsetIn;
+                                for (int32_t j = 0; j < numColumns; ++j)
+                                {
+                                    sweep.Remove(j, rowOut[column[j]]);
+                                    sweep.Add(j, rowIn[column[j]]);
+                                }
+                            }
+                        }
+
+                        sweep.ComputeRow(x1 - x0, rank,
+                            target + z * sliceSize + static_cast<size_t>(y) * dim0 + x0);
+                    }
+
+                    for (int32_t dy = dim1 - 1 - radius; dy <= dim1 - 1 + radius; ++dy)
+                    {
+                        size_t const offset = static_cast<size_t>(Clamp(dy, dim1)) * dim0;
+                        for (int32_t k = 0; k < width; ++k)
+                        {
+                            PixelType const* row = slice[k] + offset;
+                            for (int32_t j = 0; j < numColumns; ++j)
+                            {
+                                sweep.Remove(j, row[column[j]]);
+                            }
+                        }
+                    }
+                });
+        }
+
+        // Convenience wrappers for quantile 0.5.
+        static inline void Median(Image2<PixelType> const& input, int32_t radius,
+            size_t numThreads, Image2<PixelType>& output)
+        {
+            Execute(input, radius, 0.5, numThreads, output);
+        }
+
+        static inline void Median(Image3<PixelType> const& input, int32_t radius,
+            size_t numThreads, Image3<PixelType>& output)
+        {
+            Execute(input, radius, 0.5, numThreads, output);
+        }
+
+    private:
+        // The column histograms of a strip and the histogram of the window
+        // that moves along a row of the strip. The histograms are zero when
+        // a task starts and the task must restore them to zero.
+        class Sweep
+        {
+        public:
+            Sweep(int32_t radius, int32_t numCoarse)
+                :
+                mRadius(radius),
+                mNumCoarse(numCoarse),
+                mColumnCoarse(static_cast<size_t>(STRIP_WIDTH + 2 * radius) * NUM_COARSE, 0),
+                mColumnFine(static_cast<size_t>(STRIP_WIDTH + 2 * radius) * NUM_VALUES, 0),
+                mWindowCoarse(NUM_COARSE, 0),
+                mWindowFine(NUM_VALUES, 0),
+                mLastUpdate(NUM_COARSE, -1)
+            {
+            }
+
+            inline void Add(int32_t j, PixelType value)
+            {
+                ++mColumnCoarse[static_cast<size_t>(j) * NUM_COARSE + (value >> NUM_FINE_BITS)];
+                ++mColumnFine[static_cast<size_t>(j) * NUM_VALUES + value];
+            }
+
+            inline void Remove(int32_t j, PixelType value)
+            {
+                --mColumnCoarse[static_cast<size_t>(j) * NUM_COARSE + (value >> NUM_FINE_BITS)];
+                --mColumnFine[static_cast<size_t>(j) * NUM_VALUES + value];
+            }
+
+            // Compute the outputs for the windows centered at the columns
+            // j + radius for 0 <= j < numOutputs.
+            void ComputeRow(int32_t numOutputs, uint32_t rank, PixelType* output)
+            {
+                int32_t const width = 2 * mRadius + 1;
+                uint32_t* windowCoarse = mWindowCoarse.data();
+                std::fill(mWindowCoarse.begin(), mWindowCoarse.end(), 0);
+                std::fill(mLastUpdate.begin(), mLastUpdate.end(), -1);
+                for (int32_t j = 0; j < width; ++j)
+                {
+                    uint16_t const* columnCoarse = &mColumnCoarse[static_cast<size_t>(j) * NUM_COARSE];
+                    for (int32_t c = 0; c < mNumCoarse; ++c)
+                    {
+                        windowCoarse[c] += columnCoarse[c];
+                    }
+                }
+
+                for (int32_t x = 0; x < numOutputs; ++x)
+                {
+                    if (x > 0)
+                    {
+                        uint16_t const* columnIn = &mColumnCoarse[static_cast<size_t>(x + 2 * mRadius) * NUM_COARSE];
+                        uint16_t const* columnOut = &mColumnCoarse[static_cast<size_t>(x - 1) * NUM_COARSE];
+                        for (int32_t c = 0; c < mNumCoarse; ++c)
+                        {
+                            windowCoarse[c] += columnIn[c];
+                            windowCoarse[c] -= columnOut[c];
+                        }
+                    }
+
+                    // Locate the coarse bin of the element of the rank.
+                    uint32_t sum = 0;
+                    int32_t c = 0;
+                    while (sum + windowCoarse[c] <= rank)
+                    {
+                        sum += windowCoarse[c];
+                        ++c;
+                    }
+
+                    // Locate the element in the fine bins of the coarse bin.
+                    uint32_t const* windowFine = UpdateFine(c, x);
+                    int32_t f = 0;
+                    while (sum + windowFine[f] <= rank)
+                    {
+                        sum += windowFine[f];
+                        ++f;
+                    }
+                    output[x] = static_cast<PixelType>((c << NUM_FINE_BITS) | f);
+                }
+            }
+
+        private:
+            // Update the fine bins of the window histogram for coarse bin c
+            // to the window centered at column x + radius. The fine bins are
+            // updated incrementally from their last update when that is
+            // cheaper than summing the column histograms of the window.
+            uint32_t const* UpdateFine(int32_t c, int32_t x)
+            {
+                int32_t const width = 2 * mRadius + 1;
+                uint32_t* windowFine = &mWindowFine[static_cast<size_t>(c) * NUM_FINE];
+                uint16_t const* columnFine = &mColumnFine[static_cast<size_t>(c) * NUM_FINE];
+                int32_t const last = mLastUpdate[c];
+                if (last >= 0 && 2 * (x - last) < width)
+                {
+                    for (int32_t j = last + 1; j <= x; ++j)
+                    {
+                        uint16_t const* columnIn = columnFine + static_cast<size_t>(j + 2 * mRadius) * NUM_VALUES;
+                        uint16_t const* columnOut = columnFine + static_cast<size_t>(j - 1) * NUM_VALUES;
+                        for (int32_t f = 0; f < NUM_FINE; ++f)
+                        {
+                            windowFine[f] += columnIn[f];
+                            windowFine[f] -= columnOut[f];
+                        }
+                    }
+                }
+                else
+                {
+                    std::fill(windowFine, windowFine + NUM_FINE, 0);
+                    for (int32_t j = x; j < x + width; ++j)
+                    {
+                        uint16_t const* column = columnFine + static_cast<size_t>(j) * NUM_VALUES;
+                        for (int32_t f = 0; f < NUM_FINE; ++f)
+                        {
+                            windowFine[f] += column[f];
+                        }
+                    }
+                }
+                mLastUpdate[c] = x;
+                return windowFine;
+            }
+
+            // The coarse bins c >= mNumCoarse are zero for the image.
+            int32_t mRadius, mNumCoarse;
+
+            // The histograms of the columns of the strip. The coarse bins
+            // of column j start at j * NUM_COARSE and the fine bins start
+            // at j * NUM_VALUES, where the fine bins of coarse bin c are
+            // those at offsets c * NUM_FINE through (c + 1) * NUM_FINE - 1.
+            std::vector<uint16_t> mColumnCoarse, mColumnFine;
+
+            // The window histogram. mLastUpdate[c] is the output column for
+            // which the fine bins of coarse bin c were last updated, or -1
+            // when they are not valid for the current row.
+            std::vector<uint32_t> mWindowCoarse, mWindowFine;
+            std::vector<int32_t> mLastUpdate;
+        };
+
+        // The number of coarse bins up to the one of the maximum pixel
+        // value. The window histograms are updated only for these bins,
+        // which is a large saving for 16-bit images of 12-bit data.
+        static int32_t GetNumCoarse(Image<PixelType> const& input)
+        {
+            auto const& pixels = input.GetPixels();
+            PixelType const maxValue = *std::max_element(pixels.begin(), pixels.end());
+            return (maxValue >> NUM_FINE_BITS) + 1;
+        }
+
+        static inline int32_t Clamp(int32_t i, int32_t dimension)
+        {
+            return std::min(std::max(i, 0), dimension - 1);
+        }
+
+        static uint32_t GetRank(uint64_t numElements, double quantile)
+        {
+            if (quantile == 0.5)
+            {
+                // The window has an odd number of elements, so the median
+                // is exact.
+                return static_cast<uint32_t>((numElements - 1) / 2);
+            }
+            return static_cast<uint32_t>(std::floor(
+                quantile * static_cast<double>(numElements - 1) + 0.5));
+        }
+
+        // Process the tasks in the main thread (numThreads = 0) or in
+        // numThreads threads, each with its own histograms.
+        template <typename Task>
+        static void RunTasks(size_t numTasks, size_t numThreads, int32_t radius,
+            int32_t numCoarse, Task const& task)
+        {
+            numThreads = std::min(numThreads, numTasks);
+            if (numThreads > 0)
+            {
+                std::atomic<size_t> nextTask(0);
+                std::vector<std::thread> process(numThreads);
+                for (size_t t = 0; t < numThreads; ++t)
+                {
+                    process[t] = std::thread([&nextTask, numTasks, radius, numCoarse, &task]()
+                    {
+                        Sweep sweep(radius, numCoarse);
+                        for (size_t i = nextTask++; i < numTasks; i = nextTask++)
+                        {
+                            task(sweep, i);
+                        }
+                    });
+                }
+                for (size_t t = 0; t < numThreads; ++t)
+                {
+                    process[t].join();
+                }
+            }
+            else
+            {
+                Sweep sweep(radius, numCoarse);
+                for (size_t i = 0; i < numTasks; ++i)
+                {
+                    task(sweep, i);
+                }
+            }
+        }
+    };
+}
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 6.0.2022.01.06
+// Version: 6.3.2026.10.17
 
 #pragma once
 
@@ -41,9 +41,17 @@ namespace gte
         {
         }
 
+        // When tolerance > 0, the iterations terminate early when the
+        // magnitudes of the errors at the local extremes of F(x)-P(x)
+        // equioscillate, (max|e[i]|-min|e[i]|) <= tolerance * max|e[i]|,
+        // in which case the returned value is the number of iterations.
+        // When tolerance is 0, all maxRemezIterations iterations are
+        // applied. The returned value is std::numeric_limits<size_t>::max()
+        // when the errors are not oscillatory.
         size_t Execute(Function const& F, Function const& FDer, T const& xMin,
             T const& xMax, size_t degree, size_t maxRemezIterations,
-            size_t maxBisectionIterations, size_t maxBracketIterations)
+            size_t maxBisectionIterations, size_t maxBracketIterations,
+            T const& tolerance = T(0))
         {
             LogAssert(xMin < xMax&& degree > 0 && maxRemezIterations > 0
                 && maxBisectionIterations > 0 && maxBracketIterations,
@@ -82,6 +90,11 @@ namespace gte
                 {
                     ComputePartition();
                     ComputeXExtremes();
+                    if (tolerance > static_cast<T>(0) && IsEquioscillatory(tolerance))
+                    {
+                        ++iteration;
+                        break;
+                    }
                 }
                 else
                 {
@@ -239,57 +252,37 @@ namespace gte
             return true;
         }
 
+        // The errors at the extremes of F(x)-P(x) computed by
+        // ComputeXExtremes are stored in mErrors. P(x) is the minimax
+        // polynomial when their magnitudes are equal.
+        bool IsEquioscillatory(T const& tolerance)
+        {
+            T minAbsError(0), maxAbsError(0);
+            for (size_t i = 0; i < mXNodes.size(); ++i)
+            {
+                mErrors[i] = mF(mXNodes[i]) - EvaluateP(mXNodes[i]);
+                T absError = std::fabs(mErrors[i]);
+                minAbsError = (i > 0 ? std::min(minAbsError, absError) : absError);
+                maxAbsError = std::max(maxAbsError, absError);
+            }
+            return maxAbsError - minAbsError <= tolerance * maxAbsError;
+        }
+
         void ComputePartition()
         {
-            // Define E(x) = F(x) - P(x). Use bisection to compute the roots
+            // Define E(x) = F(x) - P(x). Use FindRoot to compute the roots
             // of E(x). The algorithm partitions [xMin, xMax] into degree+2
             // subintervals, each subinterval with E(x) positive or with E(x)
             // negative. Later, the local extrema on the subintervals are
             // computed using a quadratic-fit line-search algorithm. The
             // extreme locations become the next set of x-nodes.
-            T const zero(0), half(0.5);
             mPartition.front() = mXMin;
             mPartition.back() = mXMax;
+            auto E = [this](T const& x) { return mF(x) - EvaluateP(x); };
             for (size_t i0 = 0, i1 = 1; i1 < mXNodes.size(); i0 = i1++)
             {
-                T x0 = mXNodes[i0], x1 = mXNodes[i1], xMid(0), eMid(0);
-                int32_t sign0 = (mErrors[i0] > zero ? 1 : -1);
-                int32_t sign1 = (mErrors[i1] > zero ? 1 : -1);
-                int32_t signMid;
-
-                size_t iteration;
-                for (iteration = 0; iteration < mMaxBisectionIterations; ++iteration)
-                {
-                    xMid = half * (x0 + x1);
-                    if (xMid == x0 || xMid == x1)
-                    {
-                        // We are at the limit of floating-point precision for
-                        // the average of endpoints.
-                        break;
-                    }
-
-                    // Update the correct endpoint to the midpoint.
-                    eMid = mF(xMid) - EvaluateP(xMid);
-                    signMid = (eMid > zero ? 1 : (eMid < zero ? -1 : 0));
-                    if (signMid == sign0)
-                    {
-                        x0 = xMid;
-                    }
-                    else if (signMid == sign1)
-                    {
-                        x1 = xMid;
-                    }
-                    else
-                    {
-                        // Found a root (numerically rounded to zero).
-                        break;
-                    }
-                }
-
-                // It is possible that the maximum number of bisections was
-                // applied without convergence. Use the last computed xMid
-                // as the root.
-                mPartition[i1] = xMid;
+                mPartition[i1] = FindRoot(E, mXNodes[i0], mXNodes[i1],
+                    mErrors[i0], mErrors[i1]);
             }
         }
 
@@ -419,40 +412,74 @@ namespace gte
 
         T GetXExtreme(T x0, T x1)
         {
+            auto EDer = [this](T const& x) { return mFDer(x) - EvaluatePDer(x); };
             T const zero(0);
-            T eder0 = mFDer(x0) - EvaluatePDer(x0);
-            T eder1 = mFDer(x1) - EvaluatePDer(x1);
-            int32_t signEDer0 = (eder0 > zero ? 1 : (eder0 < zero ? -1 : 0));
-            int32_t signEDer1 = (eder1 > zero ? 1 : (eder1 < zero ? -1 : 0));
-            LogAssert(signEDer0 * signEDer1 == -1, "Opposite signs required.");
+            T eder0 = EDer(x0);
+            T eder1 = EDer(x1);
+            LogAssert((eder0 > zero && eder1 < zero) || (eder0 < zero && eder1 > zero),
+                "Opposite signs required.");
+            return FindRoot(EDer, x0, x1, eder0, eder1);
+        }
 
-            T const half(0.5);
-            T xmid(0), ederMid(0);
-            int32_t signEMid = 0;
-            for (size_t i = 0; i < mMaxBisectionIterations; ++i)
+        // Compute a root of G(x) on [x0,x1], where G(x0) and G(x1) have
+        // opposite signs, using the Illinois variant of the method of false
+        // position. The next estimate is the root of the secant line, which
+        // converges superlinearly when G is smooth. When an endpoint is kept
+        // twice in a row, its function value is halved so that the other
+        // endpoint moves. An estimate outside the bracket is replaced by the
+        // midpoint. The function is evaluated at most
+        // mMaxBisectionIterations times. If there is no convergence, the
+        // last estimate is returned.
+        template <typename Function>
+        T FindRoot(Function const& G, T x0, T x1, T g0, T g1)
+        {
+            T const zero(0), half(0.5);
+            int32_t sign0 = (g0 > zero ? 1 : -1);
+            int32_t retained = 0;
+            T x(0);
+            for (size_t iteration = 0; iteration < mMaxBisectionIterations; ++iteration)
             {
-                xmid = half * (x0 + x1);
-                if (xmid == x0 || xmid == x1)
+                x = x1 - g1 * (x1 - x0) / (g1 - g0);
+                if (!(x0 < x && x < x1))
                 {
-                    return xmid;
+                    x = half * (x0 + x1);
+                }
+                if (x == x0 || x == x1)
+                {
+                    // We are at the limit of floating-point precision for
+                    // the estimate.
+                    break;
                 }
 
-                ederMid = mFDer(xmid) - EvaluatePDer(xmid);
-                signEMid = (ederMid > zero ? 1 : (ederMid < zero ? -1 : 0));
-                if (signEMid == signEDer0)
+                T g = G(x);
+                int32_t sign = (g > zero ? 1 : (g < zero ? -1 : 0));
+                if (sign == sign0)
                 {
-                    x0 = xmid;
+                    x0 = x;
+                    g0 = g;
+                    if (retained == 1)
+                    {
+                        g1 *= half;
+                    }
+                    retained = 1;
                 }
-                else if (signEMid == signEDer1)
+                else if (sign == -sign0)
                 {
-                    x1 = xmid;
+                    x1 = x;
+                    g1 = g;
+                    if (retained == -1)
+                    {
+                        g0 *= half;
+                    }
+                    retained = -1;
                 }
                 else
                 {
+                    // Found a root (numerically rounded to zero).
                     break;
                 }
             }
-            return xmid;
+            return x;
         }
 
         // Evaluate u(x) =
@@ -0,0 +1,755 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2022
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 6.3.2026.10.17
+
+#pragma once
+
+#include <GTE/Mathematics/Image2.h>
+#include <GTE/Mathematics/Image3.h>
+#include <GTE/Mathematics/Logger.h>
+#include <GTE/Mathematics/RadixHeap.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Single-source and multiple-source shortest paths on graphs with
+// nonnegative edge weights. The distance of a vertex is the minimum over
+// the sources of the length of a shortest path from the source. For cost
+// rasters, the distances form the accumulated-cost (cost-distance) map.
+//
+// The algorithms are templates for a graph type that provides
+//   int32_t GetNumVertices() const;
+//   template <typename Visitor> void ForEachEdge(int32_t v, Visitor visitor) const;
+// where visitor(w, weight) is called for each edge (v,w). The graph types
+// in this file are
+//   CSRGraph: a general directed graph stored in compressed sparse row
+//     format (offsets into arrays of neighbors and weights).
+//   GridGraph2, GridGraph3: implicit graphs of the pixels of an Image2 or
+//     Image3 of nonnegative costs. The weight of the edge between adjacent
+//     pixels u and w is length(u,w) * (cost(u) + cost(w)) / 2, where the
+//     length is 1, sqrt(2) or sqrt(3) for edge, face-diagonal or
+//     box-diagonal neighbors. A cost of +infinity marks an obstacle. The
+//     edges are not stored, so the memory is that of the image.
+//
+// ShortestPaths::Dijkstra uses a radix heap keyed by the binary encodings
+// of the distances. It computes the predecessors of the vertices on the
+// shortest paths and can stop early when a target vertex is reached.
+//
+// ShortestPaths::DeltaStepping is the parallel algorithm of U. Meyer and
+// P. Sanders, "Delta-stepping: a parallelizable shortest path algorithm",
+// Journal of Algorithms 49 (2003), 114-152. The vertices are partitioned
+// into buckets of distance width delta. The vertices of the smallest
+// nonempty bucket are relaxed concurrently, repeatedly until the bucket
+// remains empty. As in common implementations, the edges are not split
+// into light and heavy edges; the vertices reinserted into the current
+// bucket are simply processed again. The distances are equal to those of
+// Dijkstra, but the predecessors are not computed.
+
+namespace gte
+{
+    template <typename Real>
+    class CSRGraph
+    {
+    public:
+        // Create the graph from the offsets, neighbors and weights of the
+        // compressed sparse row format. The edges of vertex v are
+        // (v,neighbors[i]) with weight weights[i] for offsets[v] <= i <
+        // offsets[v+1]. The number of vertices is offsets.size() - 1.
+        CSRGraph(std::vector<int32_t> offsets, std::vector<int32_t> neighbors,
+            std::vector<Real> weights)
+            :
+            mOffsets(std::move(offsets)),
+            mNeighbors(std::move(neighbors)),
+            mWeights(std::move(weights))
+        {
+            LogAssert(mOffsets.size() > 0 && mOffsets.front() == 0 &&
+                static_cast<size_t>(mOffsets.back()) == mNeighbors.size() &&
+                mNeighbors.size() == mWeights.size(), "Invalid compressed sparse row format.");
+            int32_t const numVertices = GetNumVertices();
+            for (int32_t v = 0; v < numVertices; ++v)
+            {
+                LogAssert(mOffsets[v] <= mOffsets[v + 1], "Invalid offsets.");
+            }
+            Validate();
+        }
+
+        // Create the graph from a list of edges and their weights. For an
+        // undirected graph, each edge (v0,v1) is stored as the directed
+        // edges (v0,v1) and (v1,v0).
+        CSRGraph(int32_t numVertices, std::vector<std::array<int32_t, 2>> const& edges,
+            std::vector<Real> const& weights, bool directed)
+            :
+            mOffsets(static_cast<size_t>(numVertices) + 1, 0),
+            mNeighbors{},
+            mWeights{}
+        {
+            LogAssert(numVertices >= 0 && edges.size() == weights.size(), "Invalid input.");
+            for (auto const& edge : edges)
+            {
+                LogAssert(0 <= edge[0] && edge[0] < numVertices &&
+                    0 <= edge[1] && edge[1] < numVertices, "Invalid edge.");
+                ++mOffsets[static_cast<size_t>(edge[0]) + 1];
+                if (!directed)
+                {
+                    ++mOffsets[static_cast<size_t>(edge[1]) + 1];
+                }
+            }
+            for (int32_t v = 0; v < numVertices; ++v)
+            {
+                mOffsets[v + 1] += mOffsets[v];
+            }
+
+            mNeighbors.resize(static_cast<size_t>(mOffsets.back()));
+            mWeights.resize(mNeighbors.size());
+            std::vector<int32_t> current(mOffsets.begin(), mOffsets.end() - 1);
+            for (size_t i = 0; i < edges.size(); ++i)
+            {
+                int32_t const v0 = edges[i][0], v1 = edges[i][1];
+                int32_t j = current[v0]++;
+                mNeighbors[j] = v1;
+                mWeights[j] = weights[i];
+                if (!directed)
+                {
+                    j = current[v1]++;
+                    mNeighbors[j] = v0;
+                    mWeights[j] = weights[i];
+                }
+            }
+            Validate();
+        }
+
+        // Member access.
+        inline int32_t GetNumVertices() const
+        {
+            return static_cast<int32_t>(mOffsets.size()) - 1;
+        }
+
+        inline size_t GetNumEdges() const
+        {
+            return mNeighbors.size();
+        }
+
+        inline std::vector<int32_t> const& GetOffsets() const
+        {
+            return mOffsets;
+        }
+
+        inline std::vector<int32_t> const& GetNeighbors() const
+        {
+            return mNeighbors;
+        }
+
+        inline std::vector<Real> const& GetWeights() const
+        {
+            return mWeights;
+        }
+
+        template <typename Visitor>
+        inline void ForEachEdge(int32_t v, Visitor visitor) const
+        {
+            int32_t const iMax = mOffsets[v + 1];
+            for (int32_t i = mOffsets[v]; i < iMax; ++i)
+            {
+                visitor(mNeighbors[i], mWeights[i]);
+            }
+        }
+
+    private:
+        void Validate() const
+        {
+            int32_t const numVertices = GetNumVertices();
+            for (size_t i = 0; i < mNeighbors.size(); ++i)
+            {
+                LogAssert(0 <= mNeighbors[i] && mNeighbors[i] < numVertices, "Invalid neighbor.");
+                LogAssert(mWeights[i] >= (Real)0, "The weights must be nonnegative.");
+            }
+        }
+
+        std::vector<int32_t> mOffsets, mNeighbors;
+        std::vector<Real> mWeights;
+    };
+
+    template <typename Real>
+    class GridGraph2
+    {
+    public:
+        // The graph refers to the pixels of 'cost', so the image must exist
+        // as long as the graph is used. The vertex of pixel (x,y) is the
+        // pixel index x + dim0 * y. The neighbors of a pixel are its 4
+        // edge-adjacent pixels and, when 'useDiagonals' is 'true', its 4
+        // corner-adjacent pixels.
+        GridGraph2(Image2<Real> const& cost, bool useDiagonals)
+            :
+            mDim0(cost.GetDimension(0)),
+            mDim1(cost.GetDimension(1)),
+            mCost(cost.GetPixels().data()),
+            mNumNeighbors(useDiagonals ? 8 : 4),
+            mNeighbors{}
+        {
+            LogAssert(cost.GetNumPixels() <= static_cast<size_t>(std::numeric_limits<int32_t>::max()),
+                "The image has too many pixels.");
+            for (auto const& value : cost.GetPixels())
+            {
+                LogAssert(value >= (Real)0, "The costs must be nonnegative.");
+            }
+
+            Real const half = (Real)0.5, diagonal = (Real)0.5 * std::sqrt((Real)2);
+            std::array<std::array<int32_t, 2>, 8> const delta =
+            { {
+                { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 },
+                { 1, 1 }, { -1, 1 }, { 1, -1 }, { -1, -1 }
+            } };
+            for (size_t k = 0; k < mNumNeighbors; ++k)
+            {
+                Neighbor& neighbor = mNeighbors[k];
+                neighbor.dx = delta[k][0];
+                neighbor.dy = delta[k][1];
+                neighbor.offset = delta[k][0] + mDim0 * delta[k][1];
+                neighbor.scale = (k < 4 ? half : diagonal);
+            }
+        }
+
+        inline int32_t GetNumVertices() const
+        {
+            return mDim0 * mDim1;
+        }
+
+        template <typename Visitor>
+        inline void ForEachEdge(int32_t v, Visitor visitor) const
+        {
+            int32_t const x = v % mDim0, y = v / mDim0;
+            Real const cost = mCost[v];
+            for (size_t k = 0; k < mNumNeighbors; ++k)
+            {
+                Neighbor const& neighbor = mNeighbors[k];
+                int32_t const nx = x + neighbor.dx, ny = y + neighbor.dy;
+                if (0 <= nx && nx < mDim0 && 0 <= ny && ny < mDim1)
+                {
+                    int32_t const w = v + neighbor.offset;
+                    visitor(w, neighbor.scale * (cost + mCost[w]));
+                }
+            }
+        }
+
+    private:
+        struct Neighbor
+        {
+            int32_t dx, dy, offset;
+            Real scale;
+        };
+
+        int32_t mDim0, mDim1;
+        Real const* mCost;
+        size_t mNumNeighbors;
+        std::array<Neighbor, 8> mNeighbors;
+    };
+
+    template <typename Real>
+    class GridGraph3
+    {
+    public:
+        // The graph refers to the voxels of 'cost', so the image must exist
+        // as long as the graph is used. The vertex of voxel (x,y,z) is the
+        // voxel index x + dim0 * (y + dim1 * z). The neighbors of a voxel
+        // are its face-adjacent voxels for connectivity 6, additionally its
+        // edge-adjacent voxels for connectivity 18 and additionally its
+        // corner-adjacent voxels for connectivity 26.
+        GridGraph3(Image3<Real> const& cost, int32_t connectivity)
+            :
+            mDim0(cost.GetDimension(0)),
+            mDim1(cost.GetDimension(1)),
+            mDim2(cost.GetDimension(2)),
+            mCost(cost.GetPixels().data()),
+            mNumNeighbors(0),
+            mNeighbors{}
+        {
+            LogAssert(connectivity == 6 || connectivity == 18 || connectivity == 26,
+                "The connectivity must be 6, 18 or 26.");
+            LogAssert(cost.GetNumPixels() <= static_cast<size_t>(std::numeric_limits<int32_t>::max()),
+                "The image has too many voxels.");
+            for (auto const& value : cost.GetPixels())
+            {
+                LogAssert(value >= (Real)0, "The costs must be nonnegative.");
+            }
+
+            std::array<Real, 4> const scale =
+            {
+                (Real)0,
+                (Real)0.5,
+                (Real)0.5 * std::sqrt((Real)2),
+                (Real)0.5 * std::sqrt((Real)3)
+            };
+            for (int32_t dz = -1; dz <= 1; ++dz)
+            {
+                for (int32_t dy = -1; dy <= 1; ++dy)
+                {
+                    for (int32_t dx = -1; dx <= 1; ++dx)
+                    {
+                        int32_t const order = std::abs(dx) + std::abs(dy) + std::abs(dz);
+                        if (order == 0 || (order == 2 && connectivity == 6) ||
+                            (order == 3 && connectivity != 26))
+                        {
+                            continue;
+                        }
+
+                        Neighbor& neighbor = mNeighbors[mNumNeighbors++];
+                        neighbor.dx = dx;
+                        neighbor.dy = dy;
+                        neighbor.dz = dz;
+                        neighbor.offset = dx + mDim0 * (dy + mDim1 * dz);
+                        neighbor.scale = scale[order];
+                    }
+                }
+            }
+        }
+
+        inline int32_t GetNumVertices() const
+        {
+            return mDim0 * mDim1 * mDim2;
+        }
+
+        template <typename Visitor>
+        inline void ForEachEdge(int32_t v, Visitor visitor) const
+        {
+            int32_t const x = v % mDim0, yz = v / mDim0;
+            int32_t const y = yz % mDim1, z = yz / mDim1;
+            Real const cost = mCost[v];
+            for (size_t k = 0; k < mNumNeighbors; ++k)
+            {
+                Neighbor const& neighbor = mNeighbors[k];
+                int32_t const nx = x + neighbor.dx;
+                int32_t const ny = y + neighbor.dy;
+                int32_t const nz = z + neighbor.dz;
+                if (0 <= nx && nx < mDim0 && 0 <= ny && ny < mDim1 && 0 <= nz && nz < mDim2)
+                {
+                    int32_t const w = v + neighbor.offset;
+                    visitor(w, neighbor.scale * (cost + mCost[w]));
+                }
+            }
+        }
+
+    private:
+        struct Neighbor
+        {
+            int32_t dx, dy, dz, offset;
+            Real scale;
+        };
+
+        int32_t mDim0, mDim1, mDim2;
+        Real const* mCost;
+        size_t mNumNeighbors;
+        std::array<Neighbor, 26> mNeighbors;
+    };
+
+    template <typename Real>
+    class ShortestPaths
+    {
+    public:
+        static_assert(std::is_same<Real, float>::value || std::is_same<Real, double>::value,
+            "Real must be float or double.");
+
+        // The binary encodings of the nonnegative distances, which have the
+        // same order as the distances.
+        using UInt = typename std::conditional<sizeof(Real) == 4, uint32_t, uint64_t>::type;
+
+        // Compute the distances from the sources to all the vertices. The
+        // distance of an unreachable vertex is +infinity. The predecessor
+        // of a vertex is the previous vertex on a shortest path, which is -1
+        // for the sources and the unreachable vertices.
+        template <typename Graph>
+        static void Dijkstra(Graph const& graph, std::vector<int32_t> const& sources,
+            std::vector<Real>& distance, std::vector<int32_t>& predecessor)
+        {
+            Dijkstra(graph, sources, -1, distance, predecessor);
+        }
+
+        // Compute the distances as in the previous function but stop when
+        // the distance of the target is known. The distances of the
+        // vertices that are farther from the sources than the target are
+        // only upper bounds.
+        template <typename Graph>
+        static void Dijkstra(Graph const& graph, std::vector<int32_t> const& sources,
+            int32_t target, std::vector<Real>& distance, std::vector<int32_t>& predecessor)
+        {
+            int32_t const numVertices = graph.GetNumVertices();
+            ValidateSources(numVertices, sources);
+            distance.assign(static_cast<size_t>(numVertices), std::numeric_limits<Real>::infinity());
+            predecessor.assign(static_cast<size_t>(numVertices), -1);
+
+            RadixHeap<UInt, int32_t> heap;
+            for (auto source : sources)
+            {
+                distance[source] = (Real)0;
+                heap.Insert(0, source);
+            }
+
+            UInt key = 0;
+            int32_t u = -1;
+            while (heap.Remove(key, u))
+            {
+                Real const d = distance[u];
+                if (ToKey(d) != key)
+                {
+                    // The distance of u decreased after the element was
+                    // inserted.
+                    continue;
+                }
+                if (u == target)
+                {
+                    break;
+                }
+
+                graph.ForEachEdge(u, [&distance, &predecessor, &heap, d, u](int32_t w, Real weight)
+                {
+                    Real const candidate = d + weight;
+                    if (candidate < distance[w])
+                    {
+                        distance[w] = candidate;
+                        predecessor[w] = u;
+                        heap.Insert(ToKey(candidate), w);
+                    }
+                });
+            }
+        }
+
+        // Compute the distances from the sources to all the vertices using
+        // delta-stepping. The number of buckets is the maximum finite
+        // distance divided by delta. A small delta leads to many buckets,
+        // each with little parallelism. A large delta leads to vertices
+        // being relaxed many times before their distances are final. When
+        // 'delta' is not positive, GetDefaultDelta(graph) is used. When
+        // numThreads is 0, the computations are in the main thread.
+        template <typename Graph>
+        static void DeltaStepping(Graph const& graph, std::vector<int32_t> const& sources,
+            Real delta, size_t numThreads, std::vector<Real>& distance)
+        {
+            int32_t const numVertices = graph.GetNumVertices();
+            ValidateSources(numVertices, sources);
+            if (!(delta > (Real)0))
+            {
+                delta = GetDefaultDelta(graph);
+            }
+            distance.resize(static_cast<size_t>(numVertices));
+
+            DeltaSteppingState state(numVertices, std::max(numThreads, static_cast<size_t>(1)));
+            if (numThreads == 0)
+            {
+                DeltaSteppingWorker(graph, sources, delta, 0, state, distance);
+            }
+            else
+            {
+                std::vector<std::thread> process(numThreads);
+                for (size_t t = 0; t < numThreads; ++t)
+                {
+                    process[t] = std::thread([&graph, &sources, delta, t, &state, &distance]()
+                    {
+                        DeltaSteppingWorker(graph, sources, delta, t, state, distance);
+                    });
+                }
+                for (size_t t = 0; t < numThreads; ++t)
+                {
+                    process[t].join();
+                }
+            }
+        }
+
+        // The mean of the finite weights of the edges of at most 4096
+        // vertices sampled uniformly by index, or 1 when those edges have
+        // no positive weights.
+        template <typename Graph>
+        static Real GetDefaultDelta(Graph const& graph)
+        {
+            int32_t const numVertices = graph.GetNumVertices();
+            int32_t const numSamples = std::min(numVertices, 4096);
+            double sum = 0.0;
+            size_t numEdges = 0;
+            for (int32_t i = 0; i < numSamples; ++i)
+            {
+                int32_t const v = static_cast<int32_t>(static_cast<int64_t>(i) * numVertices / numSamples);
+                graph.ForEachEdge(v, [&sum, &numEdges](int32_t, Real weight)
+                {
+                    if (weight < std::numeric_limits<Real>::infinity())
+                    {
+                        sum += static_cast<double>(weight);
+                        ++numEdges;
+                    }
+                });
+            }
+            return (sum > 0.0 ? static_cast<Real>(sum / static_cast<double>(numEdges)) : (Real)1);
+        }
+
+        // Extract the shortest path from a source to the target using the
+        // predecessors computed by Dijkstra. The path is ordered from the
+        // source to the target. It is empty when the target is unreachable
+        // and the target is not a source, which the caller can test by
+        // distance[target] being +infinity.
+        static void GetPath(std::vector<int32_t> const& predecessor, int32_t target,
+            std::vector<int32_t>& path)
+        {
+            LogAssert(0 <= target && static_cast<size_t>(target) < predecessor.size(),
+                "Invalid target.");
+            path.clear();
+            for (int32_t v = target; v != -1; v = predecessor[v])
+            {
+                path.push_back(v);
+                LogAssert(path.size() <= predecessor.size(), "The predecessors have a cycle.");
+            }
+            std::reverse(path.begin(), path.end());
+        }
+
+    private:
+        static void ValidateSources(int32_t numVertices, std::vector<int32_t> const& sources)
+        {
+            for (auto source : sources)
+            {
+                LogAssert(0 <= source && source < numVertices, "Invalid source.");
+            }
+        }
+
+        inline static UInt ToKey(Real value)
+        {
+            UInt key;
+            std::memcpy(&key, &value, sizeof(UInt));
+            return key;
+        }
+
+        inline static Real FromKey(UInt key)
+        {
+            Real value;
+            std::memcpy(&value, &key, sizeof(Real));
+            return value;
+        }
+
+        // A reusable barrier for the threads of DeltaStepping. The threads
+        // spin briefly before yielding, because the phases are short.
+        class Barrier
+        {
+        public:
+            Barrier(size_t numThreads)
+                :
+                mNumThreads(numThreads),
+                mNumArrived(0),
+                mGeneration(0)
+            {
+            }
+
+            void Wait()
+            {
+                size_t const generation = mGeneration.load(std::memory_order_acquire);
+                if (mNumArrived.fetch_add(1, std::memory_order_acq_rel) + 1 == mNumThreads)
+                {
+                    mNumArrived.store(0, std::memory_order_relaxed);
+                    mGeneration.fetch_add(1, std::memory_order_release);
+                }
+                else
+                {
+                    for (size_t spin = 0; mGeneration.load(std::memory_order_acquire) == generation; ++spin)
+                    {
+                        if (spin >= 64)
+                        {
+                            std::this_thread::yield();
+                        }
+                    }
+                }
+            }
+
+        private:
+            size_t mNumThreads;
+            std::atomic<size_t> mNumArrived;
+            char mPadding[64];
+            std::atomic<size_t> mGeneration;
+        };
+
+        // The buckets of a thread store the vertices whose distances were
+        // decreased by the thread. The frontier of a thread is its part of
+        // the current bucket. The threads are padded to avoid false
+        // sharing.
+        struct DeltaSteppingThread
+        {
+            std::vector<std::vector<int32_t>> buckets;
+            std::vector<int32_t> frontier;
+            size_t minBucket;
+            char padding[64];
+        };
+
+        struct DeltaSteppingState
+        {
+            DeltaSteppingState(int32_t numVertices, size_t inNumThreads)
+                :
+                numThreads(inNumThreads),
+                distance(static_cast<size_t>(numVertices)),
+                threads(inNumThreads),
+                barrier(inNumThreads)
+            {
+                numChunks[0] = 0;
+                numChunks[1] = 0;
+            }
+
+            size_t numThreads;
+            std::vector<std::atomic<UInt>> distance;
+            std::vector<DeltaSteppingThread> threads;
+            Barrier barrier;
+
+            // The counters of the chunks of the frontier claimed by the
+            // threads, alternating between the phases so that a counter
+            // is reset while the other is in use.
+            std::array<std::atomic<size_t>, 2> numChunks;
+        };
+
+        enum
+        {
+            CHUNK_SIZE = 64
+        };
+
+        template <typename Graph>
+        static void DeltaSteppingWorker(Graph const& graph, std::vector<int32_t> const& sources,
+            Real delta, size_t t, DeltaSteppingState& state, std::vector<Real>& distance)
+        {
+            size_t const numThreads = state.numThreads;
+            size_t const numVertices = state.distance.size();
+            size_t const noBucket = std::numeric_limits<size_t>::max();
+            DeltaSteppingThread& self = state.threads[t];
+
+            size_t const vmin = t * numVertices / numThreads;
+            size_t const vsup = (t + 1) * numVertices / numThreads;
+            UInt const infinity = ToKey(std::numeric_limits<Real>::infinity());
+            for (size_t v = vmin; v < vsup; ++v)
+            {
+                state.distance[v].store(infinity, std::memory_order_relaxed);
+            }
+            state.barrier.Wait();
+
+            auto insert = [&self, delta](int32_t v, Real d)
+            {
+                size_t const b = static_cast<size_t>(d / delta);
+                if (b >= self.buckets.size())
+                {
+                    self.buckets.resize(b + 1);
+                }
+                self.buckets[b].push_back(v);
+            };
+
+            for (size_t i = t; i < sources.size(); i += numThreads)
+            {
+                state.distance[sources[i]].store(0, std::memory_order_relaxed);
+                insert(sources[i], (Real)0);
+            }
+
+            size_t current = 0;
+            for (size_t phase = 0; ; ++phase)
+            {
+                // Publish the smallest nonempty bucket of the thread. The
+                // barrier ensures that all relaxations of the previous
+                // phase are finished.
+                self.minBucket = noBucket;
+                for (size_t b = current; b < self.buckets.size(); ++b)
+                {
+                    if (self.buckets[b].size() > 0)
+                    {
+                        self.minBucket = b;
+                        break;
+                    }
+                }
+                state.barrier.Wait();
+
+                size_t bucket = noBucket;
+                for (auto const& thread : state.threads)
+                {
+                    bucket = std::min(bucket, thread.minBucket);
+                }
+                if (bucket == noBucket)
+                {
+                    break;
+                }
+                if (bucket != current)
+                {
+                    // The current bucket is empty for all threads. Release
+                    // its memory.
+                    if (current < self.buckets.size())
+                    {
+                        std::vector<int32_t>().swap(self.buckets[current]);
+                    }
+                    current = bucket;
+                }
+
+                // Move the part of the bucket of this thread to its
+                // frontier. The vertices that are reinserted into the
+                // bucket by the relaxations are processed in the next
+                // phase.
+                self.frontier.clear();
+                if (self.minBucket == bucket)
+                {
+                    self.frontier.swap(self.buckets[bucket]);
+                }
+                state.barrier.Wait();
+                if (t == 0)
+                {
+                    state.numChunks[(phase + 1) & 1].store(0, std::memory_order_relaxed);
+                }
+
+                // Relax the edges of the vertices of the frontiers of all
+                // threads, claiming chunks of vertices dynamically.
+                std::atomic<size_t>& numChunks = state.numChunks[phase & 1];
+                for (;;)
+                {
+                    size_t chunk = numChunks.fetch_add(1, std::memory_order_relaxed);
+                    size_t p = 0;
+                    for (; p < numThreads; ++p)
+                    {
+                        size_t const frontierSize = state.threads[p].frontier.size();
+                        size_t const numFrontierChunks = (frontierSize + CHUNK_SIZE - 1) / CHUNK_SIZE;
+                        if (chunk < numFrontierChunks)
+                        {
+                            break;
+                        }
+                        chunk -= numFrontierChunks;
+                    }
+                    if (p == numThreads)
+                    {
+                        break;
+                    }
+
+                    std::vector<int32_t> const& frontier = state.threads[p].frontier;
+                    size_t const imin = chunk * CHUNK_SIZE;
+                    size_t const isup = std::min(imin + CHUNK_SIZE, frontier.size());
+                    for (size_t i = imin; i < isup; ++i)
+                    {
+                        int32_t const u = frontier[i];
+                        Real const d = FromKey(state.distance[u].load(std::memory_order_relaxed));
+                        graph.ForEachEdge(u, [&state, &insert, d](int32_t w, Real weight)
+                        {
+                            Real const candidate = d + weight;
+                            UInt const key = ToKey(candidate);
+                            std::atomic<UInt>& target = state.distance[w];
+                            UInt oldKey = target.load(std::memory_order_relaxed);
+                            while (key < oldKey)
+                            {
+                                if (target.compare_exchange_weak(oldKey, key, std::memory_order_relaxed))
+                                {
+                                    insert(w, candidate);
+                                    break;
+                                }
+                            }
+                        });
+                    }
+                }
+            }
+
+            for (size_t v = vmin; v < vsup; ++v)
+            {
+                distance[v] = FromKey(state.distance[v].load(std::memory_order_relaxed));
+            }
+        }
+    };
+}
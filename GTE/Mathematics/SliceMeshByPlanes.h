@@ -0,0 +1,480 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2022
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 6.3.2026.10.17
+
+#pragma once
+
+#include <GTE/Mathematics/EdgeKey.h>
+#include <GTE/Mathematics/Vector3.h>
+#include <GTE/Mathematics/Logger.h>
+#include <algorithm>
+#include <array>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Compute the intersection contours of a triangle mesh with a family of
+// parallel planes Dot(N,X) = c[k], where the constants c[k] are sorted in
+// increasing order. This is the operation used to slice a mesh into layers
+// (for example, for additive manufacturing). SplitMeshByPlane splits a mesh
+// by a single plane; calling it once per plane is O(m*n) for m planes and n
+// triangles. SliceMeshByPlanes computes the range of planes crossed by each
+// triangle, sorts the triangles by the first plane of their ranges (a
+// counting sort) and sweeps the planes in increasing order while maintaining
+// the list of triangles that cross the current plane. The total cost is
+// O(n + m + s) where s is the number of segments in the contours. The planes
+// are partitioned into contiguous ranges that have approximately the same
+// number of segments, and the ranges are processed in parallel.
+//
+// Each triangle that crosses a plane contributes one segment to the layer.
+// The segment endpoints are the intersections of the plane with triangle
+// edges. An endpoint is identified by an unordered EdgeKey of the edge, so
+// the segments of adjacent triangles share endpoints, and the segments are
+// linked into polylines using a hash map of the keys. A vertex exactly on a
+// plane is treated as being on the positive side of the plane, so every
+// endpoint is on an edge with one vertex on the negative side and one vertex
+// on the nonnegative side. For a closed manifold mesh, every endpoint is
+// shared by exactly two segments and the contours are closed. If the mesh
+// triangles are counterclockwise ordered when viewed from outside the mesh,
+// the outer contours of a layer are counterclockwise ordered when viewed
+// from the positive side of the plane (the side to which N points) and the
+// inner contours (holes) are clockwise ordered. Consecutive contour points
+// that are equal, which occur when a mesh vertex is exactly on a plane, are
+// reduced to a single point.
+
+namespace gte
+{
+    template <typename Real>
+    class SliceMeshByPlanes
+    {
+    public:
+        // A polyline of a layer. When 'closed' is 'true', the last point
+        // is connected to the first point. The contours of a closed
+        // manifold mesh are always closed.
+        struct Contour
+        {
+            Contour()
+                :
+                points{},
+                closed(false)
+            {
+            }
+
+            std::vector<Vector3<Real>> points;
+            bool closed;
+        };
+
+        // To run in the main thread only, choose numThreads to be 0. For
+        // multithreading, choose numThreads > 0. The number of available
+        // hardware threads is std::thread::hardware_concurrency(). A
+        // reasonable choice for numThreads will not exceed the number of
+        // available hardware threads.
+        SliceMeshByPlanes(size_t numThreads = 0)
+            :
+            mNumThreads(numThreads)
+        {
+        }
+
+        // The 'indices' are lookups into the 'vertices' array and represent
+        // a triangle mesh as described for SplitMeshByPlane. The planes are
+        // Dot(normal,X) = constants[k], where the constants must be sorted
+        // in nondecreasing order. The normal is not required to be unit
+        // length. On return, layers[k] stores the contours for the plane
+        // with constant[k].
+        void operator()(
+            std::vector<Vector3<Real>> const& vertices,
+            std::vector<int32_t> const& indices,
+            Vector3<Real> const& normal,
+            std::vector<Real> const& constants,
+            std::vector<std::vector<Contour>>& layers)
+        {
+            LogAssert(indices.size() % 3 == 0, "Invalid number of indices.");
+            LogAssert(std::is_sorted(constants.begin(), constants.end()),
+                "The plane constants must be sorted.");
+
+            layers.clear();
+            layers.resize(constants.size());
+            if (constants.size() == 0 || indices.size() == 0)
+            {
+                return;
+            }
+
+            ComputeHeights(vertices, normal);
+            ComputePlaneRanges(indices, constants);
+            SortTriangles(constants.size());
+
+            // Partition the planes into ranges with approximately the same
+            // number of segments.
+            std::vector<int32_t> pmin, psup;
+            PartitionPlanes(constants.size(), pmin, psup);
+            size_t const numRanges = pmin.size();
+            if (numRanges > 1)
+            {
+                std::vector<std::thread> process(numRanges);
+                for (size_t t = 0; t < numRanges; ++t)
+                {
+                    process[t] = std::thread([this, t, &vertices, &indices,
+                        &constants, &pmin, &psup, &layers]()
+                    {
+                        Sweep(vertices, indices, constants, pmin[t], psup[t], layers);
+                    });
+                }
+                for (size_t t = 0; t < numRanges; ++t)
+                {
+                    process[t].join();
+                }
+            }
+            else if (numRanges == 1)
+            {
+                Sweep(vertices, indices, constants, pmin[0], psup[0], layers);
+            }
+        }
+
+        // Convenience for the planes Dot(normal,X) = c0 + k * delta for
+        // 0 <= k < numPlanes, where delta > 0.
+        void operator()(
+            std::vector<Vector3<Real>> const& vertices,
+            std::vector<int32_t> const& indices,
+            Vector3<Real> const& normal,
+            Real c0, Real delta, size_t numPlanes,
+            std::vector<std::vector<Contour>>& layers)
+        {
+            LogAssert(delta > (Real)0, "The plane spacing must be positive.");
+
+            std::vector<Real> constants(numPlanes);
+            for (size_t k = 0; k < numPlanes; ++k)
+            {
+                constants[k] = c0 + static_cast<Real>(k) * delta;
+            }
+            operator()(vertices, indices, normal, constants, layers);
+        }
+
+    private:
+        using EKey = EdgeKey<false>;
+
+        void ComputeHeights(std::vector<Vector3<Real>> const& vertices,
+            Vector3<Real> const& normal)
+        {
+            mHeights.resize(vertices.size());
+            for (size_t i = 0; i < vertices.size(); ++i)
+            {
+                mHeights[i] = Dot(normal, vertices[i]);
+            }
+        }
+
+        // Triangle t crosses the planes k with mFirst[t] <= k <= mLast[t].
+        // A triangle crosses plane k when one of its vertices has height
+        // smaller than constants[k] and one of its vertices has height
+        // larger than or equal to constants[k].
+        void ComputePlaneRanges(std::vector<int32_t> const& indices,
+            std::vector<Real> const& constants)
+        {
+            size_t const numTriangles = indices.size() / 3;
+            mFirst.resize(numTriangles);
+            mLast.resize(numTriangles);
+            for (size_t t = 0, i = 0; t < numTriangles; ++t, i += 3)
+            {
+                Real h0 = mHeights[indices[i]];
+                Real h1 = mHeights[indices[i + 1]];
+                Real h2 = mHeights[indices[i + 2]];
+                Real hmin = std::min(std::min(h0, h1), h2);
+                Real hmax = std::max(std::max(h0, h1), h2);
+                mFirst[t] = static_cast<int32_t>(std::upper_bound(
+                    constants.begin(), constants.end(), hmin) - constants.begin());
+                mLast[t] = static_cast<int32_t>(std::upper_bound(
+                    constants.begin() + mFirst[t], constants.end(), hmax) - constants.begin()) - 1;
+            }
+        }
+
+        // Counting sort of the crossing triangles by first plane. The
+        // triangles whose first plane is k are mOrder[j] for
+        // mStart[k] <= j < mStart[k+1]. The number of segments of plane k
+        // is mNumSegments[k].
+        void SortTriangles(size_t numPlanes)
+        {
+            size_t const numTriangles = mFirst.size();
+            mStart.assign(numPlanes + 1, 0);
+            std::vector<int64_t> delta(numPlanes + 1, 0);
+            for (size_t t = 0; t < numTriangles; ++t)
+            {
+                if (mFirst[t] <= mLast[t])
+                {
+                    ++mStart[static_cast<size_t>(mFirst[t]) + 1];
+                    ++delta[mFirst[t]];
+                    --delta[static_cast<size_t>(mLast[t]) + 1];
+                }
+            }
+
+            mNumSegments.resize(numPlanes);
+            int64_t numSegments = 0;
+            for (size_t k = 0; k < numPlanes; ++k)
+            {
+                mStart[k + 1] += mStart[k];
+                numSegments += delta[k];
+                mNumSegments[k] = static_cast<size_t>(numSegments);
+            }
+
+            mOrder.resize(mStart[numPlanes]);
+            std::vector<size_t> next(mStart.begin(), mStart.end() - 1);
+            for (size_t t = 0; t < numTriangles; ++t)
+            {
+                if (mFirst[t] <= mLast[t])
+                {
+                    mOrder[next[mFirst[t]]++] = static_cast<int32_t>(t);
+                }
+            }
+        }
+
+        void PartitionPlanes(size_t numPlanes, std::vector<int32_t>& pmin,
+            std::vector<int32_t>& psup) const
+        {
+            size_t total = 0;
+            for (auto numSegments : mNumSegments)
+            {
+                total += numSegments;
+            }
+
+            size_t const numRanges = std::max(std::min(mNumThreads, numPlanes), size_t(1));
+            size_t const quota = total / numRanges + 1;
+            size_t k = 0, accumulated = 0;
+            for (size_t r = 0; r < numRanges && k < numPlanes; ++r)
+            {
+                pmin.push_back(static_cast<int32_t>(k));
+                if (r + 1 == numRanges)
+                {
+                    k = numPlanes;
+                }
+                else
+                {
+                    size_t target = quota * (r + 1);
+                    do
+                    {
+                        accumulated += mNumSegments[k++];
+                    } while (k < numPlanes && accumulated < target);
+                }
+                psup.push_back(static_cast<int32_t>(k));
+            }
+        }
+
+        // Compute the contours for the planes k with kmin <= k < ksup.
+        void Sweep(std::vector<Vector3<Real>> const& vertices,
+            std::vector<int32_t> const& indices, std::vector<Real> const& constants,
+            int32_t kmin, int32_t ksup, std::vector<std::vector<Contour>>& layers) const
+        {
+            // The triangles that cross plane kmin but whose first plane is
+            // smaller than kmin.
+            std::vector<int32_t> active;
+            active.reserve(mNumSegments[kmin]);
+            for (size_t j = 0; j < mStart[kmin]; ++j)
+            {
+                int32_t t = mOrder[j];
+                if (mLast[t] >= kmin)
+                {
+                    active.push_back(t);
+                }
+            }
+
+            LayerBuilder builder;
+            for (int32_t k = kmin; k < ksup; ++k)
+            {
+                // Remove the triangles that do not cross plane k and insert
+                // the triangles whose first plane is k.
+                active.erase(std::remove_if(active.begin(), active.end(),
+                    [this, k](int32_t t) { return mLast[t] < k; }), active.end());
+                active.insert(active.end(), mOrder.begin() + mStart[k],
+                    mOrder.begin() + mStart[static_cast<size_t>(k) + 1]);
+
+                builder.Reset(active.size());
+                for (auto t : active)
+                {
+                    AddSegment(vertices, indices, constants[k], t, builder);
+                }
+                builder.Link(layers[k]);
+            }
+        }
+
+        // The segment points and the segments of a layer. Each point has an
+        // index into 'points'. The segments are pairs of point indices.
+        class LayerBuilder
+        {
+        public:
+            void Reset(size_t numSegments)
+            {
+                map.clear();
+                map.reserve(2 * numSegments);
+                points.clear();
+                points.reserve(numSegments);
+                segments.clear();
+                segments.reserve(numSegments);
+            }
+
+            void Link(std::vector<Contour>& contours)
+            {
+                // Store the outgoing segments of each point in contiguous
+                // storage and count the incoming segments.
+                size_t const numPoints = points.size();
+                size_t const numSegments = segments.size();
+                std::vector<size_t> outStart(numPoints + 1, 0);
+                std::vector<int32_t> inCount(numPoints, 0);
+                for (auto const& segment : segments)
+                {
+                    ++outStart[static_cast<size_t>(segment[0]) + 1];
+                    ++inCount[segment[1]];
+                }
+                for (size_t i = 0; i < numPoints; ++i)
+                {
+                    outStart[i + 1] += outStart[i];
+                }
+                std::vector<int32_t> outSegment(numSegments);
+                std::vector<size_t> next(outStart.begin(), outStart.end() - 1);
+                for (size_t s = 0; s < numSegments; ++s)
+                {
+                    outSegment[next[segments[s][0]]++] = static_cast<int32_t>(s);
+                }
+
+                // The points with more outgoing than incoming segments are
+                // the starts of open polylines, which occur only for meshes
+                // with boundary or nonmanifold edges. The remaining segments
+                // form closed polylines.
+                std::vector<bool> used(numSegments, false);
+                std::vector<size_t> cursor(outStart.begin(), outStart.end() - 1);
+                for (size_t i = 0; i < numPoints; ++i)
+                {
+                    int32_t outCount = static_cast<int32_t>(outStart[i + 1] - outStart[i]);
+                    for (int32_t j = inCount[i]; j < outCount; ++j)
+                    {
+                        Trace(static_cast<int32_t>(i), outStart, outSegment, used, cursor, contours);
+                    }
+                }
+                for (size_t s = 0; s < numSegments; ++s)
+                {
+                    if (!used[s])
+                    {
+                        Trace(segments[s][0], outStart, outSegment, used, cursor, contours);
+                    }
+                }
+            }
+
+            std::unordered_map<EKey, int32_t, EKey, EKey> map;
+            std::vector<Vector3<Real>> points;
+            std::vector<std::array<int32_t, 2>> segments;
+
+        private:
+            void Trace(int32_t start, std::vector<size_t> const& outStart,
+                std::vector<int32_t> const& outSegment, std::vector<bool>& used,
+                std::vector<size_t>& cursor, std::vector<Contour>& contours)
+            {
+                Contour contour;
+                contour.points.push_back(points[start]);
+                int32_t current = start;
+                for (;;)
+                {
+                    // Get the next unused outgoing segment of the point.
+                    int32_t s = -1;
+                    while (cursor[current] < outStart[static_cast<size_t>(current) + 1])
+                    {
+                        int32_t candidate = outSegment[cursor[current]++];
+                        if (!used[candidate])
+                        {
+                            s = candidate;
+                            break;
+                        }
+                    }
+                    if (s == -1)
+                    {
+                        break;
+                    }
+
+                    used[s] = true;
+                    current = segments[s][1];
+                    if (current == start)
+                    {
+                        contour.closed = true;
+                        break;
+                    }
+                    if (points[current] != contour.points.back())
+                    {
+                        contour.points.push_back(points[current]);
+                    }
+                }
+
+                if (contour.closed && contour.points.size() > 1 &&
+                    contour.points.back() == contour.points.front())
+                {
+                    contour.points.pop_back();
+                }
+                contours.push_back(std::move(contour));
+            }
+        };
+
+        // Add the segment of triangle t on the plane with the specified
+        // constant.
+        void AddSegment(std::vector<Vector3<Real>> const& vertices,
+            std::vector<int32_t> const& indices, Real constant, int32_t t,
+            LayerBuilder& builder) const
+        {
+            size_t const i = 3 * static_cast<size_t>(t);
+            std::array<int32_t, 3> v = { indices[i], indices[i + 1], indices[i + 2] };
+            std::array<bool, 3> negative{};
+            for (size_t j = 0; j < 3; ++j)
+            {
+                negative[j] = (mHeights[v[j]] < constant);
+            }
+
+            // Rotate the triangle so that v[0] is the vertex whose side of
+            // the plane differs from that of the other two vertices.
+            if (negative[1] != negative[0] && negative[1] != negative[2])
+            {
+                std::rotate(v.begin(), v.begin() + 1, v.end());
+                std::rotate(negative.begin(), negative.begin() + 1, negative.end());
+            }
+            else if (negative[2] != negative[0] && negative[2] != negative[1])
+            {
+                std::rotate(v.begin(), v.begin() + 2, v.end());
+                std::rotate(negative.begin(), negative.begin() + 2, negative.end());
+            }
+
+            int32_t p01 = GetPoint(vertices, constant, v[0], v[1], negative[0], builder);
+            int32_t p20 = GetPoint(vertices, constant, v[2], v[0], negative[2], builder);
+            if (negative[0])
+            {
+                builder.segments.push_back({ p20, p01 });
+            }
+            else
+            {
+                builder.segments.push_back({ p01, p20 });
+            }
+        }
+
+        // Get the index of the intersection of the edge <v0,v1> with the
+        // plane. The point is computed from the vertex on the nonnegative
+        // side so that the point is exactly that vertex when the vertex is
+        // on the plane.
+        int32_t GetPoint(std::vector<Vector3<Real>> const& vertices, Real constant,
+            int32_t v0, int32_t v1, bool v0Negative, LayerBuilder& builder) const
+        {
+            auto result = builder.map.insert(std::make_pair(EKey(v0, v1),
+                static_cast<int32_t>(builder.points.size())));
+            if (result.second)
+            {
+                if (v0Negative)
+                {
+                    std::swap(v0, v1);
+                }
+                Real d0 = mHeights[v0] - constant;
+                Real d1 = mHeights[v1] - constant;
+                Real t = d0 / (d0 - d1);
+                builder.points.push_back(vertices[v0] + t * (vertices[v1] - vertices[v0]));
+            }
+            return result.first->second;
+        }
+
+        size_t mNumThreads;
+        std::vector<Real> mHeights;
+        std::vector<int32_t> mFirst, mLast, mOrder;
+        std::vector<size_t> mStart, mNumSegments;
+    };
+}
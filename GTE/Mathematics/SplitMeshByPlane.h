@@ -3,20 +3,21 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 6.0.2022.01.06
+// Version: 6.3.2026.10.17
 
 #pragma once
 
 #include <GTE/Mathematics/DistPointHyperplane.h>
 #include <GTE/Mathematics/EdgeKey.h>
-#include <map>
+#include <unordered_map>
 
 // The algorithm for splitting a mesh by a plane is described in
 // https://www.geometrictools.com/Documentation/ClipMesh.pdf
 // Currently, the code here does not include generating a closed
 // mesh (from the "positive" and "zero" vertices) by attaching
 // triangulated faces to the mesh, where the those faces live in
-// the splitting plane.  (TODO: Add this code.)
+// the splitting plane.  (TODO: Add this code.)  To slice a mesh by many
+// parallel planes, use SliceMeshByPlanes.
 
 namespace gte
 {
@@ -394,6 +395,7 @@ namespace gte
         // The value is the point of intersection of the edge with the
         // plane and an index into m_kVertices (the index is larger or
         // equal to the number of vertices of incoming rkVertices).
-        std::map<EdgeKey<false>, std::pair<Vector3<Real>, int32_t>> mEMap;
+        std::unordered_map<EdgeKey<false>, std::pair<Vector3<Real>, int32_t>,
+            EdgeKey<false>, EdgeKey<false>> mEMap;
     };
 }
@@ -3,14 +3,20 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 6.0.2022.01.06
+// Version: 6.3.2026.10.17
 
 #pragma once
 
-#include <map>
-#include <mutex>
+#include <GTE/Mathematics/ConcurrentHashMap.h>
 #include <vector>
 
+// A map for concurrent access by many threads. It is a wrapper for
+// ConcurrentHashMap, so the operations on different elements lock
+// different shards and the readers do not block each other. The Key type
+// must be hashable by std::hash<Key>. GatherAll returns the values in an
+// unspecified order. See ConcurrentHashMap for bulk insertion, GetOrInsert
+// and consistent snapshots of the elements.
+
 namespace gte
 {
     template <typename Key, typename Value>
@@ -24,108 +30,40 @@ namespace gte
         // All the operations are thread-safe.
         bool HasElements() const
         {
-            bool hasElements;
-            mMutex.lock();
-            {
-                hasElements = (mMap.size() > 0);
-            }
-            mMutex.unlock();
-            return hasElements;
+            return mMap.HasElements();
         }
 
         bool Exists(Key key) const
         {
-            bool exists;
-            mMutex.lock();
-            {
-                exists = (mMap.find(key) != mMap.end());
-            }
-            mMutex.unlock();
-            return exists;
+            return mMap.Exists(key);
         }
 
         void Insert(Key key, Value value)
         {
-            mMutex.lock();
-            {
-                mMap[key] = value;
-            }
-            mMutex.unlock();
+            mMap.Insert(key, std::move(value));
         }
 
         bool Remove(Key key, Value& value)
         {
-            bool exists;
-            mMutex.lock();
-            {
-                auto iter = mMap.find(key);
-                if (iter != mMap.end())
-                {
-                    value = iter->second;
-                    mMap.erase(iter);
-                    exists = true;
-                }
-                else
-                {
-                    exists = false;
-                }
-            }
-            mMutex.unlock();
-            return exists;
+            return mMap.Remove(key, value);
         }
 
         void RemoveAll()
         {
-            mMutex.lock();
-            {
-                mMap.clear();
-            }
-            mMutex.unlock();
+            mMap.RemoveAll();
         }
 
         bool Get(Key key, Value& value) const
         {
-            bool exists;
-            mMutex.lock();
-            {
-                auto iter = mMap.find(key);
-                if (iter != mMap.end())
-                {
-                    value = iter->second;
-                    exists = true;
-                }
-                else
-                {
-                    exists = false;
-                }
-            }
-            mMutex.unlock();
-            return exists;
+            return mMap.Get(key, value);
         }
 
         void GatherAll(std::vector<Value>& values) const
         {
-            mMutex.lock();
-            {
-                if (mMap.size() > 0)
-                {
-                    values.resize(mMap.size());
-                    auto viter = values.begin();
-                    for (auto const& m : mMap)
-                    {
-                        *viter++ = m.second;
-                    }
-                }
-                else
-                {
-                    values.clear();
-                }
-            }
-            mMutex.unlock();
+            mMap.GatherAll(values);
         }
 
     protected:
-        std::map<Key, Value> mMap;
-        mutable std::mutex mMutex;
+        ConcurrentHashMap<Key, Value> mMap;
     };
 }
@@ -3,12 +3,26 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 6.0.2022.01.06
+// Version: 6.3.2026.10.17
 
 #pragma once
 
-#include <mutex>
-#include <queue>
+#include <GTE/Mathematics/LockFreeQueue.h>
+#include <algorithm>
+
+// A bounded queue for any number of producer and consumer threads. It is
+// a wrapper for MPMCQueue (see LockFreeQueue.h), so the operations do not
+// contend on a lock. Push and Pop return 'false' when the queue is full or
+// empty. WaitPush and WaitPop block until the operation succeeds or, for
+// the overloads with a timeout, until the time has elapsed; consumers need
+// not poll. When the maximum number of elements is 0, Push always fails.
+//
+// Unlike the previous mutex-and-std::queue implementation, the constructor
+// allocates storage for all maxNumElements elements, each cell holding an
+// Element and a sequence number. Do not pass a very large maximum to mean
+// "unbounded"; the allocation is proportional to it and can throw
+// std::bad_alloc. Choose the maximum number of elements the queue must
+// actually hold.
 
 namespace gte
 {
@@ -19,7 +33,8 @@ namespace gte
         // Construction and destruction.
         ThreadSafeQueue(size_t maxNumElements = 0)
             :
-            mMaxNumElements(maxNumElements)
+            mMaxNumElements(maxNumElements),
+            mQueue(std::max(maxNumElements, static_cast<size_t>(1)))
         {
         }
 
@@ -28,68 +43,66 @@ namespace gte
         // All the operations are thread-safe.
         size_t GetMaxNumElements() const
         {
-            size_t maxNumElements;
-            mMutex.lock();
-            {
-                maxNumElements = mMaxNumElements;
-            }
-            mMutex.unlock();
-            return maxNumElements;
+            return mMaxNumElements;
         }
 
         size_t GetNumElements() const
         {
-            size_t numElements;
-            mMutex.lock();
-            {
-                numElements = mQueue.size();
-            }
-            mMutex.unlock();
-            return numElements;
+            return mQueue.GetNumElements();
         }
 
         bool Push(Element const& element)
         {
-            bool pushed;
-            mMutex.lock();
-            {
-                if (mQueue.size() < mMaxNumElements)
-                {
-                    mQueue.push(element);
-                    pushed = true;
-                }
-                else
-                {
-                    pushed = false;
-                }
-            }
-            mMutex.unlock();
-            return pushed;
+            return mMaxNumElements > 0 && mQueue.Push(element);
+        }
+
+        bool Push(Element&& element)
+        {
+            return mMaxNumElements > 0 && mQueue.Push(std::move(element));
         }
 
         bool Pop(Element& element)
         {
-            bool popped;
-            mMutex.lock();
-            {
-                if (mQueue.size() > 0)
-                {
-                    element = mQueue.front();
-                    mQueue.pop();
-                    popped = true;
-                }
-                else
-                {
-                    popped = false;
-                }
-            }
-            mMutex.unlock();
-            return popped;
+            return mQueue.Pop(element);
+        }
+
+        void WaitPush(Element const& element)
+        {
+            LogAssert(mMaxNumElements > 0, "The queue has no capacity.");
+            mQueue.WaitPush(element);
+        }
+
+        void WaitPush(Element&& element)
+        {
+            LogAssert(mMaxNumElements > 0, "The queue has no capacity.");
+            mQueue.WaitPush(std::move(element));
+        }
+
+        template <typename Rep, typename Period>
+        bool WaitPush(Element const& element, std::chrono::duration<Rep, Period> const& timeout)
+        {
+            return mMaxNumElements > 0 && mQueue.WaitPush(element, timeout);
+        }
+
+        template <typename Rep, typename Period>
+        bool WaitPush(Element&& element, std::chrono::duration<Rep, Period> const& timeout)
+        {
+            return mMaxNumElements > 0 && mQueue.WaitPush(std::move(element), timeout);
+        }
+
+        void WaitPop(Element& element)
+        {
+            mQueue.WaitPop(element);
+        }
+
+        template <typename Rep, typename Period>
+        bool WaitPop(Element& element, std::chrono::duration<Rep, Period> const& timeout)
+        {
+            return mQueue.WaitPop(element, timeout);
         }
 
     protected:
         size_t mMaxNumElements;
-        std::queue<Element> mQueue;
-        mutable std::mutex mMutex;
+        MPMCQueue<Element> mQueue;
     };
 }
@@ -0,0 +1,305 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2022
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 6.3.2026.10.17
+
+#pragma once
+
+#include <GTE/Mathematics/AdaptiveSkeletonClimbing3.h>
+#include <atomic>
+#include <thread>
+#include <unordered_set>
+
+// Extract level surfaces from an image of arbitrary size using adaptive
+// skeleton climbing. AdaptiveSkeletonClimbing3 requires an image with
+// (2^N+1)^3 voxels, so the image is partitioned into blocks of that size.
+// Adjacent blocks share a plane of voxels. Blocks that extend beyond the
+// image are padded by replicating the image boundary voxels, and only the
+// voxels inside the image are tessellated. The blocks are extracted with
+// 'fixBoundary' set to 'true', which forces the highest level of detail on
+// the block boundaries, so the tessellations of adjacent blocks match on
+// the shared planes and the surface has no cracks. The vertex coordinates
+// are computed in the coordinate system of the image, so the vertices on
+// a shared plane are bitwise identical in the adjacent blocks and they are
+// welded exactly.
+//
+// The blocks are independent and are distributed among threads. Each
+// thread welds the vertices of its blocks using a hash map. The vertices
+// that are not on a shared plane cannot be shared by blocks, so the final
+// weld of the blocks uses a hash map only for the vertices on the shared
+// planes.
+
+namespace gte
+{
+    // The image type T and the Real type are the same as for
+    // AdaptiveSkeletonClimbing3.
+    template <typename T, typename Real>
+    class TiledAdaptiveSkeletonClimbing3
+    {
+    public:
+        using Extractor = AdaptiveSkeletonClimbing3<T, Real>;
+        using Vertex = typename Extractor::Vertex;
+        using Triangle = typename Extractor::Triangle;
+
+        // The input image has xBound*yBound*zBound voxels with each bound
+        // at least 2. The organization is lexicographic order for (x,y,z).
+        // The blocks have (2^N+1)^3 voxels with N > 0. To run in the main
+        // thread only, choose numThreads to be 0. For multithreading,
+        // choose numThreads > 0. Each thread has its own extractor and block
+        // of voxels, so the memory usage is proportional to numThreads and
+        // to 2^(3N).
+        TiledAdaptiveSkeletonClimbing3(int32_t N, int32_t xBound, int32_t yBound,
+            int32_t zBound, T const* inputVoxels, size_t numThreads = 0)
+            :
+            mN(N),
+            mTwoPowerN(1 << N),
+            mBound{ xBound, yBound, zBound },
+            mNumBlocks{ 0, 0, 0 },
+            mInputVoxels(inputVoxels),
+            mNumThreads(numThreads)
+        {
+            LogAssert(N > 0 && xBound >= 2 && yBound >= 2 && zBound >= 2 &&
+                inputVoxels != nullptr, "Invalid input.");
+
+            for (int32_t i = 0; i < 3; ++i)
+            {
+                mNumBlocks[i] = (mBound[i] - 2) / mTwoPowerN + 1;
+            }
+        }
+
+        // Extract the level surface. The 'level' and 'depth' are the same as
+        // for AdaptiveSkeletonClimbing3::Extract. The vertices are unique
+        // and the triangles are unique and not degenerate, so no call to
+        // MakeUnique is necessary. When 'orient' is 'true', the triangles
+        // are oriented as by AdaptiveSkeletonClimbing3::OrientTriangles
+        // with the specified 'sameDir'.
+        void Extract(Real level, int32_t depth, std::vector<Vertex>& vertices,
+            std::vector<Triangle>& triangles, bool orient = false, bool sameDir = true)
+        {
+            size_t const numBlocks = static_cast<size_t>(mNumBlocks[0]) *
+                static_cast<size_t>(mNumBlocks[1]) * static_cast<size_t>(mNumBlocks[2]);
+            std::vector<Block> blocks(numBlocks);
+            std::atomic<size_t> nextBlock(0);
+
+            auto extract = [this, level, depth, orient, sameDir, numBlocks, &blocks, &nextBlock]()
+            {
+                size_t const size = static_cast<size_t>(mTwoPowerN) + 1;
+                std::vector<T> voxels(size * size * size);
+                Extractor extractor(mN, voxels.data(), true);
+                for (;;)
+                {
+                    size_t b = nextBlock++;
+                    if (b >= numBlocks)
+                    {
+                        break;
+                    }
+                    ExtractBlock(b, level, depth, orient, sameDir, voxels, extractor, blocks[b]);
+                }
+            };
+
+            if (mNumThreads > 0)
+            {
+                size_t numThreads = std::min(mNumThreads, numBlocks);
+                std::vector<std::thread> process(numThreads);
+                for (size_t t = 0; t < numThreads; ++t)
+                {
+                    process[t] = std::thread(extract);
+                }
+                for (size_t t = 0; t < numThreads; ++t)
+                {
+                    process[t].join();
+                }
+            }
+            else
+            {
+                extract();
+            }
+
+            Weld(blocks, vertices, triangles);
+        }
+
+        // Member access.
+        inline int32_t GetN() const
+        {
+            return mN;
+        }
+
+        inline std::array<int32_t, 3> const& GetBound() const
+        {
+            return mBound;
+        }
+
+        inline std::array<int32_t, 3> const& GetNumBlocks() const
+        {
+            return mNumBlocks;
+        }
+
+    private:
+        // The welded surface of a block. The vertex indices of the triangles
+        // are relative to the block vertices.
+        struct Block
+        {
+            Block()
+                :
+                origin{ 0, 0, 0 },
+                vertices{},
+                triangles{}
+            {
+            }
+
+            std::array<int32_t, 3> origin;
+            std::vector<Vertex> vertices;
+            std::vector<Triangle> triangles;
+        };
+
+        void ExtractBlock(size_t b, Real level, int32_t depth, bool orient,
+            bool sameDir, std::vector<T>& voxels, Extractor& extractor, Block& block)
+        {
+            // Compute the block location and the number of voxels inside
+            // the image.
+            std::array<int32_t, 3> index, numCells;
+            index[0] = static_cast<int32_t>(b % static_cast<size_t>(mNumBlocks[0]));
+            b /= static_cast<size_t>(mNumBlocks[0]);
+            index[1] = static_cast<int32_t>(b % static_cast<size_t>(mNumBlocks[1]));
+            index[2] = static_cast<int32_t>(b / static_cast<size_t>(mNumBlocks[1]));
+            for (int32_t i = 0; i < 3; ++i)
+            {
+                block.origin[i] = index[i] * mTwoPowerN;
+                numCells[i] = std::min(mTwoPowerN, mBound[i] - 1 - block.origin[i]);
+            }
+
+            // Copy the block voxels, replicating the image boundary voxels
+            // for the padding.
+            int32_t const size = mTwoPowerN + 1;
+            size_t const xBound = static_cast<size_t>(mBound[0]);
+            size_t const xyBound = xBound * static_cast<size_t>(mBound[1]);
+            T* target = voxels.data();
+            for (int32_t z = 0; z < size; ++z)
+            {
+                size_t gz = static_cast<size_t>(std::min(block.origin[2] + z, mBound[2] - 1));
+                for (int32_t y = 0; y < size; ++y)
+                {
+                    size_t gy = static_cast<size_t>(std::min(block.origin[1] + y, mBound[1] - 1));
+                    T const* source = mInputVoxels + xBound * gy + xyBound * gz;
+                    int32_t const numCopy = std::min(size, mBound[0] - block.origin[0]);
+                    std::copy(source + block.origin[0], source + block.origin[0] + numCopy, target);
+                    std::fill(target + numCopy, target + size, source[xBound - 1]);
+                    target += size;
+                }
+            }
+
+            std::vector<Vertex> positions;
+            std::vector<Triangle> triangles;
+            extractor.SetSubimage(block.origin, numCells);
+            extractor.Extract(level, depth, positions, triangles);
+            if (orient)
+            {
+                extractor.OrientTriangles(positions, triangles, sameDir);
+            }
+
+            // Weld the vertices of the block.
+            std::unordered_map<Vertex, int32_t, typename Extractor::VertexHash> vmap;
+            vmap.reserve(positions.size() / 2);
+            std::unordered_set<Triangle, Triangle, Triangle> tset;
+            tset.reserve(triangles.size());
+            block.vertices.reserve(positions.size() / 4);
+            block.triangles.reserve(triangles.size());
+            for (auto const& triangle : triangles)
+            {
+                std::array<int32_t, 3> v;
+                for (int32_t i = 0; i < 3; ++i)
+                {
+                    Vertex const& position = positions[triangle.V[i]];
+                    auto result = vmap.insert(std::make_pair(position,
+                        static_cast<int32_t>(block.vertices.size())));
+                    if (result.second)
+                    {
+                        block.vertices.push_back(position);
+                    }
+                    v[i] = result.first->second;
+                }
+
+                if (v[0] != v[1] && v[0] != v[2] && v[1] != v[2])
+                {
+                    Triangle key(v[0], v[1], v[2]);
+                    if (tset.insert(key).second)
+                    {
+                        block.triangles.push_back(key);
+                    }
+                }
+            }
+        }
+
+        void Weld(std::vector<Block> const& blocks, std::vector<Vertex>& vertices,
+            std::vector<Triangle>& triangles)
+        {
+            size_t numVertices = 0, numTriangles = 0;
+            for (auto const& block : blocks)
+            {
+                numVertices += block.vertices.size();
+                numTriangles += block.triangles.size();
+            }
+            vertices.clear();
+            vertices.reserve(numVertices);
+            triangles.clear();
+            triangles.reserve(numTriangles);
+
+            // Only the vertices on the planes shared by blocks are looked up
+            // in the hash map. The coordinate of a shared plane is an
+            // integer multiple of 2^N that is strictly between 0 and the
+            // last image index.
+            std::unordered_map<Vertex, int32_t, typename Extractor::VertexHash> vmap;
+            std::vector<int32_t> remap;
+            for (auto const& block : blocks)
+            {
+                remap.resize(block.vertices.size());
+                for (size_t v = 0; v < block.vertices.size(); ++v)
+                {
+                    Vertex const& position = block.vertices[v];
+                    int32_t next = static_cast<int32_t>(vertices.size());
+                    if (OnSharedPlane(block, position))
+                    {
+                        auto result = vmap.insert(std::make_pair(position, next));
+                        if (result.second)
+                        {
+                            vertices.push_back(position);
+                        }
+                        remap[v] = result.first->second;
+                    }
+                    else
+                    {
+                        vertices.push_back(position);
+                        remap[v] = next;
+                    }
+                }
+
+                for (auto const& triangle : block.triangles)
+                {
+                    triangles.push_back(Triangle(remap[triangle.V[0]],
+                        remap[triangle.V[1]], remap[triangle.V[2]]));
+                }
+            }
+        }
+
+        bool OnSharedPlane(Block const& block, Vertex const& position) const
+        {
+            for (int32_t i = 0; i < 3; ++i)
+            {
+                if ((block.origin[i] > 0 && position[i] == static_cast<Real>(block.origin[i])) ||
+                    (block.origin[i] + mTwoPowerN < mBound[i] - 1 &&
+                    position[i] == static_cast<Real>(block.origin[i] + mTwoPowerN)))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        int32_t mN, mTwoPowerN;
+        std::array<int32_t, 3> mBound, mNumBlocks;
+        T const* mInputVoxels;
+        size_t mNumThreads;
+    };
+}
@@ -3,14 +3,21 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 6.0.2022.01.06
+// Version: 6.3.2026.10.17
 
 #pragma once
 
 #include <GTE/Mathematics/Logger.h>
 #include <GTE/Mathematics/PolygonTree.h>
 #include <GTE/Mathematics/ConstrainedDelaunay2.h>
+#include <GTE/Mathematics/HashCombine.h>
+#include <atomic>
+#include <exception>
+#include <mutex>
 #include <numeric>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 
 // The fundamental problem is to compute the triangulation of a polygon tree.
 // The outer polygons have counterclockwise ordered vertices. The inner
@@ -604,6 +611,20 @@ namespace gte
     class TriangulateCDT<T>
     {
     public:
+        TriangulateCDT()
+            :
+            mPointMap{},
+            mPoints{},
+            mRemapping{},
+            mEdges{},
+            mRegion{},
+            mRegionTriangles{},
+            mGraph{}
+        {
+        }
+
+        // The object stores the containers used by the triangulation, so
+        // their memory is reused when the object triangulates many trees.
         void operator()(
             std::vector<Vector2<T>> const& inputPoints,
             std::shared_ptr<PolygonTree> const& inputTree,
@@ -627,7 +648,94 @@ namespace gte
             Triangulate(numInputPoints, inputPoints, outputTree);
         }
 
+        // Triangulate a batch of polygon trees whose polygons are indices
+        // into the same vertex pool, for example, the output of
+        // PolygonBoolean2. The output tree outputTrees[i] corresponds to
+        // inputTrees[i]. To run in the main thread only, choose numThreads
+        // to be 0. For multithreading, choose numThreads > 0. Each thread
+        // has its own TriangulateCDT object. If the triangulation of a tree
+        // throws an exception, the first exception is rethrown after the
+        // threads are joined.
+        static void Execute(
+            std::vector<Vector2<T>> const& inputPoints,
+            std::vector<std::shared_ptr<PolygonTree>> const& inputTrees,
+            std::vector<PolygonTreeEx>& outputTrees,
+            size_t numThreads)
+        {
+            size_t const numTrees = inputTrees.size();
+            outputTrees.resize(numTrees);
+            std::atomic<size_t> nextTree(0);
+            std::exception_ptr exception = nullptr;
+            std::mutex exceptionMutex;
+
+            auto triangulate = [&inputPoints, &inputTrees, &outputTrees,
+                numTrees, &nextTree, &exception, &exceptionMutex]()
+            {
+                TriangulateCDT triangulator;
+                for (;;)
+                {
+                    size_t i = nextTree++;
+                    if (i >= numTrees)
+                    {
+                        break;
+                    }
+
+                    try
+                    {
+                        triangulator(inputPoints, inputTrees[i], outputTrees[i]);
+                    }
+                    catch (...)
+                    {
+                        std::lock_guard<std::mutex> lock(exceptionMutex);
+                        if (!exception)
+                        {
+                            exception = std::current_exception();
+                        }
+                        nextTree = numTrees;
+                        break;
+                    }
+                }
+            };
+
+            if (numThreads > 0)
+            {
+                numThreads = std::min(numThreads, numTrees);
+                std::vector<std::thread> process(numThreads);
+                for (size_t t = 0; t < numThreads; ++t)
+                {
+                    process[t] = std::thread(triangulate);
+                }
+                for (size_t t = 0; t < numThreads; ++t)
+                {
+                    process[t].join();
+                }
+            }
+            else
+            {
+                triangulate();
+            }
+
+            if (exception)
+            {
+                std::rethrow_exception(exception);
+            }
+        }
+
     private:
+        // Support for hashing points in std::unordered* containers. The
+        // addition of zero maps -0 to +0, because the two compare as equal.
+        struct PointHash
+        {
+            std::size_t operator()(Vector2<T> const& p) const
+            {
+                T const zero = static_cast<T>(0);
+                return HashValue(p[0] + zero, p[1] + zero);
+            }
+        };
+
+        using EdgeSet = std::unordered_set<EdgeKey<false>, EdgeKey<false>, EdgeKey<false>>;
+        using TriangleSet = std::unordered_set<TriangleKey<true>, TriangleKey<true>, TriangleKey<true>>;
+
         void CopyAndCompactify(std::shared_ptr<PolygonTree> const& input,
             PolygonTreeEx& output)
         {
@@ -695,25 +803,23 @@ namespace gte
             // temporarily mapped to indices relative to 'points'. Once the
             // triangulation is complete, the indices are restored to those
             // relative to inputPoints[].
-            std::vector<Vector2<T>> points;
-            std::vector<int32_t> remapping;
-            RemapPolygonTree(numInputPoints, inputPoints, tree, points, remapping);
-            LogAssert(points.size() >= 3, "Invalid polygon tree.");
+            RemapPolygonTree(numInputPoints, inputPoints, tree, mPoints, mRemapping);
+            LogAssert(mPoints.size() >= 3, "Invalid polygon tree.");
 
-            ETManifoldMesh graph;
-            std::set<EdgeKey<false>> edges;
-            ConstrainedTriangulate(tree, points, graph, edges);
-            ClassifyTriangles(tree, graph, edges);
+            mEdges.clear();
+            ConstrainedTriangulate(tree, mPoints, mGraph, mEdges);
+            ClassifyTriangles(tree, mGraph, mEdges);
 
-            RestorePolygonTree(tree, remapping);
+            RestorePolygonTree(tree, mRemapping);
         }
 
         // On return, 'points' are the unique inputPoints[] values referenced by
         // the tree. The tree 'polygon' members are modified to be indices
         // into 'points' rather than inputPoints[]. The 'remapping' allows us to
         // restore the tree 'polygon' members to be indices into inputPoints[]
-        // after the triangulation is computed. The 'edges' stores all the
-        // polygon edges that must be in the triangulation.
+        // after the triangulation is computed. The work is proportional to
+        // the number of tree indices, not to numInputPoints, so a large
+        // vertex pool can be shared by many small trees.
         void RemapPolygonTree(
             size_t numInputPoints,
             Vector2<T> const* inputPoints,
@@ -721,14 +827,12 @@ namespace gte
             std::vector<Vector2<T>>& points,
             std::vector<int32_t>& remapping)
         {
-            std::map<Vector2<T>, int32_t> pointMap;
-            points.reserve(numInputPoints);
+            auto& pointMap = mPointMap;
+            pointMap.clear();
+            points.clear();
+            remapping.clear();
             int32_t currentIndex = 0;
 
-            // The remapping is initially the identity, remapping[j] = j.
-            remapping.resize(numInputPoints);
-            std::iota(remapping.begin(), remapping.end(), 0);
-
             std::queue<size_t> queue;
             queue.push(0);
             while (queue.size() > 0)
@@ -738,13 +842,15 @@ namespace gte
                 size_t const numIndices = node.polygon.size();
                 for (size_t i = 0; i < numIndices; ++i)
                 {
+                    LogAssert(static_cast<size_t>(node.polygon[i]) < numInputPoints,
+                        "Invalid polygon tree.");
                     auto const& point = inputPoints[node.polygon[i]];
                     auto iter = pointMap.find(point);
                     if (iter == pointMap.end())
                     {
                         // The point is encountered the first time.
                         pointMap.insert(std::make_pair(point, currentIndex));
-                        remapping[currentIndex] = node.polygon[i];
+                        remapping.push_back(node.polygon[i]);
                         node.polygon[i] = currentIndex;
                         points.push_back(point);
                         ++currentIndex;
@@ -839,7 +945,7 @@ namespace gte
             PolygonTreeEx& tree,
             std::vector<Vector2<T>> const& points,
             ETManifoldMesh& graph,
-            std::set<EdgeKey<false>>& edges)
+            EdgeSet& edges)
         {
             // Use constrained Delaunay triangulation.
             ConstrainedDelaunay2<T> cdt;
@@ -919,7 +1025,7 @@ namespace gte
         }
 
         void ClassifyTriangles(PolygonTreeEx& tree, ETManifoldMesh& graph,
-            std::set<EdgeKey<false>>& edges)
+            EdgeSet& edges)
         {
             ClassifyDFS(tree, 0, graph, edges);
             LogAssert(edges.size() == 0, "The edges should be empty for a correct implementation.");
@@ -928,7 +1034,7 @@ namespace gte
         }
 
         void ClassifyDFS(PolygonTreeEx& tree, size_t index, ETManifoldMesh& graph,
-            std::set<EdgeKey<false>>& edges)
+            EdgeSet& edges)
         {
             auto& node = tree.nodes[index];
             for (size_t c = node.minChild; c < node.supChild; ++c)
@@ -937,7 +1043,9 @@ namespace gte
             }
 
             auto const& emap = graph.GetEdges();
-            std::set<TriangleKey<true>> region;
+            auto& region = mRegion;
+            region.clear();
+            mRegionTriangles.clear();
             size_t const numIndices = node.polygon.size();
             for (size_t i0 = numIndices - 1, i1 = 0; i1 < numIndices; i0 = i1++)
             {
@@ -952,20 +1060,28 @@ namespace gte
                 LogAssert(tri0, "Unexpected condition.");
                 if (tri0->WhichSideOfEdge(v0, v1) == node.chirality)
                 {
-                    region.insert(TriangleKey<true>(tri0->V[0], tri0->V[1], tri0->V[2]));
+                    TriangleKey<true> tkey(tri0->V[0], tri0->V[1], tri0->V[2]);
+                    if (region.insert(tkey).second)
+                    {
+                        mRegionTriangles.push_back(tkey);
+                    }
                 }
                 else
                 {
                     auto tri1 = edge->T[1];
                     if (tri1)
                     {
-                        region.insert(TriangleKey<true>(tri1->V[0], tri1->V[1], tri1->V[2]));
+                        TriangleKey<true> tkey(tri1->V[0], tri1->V[1], tri1->V[2]);
+                        if (region.insert(tkey).second)
+                        {
+                            mRegionTriangles.push_back(tkey);
+                        }
                     }
                 }
             }
 
-            FillRegion(graph, edges, region);
-            ExtractTriangles(graph, region, node);
+            FillRegion(graph, edges, region, mRegionTriangles);
+            ExtractTriangles(graph, mRegionTriangles, node);
             for (size_t i0 = numIndices - 1, i1 = 0; i1 < numIndices; i0 = i1++)
             {
                 edges.erase(EdgeKey<false>(node.polygon[i0], node.polygon[i1]));
@@ -975,21 +1091,16 @@ namespace gte
         // On input, the set has the initial seeds for the desired region. A
         // breadth-first search is performed to find the connected component
         // of the seeds. The component is bounded by an outer polygon and the
-        // inner polygons of its children.
-        void FillRegion(ETManifoldMesh& graph, std::set<EdgeKey<false>> const& edges,
-            std::set<TriangleKey<true>>& region)
+        // inner polygons of its children. The 'triangles' array lists the
+        // elements of 'region' in the order they were found, and it is also
+        // the queue of the search.
+        void FillRegion(ETManifoldMesh& graph, EdgeSet const& edges,
+            TriangleSet& region, std::vector<TriangleKey<true>>& triangles)
         {
-            std::queue<TriangleKey<true>> regionQueue;
-            for (auto const& tkey : region)
-            {
-                regionQueue.push(tkey);
-            }
-
             auto const& tmap = graph.GetTriangles();
-            while (regionQueue.size() > 0)
+            for (size_t front = 0; front < triangles.size(); ++front)
             {
-                TriangleKey<true> tkey = regionQueue.front();
-                regionQueue.pop();
+                TriangleKey<true> tkey = triangles[front];
                 auto titer = tmap.find(tkey);
                 LogAssert(titer != tmap.end(), "Unexpected condition.");
                 auto const& tri = titer->second;
@@ -1015,7 +1126,7 @@ namespace gte
                                     // visited, so place it in the queue to
                                     // continue the search.
                                     region.insert(akey);
-                                    regionQueue.push(akey);
+                                    triangles.push_back(akey);
                                 }
                             }
                         }
@@ -1028,7 +1139,7 @@ namespace gte
         // those triangles from the graph in preparation for processing the
         // next layer of triangles.
         void ExtractTriangles(ETManifoldMesh& graph,
-            std::set<TriangleKey<true>> const& region,
+            std::vector<TriangleKey<true>> const& region,
             PolygonTreeEx::Node& node)
         {
             node.triangulation.reserve(region.size());
@@ -1101,5 +1212,14 @@ namespace gte
                 }
             }
         }
+
+        // Storage that is reused by the calls to operator().
+        std::unordered_map<Vector2<T>, int32_t, PointHash> mPointMap;
+        std::vector<Vector2<T>> mPoints;
+        std::vector<int32_t> mRemapping;
+        EdgeSet mEdges;
+        TriangleSet mRegion;
+        std::vector<TriangleKey<true>> mRegionTriangles;
+        ETManifoldMesh mGraph;
     };
 }
@@ -3,13 +3,16 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 6.0.2022.01.06
+// Version: 6.3.2026.10.17
 
 #pragma once
 
 #include <GTE/Mathematics/Logger.h>
 #include <GTE/Mathematics/PolygonTree.h>
 #include <GTE/Mathematics/PrimalQuery2.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <memory>
 #include <map>
 #include <queue>
@@ -48,10 +51,14 @@ namespace gte
             mRFirst(-1),
             mRLast(-1),
             mEFirst(-1),
-            mELast(-1)
+            mELast(-1),
+            mGridMin{ 0.0, 0.0 },
+            mGridScale{ 0.0, 0.0 },
+            mGridBound{ 0, 0 }
         {
             LogAssert(numPoints >= 3 && points != nullptr, "Invalid input.");
             mComputePoints.resize(mNumPoints);
+            mApproxPoints.resize(mNumPoints);
             mIsConverted.resize(mNumPoints);
             std::fill(mIsConverted.begin(), mIsConverted.end(), false);
             mQuery.Set(mNumPoints, &mComputePoints[0]);
@@ -66,10 +73,14 @@ namespace gte
             mRFirst(-1),
             mRLast(-1),
             mEFirst(-1),
-            mELast(-1)
+            mELast(-1),
+            mGridMin{ 0.0, 0.0 },
+            mGridScale{ 0.0, 0.0 },
+            mGridBound{ 0, 0 }
         {
             LogAssert(mNumPoints >= 3 && mPoints != nullptr, "Invalid input.");
             mComputePoints.resize(mNumPoints);
+            mApproxPoints.resize(mNumPoints);
             mIsConverted.resize(mNumPoints);
             std::fill(mIsConverted.begin(), mIsConverted.end(), false);
             mQuery.Set(mNumPoints, &mComputePoints[0]);
@@ -92,14 +103,7 @@ namespace gte
                 // Compute the points for the queries.
                 for (int32_t i = 0; i < mNumPoints; ++i)
                 {
-                    if (!mIsConverted[i])
-                    {
-                        mIsConverted[i] = true;
-                        for (int32_t j = 0; j < 2; ++j)
-                        {
-                            mComputePoints[i][j] = mPoints[i][j];
-                        }
-                    }
+                    Convert(i);
                 }
 
                 // Triangulate the unindexed polygon.
@@ -125,15 +129,7 @@ namespace gte
                 int32_t const* indices = polygon.data();
                 for (int32_t i = 0; i < numIndices; ++i)
                 {
-                    int32_t index = indices[i];
-                    if (!mIsConverted[index])
-                    {
-                        mIsConverted[index] = true;
-                        for (int32_t j = 0; j < 2; ++j)
-                        {
-                            mComputePoints[index][j] = mPoints[index][j];
-                        }
-                    }
+                    Convert(indices[i]);
                 }
 
                 // Triangulate the indexed polygon.
@@ -162,6 +158,7 @@ namespace gte
                 if (numPointsPlusExtras > static_cast<int32_t>(mComputePoints.size()))
                 {
                     mComputePoints.resize(numPointsPlusExtras);
+                    mApproxPoints.resize(numPointsPlusExtras);
                     mIsConverted.resize(numPointsPlusExtras);
                     mIsConverted[mNumPoints] = false;
                     mIsConverted[static_cast<size_t>(mNumPoints) + 1] = false;
@@ -174,30 +171,14 @@ namespace gte
                 int32_t const* outerIndices = outer.data();
                 for (int32_t i = 0; i < numOuterIndices; ++i)
                 {
-                    int32_t index = outerIndices[i];
-                    if (!mIsConverted[index])
-                    {
-                        mIsConverted[index] = true;
-                        for (int32_t j = 0; j < 2; ++j)
-                        {
-                            mComputePoints[index][j] = mPoints[index][j];
-                        }
-                    }
+                    Convert(outerIndices[i]);
                 }
 
                 int32_t const numInnerIndices = static_cast<int32_t>(inner.size());
                 int32_t const* innerIndices = inner.data();
                 for (int32_t i = 0; i < numInnerIndices; ++i)
                 {
-                    int32_t index = innerIndices[i];
-                    if (!mIsConverted[index])
-                    {
-                        mIsConverted[index] = true;
-                        for (int32_t j = 0; j < 2; ++j)
-                        {
-                            mComputePoints[index][j] = mPoints[index][j];
-                        }
-                    }
+                    Convert(innerIndices[i]);
                 }
 
                 // Combine the outer polygon and the inner polygon into a
@@ -246,6 +227,7 @@ namespace gte
                 if (numPointsPlusExtras > static_cast<int32_t>(mComputePoints.size()))
                 {
                     mComputePoints.resize(numPointsPlusExtras);
+                    mApproxPoints.resize(numPointsPlusExtras);
                     mIsConverted.resize(numPointsPlusExtras);
                     for (int32_t i = mNumPoints; i < numPointsPlusExtras; ++i)
                     {
@@ -260,15 +242,7 @@ namespace gte
                 int32_t const* outerIndices = outer.data();
                 for (int32_t i = 0; i < numOuterIndices; ++i)
                 {
-                    int32_t index = outerIndices[i];
-                    if (!mIsConverted[index])
-                    {
-                        mIsConverted[index] = true;
-                        for (int32_t j = 0; j < 2; ++j)
-                        {
-                            mComputePoints[index][j] = mPoints[index][j];
-                        }
-                    }
+                    Convert(outerIndices[i]);
                 }
 
                 for (auto const& inner : inners)
@@ -277,15 +251,7 @@ namespace gte
                     int32_t const* innerIndices = inner.data();
                     for (int32_t i = 0; i < numInnerIndices; ++i)
                     {
-                        int32_t index = innerIndices[i];
-                        if (!mIsConverted[index])
-                        {
-                            mIsConverted[index] = true;
-                            for (int32_t j = 0; j < 2; ++j)
-                            {
-                                mComputePoints[index][j] = mPoints[index][j];
-                            }
-                        }
+                        Convert(innerIndices[i]);
                     }
                 }
 
@@ -332,6 +298,7 @@ namespace gte
                 if (numPointsPlusExtras > static_cast<int32_t>(mComputePoints.size()))
                 {
                     mComputePoints.resize(numPointsPlusExtras);
+                    mApproxPoints.resize(numPointsPlusExtras);
                     mIsConverted.resize(numPointsPlusExtras);
                     for (int32_t i = mNumPoints; i < numPointsPlusExtras; ++i)
                     {
@@ -405,6 +372,21 @@ namespace gte
         }
 
     private:
+        // Convert an input point to a ComputeType point for the exact
+        // queries and to a 'double' point for the spatial searches.
+        void Convert(int32_t index)
+        {
+            if (!mIsConverted[index])
+            {
+                mIsConverted[index] = true;
+                for (int32_t j = 0; j < 2; ++j)
+                {
+                    mComputePoints[index][j] = mPoints[index][j];
+                    mApproxPoints[index][j] = static_cast<double>(mPoints[index][j]);
+                }
+            }
+        }
+
         // Create the vertex objects that store the various lists required by
         // the ear-clipping algorithm.
         void InitializeVertices(int32_t numVertices, int32_t const* indices)
@@ -445,6 +427,112 @@ namespace gte
                     InsertAfterR(i);
                 }
             }
+
+            InitializeReflexGrid();
+        }
+
+        // Store the reflex vertices in a uniform grid so that an ear test
+        // visits only the reflex vertices in cells overlapped by the
+        // bounding box of the ear triangle.  The removal of an ear never
+        // makes a vertex reflex, so the grid is created once and a reflex
+        // vertex that becomes convex is skipped by the ear tests.  The cells
+        // are computed from the 'double' approximations of the points.  The
+        // conversion to 'double' and the cell computations are monotonic, so
+        // a point inside a triangle is in a cell overlapped by the bounding
+        // box of the triangle, and the exact ComputeType queries are applied
+        // to the same vertices as in a search of the entire reflex list.
+        void InitializeReflexGrid()
+        {
+            mGridStart.clear();
+            mGridItems.clear();
+
+            int32_t numReflex = 0;
+            std::array<double, 2> gmin{}, gmax{};
+            for (int32_t j = mRFirst; j != -1; j = V(j).sNext)
+            {
+                Vector2<double> const& point = mApproxPoints[V(j).index];
+                for (int32_t d = 0; d < 2; ++d)
+                {
+                    if (numReflex == 0 || point[d] < gmin[d])
+                    {
+                        gmin[d] = point[d];
+                    }
+                    if (numReflex == 0 || point[d] > gmax[d])
+                    {
+                        gmax[d] = point[d];
+                    }
+                }
+                ++numReflex;
+            }
+
+            // For a small number of reflex vertices, the ear tests search
+            // the reflex list.
+            if (numReflex < 32)
+            {
+                return;
+            }
+
+            // Choose nearly square cells, approximately one reflex vertex
+            // per cell.
+            std::array<double, 2> extent = { gmax[0] - gmin[0], gmax[1] - gmin[1] };
+            double cellSize = std::sqrt(extent[0] * extent[1] / static_cast<double>(numReflex));
+            for (int32_t d = 0; d < 2; ++d)
+            {
+                if (extent[d] > 0.0)
+                {
+                    double bound = (cellSize > 0.0 ? extent[d] / cellSize + 1.0 :
+                        static_cast<double>(numReflex));
+                    mGridBound[d] = static_cast<int32_t>(std::min(bound,
+                        static_cast<double>(numReflex)));
+                    mGridScale[d] = static_cast<double>(mGridBound[d]) / extent[d];
+                }
+                else
+                {
+                    mGridBound[d] = 1;
+                    mGridScale[d] = 0.0;
+                }
+                mGridMin[d] = gmin[d];
+            }
+
+            // Sort the reflex vertices by cell.
+            size_t const numCells = static_cast<size_t>(mGridBound[0]) *
+                static_cast<size_t>(mGridBound[1]);
+            mGridStart.assign(numCells + 1, 0);
+            for (int32_t j = mRFirst; j != -1; j = V(j).sNext)
+            {
+                ++mGridStart[GetGridCell(mApproxPoints[V(j).index]) + 1];
+            }
+            for (size_t c = 0; c < numCells; ++c)
+            {
+                mGridStart[c + 1] += mGridStart[c];
+            }
+            mGridItems.resize(static_cast<size_t>(numReflex));
+            std::vector<int32_t> next(mGridStart.begin(), mGridStart.end() - 1);
+            for (int32_t j = mRFirst; j != -1; j = V(j).sNext)
+            {
+                mGridItems[next[GetGridCell(mApproxPoints[V(j).index])]++] = j;
+            }
+        }
+
+        inline int32_t GetGridCoordinate(double value, int32_t d) const
+        {
+            double c = std::floor((value - mGridMin[d]) * mGridScale[d]);
+            if (c <= 0.0)
+            {
+                return 0;
+            }
+            if (c >= static_cast<double>(mGridBound[d] - 1))
+            {
+                return mGridBound[d] - 1;
+            }
+            return static_cast<int32_t>(c);
+        }
+
+        inline size_t GetGridCell(Vector2<double> const& point) const
+        {
+            return static_cast<size_t>(GetGridCoordinate(point[0], 0)) +
+                static_cast<size_t>(mGridBound[0]) *
+                static_cast<size_t>(GetGridCoordinate(point[1], 1));
         }
 
         // Apply ear clipping to the input polygon.  Polygons with holes are
@@ -479,10 +567,13 @@ namespace gte
             // vertex V1 is an ear if no other vertices of the polygon lie
             // inside T.  Although it is enough to show that V1 is not an ear
             // by finding at least one other vertex inside T, it is sufficient
-            // to search only the reflex vertices.  This is an O(C*R) process,
-            // where C is the number of convex vertices and R is the number of
-            // reflex vertices with N = C+R.  The order is O(N^2), for example
-            // when C = R = N/2.
+            // to search only the reflex vertices.  A search of all reflex
+            // vertices is an O(C*R) process, where C is the number of convex
+            // vertices and R is the number of reflex vertices with N = C+R.
+            // The order is O(N^2), for example when C = R = N/2.  The reflex
+            // grid reduces the search to the reflex vertices near T, so the
+            // process is nearly O(N) for polygons whose vertices are not
+            // clustered.
             for (int32_t i = mCFirst; i != -1; i = V(i).sNext)
             {
                 if (IsEar(i))
@@ -611,8 +702,22 @@ namespace gte
             int32_t i0, i1;
             ComputeType s = cmax;
             ComputeType t = cmax;
+            Vector2<double> const& approxM = mApproxPoints[innerIndices[xmaxIndex]];
             for (i0 = numOuterIndices - 1, i1 = 0; i1 < numOuterIndices; i0 = i1++)
             {
+                // Reject edges using the 'double' approximations of the
+                // points.  The conversion to 'double' is monotonic, so the
+                // rejected edges are a subset of those rejected by the
+                // ComputeType tests that follow.  An edge entirely left of
+                // M has t < 0.
+                Vector2<double> const& approx0 = mApproxPoints[outerIndices[i0]];
+                Vector2<double> const& approx1 = mApproxPoints[outerIndices[i1]];
+                if (approx0[1] > approxM[1] || approx1[1] < approxM[1]
+                    || (approx0[0] < approxM[0] && approx1[0] < approxM[0]))
+                {
+                    continue;
+                }
+
                 // Consider only edges for which the first vertex is below
                 // (or on) the ray and the second vertex is above (or on)
                 // the ray.
@@ -762,6 +867,20 @@ namespace gte
                 ComputeType maxCos = diff[0] * diff[0] / maxSqrLen;
                 PrimalQuery2<ComputeType> localQuery(3, sTriangle);
                 maxCosIndex = pIndex;
+
+                // The vertices outside the bounding box of the 'double'
+                // approximations of the triangle vertices are not inside the
+                // triangle and are rejected before the ComputeType queries.
+                std::array<double, 2> bmin{}, bmax{};
+                for (int32_t d = 0; d < 2; ++d)
+                {
+                    double p = static_cast<double>(sTriangle[0][d]);
+                    double m = static_cast<double>(sTriangle[1][d]);
+                    double q = static_cast<double>(sTriangle[2][d]);
+                    bmin[d] = std::min(std::min(p, m), q);
+                    bmax[d] = std::max(std::max(p, m), q);
+                }
+
                 for (int32_t i = 0; i < numOuterIndices; ++i)
                 {
                     if (i == pIndex)
@@ -769,6 +888,13 @@ namespace gte
                         continue;
                     }
 
+                    Vector2<double> const& approx = mApproxPoints[outerIndices[i]];
+                    if (approx[0] < bmin[0] || approx[0] > bmax[0]
+                        || approx[1] < bmin[1] || approx[1] > bmax[1])
+                    {
+                        continue;
+                    }
+
                     int32_t curr = outerIndices[i];
                     int32_t prev = outerIndices[(i + numOuterIndices - 1) % numOuterIndices];
                     int32_t next = outerIndices[(i + 1) % numOuterIndices];
@@ -827,6 +953,7 @@ namespace gte
 
             int32_t innerIndex = innerIndices[xmaxIndex];
             mComputePoints[nextElement] = mComputePoints[innerIndex];
+            mApproxPoints[nextElement] = mApproxPoints[innerIndex];
             combined[cIndex] = nextElement;
             auto iter = indexMap.find(innerIndex);
             if (iter != indexMap.end())
@@ -839,6 +966,7 @@ namespace gte
 
             int32_t outerIndex = outerIndices[maxCosIndex];
             mComputePoints[nextElement] = mComputePoints[outerIndex];
+            mApproxPoints[nextElement] = mApproxPoints[outerIndex];
             combined[cIndex] = nextElement;
             iter = indexMap.find(outerIndex);
             if (iter != indexMap.end())
@@ -861,6 +989,17 @@ namespace gte
         // inserts coincident edges to generate a nearly simple polygon.  It
         // repeatedly calls CombinePolygons for each inner polygon of the
         // outer polygon.
+        //
+        // The hole elimination is O(H*N) for H inner polygons and a combined
+        // polygon of N vertices.  Each call to CombinePolygons visits all
+        // edges of the current outer polygon to intersect the ray, visits
+        // all of its vertices to search for reflex vertices in the triangle
+        // <M,I,P> and copies it to the combined polygon.  The 'double'
+        // prefilters reduce the cost of each visit but not the number of
+        // visits.  The reflex grid of the ear clipping does not apply,
+        // because the outer polygon grows with each merge.  For polygons
+        // with thousands of holes, the hole elimination dominates the ear
+        // clipping.
         bool ProcessOuterAndInners(int32_t& nextElement, Polygon const& outer,
             std::vector<Polygon> const& inners, std::map<int32_t, int32_t>& indexMap,
             std::vector<int32_t>& combined)
@@ -956,15 +1095,7 @@ namespace gte
                 int32_t const* outerIndices = outer->polygon.data();
                 for (int32_t i = 0; i < numOuterIndices; ++i)
                 {
-                    int32_t index = outerIndices[i];
-                    if (!mIsConverted[index])
-                    {
-                        mIsConverted[index] = true;
-                        for (int32_t j = 0; j < 2; ++j)
-                        {
-                            mComputePoints[index][j] = mPoints[index][j];
-                        }
-                    }
+                    Convert(outerIndices[i]);
                 }
 
                 // The grandchildren of the outer polygon are also outer
@@ -979,15 +1110,7 @@ namespace gte
                     int32_t const* innerIndices = inner->polygon.data();
                     for (int32_t i = 0; i < numInnerIndices; ++i)
                     {
-                        int32_t index = innerIndices[i];
-                        if (!mIsConverted[index])
-                        {
-                            mIsConverted[index] = true;
-                            for (int32_t j = 0; j < 2; ++j)
-                            {
-                                mComputePoints[index][j] = mPoints[index][j];
-                            }
-                        }
+                        Convert(innerIndices[i]);
                     }
 
                     int32_t numGrandChildren = static_cast<int32_t>(inner->child.size());
@@ -1017,6 +1140,10 @@ namespace gte
         std::vector<bool> mIsConverted;
         PrimalQuery2<ComputeType> mQuery;
 
+        // The 'double' approximations of the compute points, used for the
+        // spatial searches that reduce the number of ComputeType queries.
+        std::vector<Vector2<double>> mApproxPoints;
+
         // Doubly linked lists for storing specially tagged vertices.
         class Vertex
         {
@@ -1076,37 +1203,94 @@ namespace gte
             int32_t curr = vertex.index;
             int32_t next = V(vertex.vNext).index;
             vertex.isEar = true;
-            for (int32_t j = mRFirst; j != -1; j = V(j).sNext)
+            if (mGridStart.size() == 0)
             {
-                // Check if the test vertex is already one of the triangle
-                // vertices.
-                if (j == vertex.vPrev || j == i || j == vertex.vNext)
+                for (int32_t j = mRFirst; j != -1; j = V(j).sNext)
                 {
-                    continue;
+                    if (IsInEar(i, j, prev, curr, next))
+                    {
+                        vertex.isEar = false;
+                        break;
+                    }
                 }
+                return vertex.isEar;
+            }
 
-                // V[j] has been ruled out as one of the original vertices of
-                // the triangle <V[prev],V[curr],V[next]>.  When triangulating
-                // polygons with holes, V[j] might be a duplicated vertex, in
-                // which case it does not affect the earness of V[curr].
-                int32_t test = V(j).index;
-                if (mComputePoints[test] == mComputePoints[prev]
-                    || mComputePoints[test] == mComputePoints[curr]
-                    || mComputePoints[test] == mComputePoints[next])
+            // Search only the reflex vertices in the grid cells overlapped
+            // by the bounding box of the triangle.
+            Vector2<double> const& p0 = mApproxPoints[prev];
+            Vector2<double> const& p1 = mApproxPoints[curr];
+            Vector2<double> const& p2 = mApproxPoints[next];
+            std::array<double, 2> bmin{}, bmax{};
+            for (int32_t d = 0; d < 2; ++d)
+            {
+                bmin[d] = std::min(std::min(p0[d], p1[d]), p2[d]);
+                bmax[d] = std::max(std::max(p0[d], p1[d]), p2[d]);
+            }
+            int32_t x0 = GetGridCoordinate(bmin[0], 0);
+            int32_t x1 = GetGridCoordinate(bmax[0], 0);
+            int32_t y0 = GetGridCoordinate(bmin[1], 1);
+            int32_t y1 = GetGridCoordinate(bmax[1], 1);
+            for (int32_t y = y0; y <= y1; ++y)
+            {
+                size_t const row = static_cast<size_t>(mGridBound[0]) * static_cast<size_t>(y);
+                for (int32_t x = x0; x <= x1; ++x)
                 {
-                    continue;
-                }
+                    size_t const cell = row + static_cast<size_t>(x);
+                    for (int32_t k = mGridStart[cell]; k < mGridStart[cell + 1]; ++k)
+                    {
+                        // The vertex is no longer reflex or it is outside
+                        // the bounding box of the triangle.
+                        int32_t j = mGridItems[k];
+                        if (V(j).isConvex)
+                        {
+                            continue;
+                        }
+                        Vector2<double> const& test = mApproxPoints[V(j).index];
+                        if (test[0] < bmin[0] || test[0] > bmax[0] ||
+                            test[1] < bmin[1] || test[1] > bmax[1])
+                        {
+                            continue;
+                        }
 
-                // Test if the vertex is inside or on the triangle.  When it
-                // is, it causes V[curr] not to be an ear.
-                if (mQuery.ToTriangle(test, prev, curr, next) <= 0)
-                {
-                    vertex.isEar = false;
-                    break;
+                        if (IsInEar(i, j, prev, curr, next))
+                        {
+                            vertex.isEar = false;
+                            return false;
+                        }
+                    }
                 }
             }
+            return true;
+        }
+
+        // Test whether the reflex vertex V[j] prevents V[i] from being an
+        // ear, where the triangle of V[i] is <V[prev],V[curr],V[next]>.
+        bool IsInEar(int32_t i, int32_t j, int32_t prev, int32_t curr, int32_t next)
+        {
+            // Check if the test vertex is already one of the triangle
+            // vertices.
+            Vertex const& vertex = V(i);
+            if (j == vertex.vPrev || j == i || j == vertex.vNext)
+            {
+                return false;
+            }
+
+            // V[j] has been ruled out as one of the original vertices of
+            // the triangle <V[prev],V[curr],V[next]>.  When triangulating
+            // polygons with holes, V[j] might be a duplicated vertex, in
+            // which case it does not affect the earness of V[curr].
+            int32_t test = V(j).index;
+            if (mComputePoints[test] == mComputePoints[prev]
+                || mComputePoints[test] == mComputePoints[curr]
+                || mComputePoints[test] == mComputePoints[next])
+            {
+                return false;
+            }
 
-            return vertex.isEar;
+            // Test if the vertex is inside or on the triangle.  When it
+            // is, it causes V[curr] not to be an ear.
+            return mQuery.ToTriangle(test, prev, curr, next) <= 0;
         }
 
         // insert convex vertex
@@ -1237,5 +1421,13 @@ namespace gte
         int32_t mCFirst, mCLast;  // linear list of convex vertices
         int32_t mRFirst, mRLast;  // linear list of reflex vertices
         int32_t mEFirst, mELast;  // cyclical list of ears
+
+        // The uniform grid of reflex vertices.  The reflex vertices in cell
+        // c are mVertices[mGridItems[k]] for
+        // mGridStart[c] <= k < mGridStart[c+1].  The grid is not used when
+        // mGridStart is empty.
+        std::array<double, 2> mGridMin, mGridScale;
+        std::array<int32_t, 2> mGridBound;
+        std::vector<int32_t> mGridStart, mGridItems;
     };
 }
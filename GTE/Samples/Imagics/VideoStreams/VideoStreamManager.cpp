@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 6.0.2022.01.06
+// Version: 6.3.2026.10.17
 
 #include "VideoStreamManager.h"
 using namespace gte;
@@ -212,7 +212,6 @@ void VideoStreamManager::AssembleFullFrame(int64_t startMicroseconds)
     int64_t finalMicroseconds = mProductionTimer.GetMicroseconds();
     full.number = mCurrentFrame++;
     full.microseconds = finalMicroseconds - startMicroseconds;
-    mFrameQueue.Push(full);
 
     mPerformanceMicroseconds = mPerformanceTimer.GetMicroseconds();
     ++mPerformanceFrames;
@@ -222,4 +221,7 @@ void VideoStreamManager::AssembleFullFrame(int64_t startMicroseconds)
     {
         mAccumulatedVSMicroseconds[i] += full.frames[i].microseconds;
     }
+
+    // The frame is moved into the queue, so its images are not copied.
+    mFrameQueue.Push(std::move(full));
 }
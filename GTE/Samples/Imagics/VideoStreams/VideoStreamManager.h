@@ -3,12 +3,13 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 6.0.2022.01.06
+// Version: 6.3.2026.10.17
 
 #pragma once
 
 #include <Mathematics/ThreadSafeQueue.h>
 #include "VideoStream.h"
+#include <chrono>
 #include <thread>
 
 class VideoStreamManager
@@ -56,6 +57,15 @@ public:
         return mFrameQueue.Pop(frame);
     }
 
+    // Wait for the next frame for at most 'timeout'.  The return value is
+    // 'true' iff a frame was produced in that time, in which case 'frame'
+    // is valid.  The function does not poll the frame queue.
+    template <typename Rep, typename Period>
+    bool GetFrame(Frame& frame, std::chrono::duration<Rep, Period> const& timeout) const
+    {
+        return mFrameQueue.WaitPop(frame, timeout);
+    }
+
     // Support for production of a single frame of a collection of video
     // streams.  The functions return 'true' iff the prodcution was successful
     // (all video streams returned a frame).
@@ -3,12 +3,15 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 6.0.2022.01.06
+// Version: 6.3.2026.10.17
 
 #include "RootFindingConsole.h"
 #include <Applications/Timer.h>
+#include <Mathematics/BatchRootsPolynomial.h>
 #include <Mathematics/IEEEBinary.h>
+#include <Mathematics/RootsPolynomial.h>
 #include <iostream>
+#include <random>
 #include <thread>
 
 RootFindingConsole::RootFindingConsole(Parameters& parameters)
@@ -50,6 +53,8 @@ void RootFindingConsole::Execute()
     delta = final - start;
     message = "GPU: " + std::to_string(delta) + "\n";
     std::cout << message;
+
+    CompareQuarticSolvers();
 }
 
 bool RootFindingConsole::SetEnvironment()
@@ -198,3 +203,75 @@ void RootFindingConsole::FindRootsCPUMultithreaded(std::set<float>& roots)
         }
     }
 }
+
+void RootFindingConsole::CompareQuarticSolvers()
+{
+    // The quartic polynomials have coefficients randomly generated in
+    // [-1,1] and leading coefficient 1.
+    size_t const numPolynomials = 1 << 20;
+    std::default_random_engine dre;
+    std::uniform_real_distribution<double> urd(-1.0, 1.0);
+    std::array<std::vector<double>, 5> p;
+    for (size_t k = 0; k < 4; ++k)
+    {
+        p[k].resize(numPolynomials);
+        for (auto& coefficient : p[k])
+        {
+            coefficient = urd(dre);
+        }
+    }
+    p[4].resize(numPolynomials, 1.0);
+
+    Timer timer;
+    double start, final, delta;
+    std::string message;
+
+    // The roots are stored in a std::map by the scalar solver.
+    size_t numRootsScalar = 0;
+    std::map<double, int32_t> rmMap;
+    start = timer.GetSeconds();
+    for (size_t i = 0; i < numPolynomials; ++i)
+    {
+        RootsPolynomial<double>::SolveQuartic<double>(p[0][i], p[1][i],
+            p[2][i], p[3][i], p[4][i], rmMap);
+        numRootsScalar += rmMap.size();
+    }
+    final = timer.GetSeconds();
+    delta = final - start;
+    message = "RootsPolynomial quartic: " + std::to_string(delta) + "\n";
+    std::cout << message;
+
+    std::vector<int32_t> numRoots(numPolynomials);
+    std::array<std::vector<double>, 4> roots;
+    std::array<std::vector<int32_t>, 4> multiplicities;
+    BatchRootsPolynomial<double>::Output output;
+    output.numRoots = numRoots.data();
+    for (size_t k = 0; k < 4; ++k)
+    {
+        roots[k].resize(numPolynomials);
+        multiplicities[k].resize(numPolynomials);
+        output.root[k] = roots[k].data();
+        output.multiplicity[k] = multiplicities[k].data();
+    }
+
+    for (size_t numThreads = 0; numThreads <= 16; numThreads += 16)
+    {
+        start = timer.GetSeconds();
+        BatchRootsPolynomial<double>::SolveQuartic(numPolynomials,
+            { p[0].data(), p[1].data(), p[2].data(), p[3].data(), p[4].data() },
+            output, numThreads);
+        final = timer.GetSeconds();
+        delta = final - start;
+
+        size_t numRootsBatch = 0;
+        for (auto const& number : numRoots)
+        {
+            numRootsBatch += static_cast<size_t>(number);
+        }
+        message = "BatchRootsPolynomial quartic (" + std::to_string(numThreads) +
+            " threads): " + std::to_string(delta) + ", roots " +
+            std::to_string(numRootsBatch) + " of " +
+            std::to_string(numRootsScalar) + "\n";
+        std::cout << message;
+    }
+}
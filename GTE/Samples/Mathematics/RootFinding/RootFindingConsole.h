@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 6.0.2022.01.06
+// Version: 6.3.2026.10.17
 
 #pragma once
 
@@ -25,4 +25,9 @@ private:
     void FindRootsGPU(std::set<float>& roots);
     static void FindSubRootsCPU(uint32_t tmin, uint32_t tsup, std::set<float>& roots);
     static void FindRootsCPUMultithreaded(std::set<float>& roots);
+
+    // Compare the throughput of RootsPolynomial<double>::SolveQuartic,
+    // which processes one polynomial per call, to that of
+    // BatchRootsPolynomial<double>::SolveQuartic.
+    static void CompareQuarticSolvers();
 };
@@ -0,0 +1,346 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2022
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 6.3.2026.10.17
+
+#include <Mathematics/ConformalMapGenus0.h>
+#include <Mathematics/ETManifoldMesh.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+using namespace gte;
+
+// Timing of ConformalMapGenus0 compared to the previous implementation,
+// which assembled the Laplacian in a map-based LinearSystem::SparseMatrix
+// from an ETManifoldMesh and solved the two systems sequentially with the
+// unpreconditioned LinearSystem::SolveSymmetricCG.
+//
+//   ConformalMapTiming [-level k] [-threads t]
+//
+// The mesh is an icosahedron subdivided k times (the default k is 6, which
+// gives 40962 vertices) and projected onto an ellipsoid. The previous
+// implementation is reproduced here: its assembly and solver times are
+// reported, and the solver is also timed with SolveSymmetricPCG on the same
+// matrix in compressed sparse row format. ConformalMapGenus0 is timed with
+// t threads (the default is the number of hardware threads; t = 0 uses the
+// main thread), without and with a warm start after a small deformation.
+// The plane coordinates of both implementations are compared.
+
+using Real = float;
+
+template <typename Function>
+double Seconds(Function function)
+{
+    auto start = std::chrono::steady_clock::now();
+    function();
+    auto final = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(final - start).count();
+}
+
+void CreateEllipsoid(int32_t level, std::vector<Vector3<Real>>& positions,
+    std::vector<int32_t>& indices)
+{
+    Real const t = static_cast<Real>(0.5 * (1.0 + std::sqrt(5.0)));
+    positions =
+    {
+        { -1, t, 0 }, { 1, t, 0 }, { -1, -t, 0 }, { 1, -t, 0 },
+        { 0, -1, t }, { 0, 1, t }, { 0, -1, -t }, { 0, 1, -t },
+        { t, 0, -1 }, { t, 0, 1 }, { -t, 0, -1 }, { -t, 0, 1 }
+    };
+    indices =
+    {
+        0, 11, 5, 0, 5, 1, 0, 1, 7, 0, 7, 10, 0, 10, 11,
+        1, 5, 9, 5, 11, 4, 11, 10, 2, 10, 7, 6, 7, 1, 8,
+        3, 9, 4, 3, 4, 2, 3, 2, 6, 3, 6, 8, 3, 8, 9,
+        4, 9, 5, 2, 4, 11, 6, 2, 10, 8, 6, 7, 9, 8, 1
+    };
+
+    for (int32_t k = 0; k < level; ++k)
+    {
+        std::map<std::pair<int32_t, int32_t>, int32_t> midpoints;
+        auto midpoint = [&positions, &midpoints](int32_t v0, int32_t v1)
+        {
+            auto key = std::make_pair(std::min(v0, v1), std::max(v0, v1));
+            auto iter = midpoints.find(key);
+            if (iter != midpoints.end())
+            {
+                return iter->second;
+            }
+            int32_t v = static_cast<int32_t>(positions.size());
+            positions.push_back((Real)0.5 * (positions[v0] + positions[v1]));
+            midpoints.insert(std::make_pair(key, v));
+            return v;
+        };
+
+        std::vector<int32_t> subdivided;
+        subdivided.reserve(4 * indices.size());
+        for (size_t i = 0; i < indices.size(); i += 3)
+        {
+            int32_t v0 = indices[i], v1 = indices[i + 1], v2 = indices[i + 2];
+            int32_t m01 = midpoint(v0, v1), m12 = midpoint(v1, v2), m20 = midpoint(v2, v0);
+            subdivided.insert(subdivided.end(),
+                { v0, m01, m20, v1, m12, m01, v2, m20, m12, m01, m12, m20 });
+        }
+        indices = std::move(subdivided);
+    }
+
+    for (auto& position : positions)
+    {
+        Normalize(position);
+        position = { (Real)3 * position[0], (Real)2 * position[1], position[2] };
+    }
+}
+
+// The right-hand sides of the real and imaginary systems, as computed by
+// ConformalMapGenus0.
+void ComputeB(std::vector<Vector3<Real>> const& positions, int32_t const* triangle,
+    std::array<std::vector<Real>, 2>& B)
+{
+    int32_t v0 = triangle[0], v1 = triangle[1], v2 = triangle[2];
+    Vector3<Real> E10 = positions[v1] - positions[v0];
+    Vector3<Real> E20 = positions[v2] - positions[v0];
+    Vector3<Real> E12 = positions[v1] - positions[v2];
+    Real len10 = Length(E10);
+    Real invLen10 = (Real)1 / len10;
+    Real invLenNormal = (Real)1 / Length(Cross(E20, E10));
+    Real invProd = invLen10 * invLenNormal;
+    for (auto& b : B)
+    {
+        b.assign(positions.size(), (Real)0);
+    }
+    B[0][v0] = -invLen10;
+    B[0][v1] = invLen10;
+    B[1][v0] = -invProd * Dot(E12, E10);
+    B[1][v1] = -invProd * Dot(E20, E10);
+    B[1][v2] = len10 * invLenNormal;
+}
+
+// The assembly of the previous implementation. Only one of (i,j) and (j,i)
+// is stored.
+void AssembleSparseMatrix(std::vector<Vector3<Real>> const& positions,
+    std::vector<int32_t> const& indices, typename LinearSystem<Real>::SparseMatrix& A)
+{
+    ETManifoldMesh graph;
+    for (size_t i = 0; i < indices.size(); i += 3)
+    {
+        graph.Insert(indices[i], indices[i + 1], indices[i + 2]);
+    }
+
+    std::vector<Real> diagonal(positions.size(), (Real)0);
+    for (auto const& element : graph.GetEdges())
+    {
+        int32_t v0 = element.first.V[0], v1 = element.first.V[1];
+        Real value = (Real)0;
+        for (int32_t j = 0; j < 2; ++j)
+        {
+            for (int32_t v2 : element.second->T[j]->V)
+            {
+                if (v2 != v0 && v2 != v1)
+                {
+                    Vector3<Real> E0 = positions[v0] - positions[v2];
+                    Vector3<Real> E1 = positions[v1] - positions[v2];
+                    value += Dot(E0, E1) / Length(Cross(E0, E1));
+                }
+            }
+        }
+        value *= -(Real)0.5;
+        A[{ v0, v1 }] = value;
+        diagonal[v0] -= value;
+        diagonal[v1] -= value;
+    }
+    for (int32_t i = 0; i < static_cast<int32_t>(positions.size()); ++i)
+    {
+        A[{ i, i }] = diagonal[i];
+    }
+}
+
+void ConvertToCSR(int32_t N, typename LinearSystem<Real>::SparseMatrix const& A,
+    typename LinearSystem<Real>::CSRMatrix& csr)
+{
+    std::vector<std::vector<std::pair<int32_t, Real>>> rows(N);
+    for (auto const& element : A)
+    {
+        int32_t r = element.first[0], c = element.first[1];
+        rows[r].push_back(std::make_pair(c, element.second));
+        if (r != c)
+        {
+            rows[c].push_back(std::make_pair(r, element.second));
+        }
+    }
+    csr.rowStart.assign(1, 0);
+    csr.columns.clear();
+    csr.values.clear();
+    for (auto& row : rows)
+    {
+        std::sort(row.begin(), row.end());
+        for (auto const& entry : row)
+        {
+            csr.columns.push_back(entry.first);
+            csr.values.push_back(entry.second);
+        }
+        csr.rowStart.push_back(static_cast<int32_t>(csr.columns.size()));
+    }
+}
+
+// The plane coordinates are the solutions scaled to [-1,1]^2 and then
+// translated so that their average is the origin, as in ConformalMapGenus0.
+std::vector<Vector2<Real>> ToPlaneCoordinates(std::array<std::vector<Real>, 2> const& X)
+{
+    Real fmin = std::min(*std::min_element(X[0].begin(), X[0].end()),
+        *std::min_element(X[1].begin(), X[1].end()));
+    Real fmax = std::max(*std::max_element(X[0].begin(), X[0].end()),
+        *std::max_element(X[1].begin(), X[1].end()));
+    Real invHalfRange = (Real)2 / (fmax - fmin);
+    std::vector<Vector2<Real>> coordinates(X[0].size());
+    Vector2<Real> origin{ (Real)0, (Real)0 };
+    for (size_t i = 0; i < coordinates.size(); ++i)
+    {
+        coordinates[i][0] = (Real)-1 + invHalfRange * (X[0][i] - fmin);
+        coordinates[i][1] = (Real)-1 + invHalfRange * (X[1][i] - fmin);
+        origin += coordinates[i];
+    }
+    origin /= static_cast<Real>(coordinates.size());
+    for (auto& coordinate : coordinates)
+    {
+        coordinate -= origin;
+    }
+    return coordinates;
+}
+
+Real MaxDifference(std::vector<Vector2<Real>> const& u, std::vector<Vector2<Real>> const& v)
+{
+    Real maxDifference = (Real)0;
+    for (size_t i = 0; i < u.size(); ++i)
+    {
+        maxDifference = std::max(maxDifference, Length(u[i] - v[i]));
+    }
+    return maxDifference;
+}
+
+int main(int numArguments, char* arguments[])
+{
+    try
+    {
+        int32_t level = 6;
+        size_t numThreads = std::thread::hardware_concurrency();
+        for (int i = 1; i < numArguments; ++i)
+        {
+            std::string argument = arguments[i];
+            LogAssert(i + 1 < numArguments, "Option " + argument + " requires a value.");
+            long value = std::strtol(arguments[++i], nullptr, 10);
+            if (argument == "-level")
+            {
+                level = static_cast<int32_t>(value);
+            }
+            else if (argument == "-threads")
+            {
+                numThreads = static_cast<size_t>(value);
+            }
+            else
+            {
+                LogError("Unknown option " + argument + ".");
+            }
+        }
+        LogAssert(0 <= level && level <= 9, "Invalid options.");
+
+        std::vector<Vector3<Real>> positions;
+        std::vector<int32_t> indices;
+        CreateEllipsoid(level, positions, indices);
+        int32_t const numPositions = static_cast<int32_t>(positions.size());
+        int32_t const numTriangles = static_cast<int32_t>(indices.size() / 3);
+        int32_t const puncture = 0;
+        uint32_t const maxIterations = 1024;
+        Real const tolerance = 1e-06f;
+
+        std::printf("%d vertices, %d triangles, threads = %zu\n", numPositions, numTriangles,
+            numThreads);
+        std::printf("%-34s %10s %12s\n", "", "seconds", "iterations");
+
+        // The previous implementation.
+        typename LinearSystem<Real>::SparseMatrix A;
+        double seconds = Seconds([&]() { AssembleSparseMatrix(positions, indices, A); });
+        std::printf("%-34s %10.3f\n", "map assembly", seconds);
+
+        std::array<std::vector<Real>, 2> B, X;
+        ComputeB(positions, &indices[3 * puncture], B);
+        std::array<uint32_t, 2> iterations = { 0, 0 };
+        seconds = Seconds([&]()
+        {
+            for (int32_t j = 0; j < 2; ++j)
+            {
+                X[j].resize(numPositions);
+                iterations[j] = LinearSystem<Real>::SolveSymmetricCG(numPositions, A,
+                    B[j].data(), X[j].data(), maxIterations, tolerance);
+            }
+        });
+        std::printf("%-34s %10.3f %5u %5u\n", "map SolveSymmetricCG", seconds,
+            iterations[0], iterations[1]);
+        std::vector<Vector2<Real>> reference = ToPlaneCoordinates(X);
+
+        typename LinearSystem<Real>::CSRMatrix csr;
+        ConvertToCSR(numPositions, A, csr);
+        seconds = Seconds([&]()
+        {
+            for (int32_t j = 0; j < 2; ++j)
+            {
+                iterations[j] = LinearSystem<Real>::SolveSymmetricPCG(numPositions, csr,
+                    B[j].data(), X[j].data(), maxIterations, tolerance);
+            }
+        });
+        std::printf("%-34s %10.3f %5u %5u\n", "CSR SolveSymmetricPCG", seconds,
+            iterations[0], iterations[1]);
+        std::printf("    max |PCG - CG| = %g\n", MaxDifference(ToPlaneCoordinates(X), reference));
+
+        // The current implementation, including the sphere mapping.
+        for (size_t threads : { static_cast<size_t>(0), numThreads })
+        {
+            ConformalMapGenus0<Real> cm(threads);
+            bool converged = false;
+            seconds = Seconds([&]()
+            {
+                converged = cm(numPositions, positions.data(), numTriangles, indices.data(),
+                    puncture);
+            });
+            LogAssert(converged, "ConformalMapGenus0 did not converge.");
+            char name[64];
+            std::snprintf(name, sizeof(name), "ConformalMapGenus0 threads = %zu", threads);
+            std::printf("%-34s %10.3f\n", name, seconds);
+            std::printf("    max |current - previous| = %g\n",
+                MaxDifference(cm.GetPlaneCoordinates(), reference));
+
+            if (threads == numThreads)
+            {
+                std::vector<Vector3<Real>> deformed = positions;
+                for (auto& position : deformed)
+                {
+                    position[2] *= (Real)1 + (Real)0.01 * position[0];
+                }
+                seconds = Seconds([&]()
+                {
+                    converged = cm(numPositions, deformed.data(), numTriangles,
+                        indices.data(), puncture, true);
+                });
+                LogAssert(converged, "ConformalMapGenus0 did not converge.");
+                std::printf("%-34s %10.3f\n", "    warm start after deformation", seconds);
+            }
+        }
+        return 0;
+    }
+    catch (std::exception const& e)
+    {
+        std::cout << e.what() << std::endl;
+        return -1;
+    }
+}
@@ -0,0 +1,183 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2022
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 6.3.2026.10.17
+
+#include <Mathematics/ConvexHull2.h>
+#include <Mathematics/ConvexHull3.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace gte;
+
+// Timing of ConvexHull2 and ConvexHull3 with and without the culling of
+// interior points (the Akl-Toussaint heuristic).
+//
+//   ConvexHullTiming [-size n] [-maxunculled m] [-lgthreads k]
+//
+// The points are double-precision and uniformly distributed in a square
+// (cube) and in a disk (ball); the latter has many more hull vertices. The
+// default n is 2^20. Without culling, every point is converted to a
+// rational number, so the memory grows quickly with n; the hulls without
+// culling are computed only when n <= m (the default m is 2^20). When both
+// hulls are computed, their vertices are compared. The sorting uses 2^k
+// threads; the default k is 0.
+
+template <typename Function>
+double Seconds(Function function)
+{
+    auto start = std::chrono::steady_clock::now();
+    function();
+    auto final = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(final - start).count();
+}
+
+template <typename Index>
+std::vector<Index> SortedVertices(std::vector<Index> hull)
+{
+    std::sort(hull.begin(), hull.end());
+    hull.erase(std::unique(hull.begin(), hull.end()), hull.end());
+    return hull;
+}
+
+void Measure2(char const* name, std::vector<Vector2<double>> const& points,
+    bool computeUnculled, size_t lgNumThreads)
+{
+    int32_t const numPoints = static_cast<int32_t>(points.size());
+    ConvexHull2<double> culled, unculled;
+    double culledSeconds = Seconds([&]()
+    {
+        culled(numPoints, points.data(), 0.0, true, lgNumThreads);
+    });
+    std::printf("2D %-8s %10.3f", name, culledSeconds);
+    if (computeUnculled)
+    {
+        double unculledSeconds = Seconds([&]()
+        {
+            unculled(numPoints, points.data(), 0.0, false, lgNumThreads);
+        });
+        LogAssert(SortedVertices(culled.GetHull()) == SortedVertices(unculled.GetHull()),
+            "The hulls are different.");
+        std::printf(" %10.3f %8.2fx", unculledSeconds, unculledSeconds / culledSeconds);
+    }
+    else
+    {
+        std::printf(" %10s %9s", "-", "-");
+    }
+    std::printf(" %10zu\n", culled.GetHull().size());
+}
+
+void Measure3(char const* name, std::vector<Vector3<double>> const& points,
+    bool computeUnculled, size_t lgNumThreads)
+{
+    ConvexHull3<double> culled, unculled;
+    double culledSeconds = Seconds([&]()
+    {
+        culled(points, lgNumThreads, true);
+    });
+    std::printf("3D %-8s %10.3f", name, culledSeconds);
+    size_t const numVertices = SortedVertices(culled.GetHull()).size();
+    if (computeUnculled)
+    {
+        double unculledSeconds = Seconds([&]()
+        {
+            unculled(points, lgNumThreads, false);
+        });
+        LogAssert(SortedVertices(culled.GetHull()) == SortedVertices(unculled.GetHull()),
+            "The hulls are different.");
+        std::printf(" %10.3f %8.2fx", unculledSeconds, unculledSeconds / culledSeconds);
+    }
+    else
+    {
+        std::printf(" %10s %9s", "-", "-");
+    }
+    std::printf(" %10zu\n", numVertices);
+}
+
+int main(int numArguments, char* arguments[])
+{
+    try
+    {
+        size_t size = static_cast<size_t>(1) << 20;
+        size_t maxUnculled = static_cast<size_t>(1) << 20;
+        size_t lgNumThreads = 0;
+        for (int i = 1; i < numArguments; ++i)
+        {
+            std::string argument = arguments[i];
+            LogAssert(i + 1 < numArguments, "Option " + argument + " requires a value.");
+            long value = std::strtol(arguments[++i], nullptr, 10);
+            if (argument == "-size")
+            {
+                size = static_cast<size_t>(value);
+            }
+            else if (argument == "-maxunculled")
+            {
+                maxUnculled = static_cast<size_t>(value);
+            }
+            else if (argument == "-lgthreads")
+            {
+                lgNumThreads = static_cast<size_t>(value);
+            }
+            else
+            {
+                LogError("Unknown option " + argument + ".");
+            }
+        }
+        LogAssert(size >= 4 && size <= static_cast<size_t>(INT32_MAX), "Invalid options.");
+        bool const computeUnculled = (size <= maxUnculled);
+
+        std::mt19937 rng(12345);
+        std::uniform_real_distribution<double> urd(-1.0, 1.0);
+        std::normal_distribution<double> normal(0.0, 1.0);
+
+        std::printf("%zu points, threads = %zu\n", size, static_cast<size_t>(1) << lgNumThreads);
+        std::printf("%-11s %10s %10s %9s %10s\n", "seconds", "culled", "unculled", "speedup", "vertices");
+
+        std::vector<Vector2<double>> points2(size);
+        for (auto& point : points2)
+        {
+            point = { urd(rng), urd(rng) };
+        }
+        Measure2("square", points2, computeUnculled, lgNumThreads);
+        for (auto& point : points2)
+        {
+            // Points on the unit circle scaled by sqrt(u) for u uniform in
+            // [0,1] are uniformly distributed in the disk.
+            Vector2<double> direction{ normal(rng), normal(rng) };
+            Normalize(direction);
+            point = std::sqrt(0.5 * (urd(rng) + 1.0)) * direction;
+        }
+        Measure2("disk", points2, computeUnculled, lgNumThreads);
+        points2.clear();
+        points2.shrink_to_fit();
+
+        std::vector<Vector3<double>> points3(size);
+        for (auto& point : points3)
+        {
+            point = { urd(rng), urd(rng), urd(rng) };
+        }
+        Measure3("cube", points3, computeUnculled, lgNumThreads);
+        for (auto& point : points3)
+        {
+            Vector3<double> direction{ normal(rng), normal(rng), normal(rng) };
+            Normalize(direction);
+            point = std::cbrt(0.5 * (urd(rng) + 1.0)) * direction;
+        }
+        Measure3("ball", points3, computeUnculled, lgNumThreads);
+        return 0;
+    }
+    catch (std::exception const& e)
+    {
+        std::cout << e.what() << std::endl;
+        return -1;
+    }
+}
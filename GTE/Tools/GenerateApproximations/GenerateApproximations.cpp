@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 6.0.2022.01.03
+// Version: 6.3.2026.10.17
 
 #include "FitSqrt.h"
 #include "FitInvSqrt.h"
@@ -14,33 +14,510 @@
 #include "FitATan.h"
 #include "FitExp2.h"
 #include "FitLog2.h"
-#include "FitReciprocal.h"
+#include <Mathematics/RemezAlgorithm.h>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
 #include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
 
-int main()
+// A command-line generator for the constants of the minimax polynomial
+// approximations in Math.h, which are used by SinEstimate and the other
+// *Estimate classes.
+//
+//   GenerateApproximations [options] [family ...]
+//
+// The families are SQRT, INVSQRT, SIN, COS, TAN, ACOS, ATAN, EXP2 and LOG2.
+// Each family is generated for the degrees that have constants in Math.h.
+// The constrained fits of the Fit* classes are used, so the constants are
+// interchangeable with those of Math.h. When no family and no -remez fit
+// are specified, all families are generated. The options are
+//
+//   -threads n      The fits are computed by n threads. For n = 0 they are
+//                   computed in the main thread. The default is the number
+//                   of hardware threads.
+//   -cache file     The fits already stored in the file are not computed
+//                   again. The new fits are added to the file.
+//   -output file    The #define constants are written to the file. The
+//                   default is standard output.
+//   -remez name function xmin xmax degree
+//                   An unconstrained minimax fit computed by RemezAlgorithm,
+//                   where function is one of sqrt, invsqrt, sin, cos, tan,
+//                   asin, atan, exp2, log2 or reciprocal. The constants are
+//                   GTE_C_<name>_DEG<degree>_C<i> and the _MAX_ERROR.
+//   -tolerance t    The equioscillation tolerance for all -remez fits,
+//                   wherever the option occurs. The default is 1e-8.
+//
+// For example, to regenerate the sin and cos constants and to add a fit of
+// exp2(x) on [-1,1] using 4 threads,
+//   GenerateApproximations -threads 4 -cache fits.txt -output fits.h
+//       SIN COS -remez EXP2_SYM exp2 -1 1 6
+
+namespace
 {
-    try
+    struct Fit
     {
-        FitSqrt fitterSqrt;
-        FitInvSqrt fitterInvSqrt;
-        FitSin fitterSin;  // template parameter is 'order', degree = 2*order + 1
-        FitCos fitterCos;  // template parameter is 'order', degree = 2*order
-        FitTan fitterTan;  // template parameter is 'order', degree = 2*order + 1
-        FitASin fitterASin;  // template parameter is 'order', degree = 2*order + 1
-        FitATan fitterATan;  // template parameter is 'order', degree = 2*order + 1
-        FitExp2 fitterExp2;
-        FitLog2 fitterLog2;
-        FitReciprocal fitterReciprocal;
-
-        // Generate an approximation for sin(x) of degree 9 (= 2 * 4 + 1).
-        std::vector<double> poly;
+        Fit()
+            :
+            error(0.0),
+            coefficients{}
+        {
+        }
+
         double error;
-        fitterSin.Generate<4>(poly, error);
+        std::vector<double> coefficients;
+    };
+
+    struct Job
+    {
+        // The key identifies the fit in the cache file.
+        std::string key;
+        std::string name;
+        int degree;
+        std::string description;
+        std::function<void(Fit&)> generate;
+    };
+
+    template <typename Fitter, int N>
+    void Generate(Fit& fit)
+    {
+        Fitter fitter;
+        fitter.template Generate<N>(fit.coefficients, fit.error);
+    }
+
+    // The fits of a family are pairs of the polynomial degree and the
+    // Generate<N> function of a Fit* class. For SIN, TAN and ATAN, N is the
+    // order and the degree is 2*N+1. For COS, the degree is 2*N.
+    struct Family
+    {
+        std::string name;
+        std::string description;
+        std::vector<std::pair<int, std::function<void(Fit&)>>> fits;
+    };
+
+    std::vector<Family> GetFamilies()
+    {
+        std::vector<Family> families(9);
+
+        families[0].name = "SQRT";
+        families[0].description = "sqrt(x), minimizing the maximum absolute error on [1,2]";
+        families[0].fits = { { 1, Generate<FitSqrt, 1> }, { 2, Generate<FitSqrt, 2> },
+            { 3, Generate<FitSqrt, 3> }, { 4, Generate<FitSqrt, 4> },
+            { 5, Generate<FitSqrt, 5> }, { 6, Generate<FitSqrt, 6> },
+            { 7, Generate<FitSqrt, 7> }, { 8, Generate<FitSqrt, 8> } };
+
+        families[1].name = "INVSQRT";
+        families[1].description = "1/sqrt(x), minimizing the maximum absolute error on [1,2]";
+        families[1].fits = { { 1, Generate<FitInvSqrt, 1> }, { 2, Generate<FitInvSqrt, 2> },
+            { 3, Generate<FitInvSqrt, 3> }, { 4, Generate<FitInvSqrt, 4> },
+            { 5, Generate<FitInvSqrt, 5> }, { 6, Generate<FitInvSqrt, 6> },
+            { 7, Generate<FitInvSqrt, 7> }, { 8, Generate<FitInvSqrt, 8> } };
+
+        families[2].name = "SIN";
+        families[2].description = "sin(x), minimizing the maximum absolute error on [-pi/2,pi/2]";
+        families[2].fits = { { 3, Generate<FitSin, 1> }, { 5, Generate<FitSin, 2> },
+            { 7, Generate<FitSin, 3> }, { 9, Generate<FitSin, 4> },
+            { 11, Generate<FitSin, 5> } };
+
+        families[3].name = "COS";
+        families[3].description = "cos(x), minimizing the maximum absolute error on [-pi/2,pi/2]";
+        families[3].fits = { { 2, Generate<FitCos, 1> }, { 4, Generate<FitCos, 2> },
+            { 6, Generate<FitCos, 3> }, { 8, Generate<FitCos, 4> },
+            { 10, Generate<FitCos, 5> } };
+
+        families[4].name = "TAN";
+        families[4].description = "tan(x), minimizing the maximum absolute error on [-pi/4,pi/4]";
+        families[4].fits = { { 3, Generate<FitTan, 1> }, { 5, Generate<FitTan, 2> },
+            { 7, Generate<FitTan, 3> }, { 9, Generate<FitTan, 4> },
+            { 11, Generate<FitTan, 5> }, { 13, Generate<FitTan, 6> } };
+
+        families[5].name = "ACOS";
+        families[5].description = "acos(x) = sqrt(1-x)*p(x), minimizing the maximum absolute error on [0,1]";
+        families[5].fits = { { 1, Generate<FitASin, 1> }, { 2, Generate<FitASin, 2> },
+            { 3, Generate<FitASin, 3> }, { 4, Generate<FitASin, 4> },
+            { 5, Generate<FitASin, 5> }, { 6, Generate<FitASin, 6> },
+            { 7, Generate<FitASin, 7> }, { 8, Generate<FitASin, 8> } };
+
+        families[6].name = "ATAN";
+        families[6].description = "atan(x), minimizing the maximum absolute error on [-1,1]";
+        families[6].fits = { { 3, Generate<FitATan, 1> }, { 5, Generate<FitATan, 2> },
+            { 7, Generate<FitATan, 3> }, { 9, Generate<FitATan, 4> },
+            { 11, Generate<FitATan, 5> }, { 13, Generate<FitATan, 6> } };
+
+        families[7].name = "EXP2";
+        families[7].description = "exp2(x) = 2^x, minimizing the maximum absolute error on [0,1]";
+        families[7].fits = { { 1, Generate<FitExp2, 1> }, { 2, Generate<FitExp2, 2> },
+            { 3, Generate<FitExp2, 3> }, { 4, Generate<FitExp2, 4> },
+            { 5, Generate<FitExp2, 5> }, { 6, Generate<FitExp2, 6> },
+            { 7, Generate<FitExp2, 7> } };
+
+        families[8].name = "LOG2";
+        families[8].description = "log2(x), minimizing the maximum absolute error on [1,2]";
+        families[8].fits = { { 1, Generate<FitLog2, 1> }, { 2, Generate<FitLog2, 2> },
+            { 3, Generate<FitLog2, 3> }, { 4, Generate<FitLog2, 4> },
+            { 5, Generate<FitLog2, 5> }, { 6, Generate<FitLog2, 6> },
+            { 7, Generate<FitLog2, 7> }, { 8, Generate<FitLog2, 8> } };
+
+        return families;
+    }
+
+    // The functions and derivatives for the -remez fits.
+    using Function = RemezAlgorithm<double>::Function;
+
+    bool GetFunction(std::string const& function, Function& F, Function& FDer)
+    {
+        if (function == "sqrt")
+        {
+            F = [](double const& x) { return std::sqrt(x); };
+            FDer = [](double const& x) { return 0.5 / std::sqrt(x); };
+        }
+        else if (function == "invsqrt")
+        {
+            F = [](double const& x) { return 1.0 / std::sqrt(x); };
+            FDer = [](double const& x) { return -0.5 / (x * std::sqrt(x)); };
+        }
+        else if (function == "sin")
+        {
+            F = [](double const& x) { return std::sin(x); };
+            FDer = [](double const& x) { return std::cos(x); };
+        }
+        else if (function == "cos")
+        {
+            F = [](double const& x) { return std::cos(x); };
+            FDer = [](double const& x) { return -std::sin(x); };
+        }
+        else if (function == "tan")
+        {
+            F = [](double const& x) { return std::tan(x); };
+            FDer = [](double const& x) { double t = std::tan(x); return 1.0 + t * t; };
+        }
+        else if (function == "asin")
+        {
+            F = [](double const& x) { return std::asin(x); };
+            FDer = [](double const& x) { return 1.0 / std::sqrt(1.0 - x * x); };
+        }
+        else if (function == "atan")
+        {
+            F = [](double const& x) { return std::atan(x); };
+            FDer = [](double const& x) { return 1.0 / (1.0 + x * x); };
+        }
+        else if (function == "exp2")
+        {
+            F = [](double const& x) { return std::exp2(x); };
+            FDer = [](double const& x) { return GTE_C_LN_2 * std::exp2(x); };
+        }
+        else if (function == "log2")
+        {
+            F = [](double const& x) { return std::log2(x); };
+            FDer = [](double const& x) { return GTE_C_INV_LN_2 / x; };
+        }
+        else if (function == "reciprocal")
+        {
+            F = [](double const& x) { return 1.0 / x; };
+            FDer = [](double const& x) { return -1.0 / (x * x); };
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    }
+
+    // The cache file has one fit per line,
+    //   key error n c[0] ... c[n-1]
+    // where the numbers are hexadecimal floating-point so that they are
+    // read back exactly.
+    void LoadCache(std::string const& filename, std::map<std::string, Fit>& cache)
+    {
+        std::ifstream input(filename);
+        std::string line;
+        while (std::getline(input, line))
+        {
+            std::istringstream tokens(line);
+            std::string key, number;
+            size_t numCoefficients = 0;
+            Fit fit;
+            if (!(tokens >> key >> number >> numCoefficients))
+            {
+                continue;
+            }
+            fit.error = std::strtod(number.c_str(), nullptr);
+            fit.coefficients.resize(numCoefficients);
+            bool valid = true;
+            for (auto& coefficient : fit.coefficients)
+            {
+                valid = valid && static_cast<bool>(tokens >> number);
+                coefficient = std::strtod(number.c_str(), nullptr);
+            }
+            if (valid)
+            {
+                cache[key] = fit;
+            }
+        }
+    }
+
+    void SaveCache(std::string const& filename, std::map<std::string, Fit> const& cache)
+    {
+        std::ofstream output(filename);
+        LogAssert(output, "Cannot open cache file " + filename + ".");
+        char number[64];
+        for (auto const& element : cache)
+        {
+            Fit const& fit = element.second;
+            std::snprintf(number, sizeof(number), "%a", fit.error);
+            output << element.first << " " << number << " " << fit.coefficients.size();
+            for (auto const& coefficient : fit.coefficients)
+            {
+                std::snprintf(number, sizeof(number), "%a", coefficient);
+                output << " " << number;
+            }
+            output << "\n";
+        }
+    }
+
+    void WriteConstants(std::ostream& output, std::vector<Job> const& jobs,
+        std::vector<Fit> const& fits)
+    {
+        char number[64];
+        std::string description;
+        for (size_t i = 0; i < jobs.size(); ++i)
+        {
+            Job const& job = jobs[i];
+            if (job.description != description)
+            {
+                description = job.description;
+                output << "// Constants for minimax polynomial approximations to "
+                    << description << ".\n";
+            }
+
+            std::string const prefix = "#define GTE_C_" + job.name + "_DEG" +
+                std::to_string(job.degree);
+            for (size_t j = 0; j < fits[i].coefficients.size(); ++j)
+            {
+                std::snprintf(number, sizeof(number), "%+.16e", fits[i].coefficients[j]);
+                output << prefix << "_C" << j << " " << number << "\n";
+            }
+            std::snprintf(number, sizeof(number), "%.16e", std::fabs(fits[i].error));
+            output << prefix << "_MAX_ERROR " << number << "\n\n";
+        }
+    }
+
+    // The jobs are assigned to the threads dynamically, because the costs
+    // of the fits vary greatly with the degree.
+    void Execute(std::vector<Job> const& jobs, std::vector<Fit>& fits,
+        std::vector<std::string>& errors, size_t numThreads)
+    {
+        std::atomic<size_t> next(0);
+        auto worker = [&jobs, &fits, &errors, &next]()
+        {
+            for (size_t i = next++; i < jobs.size(); i = next++)
+            {
+                try
+                {
+                    jobs[i].generate(fits[i]);
+                }
+                catch (std::exception const& e)
+                {
+                    errors[i] = e.what();
+                }
+            }
+        };
+
+        numThreads = std::min(numThreads, jobs.size());
+        if (numThreads > 0)
+        {
+            std::vector<std::thread> process(numThreads);
+            for (auto& thread : process)
+            {
+                thread = std::thread(worker);
+            }
+            for (auto& thread : process)
+            {
+                thread.join();
+            }
+        }
+        else
+        {
+            worker();
+        }
+    }
+}
+
+int main(int numArguments, char* arguments[])
+{
+    try
+    {
+        size_t numThreads = std::thread::hardware_concurrency();
+        std::string cacheFile, outputFile;
+        double tolerance = 1e-8;
+        std::vector<std::string> familyNames;
+        std::vector<int> remezArguments;
+
+        for (int i = 1; i < numArguments; ++i)
+        {
+            std::string argument = arguments[i];
+            if (argument == "-threads" && i + 1 < numArguments)
+            {
+                numThreads = static_cast<size_t>(std::strtoul(arguments[++i], nullptr, 10));
+            }
+            else if (argument == "-cache" && i + 1 < numArguments)
+            {
+                cacheFile = arguments[++i];
+            }
+            else if (argument == "-output" && i + 1 < numArguments)
+            {
+                outputFile = arguments[++i];
+            }
+            else if (argument == "-tolerance" && i + 1 < numArguments)
+            {
+                tolerance = std::strtod(arguments[++i], nullptr);
+            }
+            else if (argument == "-remez" && i + 5 < numArguments)
+            {
+                remezArguments.push_back(i + 1);
+                i += 5;
+            }
+            else
+            {
+                familyNames.push_back(argument);
+            }
+        }
+
+        // The -remez jobs are created after all options are read, so the
+        // tolerance applies to every -remez fit regardless of the order of
+        // the options.
+        std::vector<Job> remezJobs;
+        for (int i : remezArguments)
+        {
+            Job job;
+            job.name = arguments[i];
+            std::string function = arguments[i + 1];
+            double xMin = std::strtod(arguments[i + 2], nullptr);
+            double xMax = std::strtod(arguments[i + 3], nullptr);
+            job.degree = std::atoi(arguments[i + 4]);
+
+            Function F, FDer;
+            LogAssert(GetFunction(function, F, FDer), "Unknown function " + function + ".");
+            LogAssert(xMin < xMax && job.degree > 0, "Invalid -remez fit " + job.name + ".");
+            char number[128];
+            std::snprintf(number, sizeof(number), "[%.17g,%.17g]", xMin, xMax);
+            job.description = function + "(x) on " + number;
+            std::snprintf(number, sizeof(number), "%a:%a:%d:%a", xMin, xMax, job.degree,
+                tolerance);
+            job.key = "remez:" + job.name + ":" + function + ":" + number;
+
+            size_t const degree = static_cast<size_t>(job.degree);
+            job.generate = [F, FDer, xMin, xMax, degree, tolerance](Fit& fit)
+            {
+                RemezAlgorithm<double> remez;
+                remez.Execute(F, FDer, xMin, xMax, degree, 256, 2048, 128, tolerance);
+                fit.coefficients = remez.GetCoefficients();
+                fit.error = remez.GetEstimatedMaxError();
+            };
+            remezJobs.push_back(job);
+        }
+
+        std::vector<Job> jobs;
+        std::vector<Family> families = GetFamilies();
+        bool const allFamilies = (familyNames.size() == 0 && remezJobs.size() == 0);
+        for (auto const& family : families)
+        {
+            bool selected = allFamilies || std::find(familyNames.begin(),
+                familyNames.end(), family.name) != familyNames.end();
+            if (selected)
+            {
+                for (auto const& element : family.fits)
+                {
+                    Job job;
+                    job.key = "fit:" + family.name + ":" + std::to_string(element.first);
+                    job.name = family.name;
+                    job.degree = element.first;
+                    job.description = family.description;
+                    job.generate = element.second;
+                    jobs.push_back(job);
+                }
+            }
+        }
+        for (auto const& name : familyNames)
+        {
+            bool found = false;
+            for (auto const& family : families)
+            {
+                found = found || (family.name == name);
+            }
+            LogAssert(found, "Unknown option or family " + name + ".");
+        }
+        jobs.insert(jobs.end(), remezJobs.begin(), remezJobs.end());
+
+        // Only the fits that are not in the cache are computed.
+        std::map<std::string, Fit> cache;
+        if (cacheFile != "")
+        {
+            LoadCache(cacheFile, cache);
+        }
+
+        std::vector<Job> newJobs;
+        for (auto const& job : jobs)
+        {
+            if (cache.find(job.key) == cache.end())
+            {
+                newJobs.push_back(job);
+            }
+        }
+        std::vector<Fit> newFits(newJobs.size());
+        std::vector<std::string> errors(newJobs.size());
+        Execute(newJobs, newFits, errors, numThreads);
+
+        bool success = true;
+        for (size_t i = 0; i < newJobs.size(); ++i)
+        {
+            if (errors[i] == "")
+            {
+                cache[newJobs[i].key] = newFits[i];
+            }
+            else
+            {
+                std::cerr << newJobs[i].key << ": " << errors[i] << std::endl;
+                success = false;
+            }
+        }
+        if (cacheFile != "")
+        {
+            SaveCache(cacheFile, cache);
+        }
+
+        std::vector<Job> validJobs;
+        std::vector<Fit> fits;
+        for (auto const& job : jobs)
+        {
+            auto iter = cache.find(job.key);
+            if (iter != cache.end())
+            {
+                validJobs.push_back(job);
+                fits.push_back(iter->second);
+            }
+        }
+
+        if (outputFile != "")
+        {
+            std::ofstream output(outputFile);
+            LogAssert(output, "Cannot open output file " + outputFile + ".");
+            WriteConstants(output, validJobs, fits);
+        }
+        else
+        {
+            WriteConstants(std::cout, validJobs, fits);
+        }
+        return (success ? 0 : 1);
     }
     catch (std::exception const& e)
     {
         std::cout << e.what() << std::endl;
     }
-    return 0;
+    return 1;
 }
-
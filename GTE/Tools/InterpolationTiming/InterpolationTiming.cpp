@@ -0,0 +1,180 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2022
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 6.3.2026.10.17
+
+#include <Mathematics/IntpAkimaUniform3.h>
+#include <Mathematics/IntpTricubic3.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace gte;
+
+// Memory and throughput of the 3D interpolators.
+//
+//   InterpolationTiming [-size n] [-cache c] [-threads t]
+//
+// The samples are a smooth function on an n-by-n-by-n grid (the default n
+// is 64). IntpAkimaUniform3 is measured in the eager mode, which computes
+// the polynomials of all cells in the constructor, and in the lazy mode
+// with an LRU cache of c cells (the default c is 4096). For each mode, the
+// construction time, the polynomial storage and the times to evaluate a
+// grid of twice the sample resolution pointwise by operator() and by
+// Resample are reported. The lazy results are compared to the eager ones.
+// IntpTricubic3 is measured by the pointwise and Resample evaluations of
+// the same grid. Resample uses t threads (the default is the number of
+// hardware threads; t = 0 uses the main thread).
+
+template <typename Function>
+double Seconds(Function function)
+{
+    auto start = std::chrono::steady_clock::now();
+    function();
+    auto final = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(final - start).count();
+}
+
+// Evaluate the grid of Resample by calls to operator().
+template <typename Interpolator>
+void Pointwise(Interpolator const& interpolator, int32_t num, float delta,
+    std::vector<float>& output)
+{
+    for (int32_t k = 0, index = 0; k < num; ++k)
+    {
+        float z = k * delta;
+        for (int32_t j = 0; j < num; ++j)
+        {
+            float y = j * delta;
+            for (int32_t i = 0; i < num; ++i, ++index)
+            {
+                output[index] = interpolator(i * delta, y, z);
+            }
+        }
+    }
+}
+
+float MaxDifference(std::vector<float> const& v0, std::vector<float> const& v1)
+{
+    float maxDifference = 0.0f;
+    for (size_t i = 0; i < v0.size(); ++i)
+    {
+        maxDifference = std::max(maxDifference, std::fabs(v0[i] - v1[i]));
+    }
+    return maxDifference;
+}
+
+int main(int numArguments, char* arguments[])
+{
+    try
+    {
+        int32_t size = 64;
+        size_t cacheCapacity = 4096;
+        size_t numThreads = std::thread::hardware_concurrency();
+        for (int i = 1; i < numArguments; ++i)
+        {
+            std::string argument = arguments[i];
+            LogAssert(i + 1 < numArguments, "Option " + argument + " requires a value.");
+            long value = std::strtol(arguments[++i], nullptr, 10);
+            if (argument == "-size")
+            {
+                size = static_cast<int32_t>(value);
+            }
+            else if (argument == "-cache")
+            {
+                cacheCapacity = static_cast<size_t>(value);
+            }
+            else if (argument == "-threads")
+            {
+                numThreads = static_cast<size_t>(value);
+            }
+            else
+            {
+                LogError("Unknown option " + argument + ".");
+            }
+        }
+        LogAssert(size >= 4 && cacheCapacity > 0, "Invalid options.");
+
+        // The samples are at integer coordinates in [0,size-1]^3.
+        std::vector<float> samples(static_cast<size_t>(size) * size * size);
+        for (int32_t z = 0, index = 0; z < size; ++z)
+        {
+            for (int32_t y = 0; y < size; ++y)
+            {
+                for (int32_t x = 0; x < size; ++x, ++index)
+                {
+                    samples[index] = std::sin(0.11f * x) * std::cos(0.07f * y) + 0.01f * z;
+                }
+            }
+        }
+
+        int32_t const num = 2 * (size - 1) + 1;
+        float const delta = 0.5f;
+        size_t const numGrid = static_cast<size_t>(num) * num * num;
+        std::vector<float> eagerPoints(numGrid), eagerGrid(numGrid), points(numGrid), grid(numGrid);
+
+        std::printf("%d^3 samples, %d^3 grid points, cache = %zu cells, threads = %zu\n",
+            size, num, cacheCapacity, numThreads);
+        std::printf("%-16s %12s %12s %12s %12s\n", "", "construct s", "storage MB",
+            "pointwise s", "resample s");
+
+        std::unique_ptr<IntpAkimaUniform3<float>> akima;
+        double construct = Seconds([&]()
+        {
+            akima = std::make_unique<IntpAkimaUniform3<float>>(size, size, size,
+                0.0f, 1.0f, 0.0f, 1.0f, 0.0f, 1.0f, samples.data());
+        });
+        double pointwise = Seconds([&]() { Pointwise(*akima, num, delta, eagerPoints); });
+        double resample = Seconds([&]()
+        {
+            akima->Resample(0, 0, 0, num, 0.0f, delta, num, 0.0f, delta, num, 0.0f, delta,
+                eagerGrid.data(), numThreads);
+        });
+        std::printf("%-16s %12.3f %12.2f %12.3f %12.3f\n", "Akima eager", construct,
+            akima->GetPolynomialStorage() / 1048576.0, pointwise, resample);
+
+        construct = Seconds([&]()
+        {
+            akima = std::make_unique<IntpAkimaUniform3<float>>(size, size, size,
+                0.0f, 1.0f, 0.0f, 1.0f, 0.0f, 1.0f, samples.data(), cacheCapacity);
+        });
+        pointwise = Seconds([&]() { Pointwise(*akima, num, delta, points); });
+        resample = Seconds([&]()
+        {
+            akima->Resample(0, 0, 0, num, 0.0f, delta, num, 0.0f, delta, num, 0.0f, delta,
+                grid.data(), numThreads);
+        });
+        std::printf("%-16s %12.3f %12.2f %12.3f %12.3f\n", "Akima lazy", construct,
+            akima->GetPolynomialStorage() / 1048576.0, pointwise, resample);
+        std::printf("    max |lazy - eager| = %g (pointwise), %g (resample)\n",
+            MaxDifference(points, eagerPoints), MaxDifference(grid, eagerGrid));
+        std::printf("    max |resample - pointwise| = %g\n", MaxDifference(eagerGrid, eagerPoints));
+        akima.reset();
+
+        IntpTricubic3<float> tricubic(size, size, size, 0.0f, 1.0f, 0.0f, 1.0f, 0.0f, 1.0f,
+            samples.data(), true);
+        pointwise = Seconds([&]() { Pointwise(tricubic, num, delta, points); });
+        resample = Seconds([&]()
+        {
+            tricubic.Resample(0, 0, 0, num, 0.0f, delta, num, 0.0f, delta, num, 0.0f, delta,
+                grid.data(), numThreads);
+        });
+        std::printf("%-16s %12s %12s %12.3f %12.3f\n", "Tricubic", "-", "-", pointwise, resample);
+        std::printf("    max |resample - pointwise| = %g\n", MaxDifference(grid, points));
+        return 0;
+    }
+    catch (std::exception const& e)
+    {
+        std::cout << e.what() << std::endl;
+        return -1;
+    }
+}
@@ -0,0 +1,181 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2022
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 6.3.2026.10.17
+
+#include <Mathematics/ConcurrentHashMap.h>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace gte;
+
+// A contention benchmark for ConcurrentHashMap.
+//
+//   MapContention [-operations n] [-keys k] [-maxthreads t]
+//
+// For each count p = 1, 2, 4, ..., t (the default t is 32), p threads
+// perform a total of n operations (the default is 2^21) on random keys in
+// [0, k) (the default k is 2^16), where half the keys are initially in the
+// map. The throughput in millions of operations per second is reported for
+// two mixes of operations,
+//   read-heavy:  90% Get, 5% Insert, 5% Remove
+//   write-heavy: 50% Get, 25% Insert, 25% Remove
+// and for two maps,
+//   mutex: a std::map protected by a std::mutex, which is the previous
+//          implementation of ThreadSafeMap
+//   hash:  ConcurrentHashMap with the default number of shards
+
+class MutexMap
+{
+public:
+    bool Get(uint32_t key, uint64_t& value) const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        auto iter = mMap.find(key);
+        if (iter != mMap.end())
+        {
+            value = iter->second;
+            return true;
+        }
+        return false;
+    }
+
+    void Insert(uint32_t key, uint64_t value)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mMap[key] = value;
+    }
+
+    bool Remove(uint32_t key)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mMap.erase(key) > 0;
+    }
+
+private:
+    std::map<uint32_t, uint64_t> mMap;
+    mutable std::mutex mMutex;
+};
+
+// The mix is the percentage of Get operations. The remaining operations
+// are equally Insert and Remove.
+template <typename Map>
+double Measure(Map& map, size_t numThreads, size_t numPerThread,
+    uint32_t numKeys, uint32_t getPercent)
+{
+    for (uint32_t key = 0; key < numKeys; key += 2)
+    {
+        map.Insert(key, key);
+    }
+
+    std::vector<std::thread> process(numThreads);
+    std::vector<uint64_t> found(numThreads, 0);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t t = 0; t < numThreads; ++t)
+    {
+        process[t] = std::thread([&map, &found, t, numPerThread, numKeys, getPercent]()
+        {
+            std::minstd_rand rng(static_cast<uint32_t>(t + 1));
+            uint64_t numFound = 0, value = 0;
+            for (size_t i = 0; i < numPerThread; ++i)
+            {
+                uint32_t const r = static_cast<uint32_t>(rng());
+                uint32_t const key = (r >> 7) % numKeys;
+                uint32_t const operation = r % 100;
+                if (operation < getPercent)
+                {
+                    numFound += (map.Get(key, value) ? 1 : 0);
+                }
+                else if ((operation & 1) == 0)
+                {
+                    map.Insert(key, key);
+                }
+                else
+                {
+                    numFound += (map.Remove(key) ? 1 : 0);
+                }
+            }
+            found[t] = numFound;
+        });
+    }
+    for (auto& p : process)
+    {
+        p.join();
+    }
+    auto final = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(final - start).count();
+    return static_cast<double>(numThreads * numPerThread) / (1e6 * seconds);
+}
+
+int main(int numArguments, char* arguments[])
+{
+    try
+    {
+        size_t numOperations = static_cast<size_t>(1) << 21;
+        size_t numKeys = static_cast<size_t>(1) << 16;
+        size_t maxNumThreads = 32;
+        for (int i = 1; i < numArguments; ++i)
+        {
+            std::string argument = arguments[i];
+            LogAssert(i + 1 < numArguments, "Option " + argument + " requires a value.");
+            size_t value = static_cast<size_t>(std::strtoul(arguments[++i], nullptr, 10));
+            if (argument == "-operations")
+            {
+                numOperations = value;
+            }
+            else if (argument == "-keys")
+            {
+                numKeys = value;
+            }
+            else if (argument == "-maxthreads")
+            {
+                maxNumThreads = value;
+            }
+            else
+            {
+                LogError("Unknown option " + argument + ".");
+            }
+        }
+        LogAssert(numOperations > 0 && numKeys > 0 && numKeys <= UINT32_MAX
+            && maxNumThreads > 0, "Invalid options.");
+
+        uint32_t const keys = static_cast<uint32_t>(numKeys);
+        std::printf("%zu operations, %zu keys, Moperations/second\n", numOperations, numKeys);
+        std::printf("         read-heavy              write-heavy\n");
+        std::printf("threads       mutex        hash        mutex        hash\n");
+        for (size_t numThreads = 1; numThreads <= maxNumThreads; numThreads *= 2)
+        {
+            size_t const numPerThread = numOperations / numThreads;
+            double rates[4];
+            for (size_t mix = 0; mix < 2; ++mix)
+            {
+                uint32_t const getPercent = (mix == 0 ? 90 : 50);
+
+                MutexMap mutexMap;
+                rates[2 * mix] = Measure(mutexMap, numThreads, numPerThread, keys, getPercent);
+
+                ConcurrentHashMap<uint32_t, uint64_t> hashMap;
+                rates[2 * mix + 1] = Measure(hashMap, numThreads, numPerThread, keys, getPercent);
+            }
+            std::printf("%7zu %11.2f %11.2f  %11.2f %11.2f\n", numThreads,
+                rates[0], rates[1], rates[2], rates[3]);
+        }
+        return 0;
+    }
+    catch (std::exception const& e)
+    {
+        std::cout << e.what() << std::endl;
+        return -1;
+    }
+}
@@ -0,0 +1,210 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2022
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 6.3.2026.10.17
+
+#include <Mathematics/Logger.h>
+#include <Mathematics/ParallelAlgorithms.h>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace gte;
+
+// Timing of the scans, compaction and radix sort of ParallelAlgorithms.h
+// compared to their serial std counterparts.
+//
+//   ParallelScanTiming [-size n] [-lgthreads k]
+//
+// The arrays have n elements (the default n is 2^24). The parallel
+// functions use 2^k threads; the default k is the floor of the base-2
+// logarithm of the number of hardware threads. The results of the
+// parallel functions are compared to those of the std functions.
+
+template <typename Function>
+double Milliseconds(Function function)
+{
+    auto start = std::chrono::steady_clock::now();
+    function();
+    auto final = std::chrono::steady_clock::now();
+    return 1000.0 * std::chrono::duration<double>(final - start).count();
+}
+
+void Report(char const* name, double serial, double parallel)
+{
+    std::printf("%-28s %10.2f %10.2f %8.2fx\n", name, serial, parallel, serial / parallel);
+}
+
+int main(int numArguments, char* arguments[])
+{
+    try
+    {
+        size_t size = static_cast<size_t>(1) << 24;
+        size_t lgNumThreads = 0;
+        for (unsigned int n = std::thread::hardware_concurrency(); n > 1; n /= 2)
+        {
+            ++lgNumThreads;
+        }
+        for (int i = 1; i < numArguments; ++i)
+        {
+            std::string argument = arguments[i];
+            LogAssert(i + 1 < numArguments, "Option " + argument + " requires a value.");
+            long value = std::strtol(arguments[++i], nullptr, 10);
+            if (argument == "-size")
+            {
+                size = static_cast<size_t>(value);
+            }
+            else if (argument == "-lgthreads")
+            {
+                lgNumThreads = static_cast<size_t>(value);
+            }
+            else
+            {
+                LogError("Unknown option " + argument + ".");
+            }
+        }
+        LogAssert(size > 0, "Invalid options.");
+
+        std::mt19937 rng(12345);
+        std::vector<uint32_t> integers(size);
+        std::vector<float> numbers(size);
+        std::vector<char> flags(size);
+        std::normal_distribution<float> normal(0.0f, 1000.0f);
+        for (size_t i = 0; i < size; ++i)
+        {
+            integers[i] = static_cast<uint32_t>(rng());
+            numbers[i] = normal(rng);
+            flags[i] = (rng() % 64 == 0 ? 1 : 0);
+        }
+
+        std::printf("%zu elements, threads = %zu\n", size, static_cast<size_t>(1) << lgNumThreads);
+        std::printf("%-28s %10s %10s %9s\n", "milliseconds", "serial", "parallel", "speedup");
+
+        std::vector<uint32_t> serialIntegers(size), parallelIntegers(size);
+        double serial = Milliseconds([&]()
+        {
+            std::partial_sum(integers.begin(), integers.end(), serialIntegers.begin());
+        });
+        double parallel = Milliseconds([&]()
+        {
+            ParallelInclusiveScan(integers.begin(), integers.end(), parallelIntegers.begin(),
+                std::plus<uint32_t>(), lgNumThreads);
+        });
+        LogAssert(serialIntegers == parallelIntegers, "Incorrect inclusive scan.");
+        Report("inclusive scan uint32_t", serial, parallel);
+
+        serial = Milliseconds([&]()
+        {
+            uint32_t sum = 0;
+            for (size_t i = 0; i < size; ++i)
+            {
+                serialIntegers[i] = sum;
+                sum += integers[i];
+            }
+        });
+        parallel = Milliseconds([&]()
+        {
+            ParallelExclusiveScan(integers.begin(), integers.end(), parallelIntegers.begin(),
+                0u, std::plus<uint32_t>(), lgNumThreads);
+        });
+        LogAssert(serialIntegers == parallelIntegers, "Incorrect exclusive scan.");
+        Report("exclusive scan uint32_t", serial, parallel);
+
+        serial = Milliseconds([&]()
+        {
+            uint32_t sum = 0;
+            for (size_t i = 0; i < size; ++i)
+            {
+                sum = (flags[i] ? integers[i] : sum + integers[i]);
+                serialIntegers[i] = sum;
+            }
+        });
+        parallel = Milliseconds([&]()
+        {
+            ParallelSegmentedInclusiveScan(integers.begin(), integers.end(), flags.begin(),
+                parallelIntegers.begin(), std::plus<uint32_t>(), lgNumThreads);
+        });
+        LogAssert(serialIntegers == parallelIntegers, "Incorrect segmented scan.");
+        Report("segmented scan uint32_t", serial, parallel);
+
+        std::vector<float> parallelNumbers(size);
+        float serialSum = 0.0f, parallelSum = 0.0f;
+        serial = Milliseconds([&]()
+        {
+            serialSum = std::accumulate(numbers.begin(), numbers.end(), 0.0f);
+        });
+        parallel = Milliseconds([&]()
+        {
+            parallelSum = ParallelReduce(numbers.begin(), numbers.end(), 0.0f,
+                std::plus<float>(), lgNumThreads);
+        });
+        Report("reduce float", serial, parallel);
+        std::printf("    serial sum = %.6g, parallel sum = %.6g\n", serialSum, parallelSum);
+
+        auto isPositive = [](float x) { return x > 0.0f; };
+        std::vector<float> serialNumbers;
+        serialNumbers.reserve(size);
+        serial = Milliseconds([&]()
+        {
+            std::copy_if(numbers.begin(), numbers.end(), std::back_inserter(serialNumbers), isPositive);
+        });
+        parallel = Milliseconds([&]()
+        {
+            auto last = ParallelCopyIf(numbers.begin(), numbers.end(), parallelNumbers.begin(),
+                isPositive, lgNumThreads);
+            parallelNumbers.resize(static_cast<size_t>(last - parallelNumbers.begin()));
+        });
+        LogAssert(serialNumbers == parallelNumbers, "Incorrect compaction.");
+        Report("copy_if float", serial, parallel);
+
+        serialIntegers = integers;
+        parallelIntegers = integers;
+        serial = Milliseconds([&]()
+        {
+            std::sort(serialIntegers.begin(), serialIntegers.end());
+        });
+        parallel = Milliseconds([&]()
+        {
+            ParallelRadixSort(parallelIntegers.begin(), parallelIntegers.end(), lgNumThreads);
+        });
+        LogAssert(serialIntegers == parallelIntegers, "Incorrect radix sort.");
+        Report("radix sort uint32_t", serial, parallel);
+
+        parallelIntegers = integers;
+        parallel = Milliseconds([&]()
+        {
+            ParallelSort(parallelIntegers.begin(), parallelIntegers.end(),
+                std::less<uint32_t>(), lgNumThreads);
+        });
+        LogAssert(serialIntegers == parallelIntegers, "Incorrect sort.");
+        Report("ParallelSort uint32_t", serial, parallel);
+
+        serialNumbers = numbers;
+        parallelNumbers = numbers;
+        serial = Milliseconds([&]()
+        {
+            std::sort(serialNumbers.begin(), serialNumbers.end());
+        });
+        parallel = Milliseconds([&]()
+        {
+            ParallelRadixSort(parallelNumbers.begin(), parallelNumbers.end(),
+                [](float x) { return GetRadixSortKey(x); }, lgNumThreads);
+        });
+        LogAssert(serialNumbers == parallelNumbers, "Incorrect radix sort.");
+        Report("radix sort float", serial, parallel);
+        return 0;
+    }
+    catch (std::exception const& e)
+    {
+        std::cout << e.what() << std::endl;
+        return -1;
+    }
+}
@@ -0,0 +1,196 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2022
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 6.3.2026.10.17
+
+#include <Mathematics/LockFreeQueue.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace gte;
+
+// A contention benchmark for the bounded queues of LockFreeQueue.h.
+//
+//   QueueContention [-elements n] [-capacity c] [-maxthreads t]
+//
+// For each count p = 1, 2, 4, ..., t (the default t is 32), p producer
+// threads push a total of n elements (the default is 2^20) into a queue of
+// capacity c (the default is 1024) and p consumer threads pop them. The
+// throughput in millions of elements per second is reported for
+//   mutex: a std::queue protected by a std::mutex, which is the previous
+//          implementation of ThreadSafeQueue, where the threads poll Push
+//          and Pop and yield when they fail
+//   mpmc:  MPMCQueue with WaitPush and WaitPop
+//   spsc:  SPSCQueue with WaitPush and WaitPop (only for p = 1)
+
+class MutexQueue
+{
+public:
+    MutexQueue(size_t maxNumElements)
+        :
+        mMaxNumElements(maxNumElements)
+    {
+    }
+
+    bool Push(uint64_t element)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mQueue.size() < mMaxNumElements)
+        {
+            mQueue.push(element);
+            return true;
+        }
+        return false;
+    }
+
+    bool Pop(uint64_t& element)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mQueue.size() > 0)
+        {
+            element = mQueue.front();
+            mQueue.pop();
+            return true;
+        }
+        return false;
+    }
+
+    void WaitPush(uint64_t element)
+    {
+        while (!Push(element))
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    void WaitPop(uint64_t& element)
+    {
+        while (!Pop(element))
+        {
+            std::this_thread::yield();
+        }
+    }
+
+private:
+    size_t mMaxNumElements;
+    std::queue<uint64_t> mQueue;
+    std::mutex mMutex;
+};
+
+// Run numThreads producers and numThreads consumers that each transfer
+// numPerThread elements. The return value is the throughput in millions
+// of elements per second. The sum of the popped elements is verified.
+template <typename Queue>
+double Measure(Queue& queue, size_t numThreads, size_t numPerThread)
+{
+    std::atomic<uint64_t> sum(0);
+    std::vector<std::thread> process;
+    process.reserve(2 * numThreads);
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t t = 0; t < numThreads; ++t)
+    {
+        process.emplace_back([&queue, t, numPerThread]()
+        {
+            uint64_t const first = static_cast<uint64_t>(t * numPerThread);
+            for (uint64_t i = 0; i < numPerThread; ++i)
+            {
+                queue.WaitPush(first + i);
+            }
+        });
+
+        process.emplace_back([&queue, &sum, numPerThread]()
+        {
+            uint64_t localSum = 0, element = 0;
+            for (size_t i = 0; i < numPerThread; ++i)
+            {
+                queue.WaitPop(element);
+                localSum += element;
+            }
+            sum += localSum;
+        });
+    }
+    for (auto& p : process)
+    {
+        p.join();
+    }
+    auto final = std::chrono::steady_clock::now();
+
+    uint64_t const numElements = static_cast<uint64_t>(numThreads * numPerThread);
+    LogAssert(sum == numElements * (numElements - 1) / 2, "Elements were lost.");
+
+    double seconds = std::chrono::duration<double>(final - start).count();
+    return static_cast<double>(numElements) / (1e6 * seconds);
+}
+
+int main(int numArguments, char* arguments[])
+{
+    try
+    {
+        size_t numElements = static_cast<size_t>(1) << 20;
+        size_t capacity = 1024;
+        size_t maxNumThreads = 32;
+        for (int i = 1; i < numArguments; ++i)
+        {
+            std::string argument = arguments[i];
+            LogAssert(i + 1 < numArguments, "Option " + argument + " requires a value.");
+            size_t value = static_cast<size_t>(std::strtoul(arguments[++i], nullptr, 10));
+            if (argument == "-elements")
+            {
+                numElements = value;
+            }
+            else if (argument == "-capacity")
+            {
+                capacity = value;
+            }
+            else if (argument == "-maxthreads")
+            {
+                maxNumThreads = value;
+            }
+            else
+            {
+                LogError("Unknown option " + argument + ".");
+            }
+        }
+        LogAssert(numElements > 0 && capacity > 0 && maxNumThreads > 0, "Invalid options.");
+
+        std::printf("%zu elements, capacity %zu, Melements/second\n", numElements, capacity);
+        std::printf("threads       mutex        mpmc        spsc\n");
+        for (size_t numThreads = 1; numThreads <= maxNumThreads; numThreads *= 2)
+        {
+            size_t const numPerThread = numElements / numThreads;
+
+            MutexQueue mutexQueue(capacity);
+            double mutexRate = Measure(mutexQueue, numThreads, numPerThread);
+
+            MPMCQueue<uint64_t> mpmcQueue(capacity);
+            double mpmcRate = Measure(mpmcQueue, numThreads, numPerThread);
+
+            std::printf("%7zu %11.2f %11.2f", numThreads, mutexRate, mpmcRate);
+            if (numThreads == 1)
+            {
+                SPSCQueue<uint64_t> spscQueue(capacity);
+                double spscRate = Measure(spscQueue, numThreads, numPerThread);
+                std::printf(" %11.2f", spscRate);
+            }
+            std::printf("\n");
+        }
+        return 0;
+    }
+    catch (std::exception const& e)
+    {
+        std::cout << e.what() << std::endl;
+        return -1;
+    }
+}
@@ -0,0 +1,175 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2022
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 6.3.2026.10.17
+
+#include <Mathematics/RankFilter.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace gte;
+
+// Throughput of the median filters of RankFilter.h by window radius.
+//
+//   RankFilterTiming [-size n] [-depth m] [-threads t]
+//
+// The 2D images are n-by-n (the default n is 1024) and the 3D images are
+// n/4-by-n/4-by-m (the default m is 64). The pixels are a smooth function
+// plus noise, as in CT slices: 8-bit pixels for uint8_t and 12-bit values
+// for uint16_t. The throughput is reported in millions of pixels per
+// second, and for small radii it is compared to the direct computation of
+// the median of each window by std::nth_element. The default number of
+// threads is the number of hardware threads; t = 0 uses the main thread.
+
+template <typename PixelType>
+void Generate(std::vector<PixelType>& pixels, int32_t dim0, int32_t dim1, uint32_t maxValue)
+{
+    std::mt19937 rng(12345);
+    std::normal_distribution<double> noise(0.0, 0.05 * maxValue);
+    for (int32_t y = 0, i = 0; y < dim1; ++y)
+    {
+        for (int32_t x = 0; x < dim0; ++x, ++i)
+        {
+            double u = static_cast<double>(x) / dim0, v = static_cast<double>(y % dim1) / dim1;
+            double value = 0.5 * maxValue * (1.0 + std::sin(6.0 * u) * std::cos(4.0 * v)) + noise(rng);
+            pixels[i] = static_cast<PixelType>(std::min(std::max(value, 0.0), static_cast<double>(maxValue)));
+        }
+    }
+}
+
+template <typename PixelType>
+void Direct(Image2<PixelType> const& input, int32_t radius, Image2<PixelType>& output)
+{
+    int32_t const dim0 = input.GetDimension(0), dim1 = input.GetDimension(1);
+    output.Reconstruct(dim0, dim1);
+    std::vector<PixelType> window;
+    for (int32_t y = 0; y < dim1; ++y)
+    {
+        for (int32_t x = 0; x < dim0; ++x)
+        {
+            window.clear();
+            for (int32_t dy = -radius; dy <= radius; ++dy)
+            {
+                int32_t yy = std::min(std::max(y + dy, 0), dim1 - 1);
+                for (int32_t dx = -radius; dx <= radius; ++dx)
+                {
+                    int32_t xx = std::min(std::max(x + dx, 0), dim0 - 1);
+                    window.push_back(input(xx, yy));
+                }
+            }
+            auto median = window.begin() + window.size() / 2;
+            std::nth_element(window.begin(), median, window.end());
+            output(x, y) = *median;
+        }
+    }
+}
+
+template <typename Function>
+double Rate(size_t numPixels, Function function)
+{
+    auto start = std::chrono::steady_clock::now();
+    function();
+    auto final = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(final - start).count();
+    return static_cast<double>(numPixels) / (1e6 * seconds);
+}
+
+template <typename PixelType>
+void Measure2(char const* name, int32_t size, uint32_t maxValue, size_t numThreads)
+{
+    Image2<PixelType> input(size, size), output, direct;
+    Generate(input.GetPixels(), size, size, maxValue);
+    size_t const numPixels = input.GetNumPixels();
+
+    std::printf("Image2<%s> %dx%d, Mpixels/second\n", name, size, size);
+    std::printf(" radius    rankfilter      direct\n");
+    for (int32_t radius = 1; radius <= 64; radius *= 2)
+    {
+        double rate = Rate(numPixels, [&]()
+        {
+            RankFilter<PixelType>::Median(input, radius, numThreads, output);
+        });
+        std::printf("%7d %13.2f", radius, rate);
+
+        if (radius <= 4)
+        {
+            double directRate = Rate(numPixels, [&]() { Direct(input, radius, direct); });
+            LogAssert(direct.GetPixels() == output.GetPixels(), "Incorrect median.");
+            std::printf(" %11.2f", directRate);
+        }
+        std::printf("\n");
+    }
+}
+
+template <typename PixelType>
+void Measure3(char const* name, int32_t size, int32_t depth, uint32_t maxValue, size_t numThreads)
+{
+    Image3<PixelType> input(size, size, depth), output;
+    Generate(input.GetPixels(), size, size * depth, maxValue);
+    size_t const numPixels = input.GetNumPixels();
+
+    std::printf("Image3<%s> %dx%dx%d, Mvoxels/second\n", name, size, size, depth);
+    std::printf(" radius    rankfilter\n");
+    for (int32_t radius = 1; radius <= 8; radius *= 2)
+    {
+        double rate = Rate(numPixels, [&]()
+        {
+            RankFilter<PixelType>::Median(input, radius, numThreads, output);
+        });
+        std::printf("%7d %13.2f\n", radius, rate);
+    }
+}
+
+int main(int numArguments, char* arguments[])
+{
+    try
+    {
+        int32_t size = 1024, depth = 64;
+        size_t numThreads = std::thread::hardware_concurrency();
+        for (int i = 1; i < numArguments; ++i)
+        {
+            std::string argument = arguments[i];
+            LogAssert(i + 1 < numArguments, "Option " + argument + " requires a value.");
+            long value = std::strtol(arguments[++i], nullptr, 10);
+            if (argument == "-size")
+            {
+                size = static_cast<int32_t>(value);
+            }
+            else if (argument == "-depth")
+            {
+                depth = static_cast<int32_t>(value);
+            }
+            else if (argument == "-threads")
+            {
+                numThreads = static_cast<size_t>(value);
+            }
+            else
+            {
+                LogError("Unknown option " + argument + ".");
+            }
+        }
+        LogAssert(size >= 4 && depth > 0, "Invalid options.");
+
+        std::printf("threads = %zu\n", numThreads);
+        Measure2<uint8_t>("uint8_t", size, 255, numThreads);
+        Measure2<uint16_t>("uint16_t", size, 4095, numThreads);
+        Measure3<uint8_t>("uint8_t", size / 4, depth, 255, numThreads);
+        Measure3<uint16_t>("uint16_t", size / 4, depth, 4095, numThreads);
+        return 0;
+    }
+    catch (std::exception const& e)
+    {
+        std::cout << e.what() << std::endl;
+        return -1;
+    }
+}
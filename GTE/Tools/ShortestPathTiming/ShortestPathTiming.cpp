@@ -0,0 +1,173 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2022
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 6.3.2026.10.17
+
+#include <Mathematics/ShortestPaths.h>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+using namespace gte;
+
+// Timing of the cost-distance map of a cost raster by ShortestPaths.h.
+//
+//   ShortestPathTiming [-size n] [-sources s] [-threads t]
+//
+// The raster is n-by-n (the default n is 2048) with 8-connectivity. The
+// costs are a smooth function plus noise with obstacles of infinite cost.
+// The distances are computed from s random sources (the default s is 1)
+// by Dijkstra with a binary heap (std::priority_queue), by Dijkstra with
+// the radix heap and by delta-stepping for several multiples of the
+// default delta. The delta-stepping distances are compared to those of
+// Dijkstra. The default number of threads is the number of hardware
+// threads; t = 0 uses the main thread.
+
+void Generate(Image2<float>& cost)
+{
+    int32_t const dim0 = cost.GetDimension(0), dim1 = cost.GetDimension(1);
+    std::mt19937 rng(12345);
+    std::uniform_real_distribution<float> noise(0.0f, 0.5f);
+    std::uniform_int_distribution<int32_t> obstacle(0, 99);
+    for (int32_t y = 0; y < dim1; ++y)
+    {
+        for (int32_t x = 0; x < dim0; ++x)
+        {
+            float u = static_cast<float>(x) / dim0, v = static_cast<float>(y) / dim1;
+            float value = 1.5f + std::sin(12.0f * u) * std::cos(8.0f * v) + noise(rng);
+            cost(x, y) = (obstacle(rng) == 0 ? std::numeric_limits<float>::infinity() : value);
+        }
+    }
+}
+
+void BinaryHeapDijkstra(GridGraph2<float> const& graph, std::vector<int32_t> const& sources,
+    std::vector<float>& distance)
+{
+    using Element = std::pair<float, int32_t>;
+    std::priority_queue<Element, std::vector<Element>, std::greater<Element>> heap;
+    distance.assign(static_cast<size_t>(graph.GetNumVertices()), std::numeric_limits<float>::infinity());
+    for (auto source : sources)
+    {
+        distance[source] = 0.0f;
+        heap.push(std::make_pair(0.0f, source));
+    }
+    while (!heap.empty())
+    {
+        Element element = heap.top();
+        heap.pop();
+        float const d = element.first;
+        if (d != distance[element.second])
+        {
+            continue;
+        }
+        graph.ForEachEdge(element.second, [&distance, &heap, d](int32_t w, float weight)
+        {
+            float const candidate = d + weight;
+            if (candidate < distance[w])
+            {
+                distance[w] = candidate;
+                heap.push(std::make_pair(candidate, w));
+            }
+        });
+    }
+}
+
+template <typename Function>
+double Seconds(Function function)
+{
+    auto start = std::chrono::steady_clock::now();
+    function();
+    auto final = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(final - start).count();
+}
+
+int main(int numArguments, char* arguments[])
+{
+    try
+    {
+        int32_t size = 2048, numSources = 1;
+        size_t numThreads = std::thread::hardware_concurrency();
+        for (int i = 1; i < numArguments; ++i)
+        {
+            std::string argument = arguments[i];
+            LogAssert(i + 1 < numArguments, "Option " + argument + " requires a value.");
+            long value = std::strtol(arguments[++i], nullptr, 10);
+            if (argument == "-size")
+            {
+                size = static_cast<int32_t>(value);
+            }
+            else if (argument == "-sources")
+            {
+                numSources = static_cast<int32_t>(value);
+            }
+            else if (argument == "-threads")
+            {
+                numThreads = static_cast<size_t>(value);
+            }
+            else
+            {
+                LogError("Unknown option " + argument + ".");
+            }
+        }
+        LogAssert(size > 0 && numSources > 0, "Invalid options.");
+
+        Image2<float> cost(size, size);
+        Generate(cost);
+        GridGraph2<float> graph(cost, true);
+
+        std::mt19937 rng(67890);
+        std::uniform_int_distribution<int32_t> location(0, graph.GetNumVertices() - 1);
+        std::vector<int32_t> sources(static_cast<size_t>(numSources));
+        for (auto& source : sources)
+        {
+            do
+            {
+                source = location(rng);
+            } while (!std::isfinite(cost.GetPixels()[source]));
+        }
+
+        double const numMPixels = static_cast<double>(cost.GetNumPixels()) / 1e6;
+        std::printf("%dx%d raster, %d sources, threads = %zu\n", size, size, numSources, numThreads);
+        std::printf("%-26s %10s %14s\n", "method", "seconds", "Mpixels/second");
+
+        std::vector<float> reference, distance;
+        std::vector<int32_t> predecessor;
+        double seconds = Seconds([&]() { BinaryHeapDijkstra(graph, sources, distance); });
+        std::printf("%-26s %10.3f %14.2f\n", "Dijkstra binary heap", seconds, numMPixels / seconds);
+
+        seconds = Seconds([&]() { ShortestPaths<float>::Dijkstra(graph, sources, reference, predecessor); });
+        std::printf("%-26s %10.3f %14.2f\n", "Dijkstra radix heap", seconds, numMPixels / seconds);
+        LogAssert(distance == reference, "Incorrect distances.");
+
+        float const defaultDelta = ShortestPaths<float>::GetDefaultDelta(graph);
+        for (float multiple : { 0.25f, 1.0f, 4.0f, 16.0f })
+        {
+            seconds = Seconds([&]()
+            {
+                ShortestPaths<float>::DeltaStepping(graph, sources, multiple * defaultDelta,
+                    numThreads, distance);
+            });
+            char name[32];
+            std::snprintf(name, sizeof(name), "delta-stepping %gx", multiple);
+            std::printf("%-26s %10.3f %14.2f\n", name, seconds, numMPixels / seconds);
+            LogAssert(distance == reference, "Incorrect distances.");
+        }
+        return 0;
+    }
+    catch (std::exception const& e)
+    {
+        std::cout << e.what() << std::endl;
+        return -1;
+    }
+}
@@ -0,0 +1,152 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2022
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 6.3.2026.10.17
+
+#include <Mathematics/ArbitraryPrecision.h>
+#include <Mathematics/TriangulateEC.h>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+using namespace gte;
+
+// Timing of TriangulateEC for large polygons with many holes.
+//
+//   TriangulateECTiming [-size n] [-holes k] [-holesize m] [-rational r]
+//
+// The outer polygon is a star with n vertices (the default n is 20000),
+// half of which are reflex. The holes are star polygons with m vertices
+// (the default m is 8) on a k-by-k grid (the default k is 20). The outer
+// polygon is triangulated alone and with the holes, so the difference of
+// the times is approximately the cost of the hole elimination, which is
+// O(H*N) for H holes and N vertices. The ComputeType is 'double' when r is
+// 0 (the default) and BSRational<UIntegerAP32> otherwise. The number of
+// triangles is verified to be N+2*H-2.
+
+template <typename Function>
+double Seconds(Function function)
+{
+    auto start = std::chrono::steady_clock::now();
+    function();
+    auto final = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(final - start).count();
+}
+
+template <typename ComputeType>
+void Measure(std::vector<Vector2<double>> const& points,
+    std::vector<int32_t> const& outer, std::vector<std::vector<int32_t>> const& inners)
+{
+    TriangulateEC<double, ComputeType> triangulator(points);
+    double outerSeconds = Seconds([&]() { triangulator(outer); });
+    LogAssert(triangulator.GetTriangles().size() + 2 == outer.size(),
+        "Incorrect number of triangles.");
+
+    double holesSeconds = Seconds([&]() { triangulator(outer, inners); });
+    size_t const numTriangles = points.size() + 2 * inners.size() - 2;
+    LogAssert(triangulator.GetTriangles().size() == numTriangles,
+        "Incorrect number of triangles.");
+
+    std::printf("%-20s %12.3f\n", "outer polygon", outerSeconds);
+    std::printf("%-20s %12.3f\n", "with holes", holesSeconds);
+    std::printf("%zu triangles\n", numTriangles);
+}
+
+int main(int numArguments, char* arguments[])
+{
+    try
+    {
+        int32_t size = 20000, holesPerSide = 20, holeSize = 8;
+        bool rational = false;
+        for (int i = 1; i < numArguments; ++i)
+        {
+            std::string argument = arguments[i];
+            LogAssert(i + 1 < numArguments, "Option " + argument + " requires a value.");
+            long value = std::strtol(arguments[++i], nullptr, 10);
+            if (argument == "-size")
+            {
+                size = static_cast<int32_t>(value);
+            }
+            else if (argument == "-holes")
+            {
+                holesPerSide = static_cast<int32_t>(value);
+            }
+            else if (argument == "-holesize")
+            {
+                holeSize = static_cast<int32_t>(value);
+            }
+            else if (argument == "-rational")
+            {
+                rational = (value != 0);
+            }
+            else
+            {
+                LogError("Unknown option " + argument + ".");
+            }
+        }
+        LogAssert(size >= 4 && size % 2 == 0 && holesPerSide >= 0 &&
+            holeSize >= 4 && holeSize % 2 == 0, "Invalid options.");
+
+        // The outer polygon is counterclockwise with radii alternating
+        // between 100 and a random value in [97,99]. The holes are clockwise
+        // and lie in the square [-60,60]^2, which is inside the circle of
+        // radius 97.
+        double const twoPi = 2.0 * GTE_C_PI;
+        std::mt19937 rng(12345);
+        std::uniform_real_distribution<double> urd(97.0, 99.0);
+        std::vector<Vector2<double>> points;
+        std::vector<int32_t> outer(size);
+        for (int32_t i = 0; i < size; ++i)
+        {
+            double angle = twoPi * i / size;
+            double radius = (i % 2 == 1 ? 100.0 : urd(rng));
+            outer[i] = static_cast<int32_t>(points.size());
+            points.push_back({ radius * std::cos(angle), radius * std::sin(angle) });
+        }
+
+        std::vector<std::vector<int32_t>> inners;
+        double const spacing = 120.0 / std::max(holesPerSide, 1);
+        for (int32_t y = 0; y < holesPerSide; ++y)
+        {
+            for (int32_t x = 0; x < holesPerSide; ++x)
+            {
+                double cx = -60.0 + spacing * (x + 0.5);
+                double cy = -60.0 + spacing * (y + 0.5);
+                std::vector<int32_t> inner(holeSize);
+                for (int32_t i = 0; i < holeSize; ++i)
+                {
+                    double angle = -twoPi * i / holeSize;
+                    double radius = (i % 2 == 1 ? 0.35 : 0.25) * spacing;
+                    inner[i] = static_cast<int32_t>(points.size());
+                    points.push_back({ cx + radius * std::cos(angle), cy + radius * std::sin(angle) });
+                }
+                inners.push_back(std::move(inner));
+            }
+        }
+
+        std::printf("%d outer vertices, %zu holes of %d vertices, %s\n", size, inners.size(),
+            holeSize, rational ? "BSRational" : "double");
+        std::printf("%-20s %12s\n", "", "seconds");
+        if (rational)
+        {
+            Measure<BSRational<UIntegerAP32>>(points, outer, inners);
+        }
+        else
+        {
+            Measure<double>(points, outer, inners);
+        }
+        return 0;
+    }
+    catch (std::exception const& e)
+    {
+        std::cout << e.what() << std::endl;
+        return -1;
+    }
+}